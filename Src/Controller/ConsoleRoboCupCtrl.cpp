@@ -546,6 +546,7 @@ void ConsoleRoboCupCtrl::help(In& stream)
   list("  save ? [<pattern>] | <key> [<path>] : Save debug data to a configuration file.", pattern, true);
   list("  set ? [<pattern>] | <key> ( ? | unchanged | <data> ) : Change debug data or show its specification.", pattern, true);
   list("  si reset [<number>] | ( lower | upper ) [number] [grayscale] [region <left> <top> <right> <bottom>] [<file>] : Save the lower/upper camera's image.", pattern, true);
+  list("  sp [<file>] : Save the stacks sampled by the sample profiler (dr timing:sampleProfiler) in the folded format of flame graph tools.", pattern, true);
   list("  v3 ? [<pattern>] | <image> [jpeg] [<thread>] [<name>] : Add a set of 3-D views for a certain image.", pattern, true);
   list("  vd <debug data> ( on | off ) : Show debug data in a window or switch sending it off.", pattern, true);
   list("  vf <name> : Add field view.", pattern, true);
@@ -804,6 +805,7 @@ void ConsoleRoboCupCtrl::createCompletion()
     "si reset",
     "sl",
     "sml",
+    "sp",
     "st off",
     "st on",
     "v3 image Upper",
@@ -18,6 +18,7 @@
 #include "Representations/Infrastructure/FrameInfo.h"
 #include "Representations/Infrastructure/JointAngles.h"
 #include "Representations/Infrastructure/JointRequest.h"
+#include "Representations/Infrastructure/CompressedCameraImage.h"
 #include "Representations/Infrastructure/JPEGImage.h"
 #include "Representations/Infrastructure/RobotHealth.h"
 #include "Representations/Infrastructure/SensorData/InertialSensorData.h"
@@ -263,6 +264,7 @@ bool LogExtractor::saveImages(const std::string& path, const bool raw, const boo
     FallDownState,
     GameInfo,
     CameraImage,
+    CompressedCameraImage,
     JPEGImage,
     RobotInfo,
   });
@@ -290,6 +292,11 @@ bool LogExtractor::saveImages(const std::string& path, const bool raw, const boo
       theJPEGImage.toCameraImage(theCameraImage); // Assume that CameraImage and JPEGImage are not logged at the same time.
       theJPEGImage.timestamp = 0;
     }
+    if(theCompressedCameraImage.timestamp)
+    {
+      theCompressedCameraImage.toCameraImage(theCameraImage); // Same assumption as above.
+      theCompressedCameraImage.timestamp = 0;
+    }
 
     CameraImage* imageToExport = nullptr;
 
@@ -498,8 +505,10 @@ bool LogExtractor::saveLabeledBallSpots(const std::string& path)
   DECLARE_REPRESENTATIONS_AND_MAP(
   {,
     BallSpots,
+    CameraImage,
     CameraInfo,
     CameraMatrix,
+    CompressedCameraImage,
     LabelImage,
     JPEGImage,
   });
@@ -516,6 +525,17 @@ bool LogExtractor::saveLabeledBallSpots(const std::string& path)
   representations,
   [&](Out& file, const std::string& sep)
   {
+    if(theJPEGImage.timestamp)
+    {
+      theJPEGImage.toCameraImage(theCameraImage); // Assume that only one kind of image is logged.
+      theJPEGImage.timestamp = 0;
+    }
+    if(theCompressedCameraImage.timestamp)
+    {
+      theCompressedCameraImage.toCameraImage(theCameraImage); // Same assumption as above.
+      theCompressedCameraImage.timestamp = 0;
+    }
+
     if(theLabelImage.valid)
     {
       for(const Vector2i& ballSpot : theBallSpots.ballSpots)
@@ -572,9 +592,7 @@ bool LogExtractor::saveLabeledBallSpots(const std::string& path)
           Vector2f ballSpotOnField;
           if(!Transformation::imageToRobotHorizontalPlane(ballSpot.cast<float>(), ballSpecification.radius, theCameraMatrix, theCameraInfo, ballSpotOnField))
             continue;
-          CameraImage cameraImage;
-          theJPEGImage.toCameraImage(cameraImage);
-          PatchUtilities::extractPatch(ballSpot, Vector2i(diameter, diameter), Vector2i(32, 32), cameraImage.getGrayscaled(), dest);
+          PatchUtilities::extractPatch(ballSpot, Vector2i(diameter, diameter), Vector2i(32, 32), theCameraImage.getGrayscaled(), dest);
           dest.exportImage(ss.str(), theLabelImage.frameTime, GrayscaledImage::grayscale);
           file << imageNumber << sep
                << theLabelImage.frameTime << sep
@@ -190,6 +190,7 @@ void LogPlayer::stepForward()
       copyMessage(++currentMessageNumber, targetQueue);
       if(queue.getMessageID() == idCameraImage
          || queue.getMessageID() == idJPEGImage
+         || queue.getMessageID() == idCompressedCameraImage
          || queue.getMessageID() == idThumbnail)
         lastImageFrameNumber = currentFrameNumber + 1;
     }
@@ -287,6 +288,7 @@ bool LogPlayer::replay()
         copyMessage(++currentMessageNumber, targetQueue);
         if(queue.getMessageID() == idCameraImage
            || queue.getMessageID() == idJPEGImage
+           || queue.getMessageID() == idCompressedCameraImage
            || queue.getMessageID() == idThumbnail)
           lastImageFrameNumber = currentFrameNumber + 1;
       }
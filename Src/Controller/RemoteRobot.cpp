@@ -7,6 +7,7 @@
 #include "RemoteRobot.h"
 #include "ConsoleRoboCupCtrl.h"
 #include "Platform/Time.h"
+#include <cstdlib>
 
 RemoteRobot::RemoteRobot(const std::string& name, const std::string& ip) :
   RobotConsole(nullptr, nullptr), name(name), ip(ip)
@@ -34,9 +35,21 @@ bool RemoteRobot::main()
   int sendSize = 0;
   int receivedSize = 0;
   MessageQueue temp;
+  std::vector<unsigned char> hello;
 
+  // After the connection was lost, the next one must start with a hello again
+  if(!isConnected())
+    helloSent = false;
+
+  // Announce the capabilities of this side before anything else is sent
+  if(!helloSent && isConnected())
+  {
+    hello = DebugTransport::hello();
+    sendData = hello.data();
+    sendSize = static_cast<int>(hello.size());
+  }
   // If there is something to send, prepare a packet
-  if(!debugSender->isEmpty())
+  else if(!debugSender->isEmpty())
   {
     SYNC;
     sendSize = static_cast<int>(debugSender->getStreamedSize());
@@ -50,24 +63,28 @@ bool RemoteRobot::main()
   // exchange data with the router
   if(!sendAndReceive(sendData, sendSize, receivedData, receivedSize) && sendSize)
   {
-    // sending failed, restore theDebugSender
-    SYNC;
-    // move all messages since cleared (if any)
-    debugSender->moveAllMessages(temp);
-    // restore
-    temp.moveAllMessages(*debugSender);
+    if(hello.empty())
+    {
+      // sending failed, restore theDebugSender
+      SYNC;
+      // move all messages since cleared (if any)
+      debugSender->moveAllMessages(temp);
+      // restore
+      temp.moveAllMessages(*debugSender);
+    }
   }
+  else if(!hello.empty())
+    helloSent = true;
 
   // If a packet was prepared, remove it
-  if(sendSize)
-    delete[] sendData;
+  if(sendSize && hello.empty())
+    std::free(sendData);
 
   // If a packet was received from the router program, add it to receiver queue
   if(receivedSize > 0)
   {
     SYNC;
-    InBinaryMemory stream(receivedData, receivedSize);
-    stream >> *debugReceiver;
+    DebugTransport::unpack(receivedData, receivedSize, *debugReceiver);
     delete[] receivedData;
   }
 
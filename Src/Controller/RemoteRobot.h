@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "Tools/Debugging/DebugTransport.h"
 #include "Tools/Debugging/TcpConnection.h"
 #include "RobotConsole.h"
 #include "SimulatedRobot.h"
@@ -25,6 +26,7 @@ private:
   unsigned timestamp = 0; /**< The time when the transfer speed was measured. */
   SimulatedRobot simulatedRobot; /**< The interface to simulated objects. */
   SimRobotCore2::Body* puppet; /**< A pointer to the puppet when there is one. Otherwise 0. */
+  bool helloSent = false; /**< Were the capabilities of this side announced to the robot? */
 
 public:
   /**
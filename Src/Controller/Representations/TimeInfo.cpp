@@ -15,6 +15,8 @@
 void TimeInfo::reset()
 {
   infos.clear();
+  allocations.clear();
+  allocatedBytes.clear();
   lastFrameNo = 0;
   lastStartTime = 0;
 }
@@ -76,6 +78,16 @@ bool TimeInfo::handleMessage(InMessage& message, bool justReadNames)
 
     lastFrameNo = frameNo;
     lastStartTime = threadStartTime;
+
+    // Older robots do not send allocation statistics.
+    if(!message.bin.eof())
+    {
+      unsigned frameAllocations;
+      unsigned frameAllocatedBytes;
+      message.bin >> frameAllocations >> frameAllocatedBytes;
+      allocations.push_front(static_cast<float>(frameAllocations));
+      allocatedBytes.push_front(static_cast<float>(frameAllocatedBytes));
+    }
     return true;
   }
   else
@@ -96,6 +108,15 @@ void TimeInfo::getThreadStatistics(float& outAvgFreq, float& outMin, float& outM
   outMax = threadDeltas.maximum();
 }
 
+bool TimeInfo::getAllocationStatistics(float& outAvgAllocations, float& outAvgBytes) const
+{
+  if(allocations.empty())
+    return false;
+  outAvgAllocations = allocations.average();
+  outAvgBytes = allocatedBytes.average();
+  return true;
+}
+
 std::string TimeInfo::getName(unsigned short watchId) const
 {
   if(names.find(watchId) == names.end())
@@ -46,6 +46,8 @@ private:
   unsigned lastFrameNo; /**< frame number of the last received frame */
   unsigned lastStartTime; /**< The start time of the frame before this one */
   Info threadDeltas; /**< contains the deltas between the recent thread start times. Is used to calculate the frequency */
+  Info allocations; /**< The number of heap allocations in the recent frames. */
+  Info allocatedBytes; /**< The number of bytes allocated in the recent frames. */
 
 public:
   TimeInfo() {reset();}
@@ -77,6 +79,14 @@ public:
    */
   void getThreadStatistics(float& outAvgFreq, float& outMin, float& outMax) const;
 
+  /**
+   * Returns the average heap usage per frame of the thread attached to this time info.
+   * @param outAvgAllocations The average number of allocations per frame.
+   * @param outAvgBytes The average number of bytes allocated per frame.
+   * @return Did the thread send allocation statistics?
+   */
+  bool getAllocationStatistics(float& outAvgAllocations, float& outAvgBytes) const;
+
   /**
    * Returns the name of the stopwatch with id watchId
    */
@@ -14,6 +14,7 @@
 #include <cctype>
 #include "Platform/Time.h"
 #include "Representations/Infrastructure/CameraInfo.h"
+#include "Representations/Infrastructure/CompressedCameraImage.h"
 #include "Representations/Infrastructure/JPEGImage.h"
 #include "Representations/Infrastructure/Thumbnail.h"
 #include "Representations/Perception/BallPercepts/BallPercept.h"
@@ -253,6 +254,18 @@ bool RobotConsole::handleMessage(InMessage& message)
         incompleteImages["raw image"].image = new DebugImage(ci, true);
       return true;
     }
+    case idCompressedCameraImage:
+    {
+      CameraImage ci;
+      CompressedCameraImage cci;
+      message.bin >> cci;
+      cci.toCameraImage(ci);
+      if(incompleteImages["raw image"].image)
+        incompleteImages["raw image"].image->from(ci);
+      else
+        incompleteImages["raw image"].image = new DebugImage(ci, true);
+      return true;
+    }
     case idThumbnail:
     {
       Thumbnail thumbnail;
@@ -331,15 +344,21 @@ bool RobotConsole::handleMessage(InMessage& message)
       if(polled[idDrawingManager] && !waitingFor[idDrawingManager]) // drawing manager not up-to-date
       {
         ThreadData& data = threadData[threadIdentifier];
-        char shapeType, id;
+        unsigned char shapeType;
+        char id;
         message.bin >> shapeType >> id;
         const char* name = data.drawingManager.getDrawingName(id); // const char* is required here
         std::string type = data.drawingManager.getDrawingType(name);
 
+        DebugDrawing* drawing = nullptr;
         if(type == "drawingOnImage")
-          incompleteImageDrawings[name].addShapeFromQueue(message, static_cast<::Drawings::ShapeType>(shapeType));
+          drawing = &incompleteImageDrawings[name];
         else if(type == "drawingOnField")
-          incompleteFieldDrawings[name].addShapeFromQueue(message, static_cast<::Drawings::ShapeType>(shapeType));
+          drawing = &incompleteFieldDrawings[name];
+        if(drawing && shapeType & DrawingBatch::batched)
+          drawing->addShapesFromBatch(message, static_cast<::Drawings::ShapeType>(shapeType & ~DrawingBatch::batched));
+        else if(drawing)
+          drawing->addShapeFromQueue(message, static_cast<::Drawings::ShapeType>(shapeType));
       }
       return true;
     }
@@ -347,10 +366,14 @@ bool RobotConsole::handleMessage(InMessage& message)
     {
       if(polled[idDrawingManager3D] && !waitingFor[idDrawingManager3D])
       {
-        char shapeType, id;
+        unsigned char shapeType;
+        char id;
         message.bin >> shapeType >> id;
-        incompleteDrawings3D[threadData[threadIdentifier].drawingManager3D.getDrawingName(id)]
-        .addShapeFromQueue(message, static_cast<::Drawings3D::ShapeType>(shapeType));
+        DebugDrawing3D& drawing = incompleteDrawings3D[threadData[threadIdentifier].drawingManager3D.getDrawingName(id)];
+        if(shapeType & DrawingBatch::batched)
+          drawing.addShapesFromBatch(message, static_cast<::Drawings3D::ShapeType>(shapeType & ~DrawingBatch::batched));
+        else
+          drawing.addShapeFromQueue(message, static_cast<::Drawings3D::ShapeType>(shapeType));
       }
       return true;
     }
@@ -576,6 +599,17 @@ bool RobotConsole::handleMessage(InMessage& message)
     case idLogResponse:
       threadData[threadIdentifier].logAcknowledged = true;
       return true;
+    case idSampleProfile:
+    {
+      message.bin >> sampleProfiles[threadIdentifier];
+      if(!sampleProfileFile.empty())
+      {
+        std::ofstream stream(sampleProfileFile);
+        for(const auto& pair : sampleProfiles)
+          stream << pair.second;
+      }
+      return true;
+    }
     case idMotionRequest:
       message.bin >> motionRequest;
       return true;
@@ -954,6 +988,10 @@ bool RobotConsole::handleConsoleLine(const std::string& line)
   {
     result = saveImage(stream);
   }
+  else if(command == "sp")
+  {
+    result = saveSampleProfile(stream);
+  }
   else if(command == "vf")
   {
     PREREQUISITE(idModuleTable);
@@ -1026,6 +1064,22 @@ bool RobotConsole::handleConsoleLine(const std::string& line)
   return true;
 }
 
+bool RobotConsole::saveSampleProfile(In& stream)
+{
+  std::string filename;
+  stream >> filename;
+  if(filename.empty())
+    filename = "profile.folded";
+  sampleProfileFile = filename;
+  sampleProfiles.clear();
+
+  // Each thread that is currently profiled answers with its folded stacks.
+  SYNC;
+  debugSender->out.bin << DebugRequest("timing:sampleProfiler:dump", true);
+  debugSender->out.finishMessage(idDebugRequest);
+  return true;
+}
+
 bool RobotConsole::msg(In& stream)
 {
   std::string state;
@@ -1544,7 +1598,7 @@ bool RobotConsole::log(In& stream)
           if(frequency.second[i] > 0)
           { // This representation is provided in at least one thread
             std::string representation = std::string(TypeRegistry::getEnumName(MessageID(i))).substr(2);
-            if(representation == "JPEGImage" || representation == "Thumbnail")
+            if(representation == "JPEGImage" || representation == "CompressedCameraImage" || representation == "Thumbnail")
               representation = "CameraImage";
             if(std::find(log->representations.begin(), log->representations.end(), representation) != log->representations.end())
             {
@@ -258,6 +258,8 @@ private:
   Views imageViews3D; /**< The map of all 3-D image views. */
   Vector3f background = Vector3f(0.5f, 0.5f, 0.5f); /**< The background color of all 3-D views. */
   Out* logMessages = nullptr; /** The file messages from the robot are written to. */
+  std::string sampleProfileFile; /**< The file the folded stacks of the sample profiler are written to. */
+  std::map<std::string, std::string> sampleProfiles; /**< The folded stacks received from each thread. */
   std::list<std::string> lines; /**< Console lines buffered because the thread is currently waiting. */
   std::list<std::string> commands; /**< (Global) commands to execute in the next update step. */
   int waitingFor[numOfMessageIDs]; /**< Each entry states for how many information packets the thread waits. */
@@ -487,6 +489,7 @@ private:
   bool get(In& stream, bool first, bool print);
   bool set(In& stream);
   bool saveImage(In& stream);
+  bool saveSampleProfile(In& stream);
   bool saveRequest(In& stream, bool first);
   bool sendMof(In& stream);
   bool repoll(In& stream);
@@ -19,7 +19,6 @@
 #include "FieldView.h"
 #include "Controller/RoboCupCtrl.h"
 #include "Controller/RobotConsole.h"
-#include "Controller/Visualization/PaintMethods.h"
 
 FieldView::FieldView(const QString& fullName, RobotConsole& console, const std::string& name) :
   fullName(fullName), icon(":/Icons/tag_green.png"), console(console), name(name)
@@ -43,6 +42,7 @@ FieldWidget::FieldWidget(FieldView& fieldView) :
   settings.beginGroup(fieldView.fullName);
   zoom = static_cast<float>(settings.value("Zoom", 1.).toDouble());
   offset = settings.value("Offset", QPointF()).toPoint();
+  layerCache.showStatistics = settings.value("ShowStatistics", false).toBool();
   settings.endGroup();
 }
 
@@ -52,13 +52,16 @@ FieldWidget::~FieldWidget()
   settings.beginGroup(fieldView.fullName);
   settings.setValue("Zoom", static_cast<double>(zoom));
   settings.setValue("Offset", offset);
+  settings.setValue("ShowStatistics", layerCache.showStatistics);
   settings.endGroup();
 }
 
 void FieldWidget::paintEvent(QPaintEvent* event)
 {
   painter.begin(this);
+  layerCache.beginFrame(painter);
   paint(painter);
+  layerCache.endFrame(painter);
   painter.end();
 }
 
@@ -93,7 +96,7 @@ void FieldWidget::paintDrawings(QPainter& painter)
         transform = transforms.find(pair.first);
       }
       painter.setTransform(transform->second);
-      PaintMethods::paintDebugDrawing(painter, *pair.second, baseTrans);
+      layerCache.paint(painter, pair.first + ":" + drawing, *pair.second, baseTrans);
       transform->second = painter.transform();
       if(pair.second->timestamp > lastDrawingsTimestamp)
         lastDrawingsTimestamp = pair.second->timestamp;
@@ -313,7 +316,20 @@ void FieldWidget::mouseDoubleClickEvent(QMouseEvent* event)
 
 QMenu* FieldWidget::createUserMenu() const
 {
-  return new QMenu(tr("&Field"));
+  QMenu* menu = new QMenu(tr("&Field"));
+
+  QAction* statisticsAct = new QAction(tr("Show &Frame Rate"), menu);
+  statisticsAct->setCheckable(true);
+  statisticsAct->setChecked(layerCache.showStatistics);
+  connect(statisticsAct, &QAction::toggled, [this](bool checked)
+  {
+    FieldWidget* widget = const_cast<FieldWidget*>(this);
+    widget->layerCache.showStatistics = checked;
+    widget->QWidget::update();
+  });
+  menu->addAction(statisticsAct);
+
+  return menu;
 }
 
 std::vector<std::pair<std::string, const DebugDrawing*>> FieldWidget::getDrawings(const std::string& name) const
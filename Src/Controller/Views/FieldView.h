@@ -14,6 +14,7 @@
 
 #include <SimRobot.h>
 #include "Controller/RobotConsole.h"
+#include "Controller/Visualization/LayerCache.h"
 #include "Representations/Configuration/FieldDimensions.h"
 
 class RobotConsole;
@@ -65,6 +66,7 @@ private:
   FieldDimensions fieldDimensions; /**< The field dimensions. */
   unsigned lastDrawingsTimestamp = 0;
   QPainter painter;
+  LayerCache layerCache; /**< Keeps the drawings that did not change between frames. */
   QPointF dragStart;
   QPointF dragStartOffset;
   QPointF mousePos;
@@ -57,6 +57,7 @@ ImageWidget::ImageWidget(ImageView& imageView) :
   settings.beginGroup(imageView.fullName);
   zoom = static_cast<float>(settings.value("Zoom", 1.).toDouble());
   offset = settings.value("Offset", QPointF()).toPoint();
+  layerCache.showStatistics = settings.value("ShowStatistics", false).toBool();
   settings.endGroup();
 }
 
@@ -66,6 +67,7 @@ ImageWidget::~ImageWidget()
   settings.beginGroup(imageView.fullName);
   settings.setValue("Zoom", static_cast<double>(zoom));
   settings.setValue("Offset", offset);
+  settings.setValue("ShowStatistics", layerCache.showStatistics);
   settings.endGroup();
 
   imageView.widget = nullptr;
@@ -79,7 +81,9 @@ ImageWidget::~ImageWidget()
 void ImageWidget::paintEvent(QPaintEvent* event)
 {
   painter.begin(this);
+  layerCache.beginFrame(painter);
   paint(painter);
+  layerCache.endFrame(painter);
   painter.end();
 }
 
@@ -131,7 +135,7 @@ void ImageWidget::paintDrawings(QPainter& painter)
     const DebugDrawing* debugDrawing = getDrawing(drawing);
     if(debugDrawing)
     {
-      PaintMethods::paintDebugDrawing(painter, *debugDrawing, baseTrans);
+      layerCache.paint(painter, drawing, *debugDrawing, baseTrans);
       if(debugDrawing->timestamp > lastDrawingsTimestamp)
         lastDrawingsTimestamp = debugDrawing->timestamp;
     }
@@ -584,6 +588,17 @@ QMenu* ImageWidget::createUserMenu() const
 
   menu->addSeparator();
 
+  QAction* statisticsAct = new QAction(tr("Show &Frame Rate"), menu);
+  statisticsAct->setCheckable(true);
+  statisticsAct->setChecked(layerCache.showStatistics);
+  connect(statisticsAct, &QAction::toggled, [this](bool checked)
+  {
+    ImageWidget* widget = const_cast<ImageWidget*>(this);
+    widget->layerCache.showStatistics = checked;
+    widget->QWidget::update();
+  });
+  menu->addAction(statisticsAct);
+
   QAction* saveImgAct = new QAction(tr("&Save Image"), menu);
   connect(saveImgAct, SIGNAL(triggered()), this, SLOT(saveImg()));
   menu->addAction(saveImgAct);
@@ -24,6 +24,7 @@
 #include "Controller/RoboCupCtrl.h"
 #include "Controller/RobotConsole.h"
 #include "Controller/Views/ColorCalibrationView/ColorCalibrationView.h"
+#include "Controller/Visualization/LayerCache.h"
 #include "Controller/Visualization/PaintMethods.h"
 #include "Representations/Infrastructure/CameraImage.h"
 #include "Tools/Math/Eigen.h"
@@ -95,6 +96,7 @@ private:
   unsigned int lastColorTableTimestamp = 0;
   unsigned int lastDrawingsTimestamp = 0;
   QPainter painter;
+  LayerCache layerCache; /**< Keeps the drawings that did not change between frames. */
   QPointF dragStart;
   QPointF dragStartOffset;
   QPointF mousePos;
@@ -124,9 +124,15 @@ void TimeWidget::update()
     float minDuration = -1.0;
     float maxDuration = -1.0;
     timeView.info.getThreadStatistics(avgFrequency, minDuration, maxDuration);
-    frequency->setText(" Freq: " + QString::number(avgFrequency, 'f', 1)
-                       + ", Min: " + QString::number(minDuration, 'f', 1) +
-                       "ms, Max: " + QString::number(maxDuration, 'f', 1) + "ms");
+    QString text = " Freq: " + QString::number(avgFrequency, 'f', 1)
+                   + ", Min: " + QString::number(minDuration, 'f', 1) +
+                   "ms, Max: " + QString::number(maxDuration, 'f', 1) + "ms";
+    float avgAllocations;
+    float avgAllocatedBytes;
+    if(timeView.info.getAllocationStatistics(avgAllocations, avgAllocatedBytes))
+      text += ", Allocs: " + QString::number(avgAllocations, 'f', 0)
+              + ", Alloc KB: " + QString::number(avgAllocatedBytes / 1024.f, 'f', 1);
+    frequency->setText(text);
 
     table->setUpdatesEnabled(false);
     table->setSortingEnabled(false);//disable sorting while updating to avoid race conditions
@@ -12,6 +12,7 @@
 #include "DebugDrawing.h"
 #include "Platform/BHAssert.h"
 #include "Platform/Time.h"
+#include "Tools/Debugging/DrawingBatch.h"
 
 DebugDrawing::DebugDrawing()
 {
@@ -88,6 +89,7 @@ void DebugDrawing::reset()
   firstTip = -1;
   firstSpot = -1;
   lastOrigin = -1;
+  hash = 0;
 }
 
 const char* DebugDrawing::getSpot(int x, int y, const Pose2f& origin) const
@@ -143,6 +145,19 @@ void DebugDrawing::updateOrigin(Pose2f& origin) const
   }
 }
 
+unsigned long long DebugDrawing::getHash() const
+{
+  if(!hash)
+  {
+    hash = 14695981039346656037ull; // FNV-1a
+    for(const char* p = elements, *end = p + usedSize; p < end; ++p)
+      hash = (hash ^ static_cast<unsigned char>(*p)) * 1099511628211ull;
+    if(!hash)
+      hash = 1;
+  }
+  return hash;
+}
+
 void DebugDrawing::arrow(Vector2f start, Vector2f end,
                          Drawings::PenStyle penStyle, float width, ColorRGBA color)
 {
@@ -534,6 +549,176 @@ bool DebugDrawing::addShapeFromQueue(InMessage& message, Drawings::ShapeType sha
   return true;
 }
 
+bool DebugDrawing::addShapesFromBatch(InMessage& message, Drawings::ShapeType shapeType)
+{
+  DrawingBatch::Reader batch(message.bin);
+  while(batch.next())
+    switch(shapeType)
+    {
+      case Drawings::circle:
+      {
+        Ellipse newCircle;
+        newCircle.center.x() = batch.integer();
+        newCircle.center.y() = batch.integer();
+        newCircle.radii.x() = batch.integer();
+        newCircle.radii.y() = newCircle.radii.x();
+        newCircle.rotation = 0.0f;
+        readStyles(batch, newCircle);
+        write(&newCircle, sizeof(newCircle));
+        break;
+      }
+      case Drawings::arc:
+      {
+        Arc newArc;
+        newArc.center.x() = batch.integer();
+        newArc.center.y() = batch.integer();
+        newArc.radius = batch.integer();
+        newArc.startAngle = batch.angle();
+        newArc.spanAngle = batch.angle();
+        readStyles(batch, newArc);
+        write(&newArc, sizeof(newArc));
+        break;
+      }
+      case Drawings::ellipse:
+      {
+        Ellipse newEllipse;
+        newEllipse.center.x() = batch.integer();
+        newEllipse.center.y() = batch.integer();
+        newEllipse.radii.x() = batch.integer();
+        newEllipse.radii.y() = batch.integer();
+        newEllipse.rotation = batch.angle();
+        readStyles(batch, newEllipse);
+        write(&newEllipse, sizeof(newEllipse));
+        break;
+      }
+      case Drawings::rectangle:
+      {
+        Rectangle newRect;
+        newRect.topLX = batch.integer();
+        newRect.topLY = batch.integer();
+        newRect.w = batch.integer();
+        newRect.h = batch.integer();
+        newRect.rotation = batch.angle();
+        readStyles(batch, newRect);
+        write(&newRect, sizeof(newRect));
+        break;
+      }
+      case Drawings::polygon:
+      {
+        std::vector<Vector2i> points(batch.number());
+        for(Vector2i& point : points)
+        {
+          point.x() = batch.integer();
+          point.y() = batch.integer();
+        }
+        Polygon styles;
+        readStyles(batch, styles);
+        this->polygon(points.data(), static_cast<int>(points.size()), static_cast<int>(styles.width),
+                      styles.penStyle, styles.penColor, styles.brushStyle, styles.brushColor);
+        break;
+      }
+      case Drawings::line:
+      case Drawings::arrow:
+      {
+        const float x1 = batch.coordinate();
+        const float y1 = batch.coordinate();
+        const float x2 = batch.coordinate();
+        const float y2 = batch.coordinate();
+        const float penWidth = batch.coordinate();
+        const Drawings::PenStyle penStyle = static_cast<Drawings::PenStyle>(batch.byte());
+        const ColorRGBA penColor = batch.color();
+        if(shapeType == Drawings::line)
+          this->line(x1, y1, x2, y2, penStyle, penWidth, penColor);
+        else
+          this->arrow(Vector2f(x1, y1), Vector2f(x2, y2), penStyle, penWidth, penColor);
+        break;
+      }
+      case Drawings::origin:
+      {
+        const int x = batch.integer();
+        const int y = batch.integer();
+        this->origin(x, y, batch.angle());
+        break;
+      }
+      case Drawings::dot:
+      case Drawings::dotMedium:
+      case Drawings::dotLarge:
+      {
+        const int x = batch.integer();
+        const int y = batch.integer();
+        const ColorRGBA penColor = batch.color();
+        const ColorRGBA brushColor = batch.color();
+        if(shapeType == Drawings::dot)
+          this->dot(x, y, penColor, brushColor);
+        else if(shapeType == Drawings::dotMedium)
+          this->midDot(x, y, penColor, brushColor);
+        else
+          this->largeDot(x, y, penColor, brushColor);
+        break;
+      }
+      case Drawings::text:
+      {
+        const int x = batch.integer();
+        const int y = batch.integer();
+        const int fontSize = static_cast<short>(batch.number());
+        const ColorRGBA color = batch.color();
+        this->text(batch.string().c_str(), x, y, fontSize, color);
+        break;
+      }
+      case Drawings::tip:
+      {
+        const int x = batch.integer();
+        const int y = batch.integer();
+        const int radius = batch.integer();
+        this->tip(batch.string().c_str(), x, y, radius);
+        break;
+      }
+      case Drawings::robot:
+      {
+        Pose2f p;
+        p.translation.x() = batch.coordinate();
+        p.translation.y() = batch.coordinate();
+        p.rotation = batch.angle();
+        Vector2f dirVec, dirHeadVec;
+        dirVec.x() = batch.coordinate();
+        dirVec.y() = batch.coordinate();
+        dirHeadVec.x() = batch.coordinate();
+        dirHeadVec.y() = batch.coordinate();
+        const float alphaRobot = static_cast<float>(static_cast<unsigned char>(batch.byte())) / 255.f;
+        const ColorRGBA colorBody = batch.color();
+        const ColorRGBA colorDirVec = batch.color();
+        const ColorRGBA colorDirHeadVec = batch.color();
+        this->robot(p, dirVec, dirHeadVec, alphaRobot, colorBody, colorDirVec, colorDirHeadVec);
+        break;
+      }
+      case Drawings::spot:
+      {
+        const int x1 = batch.integer();
+        const int y1 = batch.integer();
+        const int x2 = batch.integer();
+        const int y2 = batch.integer();
+        this->spot(batch.string().c_str(), x1, y1, x2, y2);
+        break;
+      }
+      case Drawings::thread:
+      {
+        threadIdentifier = batch.string();
+        break;
+      }
+    }
+  return true;
+}
+
+template<typename T> void DebugDrawing::readStyles(DrawingBatch::Reader& batch, T& element)
+{
+  element.width = batch.byte();
+  const unsigned char styles = static_cast<unsigned char>(batch.byte());
+  element.penStyle = static_cast<Drawings::PenStyle>(styles & 15);
+  element.brushStyle = static_cast<Drawings::BrushStyle>(styles >> 4);
+  element.penColor = batch.color();
+  element.brushColor = batch.color();
+}
+
 void DebugDrawing::reserve(int size)
 {
   if(usedSize + size > reservedSize)
@@ -551,6 +736,7 @@ void DebugDrawing::write(const void* data, int size)
   reserve(size);
   memcpy(elements + usedSize, data, size);
   usedSize += size;
+  hash = 0;
 }
 
 const DebugDrawing::Element* DebugDrawing::getNext(const Element* element) const
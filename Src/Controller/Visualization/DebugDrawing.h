@@ -39,7 +39,7 @@ public:
     ColorRGBA penColor;
     float width;
 
-    Element(ElementType type) : type(type) {};
+    Element(ElementType type) : type(type), penStyle(Drawings::noPen), width(0.f) {};
   };
 
   /** Stores an arc */
@@ -162,6 +162,13 @@ public:
   /** Updates the origin if it was set in this drawing. */
   void updateOrigin(Pose2f& origin) const;
 
+  /**
+   * Returns a hash of all elements of this drawing. Drawings with the same hash
+   * look the same when painted with the same transformation.
+   * @return The hash, which is only recomputed after the drawing was changed.
+   */
+  unsigned long long getHash() const;
+
   /**
    * Adds an arrow to the debug drawing
    * @param start The starting point of the arrow
@@ -280,6 +287,15 @@ public:
   void robot(Pose2f p, Vector2f dirVec, Vector2f dirHeadVec, float alphaRobot, ColorRGBA colorBody, ColorRGBA colorDirVec, ColorRGBA colorDirHeadVec);
 
   bool addShapeFromQueue(InMessage& message, Drawings::ShapeType shapeType);
+
+  /**
+   * Adds all primitives of a message in the compact encoding (see DrawingBatch).
+   * @param message The message. Its shape type and drawing id were already read.
+   * @param shapeType The shape type without the flag DrawingBatch::batched.
+   * @return Was the message handled?
+   */
+  bool addShapesFromBatch(InMessage& message, Drawings::ShapeType shapeType);
+
   /**
    * The function returns a pointer to the first drawing element.
    * @return A pointer to the first drawing element or 0 if the drawing is empty.
@@ -303,6 +319,7 @@ private:
   int firstTip = -1; /**< The index of the first tip. */
   int lastOrigin = -1; /** The index of the last origin. */
   int firstSpot = -1; /**< The index of the last origin. */
+  mutable unsigned long long hash = 0; /**< The hash of the elements or 0 if it was not computed yet. */
 
   /**
    * The function reserves enough space in the element buffer to store a new element.
@@ -316,4 +333,12 @@ private:
    * @param size The number of bytes to be written.
    */
   void write(const void* data, int size);
+
+  /**
+   * Reads pen width, pen and brush style, and pen and brush color of a
+   * primitive in the compact encoding.
+   * @param batch The batch the fields are read from.
+   * @param element The element that receives them.
+   */
+  template<typename T> static void readStyles(DrawingBatch::Reader& batch, T& element);
 };
@@ -16,6 +16,7 @@
 #include "DebugDrawing3D.h"
 #include "Platform/BHAssert.h"
 #include "Platform/Time.h"
+#include "Tools/Debugging/DrawingBatch.h"
 #include "Representations/Infrastructure/CameraImage.h"
 #include "Representations/Configuration/FieldDimensions.h"
 #include "Representations/Configuration/RobotDimensions.h"
@@ -575,6 +576,54 @@ bool DebugDrawing3D::addShapeFromQueue(InMessage& message, Drawings3D::ShapeType
   return true;
 }
 
+bool DebugDrawing3D::addShapesFromBatch(InMessage& message, Drawings3D::ShapeType shapeType)
+{
+  DrawingBatch::Reader batch(message.bin);
+  const auto vector = [&batch]
+  {
+    const float x = batch.coordinate();
+    const float y = batch.coordinate();
+    return Vector3f(x, y, batch.coordinate());
+  };
+  while(batch.next())
+    switch(shapeType)
+    {
+      case Drawings3D::quad:
+      {
+        std::array<Vector3f, 4> points;
+        for(Vector3f& point : points)
+          point = vector();
+        this->quad(points, batch.color());
+        break;
+      }
+      case Drawings3D::line:
+      {
+        const Vector3f start = vector();
+        const Vector3f end = vector();
+        const float width = batch.coordinate();
+        this->line(start, end, width, batch.color());
+        break;
+      }
+      case Drawings3D::dot:
+      {
+        const Vector3f v = vector();
+        const float w = batch.coordinate();
+        this->dot(v, w, batch.color());
+        break;
+      }
+      case Drawings3D::sphere:
+      {
+        const Vector3f v = vector();
+        const float r = batch.coordinate();
+        this->sphere(v, r, batch.color());
+        break;
+      }
+      default:
+        return false;
+    }
+  return true;
+}
+
 char* DebugDrawing3D::copyImage(const CameraImage& srcImage, unsigned int& width, unsigned int& height) const
 {
   width = 1;
@@ -196,6 +196,15 @@ public:
 
   bool addShapeFromQueue(InMessage& message, Drawings3D::ShapeType shapeType);
 
+  /**
+   * Adds all primitives of a message in the compact encoding (see DrawingBatch).
+   * Only lines, dots, spheres, and quads are sent in this encoding.
+   * @param message The message. Its shape type and drawing id were already read.
+   * @param shapeType The shape type without the flag DrawingBatch::batched.
+   * @return Was the message handled?
+   */
+  bool addShapesFromBatch(InMessage& message, Drawings3D::ShapeType shapeType);
+
 private:
   Vector3f scale = Vector3f::Ones();
   Vector3f rotate = Vector3f::Zero();
@@ -0,0 +1,141 @@
+/**
+ * @file Controller/Visualization/LayerCache.cpp
+ * Implementation of class LayerCache.
+ */
+
+#include <QPainter>
+#include "LayerCache.h"
+#include "PaintMethods.h"
+
+void LayerCache::beginFrame(QPainter& painter)
+{
+  paintTimer.start();
+  active = true;
+  cachedLayers = paintedLayers = 0;
+
+  const QSize size = painter.window().size();
+  const qreal devicePixelRatio = painter.device()->devicePixelRatioF();
+  if(size != this->size || devicePixelRatio != this->devicePixelRatio)
+  {
+    layers.clear();
+    this->size = size;
+    this->devicePixelRatio = devicePixelRatio;
+  }
+}
+
+void LayerCache::paint(QPainter& painter, const std::string& name, const DebugDrawing& debugDrawing, const QTransform& baseTrans)
+{
+  if(!active)
+  {
+    PaintMethods::paintDebugDrawing(painter, debugDrawing, baseTrans);
+    return;
+  }
+
+  Layer& layer = layers[name];
+  layer.used = true;
+  const QTransform transform = painter.transform();
+  const unsigned long long hash = debugDrawing.getHash();
+  if(hash != layer.hash || transform != layer.transform || baseTrans != layer.baseTrans)
+  {
+    // The drawing changed, so it is likely to change again in the next frame.
+    layer.hash = hash;
+    layer.transform = transform;
+    layer.baseTrans = baseTrans;
+    layer.image = QImage();
+    paintDirectly(painter, layer, debugDrawing, baseTrans);
+    return;
+  }
+
+  if(layer.image.isNull())
+  {
+    if(layer.paintTime < minPaintTime || !reserveImage(layer))
+    {
+      paintDirectly(painter, layer, debugDrawing, baseTrans);
+      return;
+    }
+
+    layer.image = QImage(size * devicePixelRatio, QImage::Format_ARGB32_Premultiplied);
+    layer.image.setDevicePixelRatio(devicePixelRatio);
+    layer.image.fill(Qt::transparent);
+    QPainter layerPainter(&layer.image);
+    layerPainter.setRenderHints(painter.renderHints());
+    layerPainter.setTransform(transform);
+    PaintMethods::paintDebugDrawing(layerPainter, debugDrawing, baseTrans);
+    layer.endTransform = layerPainter.transform();
+  }
+
+  painter.resetTransform();
+  painter.drawImage(0, 0, layer.image);
+  painter.setTransform(layer.endTransform);
+  ++cachedLayers;
+}
+
+void LayerCache::paintDirectly(QPainter& painter, Layer& layer, const DebugDrawing& debugDrawing, const QTransform& baseTrans)
+{
+  QElapsedTimer timer;
+  timer.start();
+  PaintMethods::paintDebugDrawing(painter, debugDrawing, baseTrans);
+  layer.paintTime = static_cast<float>(timer.nsecsElapsed()) * 1e-6f;
+  ++paintedLayers;
+}
+
+bool LayerCache::reserveImage(const Layer& layer)
+{
+  unsigned numOfImages = 0;
+  Layer* cheapest = nullptr;
+  for(auto& pair : layers)
+    if(!pair.second.image.isNull())
+    {
+      ++numOfImages;
+      if(!cheapest || pair.second.paintTime < cheapest->paintTime)
+        cheapest = &pair.second;
+    }
+  if(numOfImages < maxCachedLayers)
+    return true;
+
+  // Only replace a layer that is clearly cheaper, so that two similar layers do not take turns.
+  if(cheapest && cheapest->paintTime * 2.f < layer.paintTime)
+  {
+    cheapest->image = QImage();
+    return true;
+  }
+  return false;
+}
+
+void LayerCache::endFrame(QPainter& painter)
+{
+  for(auto i = layers.begin(); i != layers.end();)
+    if(i->second.used)
+    {
+      i->second.used = false;
+      ++i;
+    }
+    else
+      i = layers.erase(i);
+  active = false;
+
+  // Smooth both times over roughly the last ten frames.
+  const float paintTime = static_cast<float>(paintTimer.nsecsElapsed()) * 1e-6f;
+  this->paintTime = this->paintTime * 0.9f + paintTime * 0.1f;
+  if(frameTimer.isValid())
+    frameTime = frameTime * 0.9f + static_cast<float>(frameTimer.nsecsElapsed()) * 1e-6f * 0.1f;
+  frameTimer.start();
+
+  if(showStatistics)
+  {
+    const QString text = QString("%1 fps, %2 ms, %3/%4 layers cached")
+                         .arg(frameTime > 0.f ? 1000.f / frameTime : 0.f, 0, 'f', 1)
+                         .arg(this->paintTime, 0, 'f', 2)
+                         .arg(cachedLayers)
+                         .arg(cachedLayers + paintedLayers);
+    painter.save();
+    painter.resetTransform();
+    painter.setFont(QFont("Arial", 9));
+    const QRect rect = painter.fontMetrics().boundingRect(text).adjusted(-3, -2, 3, 2);
+    painter.translate(4 - rect.left(), 4 - rect.top());
+    painter.fillRect(rect, QColor(255, 255, 255, 192));
+    painter.setPen(Qt::black);
+    painter.drawText(0, 0, text);
+    painter.restore();
+  }
+}
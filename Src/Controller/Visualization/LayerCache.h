@@ -0,0 +1,103 @@
+/**
+ * @file Controller/Visualization/LayerCache.h
+ * Declaration of class LayerCache.
+ */
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QTransform>
+
+class DebugDrawing;
+class QPainter;
+
+/**
+ * @class LayerCache
+ *
+ * Paints debug drawings as layers that are kept between frames. A drawing
+ * that did not change since the previous frame (same content hash and same
+ * transformation) is rendered once into an image of the size of the widget
+ * and only composited afterwards. Drawings that change every frame are
+ * painted directly, because caching them would only add the cost of the
+ * compositing. The same holds for drawings that are cheaper to paint than
+ * to composite. Since every image has the size of the widget, only the most
+ * expensive drawings are cached and their number is limited.
+ * The cache is only used between beginFrame() and endFrame().
+ * Otherwise, the drawings are painted directly, e.g. when exporting a view.
+ */
+class LayerCache
+{
+private:
+  /** A single cached debug drawing. */
+  struct Layer
+  {
+    unsigned long long hash = 0; /**< The hash of the drawing painted last. */
+    QTransform transform; /**< The transformation the drawing was painted with. */
+    QTransform baseTrans; /**< The base transformation the drawing was painted with. */
+    QTransform endTransform; /**< The transformation the drawing left behind in the painter. */
+    QImage image; /**< The rendered drawing. Null if the drawing changed recently or is not worth caching. */
+    float paintTime = 0.f; /**< The time required to paint the drawing directly the last time in ms. */
+    bool used = false; /**< Was this layer painted in the current frame? */
+  };
+
+  static constexpr unsigned maxCachedLayers = 8; /**< The maximum number of layers that keep an image. */
+  static constexpr float minPaintTime = 0.2f; /**< Drawings that are painted faster than this are not cached (in ms). */
+
+  std::unordered_map<std::string, Layer> layers; /**< All layers by name. */
+  bool active = false; /**< Is a frame currently painted? */
+  QSize size; /**< The size of the device painted to in logical pixels. */
+  qreal devicePixelRatio = 1.; /**< The ratio between physical and logical pixels of the device. */
+  QElapsedTimer frameTimer; /**< Measures the time between two frames. */
+  QElapsedTimer paintTimer; /**< Measures the time required to paint a frame. */
+  float frameTime = 0.f; /**< The smoothed time between two frames in ms. */
+  float paintTime = 0.f; /**< The smoothed time required to paint a frame in ms. */
+  unsigned cachedLayers = 0; /**< The number of layers composited in the current frame. */
+  unsigned paintedLayers = 0; /**< The number of layers painted directly in the current frame. */
+
+  /**
+   * Paints a debug drawing directly and measures the time this takes.
+   * @param painter The graphics context the DebugDrawing is painted to.
+   * @param layer The layer of the drawing. Its paint time is updated.
+   * @param debugDrawing The DebugDrawing to paint.
+   * @param baseTrans A basic transformation.
+   */
+  void paintDirectly(QPainter& painter, Layer& layer, const DebugDrawing& debugDrawing, const QTransform& baseTrans);
+
+  /**
+   * Determines whether a layer may keep an image. If the maximum number of
+   * images is reached, the image of a layer that is much cheaper to paint is
+   * released.
+   * @param layer The layer that would like to keep an image.
+   * @return Can an image be created for the layer?
+   */
+  bool reserveImage(const Layer& layer);
+
+public:
+  bool showStatistics = false; /**< Paint frame rate and paint time on top of the view. */
+
+  /**
+   * Starts painting a frame.
+   * @param painter The painter of the widget, which must already be active.
+   */
+  void beginFrame(QPainter& painter);
+
+  /**
+   * Paints a debug drawing, using its layer if possible. The transformation of
+   * the painter is updated as if the drawing was painted directly.
+   * @param painter The graphics context the DebugDrawing is painted to.
+   * @param name A name that identifies the layer of the drawing.
+   * @param debugDrawing The DebugDrawing to paint.
+   * @param baseTrans A basic transformation.
+   */
+  void paint(QPainter& painter, const std::string& name, const DebugDrawing& debugDrawing, const QTransform& baseTrans);
+
+  /**
+   * Ends painting a frame. Layers that were not painted are dropped.
+   * If requested, the statistics are painted on top of the frame.
+   * @param painter The painter of the widget.
+   */
+  void endFrame(QPainter& painter);
+};
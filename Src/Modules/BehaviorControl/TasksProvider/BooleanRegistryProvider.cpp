@@ -20,6 +20,20 @@
 
 BooleanRegistryProvider::BooleanRegistryProvider(){}
 
+bool BooleanRegistryProvider::evaluate(BooleanRegistry::Condition condition) const
+{
+    switch(condition)
+    {
+      case BooleanRegistry::isCurrentActionCompleted:
+        return theTaskController.isTaskComplete();
+      case BooleanRegistry::isBatteryLow:
+        return theRobotHealth.batteryLevel < BATTERY_LOW;
+      default:
+        FAIL("Unknown condition " << TypeRegistry::getEnumName(condition) << ".");
+        return false;
+    }
+}
+
 void BooleanRegistryProvider::update(BooleanRegistry& booleanRegistry)
 {
     
@@ -28,25 +42,25 @@ void BooleanRegistryProvider::update(BooleanRegistry& booleanRegistry)
     //CFG parameters
     booleanRegistry.ALWAYS_SEND = ALWAYS_SEND;
 
-    booleanRegistry.isCurrentActionCompleted = [&] () -> bool
-    {
-      return theTaskController.isTaskComplete();
-    };
+    //Evaluate every condition exactly once per frame
+    unsigned values = 0;
+    FOREACH_ENUM(BooleanRegistry::Condition, condition)
+      if(evaluate(condition))
+        values |= 1u << condition;
 
-    booleanRegistry.isBatteryLow = [&] () -> bool
-    {
-      return theRobotHealth.batteryLevel < BATTERY_LOW;
-    };
-
-    booleanRegistry.getString = [&] () -> std::string
-    {
-      std::string ret_string;
-      ret_string.append("booleanFlags;");
-      ret_string.append("is_current_action_completed:");
-      ret_string.append(std::to_string(booleanRegistry.isCurrentActionCompleted()));
-      return ret_string;
-    };
-    
+    //Only record the conditions that changed since the last frame
+    const unsigned changed = values ^ booleanRegistry.values;
+    booleanRegistry.events.clear();
+    FOREACH_ENUM(BooleanRegistry::Condition, condition)
+      if((changed >> condition) & 1u)
+      {
+        BooleanRegistry::Event& event = booleanRegistry.events.emplace_back();
+        event.condition = condition;
+        event.rising = (values >> condition) & 1u;
+        event.timestamp = theFrameInfo.time;
+        DEBUG_NUMB(PRINT_DEBUG, TypeRegistry::getEnumName(condition) << (event.rising ? " became true" : " became false"));
+      }
+    booleanRegistry.values = values;
 }
 
 
@@ -13,12 +13,14 @@
 #include "Representations/BehaviorControl/TasksProvider/TaskController.h"
 #include "Representations/Communication/RobotInfo.h"
 #include "Representations/Infrastructure/RobotHealth.h"
+#include "Representations/Infrastructure/FrameInfo.h"
 
 #include <iostream>
 #include <ostream>
 
 MODULE(BooleanRegistryProvider,
 {,
+    REQUIRES(FrameInfo),
     REQUIRES(RobotInfo),
     REQUIRES(TaskController),
     REQUIRES(RobotHealth),
@@ -47,4 +49,7 @@ public:
 
 private:
   void update(BooleanRegistry& controller) override;
+
+  /** Computes the value of a single condition */
+  bool evaluate(BooleanRegistry::Condition condition) const;
 };
\ No newline at end of file
@@ -15,8 +15,6 @@
 #define DEBUG_NUMB(print_debug, message) \
   if(print_debug) std::cout<<"[Robot #"<<theRobotInfo.number<<"] " << message << std::endl; \
 
-#define BUFFER_SIZE 1024
-
 #define ACTION_QUEUE_TAG_STRING std::string("taskQueue")
 #define PLAN_ACTION_TAG_STRING std::string("PlanAction")
 #define LAST_TASK_ID_REQUEST_STRING std::string("lastTaskID?")
@@ -98,8 +96,8 @@ ExternalServerCommunicationController::ExternalServerCommunicationController(){
         write_port_number = CONTROL_DEVICE_COMMUNICATION_WRITE_PORT_BASE + theRobotInfo.number-1 - 1000;
     }
     DEBUG_NUMB(true, "Trying to setup write socket with target address: "<<TARGET_IP_ADDRESS<<":"<<write_port_number);
-    this->udp_write_socket.setTarget(TARGET_IP_ADDRESS.c_str(), write_port_number);
-    this->udp_write_socket.setBlocking(false);
+    this->ioThread.writeSocket.setTarget(TARGET_IP_ADDRESS.c_str(), write_port_number);
+    this->ioThread.writeSocket.setBlocking(false);
     DEBUG_NUMB(true, "Write socket set with target address: "<<TARGET_IP_ADDRESS<<":"<<write_port_number);
 
     //Setup the READ socket (for incoming messages)
@@ -114,12 +112,12 @@ ExternalServerCommunicationController::ExternalServerCommunicationController(){
         read_port_number = CONTROL_DEVICE_COMMUNICATION_READ_PORT_BASE + theRobotInfo.number-1 - 1000;
     }
     DEBUG_NUMB(true, "Trying to bind read socket on address: "<<READ_IP_ADDRESS<<":"<<read_port_number);
-    if(!this->udp_read_socket.bind(READ_IP_ADDRESS.c_str(), read_port_number))
+    if(!this->ioThread.readSocket.bind(READ_IP_ADDRESS.c_str(), read_port_number))
     {
         DEBUG_NUMB(true, "Could not bind read socket! Exiting...");
         exit(1);
     }
-    this->udp_read_socket.setBlocking(false);
+    this->ioThread.readSocket.setBlocking(false);
     DEBUG_NUMB(true, "Read socket bound on address: "<<READ_IP_ADDRESS<<":"<<read_port_number);
     
 
@@ -130,7 +128,17 @@ ExternalServerCommunicationController::ExternalServerCommunicationController(){
     
     this->cycles_since_robot_pose_update = 0;
     this->cycles_since_ball_update = 0;
+    this->cycles_since_role_update = 0;
     this->cycles_since_obstacles_update = 0; 
+    this->cycles_since_task_queue_update = 0;
+    this->cycles_since_boolean_flags_update = 0;
+
+    //Move all socket I/O (including the keepalive protocol) to a separate thread
+    if(USE_IO_THREAD)
+    {
+        this->ioThread.start(theRobotInfo.number, PREFIX_TIMESTAMP, PREFIX_ROBOT_NUMBER, PERFORM_KEEPALIVE_CHECK, KEEPALIVE_TIMEOUT);
+        DEBUG_NUMB(true, "I/O thread started");
+    }
 }
 
 
@@ -267,24 +275,9 @@ std::string ExternalServerCommunicationController::plan_action_completed_string(
 //Given a string to be sent as a MESSAGE, prefixes a HEADER to it containing the timestamp (if required) and the robot number (if required)
 void ExternalServerCommunicationController::send_data_string(std::string str, bool prefix_timestamp, bool prefix_robot_number, bool print_message)
 {
-    std::string header;
-    if(prefix_timestamp)
-    {
-        header.append("timestamp,");
-        header.append(std::to_string(Time::getCurrentSystemTime()));
-        header.append(std::string("."));
-    }
-    if(prefix_robot_number)
-    {
-        header.append("robot_number,");
-        header.append(std::to_string(theRobotInfo.number));
-    }
-    header.append("|");
-
-    str = header + str;
-    const char *s_str = str.c_str();
+    str = ExternalServerIOThread::header(theRobotInfo.number, prefix_timestamp, prefix_robot_number) + str;
     if(print_message) std::cout<<str.c_str()<<std::endl;
-    this->udp_write_socket.write(s_str, str.length());    
+    this->ioThread.send(std::move(str));
 }
 
 //Given a string and a delimiter string, returns a std::vector with all the strings delimited by the "delimiter" string 
@@ -768,31 +761,26 @@ void ExternalServerCommunicationController::update(ExternalServerCommunicationCo
     std::string recv_string;
     
     bool received = false;
-    
-    char* buffer = (char*) malloc(sizeof(char) * BUFFER_SIZE);
-
-
-   /* Read the latest message from the READ SOCKET */
-    //DEBUG_NUMB(PRINT_DEBUG,"HELLO");
-    int bt = this->udp_read_socket.read(buffer, sizeof(char) * BUFFER_SIZE);
 
-    if(bt != -1){
-        received = true;
-
-        recv_string += std::string(buffer);
-        //std::cout<<"Data received"<<std::endl;
-    }
-    //DEBUG_NUMB(PRINT_DEBUG,"HELLO");
-
-    free(buffer);
-    
-    if(received)
+    if(this->ioThread.isStarted())
     {
-        DEBUG_NUMB(PRINT_DEBUG,"Received string: "<<recv_string);
+       /* Handle all messages the I/O thread has received since the last frame (keepalive responses are consumed by the thread) */
+        while(this->ioThread.receive(recv_string))
+        {
+            DEBUG_NUMB(PRINT_DEBUG,"Received string: "<<recv_string);
+            handleMessage(recv_string, externalServerCommunicationControl.currentTaskQueue);
+        }
+        recv_string.clear();
     }
     else
     {
-        //DEBUG_NUMB(PRINT_DEBUG,"Nothing received");
+       /* Read the latest message from the READ SOCKET */
+        received = this->ioThread.receive(recv_string);
+
+        if(received)
+        {
+            DEBUG_NUMB(PRINT_DEBUG,"Received string: "<<recv_string);
+        }
     }
     
 
@@ -804,8 +792,20 @@ void ExternalServerCommunicationController::update(ExternalServerCommunicationCo
 
     */
 
+   /* The I/O thread performs the keepalive check on its own, using timeouts instead of cycle counters */
+    if(this->ioThread.isStarted())
+    {
+        this->client_alive = this->ioThread.isClientAlive();
+        if(!this->client_alive)
+        {
+            this->ioThread.flush();
+            //Edges are lost while the client is not connected, so send all boolean flags as soon as it is back
+            this->cycles_since_boolean_flags_update = 0;
+            return;
+        }
+    }
    /* Perform the KEEPALIVE check or wait for a keepalive response if the keepalive message has already been sent */
-    if(PERFORM_KEEPALIVE_CHECK)
+    else if(PERFORM_KEEPALIVE_CHECK)
     {
         //DEBUG_NUMB(PRINT_DEBUG,"this->cycles_since_last_keepalive_check: "<<this->cycles_since_last_keepalive_check);
         /* 
@@ -843,8 +843,12 @@ void ExternalServerCommunicationController::update(ExternalServerCommunicationCo
             }
         }
         //ALSO,
-        //IF the Python server is not alive, return prematurely
-        if(!this->client_alive) return;
+        //IF the Python server is not alive, return prematurely (and send all boolean flags as soon as it is back)
+        if(!this->client_alive)
+        {
+            this->cycles_since_boolean_flags_update = 0;
+            return;
+        }
 
         this->cycles_since_last_keepalive_check++;
 
@@ -908,12 +912,19 @@ void ExternalServerCommunicationController::update(ExternalServerCommunicationCo
     this->cycles_since_task_queue_update++;
 
     
-    //Send a MESSAGE with the boolean flags every BOOLEANS_UPDATE_FREQUENCY millisecs, to stream boolean flags to the Behavior Controller
-    if(this->cycles_since_boolean_flags_update % BOOLEANS_UPDATE_FREQUENCY == 0 && theBooleanRegistry.ALWAYS_SEND){
-        send_data_string(theBooleanRegistry.getString(), PREFIX_TIMESTAMP, PREFIX_ROBOT_NUMBER, PRINT_SENT_MESSAGES);
-        this->cycles_since_boolean_flags_update = 0;
+    //Send a MESSAGE with all boolean flags every BOOLEANS_UPDATE_FREQUENCY millisecs, to resynchronize the boolean flags of the Behavior Controller
+    //and a MESSAGE with only the changed boolean flags in every frame in which one of them changed
+    if(theBooleanRegistry.ALWAYS_SEND)
+    {
+        if(this->cycles_since_boolean_flags_update % BOOLEANS_UPDATE_FREQUENCY == 0){
+            send_data_string(theBooleanRegistry.getString(), PREFIX_TIMESTAMP, PREFIX_ROBOT_NUMBER, PRINT_SENT_MESSAGES);
+            this->cycles_since_boolean_flags_update = 0;
+        }
+        else if(!theBooleanRegistry.events.empty()){
+            send_data_string(theBooleanRegistry.getEventsString(), PREFIX_TIMESTAMP, PREFIX_ROBOT_NUMBER, PRINT_SENT_MESSAGES);
+        }
+        this->cycles_since_boolean_flags_update++;
     }
-    this->cycles_since_task_queue_update++;
 
 
     /* 
@@ -927,6 +938,9 @@ void ExternalServerCommunicationController::update(ExternalServerCommunicationCo
     //Message analysis
     if(recv_string.length()>0) handleMessage(recv_string, externalServerCommunicationControl.currentTaskQueue);
 
+    //Wake up the I/O thread once to send everything queued in this frame
+    this->ioThread.flush();
+
 }
 
 
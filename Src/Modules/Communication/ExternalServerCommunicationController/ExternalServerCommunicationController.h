@@ -5,6 +5,7 @@
 #include "Tools/Module/Module.h"
 #include "Tools/Math/Transformation.h"
 #include "Tools/Communication/UdpComm.h"
+#include "ExternalServerIOThread.h"
 #include "Representations/BehaviorControl/FieldBall.h"
 #include "Representations/Modeling/RobotPose.h"
 #include "Representations/BehaviorControl/TasksProvider/TaskController.h"
@@ -57,6 +58,9 @@ MODULE(ExternalServerCommunicationController,
       (bool) PERFORM_KEEPALIVE_CHECK,               /** Perform a keepalive check (send a message to signal being active and wait for a response) every KEEPALIVE_CHECK_FREQUENCY */ 
       (int) KEEPALIVE_CHECK_FREQUENCY,              /** Number of cycles between two different keepalive requests to client device */
 
+      (bool) USE_IO_THREAD,                         /** Perform all socket I/O in a separate thread instead of the Cognition thread */
+      (unsigned) KEEPALIVE_TIMEOUT,                 /** Time in ms between two keepalive requests sent by the I/O thread (the server is considered dead after twice this time) */
+
       (int) ROBOT_POSE_UPDATE_FREQUENCY,            /** Number of cycles between two different robot pose updates to client device */
       (int) BALL_POSITION_UPDATE_FREQUENCY,         /** Number of cycles between two different ball info updates to client device */
       (int) ROLE_UPDATE_FREQUENCY,                  /** Number of cycles between two different role updates to client device */
@@ -80,8 +84,7 @@ private:
     void isDone();
 
 public:
-    UdpComm udp_write_socket;
-    UdpComm udp_read_socket;
+    ExternalServerIOThread ioThread;        /* owns the read and write sockets, optionally running them in a separate thread */
 
     std::string TARGET_IP_ADDRESS;          /** IP address of the Python server in the frontend pipeline */
     std::string READ_IP_ADDRESS;            /** IP address of this robot in the LAN */
@@ -100,8 +103,6 @@ public:
 
     void update(ExternalServerCommunicationControl &ExternalServerCommunicationControl);
 
-    void check_client_alive();
-
     std::string keepalive_check_string();
 
     std::string last_task_id_string();
@@ -114,7 +115,6 @@ public:
     std::string plan_action_completed_string();
 
     void send_data_string(std::string str, bool prefix_timestamp, bool prefix_robot_number, bool print_message);
-    bool read_data_string_from_socket(UdpComm sock, std::string& recv_str);
 
     std::vector<std::string> getTokens(std::string& str, std::string delimiter);
     void handleMessage(std::string message, std::vector<Task>& currentTaskQueue);
@@ -0,0 +1,193 @@
+/**
+ * @file ExternalServerIOThread.cpp
+ *
+ * Implementation of the thread that owns the UDP sockets used to talk to the
+ * external (Python) server.
+ */
+
+#include "ExternalServerIOThread.h"
+#include "Platform/BHAssert.h"
+#include "Platform/Time.h"
+#include "Tools/Debugging/Debugging.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef LINUX
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+#define KEEPALIVE_REQUEST_STRING std::string("uthere?")
+#define KEEPALIVE_RESPONSE_STRING std::string("yeah")
+
+ExternalServerIOThread::ExternalServerIOThread()
+{
+#ifdef LINUX
+  epollFd = epoll_create1(EPOLL_CLOEXEC);
+  wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  ASSERT(epollFd != -1 && wakeFd != -1);
+#endif
+}
+
+ExternalServerIOThread::~ExternalServerIOThread()
+{
+  stop();
+#ifdef LINUX
+  close(wakeFd);
+  close(epollFd);
+#endif
+}
+
+void ExternalServerIOThread::start(int robotNumber, bool prefixTimestamp, bool prefixRobotNumber, bool performKeepaliveCheck, unsigned keepaliveTimeout)
+{
+  if(started)
+    return;
+
+  this->robotNumber = robotNumber;
+  this->prefixTimestamp = prefixTimestamp;
+  this->prefixRobotNumber = prefixRobotNumber;
+  this->performKeepaliveCheck = performKeepaliveCheck;
+  this->keepaliveTimeout = std::max(keepaliveTimeout, 1u);
+  clientAlive = !performKeepaliveCheck;
+
+#ifdef LINUX
+  epoll_event event;
+  event.events = EPOLLIN;
+  event.data.fd = readSocket.getSocket();
+  VERIFY(epoll_ctl(epollFd, EPOLL_CTL_ADD, readSocket.getSocket(), &event) == 0);
+  event.data.fd = wakeFd;
+  VERIFY(epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event) == 0);
+#endif
+
+  started = true;
+  thread.start(this, &ExternalServerIOThread::run);
+}
+
+void ExternalServerIOThread::stop()
+{
+  if(!started)
+    return;
+
+  thread.announceStop();
+  flush();
+  thread.stop();
+  started = false;
+}
+
+bool ExternalServerIOThread::send(std::string&& message)
+{
+  if(started)
+    return outgoing.push(std::move(message));
+  else
+    return writeSocket.write(message.c_str(), static_cast<int>(message.length()));
+}
+
+void ExternalServerIOThread::flush()
+{
+#ifdef LINUX
+  if(started)
+  {
+    const uint64_t one = 1;
+    VERIFY(write(wakeFd, &one, sizeof(one)) == sizeof(one));
+  }
+#endif
+}
+
+bool ExternalServerIOThread::receive(std::string& message)
+{
+  if(started)
+    return incoming.pop(message);
+
+  char buffer[bufferSize];
+  const int size = readSocket.read(buffer, bufferSize);
+  if(size <= 0)
+    return false;
+  message.assign(buffer, strnlen(buffer, size));
+  return true;
+}
+
+std::string ExternalServerIOThread::header(int robotNumber, bool prefixTimestamp, bool prefixRobotNumber)
+{
+  std::string header;
+  if(prefixTimestamp)
+  {
+    header.append("timestamp,");
+    header.append(std::to_string(Time::getCurrentSystemTime()));
+    header.append(".");
+  }
+  if(prefixRobotNumber)
+  {
+    header.append("robot_number,");
+    header.append(std::to_string(robotNumber));
+  }
+  header.append("|");
+  return header;
+}
+
+void ExternalServerIOThread::readAll(unsigned now, unsigned& lastReceived)
+{
+  char buffer[bufferSize];
+  int size;
+  while((size = readSocket.read(buffer, bufferSize)) > 0)
+  {
+    lastReceived = now;
+    clientAlive = true;
+
+    // Keepalive responses only refresh the timeout, the module does not need to see them.
+    // The server terminates its messages with '\0'.
+    std::string message(buffer, strnlen(buffer, size));
+    if(message != KEEPALIVE_RESPONSE_STRING && !incoming.push(std::move(message)))
+      OUTPUT_WARNING("ExternalServerIOThread: incoming queue full, message dropped");
+  }
+}
+
+void ExternalServerIOThread::writeAll()
+{
+  std::string message;
+  while(outgoing.pop(message))
+    writeSocket.write(message.c_str(), static_cast<int>(message.length()));
+}
+
+void ExternalServerIOThread::run()
+{
+  Thread::nameCurrentThread("ExternalServerIO");
+
+  // The server is considered dead if nothing was received for two keepalive periods.
+  unsigned lastReceived = Time::getRealSystemTime() - 2 * keepaliveTimeout;
+  unsigned lastKeepaliveRequest = Time::getRealSystemTime() - keepaliveTimeout;
+
+  while(thread.isRunning())
+  {
+    unsigned now = Time::getRealSystemTime();
+    if(performKeepaliveCheck)
+    {
+      if(now - lastReceived >= 2 * keepaliveTimeout)
+        clientAlive = false;
+      if(now - lastKeepaliveRequest >= keepaliveTimeout)
+      {
+        const std::string request = header(robotNumber, prefixTimestamp, prefixRobotNumber) + KEEPALIVE_REQUEST_STRING;
+        writeSocket.write(request.c_str(), static_cast<int>(request.length()));
+        lastKeepaliveRequest = now;
+      }
+    }
+
+#ifdef LINUX
+    const int timeout = performKeepaliveCheck ? static_cast<int>(keepaliveTimeout - (now - lastKeepaliveRequest)) : -1;
+    epoll_event events[2];
+    const int numOfEvents = epoll_wait(epollFd, events, 2, timeout);
+    for(int i = 0; i < numOfEvents; ++i)
+      if(events[i].data.fd == wakeFd)
+      {
+        uint64_t counter;
+        static_cast<void>(read(wakeFd, &counter, sizeof(counter)));
+      }
+#else
+    Thread::sleep(1);
+#endif
+
+    now = Time::getRealSystemTime();
+    readAll(now, lastReceived);
+    writeAll();
+  }
+}
@@ -0,0 +1,107 @@
+/**
+ * @file ExternalServerIOThread.h
+ *
+ * Declaration of the thread that owns the UDP sockets used to talk to the
+ * external (Python) server. Incoming messages and outgoing telemetry are
+ * exchanged with the ExternalServerCommunicationController through lock-free
+ * single-producer/single-consumer queues, so the Cognition thread never blocks
+ * in a socket call. The keepalive protocol is handled inside the thread using
+ * wall-clock timeouts.
+ *
+ * If the thread is not started, send() and receive() fall back to direct
+ * non-blocking socket calls from the calling thread.
+ */
+
+#pragma once
+
+#include "Platform/Thread.h"
+#include "Tools/Communication/UdpComm.h"
+#include "Tools/SPSCQueue.h"
+#include <atomic>
+#include <string>
+
+class ExternalServerIOThread
+{
+public:
+  static constexpr int bufferSize = 1024; /**< Maximum size of a received datagram. */
+  static constexpr std::size_t queueSize = 64; /**< Capacity of each message queue. */
+
+  UdpComm writeSocket; /**< The socket for outgoing messages. */
+  UdpComm readSocket; /**< The socket for incoming messages. */
+
+  ExternalServerIOThread();
+  ~ExternalServerIOThread();
+
+  /**
+   * Starts the I/O thread. From now on, the sockets must only be accessed through send() and receive().
+   * @param robotNumber The number of this robot, used in the header of keepalive requests.
+   * @param prefixTimestamp Add the timestamp to the header of keepalive requests.
+   * @param prefixRobotNumber Add the robot number to the header of keepalive requests.
+   * @param performKeepaliveCheck Send keepalive requests if the server did not respond for a while.
+   * @param keepaliveTimeout Time in ms without incoming messages after which the server is considered dead.
+   */
+  void start(int robotNumber, bool prefixTimestamp, bool prefixRobotNumber, bool performKeepaliveCheck, unsigned keepaliveTimeout);
+
+  /** Stops the I/O thread if it is running. */
+  void stop();
+
+  /** Is the I/O thread running? */
+  bool isStarted() const {return started;}
+
+  /**
+   * Queues a message for sending. Without a running thread, the message is written directly.
+   * @param message The complete message including its header.
+   * @return Could the message be queued/sent?
+   */
+  bool send(std::string&& message);
+
+  /**
+   * Wakes up the I/O thread so that it sends all queued messages.
+   * Should be called once per frame after all messages were queued.
+   */
+  void flush();
+
+  /**
+   * Returns the next received message. Without a running thread, the socket is read directly.
+   * @param message The message received.
+   * @return Was a message available?
+   */
+  bool receive(std::string& message);
+
+  /** Did the server answer within the keepalive timeout? Only meaningful while the thread is running. */
+  bool isClientAlive() const {return clientAlive.load(std::memory_order_relaxed);}
+
+  /**
+   * Creates the header that is prefixed to every outgoing message.
+   * @param robotNumber The number of this robot.
+   * @param prefixTimestamp Add the current timestamp.
+   * @param prefixRobotNumber Add the robot number.
+   * @return The header including the terminating '|'.
+   */
+  static std::string header(int robotNumber, bool prefixTimestamp, bool prefixRobotNumber);
+
+private:
+  Thread thread;
+  bool started = false;
+  int robotNumber = 0;
+  bool prefixTimestamp = true;
+  bool prefixRobotNumber = true;
+  bool performKeepaliveCheck = true;
+  unsigned keepaliveTimeout = 3000;
+
+  SPSCQueue<std::string, queueSize> incoming; /**< Produced by the I/O thread, consumed by the module. */
+  SPSCQueue<std::string, queueSize> outgoing; /**< Produced by the module, consumed by the I/O thread. */
+  std::atomic<bool> clientAlive{false};
+
+  int epollFd = -1; /**< The epoll instance waiting for the read socket and the wake up event. */
+  int wakeFd = -1; /**< An eventfd used to wake up the thread when messages were queued. */
+
+  /** The main loop of the thread. */
+  void run();
+
+  /** Reads all pending datagrams from the read socket. */
+  void readAll(unsigned now, unsigned& lastReceived);
+
+  /** Writes all queued outgoing messages. */
+  void writeAll();
+};
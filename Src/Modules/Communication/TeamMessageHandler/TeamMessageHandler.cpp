@@ -56,6 +56,20 @@ void TeamMessageHandler::generateMessage(BHumanMessageOutputGenerator& outputGen
   outputGenerator.theBSPLStandardMessage.fallen =
     !outputGenerator.theBHumanStandardMessage.hasGroundContact || !outputGenerator.theBHumanStandardMessage.isUpright;
 
+  switch(theRole.role)
+  {
+    case Role::goalie: outputGenerator.theBSPLStandardMessage.role = 1; break;
+    case Role::striker: outputGenerator.theBSPLStandardMessage.role = 2; break;
+    case Role::defender: outputGenerator.theBSPLStandardMessage.role = 3; break;
+    case Role::supporter: outputGenerator.theBSPLStandardMessage.role = 4; break;
+    case Role::jolly: outputGenerator.theBSPLStandardMessage.role = 5; break;
+    case Role::searcher_1: outputGenerator.theBSPLStandardMessage.role = 6; break;
+    case Role::searcher_2: outputGenerator.theBSPLStandardMessage.role = 7; break;
+    case Role::searcher_3: outputGenerator.theBSPLStandardMessage.role = 8; break;
+    case Role::searcher_4: outputGenerator.theBSPLStandardMessage.role = 9; break;
+    default: outputGenerator.theBSPLStandardMessage.role = 0; break;
+  }
+
   SEND_PARTICLE(BNTP);
 
   SEND_PARTICLE(BallModel);
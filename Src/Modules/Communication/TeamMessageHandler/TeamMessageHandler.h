@@ -10,6 +10,7 @@
 #pragma once
 
 #include "Representations/BehaviorControl/BehaviorStatus.h"
+#include "Representations/BehaviorControl/Role.h"
 #include "Representations/BehaviorControl/TeamBehaviorStatus.h"
 #include "Representations/Communication/GameInfo.h"
 #include "Representations/Communication/RobotInfo.h"
@@ -54,6 +55,7 @@ MODULE(TeamMessageHandler,
   USES(ObstacleModel),
   USES(RobotHealth),
   USES(RobotPose),
+  USES(Role),
   USES(SideConfidence),
   USES(TeamBehaviorStatus),
   USES(TeamTalk),
@@ -113,7 +113,12 @@ void CameraProvider::update(CameraImage& theCameraImage)
 
 void CameraProvider::update(JPEGImage& jpegImage)
 {
-  jpegImage = theCameraImage;
+  jpegImage.compress(theCameraImage, jpegQuality, jpegChromaSubsampling);
+}
+
+void CameraProvider::update(CompressedCameraImage& compressedCameraImage)
+{
+  compressedCameraImage = theCameraImage;
 }
 
 void CameraProvider::update(CameraInfo& cameraInfo)
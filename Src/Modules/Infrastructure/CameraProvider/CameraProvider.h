@@ -21,6 +21,7 @@
 #include "Representations/Infrastructure/CameraImage.h"
 #include "Representations/Infrastructure/CameraInfo.h"
 #include "Representations/Infrastructure/CameraStatus.h"
+#include "Representations/Infrastructure/CompressedCameraImage.h"
 #include "Representations/Infrastructure/FrameInfo.h"
 #include "Representations/Infrastructure/JPEGImage.h"
 #include "Tools/Module/Module.h"
@@ -43,10 +44,13 @@ MODULE(CameraProvider,
   PROVIDES(CameraIntrinsics),
   PROVIDES(CameraStatus),
   PROVIDES_WITHOUT_MODIFY(JPEGImage),
+  PROVIDES_WITHOUT_MODIFY(CompressedCameraImage),
   DEFINES_PARAMETERS(
   {,
     (unsigned)(1000) maxWaitForImage, /** Timeout in ms for waiting for new images. */
     (int)(2000) resetDelay, /** Timeout in ms for resetting camera without image. */
+    (int)(75) jpegQuality, /** The quality of the JPEGImage (0..100). */
+    (JPEGImage::ChromaSubsampling)(JPEGImage::none) jpegChromaSubsampling, /** The resolution of U and V in the JPEGImage. */
   }),
 });
 
@@ -86,6 +90,7 @@ class CameraProvider : public CameraProviderBase
   void update(CameraStatus& cameraStatus) override;
   void update(FrameInfo& frameInfo) override {frameInfo.time = theCameraImage.timestamp;}
   void update(JPEGImage& jpegImage) override;
+  void update(CompressedCameraImage& compressedCameraImage) override;
 
   bool readCameraIntrinsics();
   bool readCameraResolution();
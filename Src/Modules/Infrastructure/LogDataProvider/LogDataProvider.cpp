@@ -290,6 +290,17 @@ bool LogDataProvider::handleMessage2(InMessage& message)
       }
       return true;
 
+    case idCompressedCameraImage:
+      if(Blackboard::getInstance().exists("CameraImage"))
+      {
+        CompressedCameraImage compressedCameraImage;
+        message.bin >> compressedCameraImage;
+        compressedCameraImage.toCameraImage(static_cast<CameraImage&>(Blackboard::getInstance()["CameraImage"]));
+        if(Blackboard::getInstance().exists("FrameInfo"))
+          static_cast<FrameInfo&>(Blackboard::getInstance()["FrameInfo"]).time = static_cast<const CameraImage&>(Blackboard::getInstance()["CameraImage"]).timestamp;
+      }
+      return true;
+
     default:
       return handle(message);
   }
@@ -14,6 +14,7 @@
 #include "Representations/Communication/TeamInfo.h"
 #include "Representations/Configuration/FieldColors.h"
 #include "Representations/Infrastructure/AudioData.h"
+#include "Representations/Infrastructure/CompressedCameraImage.h"
 #include "Representations/Infrastructure/FrameInfo.h"
 #include "Representations/Infrastructure/GroundTruthWorldState.h"
 #include "Representations/Infrastructure/JointRequest.h"
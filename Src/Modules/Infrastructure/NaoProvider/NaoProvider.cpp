@@ -12,9 +12,11 @@
 #include "Platform/Thread.h"
 #include "Platform/Time.h"
 #include "Tools/Communication/MsgPack.h"
+#include "Tools/Debugging/DebugDrawings.h"
 #include "Tools/Global.h"
 #include "Tools/Settings.h"
 #include "Tools/Streams/OutStreams.h"
+#include <cstdio>
 #include <cstring>
 #include <csignal>
 
@@ -22,10 +24,22 @@ MAKE_MODULE(NaoProvider, infrastructure)
 
 #ifdef TARGET_ROBOT
 
+#include <sys/ioctl.h>
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <unistd.h>
 
+/**
+ * Returns the current time of the monotonic clock.
+ * @return The time in us.
+ */
+static unsigned long long getMonotonicTime()
+{
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<unsigned long long>(ts.tv_sec) * 1000000ull + ts.tv_nsec / 1000;
+}
+
 thread_local NaoProvider* NaoProvider::theInstance = nullptr;
 
 const Joints::Joint NaoProvider::jointMappings[Joints::numOfJoints - 1] =
@@ -234,12 +248,31 @@ NaoProvider::NaoProvider()
   std::strcpy(address.sun_path, "/tmp/robocup");
   VERIFY(!connect(socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)));
 
+  // Ask for receive timestamps. Whether they are actually provided depends on the socket type and the kernel.
+  const int on = 1;
+  VERIFY(!setsockopt(socket, SOL_SOCKET, SO_TIMESTAMPNS, &on, sizeof(on)));
+
   // Receive a first packet and setup all tables
   receivePacket();
 }
 
 NaoProvider::~NaoProvider()
 {
+  if(recorderThread.isRunning())
+  {
+    // Write the packets recorded so far before the recorder is stopped.
+    if(recordingBuffer && !recordingBuffer->empty())
+    {
+      {
+        SYNC;
+        recordingBuffersToWrite.push_back(recordingBuffer);
+      }
+      recordingBuffersPending.post();
+    }
+    recorderThread.announceStop();
+    recordingBuffersPending.post();
+    recorderThread.stop();
+  }
   close(socket);
   theInstance = nullptr;
 }
@@ -247,6 +280,13 @@ NaoProvider::~NaoProvider()
 void NaoProvider::update(FrameInfo& theFrameInfo)
 {
   theFrameInfo.time = timeWhenPacketReceived;
+
+  DECLARE_PLOT("module:NaoProvider:packetAge");
+  DECLARE_PLOT("module:NaoProvider:sensorToActuatorLatency");
+  PLOT("module:NaoProvider:packetAge", static_cast<float>(packetAge) / 1000.f);
+  PLOT("module:NaoProvider:sensorToActuatorLatency", static_cast<float>(sensorToActuatorLatency) / 1000.f);
+  DEBUG_RESPONSE_ONCE("module:NaoProvider:kernelTimestamps")
+    OUTPUT_TEXT("NaoProvider: packet arrival is " << (kernelTimestamps ? "timestamped by the kernel" : "estimated from the LoLA cycle"));
 }
 
 void NaoProvider::update(FsrSensorData& theFsrSensorData)
@@ -325,15 +365,137 @@ void NaoProvider::update(SystemSensorData& theSystemSensorData)
   }
 }
 
+unsigned long long NaoProvider::getPacketArrival(bool waited, const timespec* kernelTime, unsigned long long now) const
+{
+  if(kernelTime)
+  {
+    // Convert the kernel's timestamp to the monotonic clock by determining its age.
+    timespec realNow;
+    clock_gettime(CLOCK_REALTIME, &realNow);
+    const long long age = (static_cast<long long>(realNow.tv_sec) - kernelTime->tv_sec) * 1000000ll + (realNow.tv_nsec - kernelTime->tv_nsec) / 1000;
+    return now - std::min(static_cast<unsigned long long>(std::max(age, 0ll)), now);
+  }
+  else if(waited || !packetArrival)
+    return now;
+  else
+    return std::min(packetArrival + lolaCycleTime, now);
+}
+
+void NaoProvider::recordPacket(size_t size)
+{
+  if(!recorderThread.isRunning())
+  {
+    recordingBuffers.resize(numOfRecordingBuffers);
+    for(std::vector<unsigned char>& buffer : recordingBuffers)
+    {
+      buffer.reserve(packetsPerRecordingBuffer * (sizeof(unsigned) + sizeof(receivedPacket)));
+      recordingBuffersAvailable.push(&buffer);
+    }
+    recorderThread.setPriority(-1);
+    recorderThread.start(this, &NaoProvider::recorder);
+  }
+
+  if(!recordingBuffer)
+  {
+    SYNC;
+    if(recordingBuffersAvailable.empty())
+    {
+      OUTPUT_WARNING("NaoProvider: No buffer available for recording sensor packets!");
+      return;
+    }
+    recordingBuffer = recordingBuffersAvailable.top();
+    recordingBuffersAvailable.pop();
+  }
+
+  const unsigned packetSize = static_cast<unsigned>(size);
+  const unsigned char* sizeBytes = reinterpret_cast<const unsigned char*>(&packetSize);
+  recordingBuffer->insert(recordingBuffer->end(), sizeBytes, sizeBytes + sizeof(packetSize));
+  recordingBuffer->insert(recordingBuffer->end(), receivedPacket, receivedPacket + size);
+
+  // Hand the buffer over if another packet might not fit into it anymore.
+  if(recordingBuffer->capacity() - recordingBuffer->size() < sizeof(unsigned) + sizeof(receivedPacket))
+  {
+    {
+      SYNC;
+      recordingBuffersToWrite.push_back(recordingBuffer);
+    }
+    recordingBuffer = nullptr;
+    recordingBuffersPending.post();
+  }
+}
+
+void NaoProvider::recorder()
+{
+  Thread::nameCurrentThread("SensorRecorder");
+  BH_TRACE_INIT("SensorRecorder");
+
+  FILE* file = std::fopen("/home/nao/logs/lolaSensorPackets.bin", "wb");
+  if(!file)
+    OUTPUT_WARNING("NaoProvider: Could not create file for recording sensor packets!");
+
+  while(true)
+  {
+    recordingBuffersPending.wait();
+    std::vector<unsigned char>* buffer = nullptr;
+    {
+      SYNC;
+      if(!recordingBuffersToWrite.empty())
+        buffer = recordingBuffersToWrite.front();
+    }
+
+    // All buffers are written before stopping, because they are posted before the stop.
+    if(!buffer)
+      break;
+
+    if(file)
+      std::fwrite(buffer->data(), 1, buffer->size(), file);
+    buffer->clear();
+
+    {
+      SYNC;
+      recordingBuffersToWrite.pop_front();
+      recordingBuffersAvailable.push(buffer);
+    }
+  }
+
+  if(file)
+    std::fclose(file);
+}
+
 void NaoProvider::receivePacket()
 {
+  // If no data is waiting, this thread is woken up when the packet arrives.
+  int bytesWaiting = 0;
+  const bool waited = ioctl(socket, FIONREAD, &bytesWaiting) == 0 && bytesWaiting == 0;
+
   // Read maximum size for first packet, but the smaller size for all further packets.
-  const long bytesRead = recv(socket, reinterpret_cast<char*>(receivedPacket), sizeof(receivedPacket), 0);
+  iovec buffer = {receivedPacket, sizeof(receivedPacket)};
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(timespec))];
+  msghdr message = {};
+  message.msg_iov = &buffer;
+  message.msg_iovlen = 1;
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+  const long bytesRead = recvmsg(socket, &message, 0);
   if(bytesRead < 0)
     OUTPUT_ERROR("Could not receive packet from NAO");
   else
   {
-    timeWhenPacketReceived = std::max(Time::getCurrentSystemTime(), timeWhenPacketReceived + 1);
+    const unsigned long long now = getMonotonicTime();
+    const timespec* kernelTime = nullptr;
+    for(cmsghdr* c = CMSG_FIRSTHDR(&message); c; c = CMSG_NXTHDR(&message, c))
+      if(c->cmsg_level == SOL_SOCKET && c->cmsg_type == SCM_TIMESTAMPNS)
+        kernelTime = reinterpret_cast<const timespec*>(CMSG_DATA(c));
+    kernelTimestamps = kernelTime != nullptr;
+    packetArrival = getPacketArrival(waited, kernelTime, now);
+    packetAge = static_cast<unsigned>(now - packetArrival);
+
+    // Only a measured arrival time is used to backdate the packet. The estimate
+    // from the LoLA cycle is only reported in the plot.
+    timeWhenPacketReceived = std::max(Time::getCurrentSystemTime() - (kernelTime ? packetAge / 1000 : 0), timeWhenPacketReceived + 1);
+
+    DEBUG_RESPONSE("module:NaoProvider:recordSensorPackets")
+      recordPacket(static_cast<size_t>(bytesRead));
 
     // Initialize tables if they have not been so far
     if(!batteryLevel)
@@ -467,6 +629,7 @@ void NaoProvider::sendPacket()
   }
 
   VERIFY(send(socket, reinterpret_cast<char*>(packetToSend), packetToSendSize, 0) == static_cast<ssize_t>(packetToSendSize));
+  sensorToActuatorLatency = static_cast<unsigned>(getMonotonicTime() - packetArrival);
 }
 
 void NaoProvider::waitForFrameData()
@@ -37,6 +37,7 @@ MODULE(NaoProvider,
   PROVIDES(SystemSensorData),
   DEFINES_PARAMETERS(
   {,
+    (int)(12000) lolaCycleTime, /**< The time between two packets from LoLA (in us). */
     (int)(3000) timeChestButtonPressedUntilShutdown, /**< Time the chest button must be pressed until shutdown (in ms). */
     (int)(5000) timeBetweenBatteryLevelUpdates, /**< Time between writing updates the battery level to a file (in ms). */
   }),
@@ -44,9 +45,17 @@ MODULE(NaoProvider,
 
 #ifdef TARGET_ROBOT
 
+#include "Platform/Semaphore.h"
+#include "Platform/Thread.h"
+#include <ctime>
+#include <deque>
+#include <stack>
+
 class NaoProvider : public NaoProviderBase
 {
   static thread_local NaoProvider* theInstance; /**< The only instance of this module. */
+  static constexpr size_t numOfRecordingBuffers = 8; /**< The number of buffers for recording sensor packets. */
+  static constexpr size_t packetsPerRecordingBuffer = 64; /**< How many packets fit into a recording buffer? */
   static const Joints::Joint jointMappings[Joints::numOfJoints - 1]; /**< Mappings from LoLA's joint indices to B-Human's joint indices. */
   static const KeyStates::Key keyMappings[KeyStates::numOfKeys]; /**< Mappings from LoLA's touch indices to B-Human's key indices. */
   static const LEDRequest::LED leftEyeMappings[LEDRequest::faceRightRed0Deg - LEDRequest::faceLeftRed0Deg]; /**< Mappings from LoLA's LED indices to B-Human's LED indices. */
@@ -80,6 +89,17 @@ class NaoProvider : public NaoProviderBase
   std::array<unsigned char*, Joints::numOfJoints> jointStiffnesses; /**< The addresses of joint stiffness data inside packetToSend. */
   std::array<unsigned char*, LEDRequest::numOfLEDs> leds; /**< The addresses of led data inside packetToSend. */
   unsigned timeWhenPacketReceived = 0; /**< The time when the last packet was received. */
+  unsigned long long packetArrival = 0; /**< The time when the last packet arrived at the socket (in us, monotonic clock). */
+  unsigned packetAge = 0; /**< The time between the arrival of the last packet and its reception by this thread (in us). */
+  unsigned sensorToActuatorLatency = 0; /**< The time between the arrival of the previous packet and sending the reply (in us). */
+  bool kernelTimestamps = false; /**< Did the kernel provide receive timestamps for the packets? */
+  DECLARE_SYNC; /**< Synchronizes the exchange of recording buffers with the recorder thread. */
+  std::vector<std::vector<unsigned char>> recordingBuffers; /**< All buffers to record sensor packets to. Empty until recording starts. */
+  std::stack<std::vector<unsigned char>*> recordingBuffersAvailable; /**< The buffers currently available to fill with packets. */
+  std::deque<std::vector<unsigned char>*> recordingBuffersToWrite; /**< The buffers already filled that need to be written. */
+  std::vector<unsigned char>* recordingBuffer = nullptr; /**< The buffer currently filled or nullptr if none is assigned. */
+  Thread recorderThread; /**< The thread that writes the recorded packets to a file. */
+  Semaphore recordingBuffersPending; /**< How many buffers should the recorder thread write? */
   unsigned timeWhenChestButtonUnpressed = 0; /**< The last time the chest buttom was not pressed. */
   unsigned timeWhenBatteryLevelWritten = 0; /**< The last time the battery level was written to a file. */
 
@@ -126,6 +146,30 @@ class NaoProvider : public NaoProviderBase
    */
   void receivePacket();
 
+  /**
+   * Determines when the packet just received arrived at the socket. If the kernel
+   * provides receive timestamps, they are used. Otherwise, a packet that was
+   * already waiting is assumed to have arrived one LoLA cycle after the previous
+   * one.
+   * @param waited Did the thread wait for the packet?
+   * @param kernelTime The receive timestamp of the kernel (CLOCK_REALTIME) or
+   *                   nullptr if there is none.
+   * @param now The current time (in us, monotonic clock).
+   * @return The time when the packet arrived (in us, monotonic clock).
+   */
+  unsigned long long getPacketArrival(bool waited, const timespec* kernelTime, unsigned long long now) const;
+
+  /**
+   * Records the packet just received. The Motion thread only copies it into a
+   * preallocated buffer. Full buffers are written by the recorder thread. If no
+   * buffer is available, the packet is dropped.
+   * @param size The size of the packet.
+   */
+  void recordPacket(size_t size);
+
+  /** The method runs in a separate thread and writes the recorded packets to a file. */
+  void recorder();
+
   /**
    * Write a range of leds to the packet to send and initialise the pointers
    * intended to point into packetToSend for this range.
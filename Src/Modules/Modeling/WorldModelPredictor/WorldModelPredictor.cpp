@@ -44,6 +44,8 @@ void WorldModelPredictor::update(WorldModelPrediction& worldModelPrediction)
   Pose2f odometryOffset = lastUsedBallModelOdometry - theOdometryData;
   worldModelPrediction.ballPosition = odometryOffset * propagatedBallPosition;
   worldModelPrediction.ballVelocity = propagatedBallVelocity.rotate(odometryOffset.rotation);
+  const Matrix2f rotation = Eigen::Rotation2D<float>(odometryOffset.rotation).toRotationMatrix();
+  worldModelPrediction.ballPositionCovariance = rotation * lastUsedBallModel.estimate.covariance * rotation.transpose();
 
   // Special handling for penalty shootout -> ball is supposed to be on the penalty spot!
   if(theGameInfo.gamePhase == GAME_PHASE_PENALTYSHOOT &&
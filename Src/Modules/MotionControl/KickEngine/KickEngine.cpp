@@ -102,7 +102,7 @@ void KickEngine::update(KickEngineOutput& kickEngineOutput)
     {
       if(data.activateNewMotion(lastValidKickRequest, kickEngineOutput.isLeavingPossible) && lastValidKickRequest.kickMotionType != KickRequest::none)
       {
-        data.initData(theFrameInfo, lastValidKickRequest, params, theJointAngles, theTorsoMatrix, kickEngineOutput, theRobotDimensions, theMassCalibration, theDamageConfigurationBody);
+        data.initData(theFrameInfo, lastValidKickRequest, params, trajectories, theJointAngles, theTorsoMatrix, kickEngineOutput, theRobotDimensions, theKinematics, theDamageConfigurationBody);
         data.currentKickRequest = lastValidKickRequest;
         data.setExecutedKickRequest(kickEngineOutput.executedKickRequest);
 
@@ -136,7 +136,7 @@ void KickEngine::update(KickEngineOutput& kickEngineOutput)
       //Is the current kick id valid, then calculate the jointRequest once for the balanceCom()
       if(data.calcJoints(kickEngineOutput, theRobotDimensions, theDamageConfigurationBody))
       {
-        data.balanceCOM(kickEngineOutput, theRobotDimensions, theMassCalibration);
+        data.balanceCOM(kickEngineOutput, theKinematics);
         data.calcJoints(kickEngineOutput, theRobotDimensions, theDamageConfigurationBody);
         data.mirrorIfNecessary(kickEngineOutput);
 
@@ -164,8 +164,22 @@ void KickEngine::update(KickEngineOutput& kickEngineOutput)
     }
   }
   else
+  {
     compensated = false;
+    createTrajectories();
+  }
 
   data.setEngineActivation(theLegMotionSelection.ratios[MotionRequest::kick]);
   data.ModifyData(theMotionRequest.kickRequest, kickEngineOutput, params);
 }
+
+void KickEngine::createTrajectories()
+{
+  if(!trajectories.empty() && trajectories.front().isValidFor(theRobotDimensions))
+    return;
+
+  trajectories.resize(params.size());
+  for(size_t i = 0; i < params.size(); ++i)
+    trajectories[i].create(params[i], theRobotDimensions);
+  trajectories.back().clear();
+}
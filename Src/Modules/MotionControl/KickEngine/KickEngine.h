@@ -8,12 +8,14 @@
 
 #include "KickEngineData.h"
 #include "KickEngineParameters.h"
+#include "KickTrajectory.h"
 #include "Representations/Configuration/JointLimits.h"
 #include "Representations/Infrastructure/JointAngles.h"
 #include "Representations/Modeling/BallModel.h"
 #include "Representations/MotionControl/KickEngineOutput.h"
 #include "Representations/MotionControl/LegMotionSelection.h"
 #include "Representations/MotionControl/WalkingEngineOutput.h"
+#include "Representations/Sensing/Kinematics.h"
 #include "Representations/Sensing/TorsoMatrix.h"
 #include "Representations/Sensing/InertialData.h"
 #include "Tools/Module/Module.h"
@@ -28,7 +30,7 @@ MODULE(KickEngine,
   REQUIRES(InertialData),
   REQUIRES(JointAngles),
   REQUIRES(JointLimits),
-  REQUIRES(MassCalibration),
+  REQUIRES(Kinematics),
   REQUIRES(MotionRequest),
   REQUIRES(LegMotionSelection),
   REQUIRES(KeyStates),
@@ -49,9 +51,17 @@ private:
   KickRequest lastValidKickRequest;
 
   std::vector<KickEngineParameters> params;
+  std::vector<KickTrajectory> trajectories; /**< The samples of all kick motions, in the same order as params. */
 
 public:
   KickEngine();
 
   void update(KickEngineOutput& kickEngineOutput) override;
+
+  /**
+   * Samples all kick motions if this has not been done yet or the robot
+   * dimensions have changed. The kick motion that can be modified at runtime
+   * is never sampled.
+   */
+  void createTrajectories();
 };
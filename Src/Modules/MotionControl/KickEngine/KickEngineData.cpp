@@ -4,7 +4,9 @@
  * @author <A href="mailto:judy@tzi.de">Judith Müller</A>
  */
 
+#include <algorithm>
 #include <cstring>
+#include <iterator>
 
 #include "KickEngineData.h"
 #include "Representations/Configuration/JointLimits.h"
@@ -115,6 +117,7 @@ bool KickEngineData::checkPhaseTime(const FrameInfo& frame, const JointAngles& j
         if(phaseNumber - 1 > 0 && fastKickEndAdjusted)
         {
           fastKickEndAdjusted = false;
+          modifiedPhases[phaseNumber - 1] = modifiedPhases[phaseNumber] = true;
           currentParameters.phaseParameters[phaseNumber - 1].controlPoints[Phase::rightFootTra][2].z() = adjustedZValue;
           currentParameters.phaseParameters[phaseNumber - 1].controlPoints[Phase::rightFootTra][2].x() = adjustedXValue;
         }
@@ -159,8 +162,13 @@ bool KickEngineData::calcJoints(JointRequest& jointRequest, const RobotDimension
     calcLegJoints(Joints::lHipYawPitch, jointRequest, rd, theDamageConfigurationBody);
     calcLegJoints(Joints::rHipYawPitch, jointRequest, rd, theDamageConfigurationBody);
 
-    simpleCalcArmJoints(Joints::lShoulderPitch, jointRequest, rd, positions[Phase::leftArmTra], positions[Phase::leftHandRot]);
-    simpleCalcArmJoints(Joints::rShoulderPitch, jointRequest, rd, positions[Phase::rightArmTra], positions[Phase::rightHandRot]);
+    if(useSample)
+      std::copy(std::begin(sample.armAngles), std::end(sample.armAngles), &jointRequest.angles[Joints::firstArmJoint]);
+    else
+    {
+      simpleCalcArmJoints(Joints::lShoulderPitch, jointRequest, rd, positions[Phase::leftArmTra], positions[Phase::leftHandRot]);
+      simpleCalcArmJoints(Joints::rShoulderPitch, jointRequest, rd, positions[Phase::rightArmTra], positions[Phase::rightHandRot]);
+    }
 
     return true;
   }
@@ -281,10 +289,10 @@ void KickEngineData::simpleCalcArmJoints(const Joints::Joint& joint, JointReques
   jointRequest.angles[joint + 5] = 0.f;
 }
 
-void KickEngineData::balanceCOM(JointRequest& joints, const RobotDimensions& rd, const MassCalibration& mc)
+void KickEngineData::balanceCOM(JointRequest& joints, const Kinematics& kinematics)
 {
   const Pose3f& torso = toLeftSupport ? comRobotModel.limbs[Limbs::footLeft] : comRobotModel.limbs[Limbs::footRight];
-  comRobotModel.setJointData(joints, rd, mc);
+  comRobotModel = kinematics.getRobotModel(joints);
   const Vector3f com = torso.rotation.inverse() * comRobotModel.centerOfMass;
 
   actualDiff = com - ref;
@@ -471,6 +479,10 @@ void KickEngineData::addDynPoint(const DynPoint& dynPoint, const TorsoMatrix& to
   const int phaseNumber = dynPoint.phaseNumber;
   const int limb = dynPoint.limb;
 
+  modifiedPhases[phaseNumber] = true;
+  if(phaseNumber < currentParameters.numberOfPhases - 1)
+    modifiedPhases[phaseNumber + 1] = true;
+
   if(dynPoint.duration > 0)
     currentParameters.phaseParameters[phaseNumber].duration = dynPoint.duration;
 
@@ -590,8 +602,13 @@ void KickEngineData::ModifyData(const KickRequest& br, JointRequest& kickEngineO
 
 void KickEngineData::calcPositions(const TorsoMatrix& torsoMatrix)
 {
-  for(int i = 0; i < Phase::numOfLimbs; ++i)
-    positions[i] = currentParameters.getPosition(phase, phaseNumber, i);
+  // Phases that were not modified at runtime are taken from the samples
+  useSample = trajectory && trajectory->getSample(phaseNumber, timeSinceTimestamp, sample) && !modifiedPhases[phaseNumber];
+  if(useSample)
+    std::copy(std::begin(sample.positions), std::end(sample.positions), positions);
+  else
+    for(int i = 0; i < Phase::numOfLimbs; ++i)
+      positions[i] = currentParameters.getPosition(phase, phaseNumber, i);
   bool adjustKick = adjustFastKickHack(torsoMatrix);
   if(adjustKick)
   {
@@ -608,9 +625,9 @@ void KickEngineData::calcPositions(const TorsoMatrix& torsoMatrix)
     }
   }
   if(!currentParameters.ignoreHead)
-    head = currentParameters.getHeadRefPosition(phase, phaseNumber);
+    head = useSample ? sample.head : currentParameters.getHeadRefPosition(phase, phaseNumber);
 
-  ref << currentParameters.getComRefPosition(phase, phaseNumber),
+  ref << (useSample ? sample.comRef : currentParameters.getComRefPosition(phase, phaseNumber)),
       (toLeftSupport) ? positions[Phase::leftFootTra].z() : positions[Phase::rightFootTra].z();
 }
 
@@ -621,8 +638,8 @@ void KickEngineData::setExecutedKickRequest(KickRequest& br)
   br.kickMotionType = currentKickRequest.kickMotionType;
 }
 
-void KickEngineData::initData(const FrameInfo& frame, const KickRequest& kr, std::vector<KickEngineParameters>& params,
-                              const JointAngles& ja, const TorsoMatrix& torsoMatrix, JointRequest& jointRequest, const RobotDimensions& rd, const MassCalibration& mc, const DamageConfigurationBody& theDamageConfigurationBody)
+void KickEngineData::initData(const FrameInfo& frame, const KickRequest& kr, std::vector<KickEngineParameters>& params, const std::vector<KickTrajectory>& trajectories,
+                              const JointAngles& ja, const TorsoMatrix& torsoMatrix, JointRequest& jointRequest, const RobotDimensions& rd, const Kinematics& kinematics, const DamageConfigurationBody& theDamageConfigurationBody)
 {
   VERIFY(getMotionIDByName(kr, params));
 
@@ -630,6 +647,8 @@ void KickEngineData::initData(const FrameInfo& frame, const KickRequest& kr, std
   phaseNumber = 0;
   timestamp = frame.time;
   currentParameters = params[motionID];
+  trajectory = motionID < static_cast<int>(trajectories.size()) ? &trajectories[motionID] : nullptr;
+  modifiedPhases.assign(currentParameters.numberOfPhases, false);
   toLeftSupport = currentParameters.standLeft;
   adjustedZValue = 0.f;
   adjustedXValue = 0.f;
@@ -650,7 +669,7 @@ void KickEngineData::initData(const FrameInfo& frame, const KickRequest& kr, std
 
   bodyAngle = Vector2f(angleX, angleY);
   calcJoints(jointRequest, rd, theDamageConfigurationBody);
-  comRobotModel.setJointData(jointRequest, rd, mc);
+  comRobotModel = kinematics.getRobotModel(jointRequest);
   const Pose3f& torso = toLeftSupport ? comRobotModel.limbs[Limbs::footLeft] : comRobotModel.limbs[Limbs::footRight];
   const Vector3f com = torso.rotation.inverse() * comRobotModel.centerOfMass;
 
@@ -7,15 +7,16 @@
 #pragma once
 
 #include "KickEngineParameters.h"
+#include "KickTrajectory.h"
 #include "Platform/BHAssert.h"
 #include "Representations/Configuration/DamageConfiguration.h"
-#include "Representations/Configuration/MassCalibration.h"
 #include "Representations/Configuration/RobotDimensions.h"
 #include "Representations/Infrastructure/FrameInfo.h"
 #include "Representations/Infrastructure/JointAngles.h"
 #include "Representations/Infrastructure/JointRequest.h"
 #include "Representations/MotionControl/KickEngineOutput.h"
 #include "Representations/MotionControl/MotionRequest.h"
+#include "Representations/Sensing/Kinematics.h"
 #include "Representations/Sensing/RobotModel.h"
 #include "Representations/Sensing/TorsoMatrix.h"
 #include "Representations/Sensing/InertialData.h"
@@ -72,6 +73,10 @@ private:
   Vector3f actualDiff = Vector3f::Zero();
 
   KickEngineParameters currentParameters;
+  const KickTrajectory* trajectory = nullptr; /**< The precomputed samples of the current kick motion. */
+  KickTrajectory::Sample sample; /**< The sample used in this frame. */
+  bool useSample = false; /**< Is the sample used in this frame or were the positions computed? */
+  std::vector<bool> modifiedPhases; /**< Which phases of the current kick motion differ from their samples? */
 
   RobotModel comRobotModel;
 
@@ -94,12 +99,12 @@ public:
   bool getMotionIDByName(const KickRequest& kr, const std::vector<KickEngineParameters>& params);
   void calculateOrigins(const KickRequest& kr, const JointAngles& ja, const TorsoMatrix& to, const RobotDimensions& theRobotDimensions);
   bool checkPhaseTime(const FrameInfo& frame, const JointAngles& ja, const TorsoMatrix& torsoMatrix);
-  void balanceCOM(JointRequest& joints, const RobotDimensions& rd, const MassCalibration& mc);
+  void balanceCOM(JointRequest& joints, const Kinematics& kinematics);
 
   bool calcJoints(JointRequest& jointRequest, const RobotDimensions& rd, const DamageConfigurationBody& theDamageConfigurationBody);
   void calcOdometryOffset(KickEngineOutput& output, const RobotModel& theRobotModel);
   void calcLegJoints(const Joints::Joint& joint, JointRequest& jointRequest, const RobotDimensions& theRobotDimensions, const DamageConfigurationBody& theDamageConfigurationBody);
-  void simpleCalcArmJoints(const Joints::Joint& joint, JointRequest& jointRequest, const RobotDimensions& theRobotDimensions, const Vector3f& armPos, const Vector3f& handRotAng);
+  static void simpleCalcArmJoints(const Joints::Joint& joint, JointRequest& jointRequest, const RobotDimensions& theRobotDimensions, const Vector3f& armPos, const Vector3f& handRotAng);
 
   void mirrorIfNecessary(JointRequest& joints);
   void addGyroBalance(JointRequest& jointRequest, const JointLimits& jointLimits, const InertialData& id, const float& ratio);
@@ -108,7 +113,7 @@ public:
   void calcPhaseState();
   void calcPositions(const TorsoMatrix& torsoMatrix);
   void setExecutedKickRequest(KickRequest& br);
-  void initData(const FrameInfo& frame, const KickRequest& kr, std::vector<KickEngineParameters>& params, const JointAngles& ja, const TorsoMatrix& torsoMatrix, JointRequest& jointRequest, const RobotDimensions& rd, const MassCalibration& mc, const DamageConfigurationBody& theDamageConfigurationBody);
+  void initData(const FrameInfo& frame, const KickRequest& kr, std::vector<KickEngineParameters>& params, const std::vector<KickTrajectory>& trajectories, const JointAngles& ja, const TorsoMatrix& torsoMatrix, JointRequest& jointRequest, const RobotDimensions& rd, const Kinematics& kinematics, const DamageConfigurationBody& theDamageConfigurationBody);
   void setEngineActivation(const float& ratio);
   bool activateNewMotion(const KickRequest& br, const bool& isLeavingPossible);
   bool sitOutTransitionDisturbance(bool& compensate, bool& compensated, const InertialData& id, KickEngineOutput& kickEngineOutput, const JointRequest& theJointRequest, const FrameInfo& frame);
@@ -0,0 +1,82 @@
+/**
+ * @file KickTrajectory.cpp
+ * This file implements a class that samples the phases of a kick motion at the
+ * rate of the motion cycle.
+ */
+
+#include "KickTrajectory.h"
+#include "KickEngineData.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+const int KickTrajectory::samplingInterval = static_cast<int>(std::round(Constants::motionCycleTime * 1000.f));
+
+void KickTrajectory::create(const KickEngineParameters& parameters, const RobotDimensions& robotDimensions)
+{
+  armOffset = robotDimensions.armOffset;
+  upperArmLength = robotDimensions.upperArmLength;
+  yOffsetElbowToShoulder = robotDimensions.yOffsetElbowToShoulder;
+
+  KickEngineParameters p = parameters;
+  JointRequest jointRequest;
+  phases.resize(p.numberOfPhases);
+  durations.resize(p.numberOfPhases);
+  for(int phaseNumber = 1; phaseNumber < p.numberOfPhases; ++phaseNumber)
+  {
+    // The phase is computed exactly as in KickEngineData::calcPhaseState, so that the samples
+    // are identical to what would be computed at runtime.
+    const unsigned duration = p.phaseParameters[phaseNumber].duration;
+    durations[phaseNumber] = duration;
+    std::vector<Sample>& samples = phases[phaseNumber];
+    samples.resize((duration + samplingInterval - 1) / samplingInterval + 1);
+    for(size_t i = 0; i < samples.size(); ++i)
+    {
+      Sample& sample = samples[i];
+      const float phase = static_cast<float>(std::min(static_cast<unsigned>(i * samplingInterval), duration)) / static_cast<float>(duration);
+      for(int limb = 0; limb < Phase::numOfLimbs; ++limb)
+        sample.positions[limb] = p.getPosition(phase, phaseNumber, limb);
+      sample.comRef = p.getComRefPosition(phase, phaseNumber);
+      sample.head = p.getHeadRefPosition(phase, phaseNumber);
+
+      KickEngineData::simpleCalcArmJoints(Joints::lShoulderPitch, jointRequest, robotDimensions, sample.positions[Phase::leftArmTra], sample.positions[Phase::leftHandRot]);
+      KickEngineData::simpleCalcArmJoints(Joints::rShoulderPitch, jointRequest, robotDimensions, sample.positions[Phase::rightArmTra], sample.positions[Phase::rightHandRot]);
+      std::copy(&jointRequest.angles[Joints::firstArmJoint], &jointRequest.angles[Joints::firstLegJoint], sample.armAngles);
+    }
+  }
+}
+
+bool KickTrajectory::getSample(int phaseNumber, int timeSincePhaseStart, Sample& sample) const
+{
+  if(phaseNumber <= 0 || phaseNumber >= static_cast<int>(phases.size()) || timeSincePhaseStart < 0
+     || static_cast<unsigned>(timeSincePhaseStart) > durations[phaseNumber])
+    return false;
+  const std::vector<Sample>& samples = phases[phaseNumber];
+  const int index = timeSincePhaseStart / samplingInterval;
+  const int offset = timeSincePhaseStart - index * samplingInterval;
+  if(!offset)
+  {
+    sample = samples[index];
+    return true;
+  }
+
+  // The last interval of a phase can be shorter than the sampling interval.
+  const Sample& s0 = samples[index];
+  const Sample& s1 = samples[index + 1];
+  const int interval = std::min((index + 1) * samplingInterval, static_cast<int>(durations[phaseNumber])) - index * samplingInterval;
+  const float ratio = static_cast<float>(offset) / static_cast<float>(interval);
+  for(int limb = 0; limb < Phase::numOfLimbs; ++limb)
+    sample.positions[limb] = s0.positions[limb] + (s1.positions[limb] - s0.positions[limb]) * ratio;
+  sample.comRef = s0.comRef + (s1.comRef - s0.comRef) * ratio;
+  sample.head = s0.head + (s1.head - s0.head) * ratio;
+  for(size_t joint = 0; joint < std::size(sample.armAngles); ++joint)
+    sample.armAngles[joint] = s0.armAngles[joint] + (s1.armAngles[joint] - s0.armAngles[joint]) * ratio;
+  return true;
+}
+
+bool KickTrajectory::isValidFor(const RobotDimensions& robotDimensions) const
+{
+  return armOffset == robotDimensions.armOffset && upperArmLength == robotDimensions.upperArmLength
+         && yOffsetElbowToShoulder == robotDimensions.yOffsetElbowToShoulder;
+}
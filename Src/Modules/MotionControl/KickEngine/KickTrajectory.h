@@ -0,0 +1,64 @@
+/**
+ * @file KickTrajectory.h
+ * This file declares a class that samples the phases of a kick motion at the
+ * rate of the motion cycle. The first phase is not sampled, because it starts
+ * at the pose the robot is in when the kick begins. Times between two samples
+ * are interpolated linearly, because the frames of the Motion thread are not
+ * exactly one motion cycle apart.
+ */
+
+#pragma once
+
+#include "KickEngineParameters.h"
+#include "Representations/Configuration/RobotDimensions.h"
+
+#include <vector>
+
+class KickTrajectory
+{
+public:
+  /** The state of a kick motion at a certain time of a phase. */
+  struct Sample
+  {
+    Vector3f positions[Phase::numOfLimbs]; /**< The positions of all limbs. */
+    Vector2f comRef; /**< The reference position of the center of mass. */
+    Vector2f head; /**< The head angles (pitch, yaw). */
+    Angle armAngles[Joints::firstLegJoint - Joints::firstArmJoint]; /**< The angles of the arm joints, which do not depend on balancing. */
+  };
+
+  /**
+   * Samples the phases of a kick motion.
+   * @param parameters The parameters of the kick motion.
+   * @param robotDimensions The dimensions of the robot used to compute the arm angles.
+   */
+  void create(const KickEngineParameters& parameters, const RobotDimensions& robotDimensions);
+
+  /** Removes all samples, e.g. for a kick motion that is changed at runtime. */
+  void clear() {phases.clear(); durations.clear();}
+
+  /**
+   * Checks whether the samples were created for the arms of the given robot.
+   * @param robotDimensions The dimensions of the robot.
+   * @return Are the arm angles valid for these dimensions?
+   */
+  bool isValidFor(const RobotDimensions& robotDimensions) const;
+
+  /**
+   * Determines the sample at a certain time of a phase. If the time is between
+   * two samples, the sample is interpolated linearly.
+   * @param phaseNumber The number of the phase.
+   * @param timeSincePhaseStart The time since the phase started (in ms).
+   * @param sample The sample is returned here.
+   * @return Was there a sample for this time?
+   */
+  bool getSample(int phaseNumber, int timeSincePhaseStart, Sample& sample) const;
+
+private:
+  static const int samplingInterval; /**< The time between two samples (in ms). */
+
+  std::vector<std::vector<Sample>> phases; /**< The samples of each phase, the last one at its end. The first phase is always empty. */
+  std::vector<unsigned> durations; /**< The duration of each phase (in ms). */
+  Vector3f armOffset = Vector3f::Zero(); /**< The arm offset the samples were created for. */
+  float upperArmLength = 0.f; /**< The upper arm length the samples were created for. */
+  float yOffsetElbowToShoulder = 0.f; /**< The elbow offset the samples were created for. */
+};
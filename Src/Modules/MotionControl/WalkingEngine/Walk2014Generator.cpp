@@ -722,21 +722,18 @@ void Walk2014Generator::compensateArmPosition(const Pose3f& leftFoot, const Pose
   for(int joint = 0; joint < Joints::firstArmJoint; ++joint)
     temp.angles[joint] = theJointRequest.angles[joint] != JointRequest::off
                          ? theJointRequest.angles[joint] : theJointAngles.angles[joint];
-  RobotModel withWalkGeneratorArms(temp, theRobotDimensions, theMassCalibration);
+  const Vector3f withWalkGeneratorArms = theKinematics.getRobotModel(temp).centerOfMass;
   for(int joint = Joints::firstArmJoint; joint < Joints::firstLegJoint; ++joint)
     temp.angles[joint] = theJointRequest.angles[joint] != JointRequest::off
                          ? theJointRequest.angles[joint] : theJointAngles.angles[joint];
-  RobotModel balanced(temp, theRobotDimensions, theMassCalibration);
 
+  // Only the leg chains change between iterations, the others are reused.
   for(int i = 0; i < numOfComIterations; ++i)
   {
     Quaternionf torsoRotation = Rotation::aroundY(-torsoTilt);
     VERIFY(InverseKinematic::calcLegJoints(leftFoot, rightFoot, torsoRotation, temp, theRobotDimensions) || SystemCall::getMode() == SystemCall::logFileReplay);
-    ForwardKinematic::calculateLegChain(Legs::left, temp, theRobotDimensions, balanced.limbs);
-    ForwardKinematic::calculateLegChain(Legs::right, temp, theRobotDimensions, balanced.limbs);
-    balanced.updateCenterOfMass(theMassCalibration);
-    Vector3f balancedCom = torsoRotation * balanced.centerOfMass;
-    torsoTilt += (balancedCom.x() - withWalkGeneratorArms.centerOfMass.x()) * pComFactor;
+    Vector3f balancedCom = torsoRotation * theKinematics.getRobotModel(temp).centerOfMass;
+    torsoTilt += (balancedCom.x() - withWalkGeneratorArms.x()) * pComFactor;
   }
   float tiltIncrease = mmPerM * (forward >= 0 ? forward* comTiltForwardIncreaseFactor : forward * comTiltBackwardIncreaseFactor);
   VERIFY(InverseKinematic::calcLegJoints(leftFoot, rightFoot, Vector2f(0.f, tiltIncrease - torsoTilt * comTiltFactor), jointRequest, theRobotDimensions) || SystemCall::getMode() == SystemCall::logFileReplay);
@@ -46,7 +46,6 @@
 #include "Representations/Communication/RobotInfo.h"
 #include "Representations/Configuration/DamageConfiguration.h"
 #include "Representations/Configuration/GlobalOptions.h"
-#include "Representations/Configuration/MassCalibration.h"
 #include "Representations/Configuration/RobotDimensions.h"
 #include "Representations/Infrastructure/FrameInfo.h"
 #include "Representations/Infrastructure/SensorData/InertialSensorData.h"
@@ -56,6 +55,7 @@
 #include "Representations/MotionControl/WalkLearner.h"
 #include "Representations/Sensing/FootSupport.h"
 #include "Representations/Sensing/GroundContactState.h"
+#include "Representations/Sensing/Kinematics.h"
 #include "Representations/Sensing/RobotModel.h"
 #include "Tools/Module/Module.h"
 #include "Tools/RobotParts/Legs.h"
@@ -114,7 +114,7 @@ MODULE(Walk2014Generator,
   REQUIRES(InertialSensorData),
   REQUIRES(JointAngles),
   USES(JointRequest),
-  REQUIRES(MassCalibration),
+  REQUIRES(Kinematics),
   REQUIRES(RobotDimensions),
   REQUIRES(RobotInfo),
   REQUIRES(RobotModel),
@@ -0,0 +1,111 @@
+/**
+ * @file WalkEvaluator.cpp
+ *
+ * This file implements a module that replaces the behavior in the simulator and
+ * walks with a sequence of speeds to rate the parameters of the walking engine.
+ */
+
+#include "WalkEvaluator.h"
+#include "Tools/Streams/OutStreams.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+MAKE_MODULE(WalkEvaluator, motionControl)
+
+void WalkEvaluator::update(MotionRequest& motionRequest)
+{
+  if(!timeWhenStarted)
+    timeWhenStarted = theFrameInfo.time;
+
+  if(theFallDownState.state == FallDownState::fallen && lastFallDownState != FallDownState::fallen)
+  {
+    ++evaluation.falls;
+    fellInPhase = true;
+  }
+  lastFallDownState = theFallDownState.state;
+
+  if(phase >= 0)
+    rotationWhileMeasuring += Angle::normalize(theGroundTruthWorldState.ownPose.rotation - lastRotation);
+  lastRotation = theGroundTruthWorldState.ownPose.rotation;
+
+  const int timeInPhases = theFrameInfo.getTimeSince(timeWhenStarted) - standDuration;
+  const int currentPhase = timeInPhases < 0 ? -1 : timeInPhases / phaseDuration;
+  const bool measuring = currentPhase >= 0 && timeInPhases % phaseDuration >= settleDuration;
+
+  if(!evaluation.finished && phase >= 0 && currentPhase != phase)
+  {
+    finishPhase(speeds[phase]);
+    phase = -1;
+  }
+
+  if(!evaluation.finished && currentPhase >= static_cast<int>(speeds.size()))
+  {
+    evaluation.finished = true;
+    evaluation.speedRatio = speeds.empty() ? 0.f : sumOfSpeedRatios / static_cast<float>(speeds.size());
+    evaluation.gyroDeviation = numOfGyros ? std::sqrt(sumOfSquaredGyros / static_cast<float>(numOfGyros)) : 0.f;
+    writeResult();
+  }
+
+  if(!evaluation.finished && measuring && phase < 0)
+  {
+    phase = currentPhase;
+    poseWhenMeasuringStarted = theGroundTruthWorldState.ownPose;
+    timeWhenMeasuringStarted = theFrameInfo.time;
+    rotationWhileMeasuring = 0.f;
+    fellInPhase = false;
+  }
+
+  if(phase >= 0 && theFallDownState.state == FallDownState::upright)
+  {
+    sumOfSquaredGyros += theInertialData.gyro.head<2>().cast<float>().squaredNorm();
+    ++numOfGyros;
+  }
+
+  if(theFallDownState.state == FallDownState::fallen)
+    motionRequest.motion = MotionRequest::getUp;
+  else if(evaluation.finished || currentPhase < 0)
+    motionRequest.motion = MotionRequest::stand;
+  else
+  {
+    motionRequest.motion = MotionRequest::walk;
+    motionRequest.walkRequest.mode = WalkRequest::absoluteSpeedMode;
+    motionRequest.walkRequest.speed = speeds[currentPhase];
+    motionRequest.walkRequest.walkKickRequest = WalkRequest::WalkKickRequest();
+  }
+}
+
+void WalkEvaluator::finishPhase(const Pose2f& speed)
+{
+  const float duration = theFrameInfo.getTimeSince(timeWhenMeasuringStarted) * 0.001f;
+  if(fellInPhase || duration <= 0.f)
+    return;
+
+  // The speeds actually reached relative to the robot's pose when measuring started.
+  // The rotation is summed up over the frames, because the pose difference wraps
+  // around after half a turn.
+  const Pose2f offset = poseWhenMeasuringStarted.inverse() * theGroundTruthWorldState.ownPose;
+  float ratio;
+  if(speed.translation.squaredNorm() > 0.f)
+    ratio = offset.translation.dot(speed.translation) / (speed.translation.squaredNorm() * duration);
+  else if(speed.rotation != 0.f)
+    ratio = rotationWhileMeasuring / (speed.rotation * duration);
+  else
+    ratio = 1.f;
+  sumOfSpeedRatios += std::max(0.f, std::min(ratio, 1.5f));
+}
+
+void WalkEvaluator::writeResult() const
+{
+  if(resultFile.empty())
+    return;
+
+  // Write to a temporary file first, so the file is complete when it appears.
+  const std::string tempFile = resultFile + ".tmp";
+  {
+    OutMapFile stream(tempFile);
+    stream << evaluation;
+  }
+  std::rename(tempFile.c_str(), resultFile.c_str());
+}
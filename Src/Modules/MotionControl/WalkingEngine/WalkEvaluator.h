@@ -0,0 +1,73 @@
+/**
+ * @file WalkEvaluator.h
+ *
+ * This file declares a module that replaces the behavior in the simulator and
+ * walks with a sequence of speeds to rate the parameters of the walking engine.
+ * The rating is measured using the ground truth of the simulator and can be
+ * written to a file, which is how the walk optimizer receives it.
+ */
+
+#pragma once
+
+#include "Representations/Infrastructure/FrameInfo.h"
+#include "Representations/Infrastructure/GroundTruthWorldState.h"
+#include "Representations/MotionControl/MotionRequest.h"
+#include "Representations/MotionControl/WalkEvaluation.h"
+#include "Representations/Sensing/FallDownState.h"
+#include "Representations/Sensing/InertialData.h"
+#include "Tools/Module/Module.h"
+
+MODULE(WalkEvaluator,
+{,
+  REQUIRES(FallDownState),
+  REQUIRES(FrameInfo),
+  REQUIRES(GroundTruthWorldState),
+  REQUIRES(InertialData),
+  PROVIDES(MotionRequest),
+  PROVIDES(WalkEvaluation),
+  LOADS_PARAMETERS(
+  {,
+    (std::string) resultFile, /**< The evaluation is written to this file when it is finished. Nothing is written if empty. */
+    (int) standDuration, /**< How long to stand before the first phase (in ms). */
+    (int) phaseDuration, /**< How long each phase lasts (in ms). */
+    (int) settleDuration, /**< How long to wait in each phase before measuring (in ms). */
+    (std::vector<Pose2f>) speeds, /**< The absolute speed requested in each phase (in mm/s and radians/s). */
+  }),
+});
+
+class WalkEvaluator : public WalkEvaluatorBase
+{
+  WalkEvaluation evaluation; /**< The evaluation so far. */
+  unsigned timeWhenStarted = 0; /**< The time of the first frame. */
+  int phase = -1; /**< The phase in which measuring already started. */
+  Pose2f poseWhenMeasuringStarted; /**< The ground truth pose when measuring started in the current phase. */
+  unsigned timeWhenMeasuringStarted = 0; /**< The time when measuring started in the current phase. */
+  float rotationWhileMeasuring = 0.f; /**< The ground truth rotation in the current phase summed up frame by frame, so it does not wrap around. */
+  Angle lastRotation = 0_deg; /**< The ground truth rotation in the previous frame. */
+  bool fellInPhase = false; /**< Did the robot fall during the current phase? */
+  float sumOfSpeedRatios = 0.f; /**< The sum of the speed ratios of all phases finished. */
+  float sumOfSquaredGyros = 0.f; /**< The sum of the squared gyro measurements while measuring. */
+  int numOfGyros = 0; /**< The number of gyro measurements summed up. */
+  FallDownState::State lastFallDownState = FallDownState::upright; /**< The body state in the previous frame. */
+
+  /**
+   * This method is called when the representation provided needs to be updated.
+   * @param motionRequest The representation updated.
+   */
+  void update(MotionRequest& motionRequest) override;
+
+  /**
+   * This method is called when the representation provided needs to be updated.
+   * @param walkEvaluation The representation updated.
+   */
+  void update(WalkEvaluation& walkEvaluation) override {walkEvaluation = evaluation;}
+
+  /**
+   * Rates the phase that just ended.
+   * @param speed The speed that was requested during the phase.
+   */
+  void finishPhase(const Pose2f& speed);
+
+  /** Writes the evaluation to the result file. */
+  void writeResult() const;
+};
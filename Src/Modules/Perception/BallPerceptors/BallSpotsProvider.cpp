@@ -9,10 +9,14 @@
 #include "Tools/Math/Transformation.h"
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 void BallSpotsProvider::update(BallSpots& ballSpots)
 {
   DECLARE_DEBUG_DRAWING("module:BallSpotsProvider:scanLines", "drawingOnImage");
+  DECLARE_DEBUG_DRAWING("module:BallSpotsProvider:regionOfInterest", "drawingOnImage");
+  DECLARE_PLOT("module:BallSpotsProvider:numberOfSpots");
+  DECLARE_PLOT("module:BallSpotsProvider:fullSearch");
 
   ballSpots.ballSpots.clear();
 
@@ -32,10 +36,85 @@ void BallSpotsProvider::update(BallSpots& ballSpots)
     }
   }
 
-  searchScanLines(ballSpots);
+  // While the ball is tracked, only search around its predicted position.
+  // The whole image is searched regularly and if nothing was found where the ball was expected.
+  Boundaryi regionOfInterest;
+  bool fullSearch = true;
+  if(useRegionOfInterest && ++framesSinceFullSearch < fullSearchInterval && calcRegionOfInterest(regionOfInterest))
+  {
+    fullSearch = false;
+    if(!regionOfInterest.isEmpty())
+    {
+      RECTANGLE("module:BallSpotsProvider:regionOfInterest", regionOfInterest.x.min, regionOfInterest.y.min, regionOfInterest.x.max, regionOfInterest.y.max,
+                2, Drawings::solidPen, ColorRGBA::orange);
+      searchScanLines(ballSpots, regionOfInterest);
+      fullSearch = ballSpots.ballSpots.size() == (ballSpots.firstSpotIsPredicted ? 1u : 0u);
+    }
+  }
+
+  if(fullSearch)
+  {
+    searchScanLines(ballSpots, Boundaryi(Rangei(0, theCameraInfo.width - 1), Rangei(0, theCameraInfo.height - 1)));
+    framesSinceFullSearch = 0;
+  }
+
+  limitBallSpots(ballSpots);
+
+  PLOT("module:BallSpotsProvider:numberOfSpots", ballSpots.ballSpots.size());
+  PLOT("module:BallSpotsProvider:fullSearch", fullSearch ? 1 : 0);
 }
 
-void BallSpotsProvider::searchScanLines(BallSpots& ballSpots) const
+bool BallSpotsProvider::calcRegionOfInterest(Boundaryi& regionOfInterest) const
+{
+  if(theFrameInfo.getTimeSince(theWorldModelPrediction.timeWhenBallLastSeen) > maxTimeSinceBallSeen)
+    return false;
+
+  // The largest standard deviation of the predicted position determines the size of the area on the field.
+  const Matrix2f& covariance = theWorldModelPrediction.ballPositionCovariance;
+  const float trace = covariance.trace();
+  const float maxVariance = 0.5f * (trace + std::sqrt(std::max(0.f, sqr(trace) - 4.f * covariance.determinant())));
+  const float radius = std::max(minRegionOfInterestRadius, regionOfInterestDeviations * std::sqrt(maxVariance));
+
+  // Project the area into the image and enlarge it by the size of the ball there.
+  Boundaryf area(-std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+  float ballRadiusInImage = 0.f;
+  const Vector2f& center = theWorldModelPrediction.ballPosition;
+  for(const Vector2f& offset : {Vector2f(-radius, 0.f), Vector2f(radius, 0.f), Vector2f(0.f, -radius), Vector2f(0.f, radius)})
+  {
+    const Vector2f corner = center + offset;
+    Vector2f cornerInImage;
+    if(!Transformation::robotToImage(Vector3f(corner.x(), corner.y(), theBallSpecification.radius), theCameraMatrix, theCameraInfo, cornerInImage))
+      return false;
+    ballRadiusInImage = std::max(ballRadiusInImage, IISC::getImageBallRadiusByCenter(cornerInImage, theCameraInfo, theCameraMatrix, theBallSpecification));
+    area.add(theImageCoordinateSystem.fromCorrected(cornerInImage));
+  }
+
+  regionOfInterest = Boundaryi(Rangei(std::max(0, static_cast<int>(area.x.min - ballRadiusInImage)),
+                                      std::min(theCameraInfo.width - 1, static_cast<int>(area.x.max + ballRadiusInImage))),
+                               Rangei(std::max(0, static_cast<int>(area.y.min - ballRadiusInImage)),
+                                      std::min(theCameraInfo.height - 1, static_cast<int>(area.y.max + ballRadiusInImage))));
+  return true;
+}
+
+void BallSpotsProvider::limitBallSpots(BallSpots& ballSpots) const
+{
+  if(ballSpots.ballSpots.size() <= maxNumberOfBallSpots)
+    return;
+
+  if(ballSpots.firstSpotIsPredicted)
+  {
+    const Vector2i predicted = ballSpots.ballSpots.front();
+    std::sort(ballSpots.ballSpots.begin() + 1, ballSpots.ballSpots.end(), [&predicted](const Vector2i& a, const Vector2i& b)
+    {
+      return (a - predicted).squaredNorm() < (b - predicted).squaredNorm();
+    });
+  }
+  else
+    std::sort(ballSpots.ballSpots.begin(), ballSpots.ballSpots.end(), [](const Vector2i& a, const Vector2i& b) {return a.y() > b.y();});
+  ballSpots.ballSpots.resize(maxNumberOfBallSpots);
+}
+
+void BallSpotsProvider::searchScanLines(BallSpots& ballSpots, const Boundaryi& regionOfInterest) const
 {
   //todo body and fieldline
   const unsigned step = theColorScanLineRegionsVerticalClipped.lowResStep > 1 ? theColorScanLineRegionsVerticalClipped.lowResStep / 2 : 1;
@@ -44,10 +123,19 @@ void BallSpotsProvider::searchScanLines(BallSpots& ballSpots) const
 
   for(unsigned scanLineIndex = start; scanLineIndex < theColorScanLineRegionsVerticalClipped.scanLines.size(); scanLineIndex += step)
   {
+    if(!regionOfInterest.x.isInside(theColorScanLineRegionsVerticalClipped.scanLines[scanLineIndex].x))
+      continue;
+
     int lowestYOfCurrentArea = 0;
     int currentLengthNeeded = 0;
     for(const ScanLineRegion& region : theColorScanLineRegionsVerticalClipped.scanLines[scanLineIndex].regions)
     {
+      // Regions are ordered from bottom to top.
+      if(region.range.upper > regionOfInterest.y.max)
+        continue;
+      else if(region.range.lower <= regionOfInterest.y.min && currentLengthNeeded == 0)
+        break;
+
       if(!region.is(FieldColors::field))
       {
         if(currentLengthNeeded == 0)
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "Tools/Boundary.h"
 #include "Tools/Module/Module.h"
 #include "Representations/Configuration/BallSpecification.h"
 #include "Representations/Configuration/FieldDimensions.h"
@@ -54,6 +55,13 @@ MODULE(BallSpotsProvider,
     (bool)(true) blackPixelsAreNeutral, // Is a black-colored pixel neutral? (if not it is good)
 
     (bool)(false) allowScanLineTopSpotFitting, // Is it allowed to find a spot on top of a scanLine?
+
+    (bool)(true) useRegionOfInterest, //< Only search around the predicted ball position while the ball is tracked?
+    (int)(500) maxTimeSinceBallSeen, //< The ball is considered as tracked if it was seen within this time (in ms)
+    (unsigned)(10) fullSearchInterval, //< The whole image is searched at least every this many frames
+    (float)(2.f) regionOfInterestDeviations, //< The region of interest covers this many standard deviations of the predicted ball position
+    (float)(150.f) minRegionOfInterestRadius, //< The minimum radius of the region of interest on the field (in mm)
+    (unsigned)(12) maxNumberOfBallSpots, //< The maximum number of spots passed to the BallPerceptor, including the predicted one
   }),
 });
 
@@ -63,6 +71,8 @@ MODULE(BallSpotsProvider,
  */
 class BallSpotsProvider : public BallSpotsProviderBase
 {
+  unsigned framesSinceFullSearch = 0; /**< The number of frames since the whole image was searched. */
+
   /**
    * The main method of this module.
    * @param ballSpots The percept that is filled by this module.
@@ -75,8 +85,29 @@ class BallSpotsProvider : public BallSpotsProviderBase
    * check fails.
    *
    * @param ballSpots The percept that is filled by this module.
+   * @param regionOfInterest Only scan lines and regions inside this area are searched.
+   */
+  void searchScanLines(BallSpots& ballSpots, const Boundaryi& regionOfInterest) const;
+
+  /**
+   * The method calculates the area of the image in which the predicted ball
+   * should be found, i.e. the projection of the ball's position uncertainty.
+   *
+   * @param regionOfInterest The area in image coordinates. It is empty if the
+   *                         ball is not expected to be visible in this image.
+   * @return Can the search be restricted to the region of interest, i.e. is
+   *         the ball tracked and can its surrounding be projected into the image?
+   */
+  bool calcRegionOfInterest(Boundaryi& regionOfInterest) const;
+
+  /**
+   * The method limits the number of ball spots to maxNumberOfBallSpots. The
+   * spots closest to the predicted spot are kept, or the lowest ones in the
+   * image if there is no prediction.
+   *
+   * @param ballSpots The percept that is filled by this module.
    */
-  void searchScanLines(BallSpots& ballSpots) const;
+  void limitBallSpots(BallSpots& ballSpots) const;
 
   /**
    * The method scans in y-direction to adjust the initial spot guess.
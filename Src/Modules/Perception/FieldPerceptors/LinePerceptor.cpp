@@ -22,6 +22,12 @@ void LinePerceptor::update(LinesPercept& linesPercept)
   DECLARE_DEBUG_DRAWING("module:LinePerceptor:spots", "drawingOnImage");
   DECLARE_DEBUG_DRAWING("module:LinePerceptor:visited", "drawingOnImage");
   DECLARE_DEBUG_DRAWING("module:LinePerceptor:upLow", "drawingOnImage");
+
+  // Keep the previous percepts if the classified part of the image did not change.
+  reused = theImageChange.isUnchanged(theECImage.classifiedTop, theECImage.classifiedBottom);
+  if(reused)
+    return;
+
   linesPercept.lines.clear();
   circleCandidates.clear();
   if(doAdvancedWidthChecks)
@@ -44,6 +50,9 @@ void LinePerceptor::update(CirclePercept& circlePercept)
   DECLARE_DEBUG_DRAWING("module:LinePerceptor:circlePointField", "drawingOnField");
   DECLARE_DEBUG_DRAWING("module:LinePerceptor:circleCheckPointField", "drawingOnField");
 
+  if(reused)
+    return;
+
   circlePercept.wasSeen = false;
 
   // Find a valid center circle in the circle candidates
@@ -670,9 +679,9 @@ void LinePerceptor::trimLine(LinesPercept::Line& line) const
 
   if(start != line.firstImg || end != line.lastImg)
   {
-    std::vector<Vector2i> spotsInImgTrimmed;
+    FrameVector<Vector2i> spotsInImgTrimmed;
     spotsInImgTrimmed.reserve(line.spotsInImg.size());
-    std::vector<Vector2f> spotsInFieldTrimmed;
+    FrameVector<Vector2f> spotsInFieldTrimmed;
     spotsInFieldTrimmed.reserve(line.spotsInField.size());
     for(unsigned int i = 0; i < line.spotsInImg.size(); ++i)
     {
@@ -683,8 +692,8 @@ void LinePerceptor::trimLine(LinesPercept::Line& line) const
         spotsInFieldTrimmed.emplace_back(line.spotsInField.at(i));
       }
     }
-    line.spotsInImg = spotsInImgTrimmed;
-    line.spotsInField = spotsInFieldTrimmed;
+    line.spotsInImg.assign(spotsInImgTrimmed.begin(), spotsInImgTrimmed.end());
+    line.spotsInField.assign(spotsInFieldTrimmed.begin(), spotsInFieldTrimmed.end());
   }
 }
 
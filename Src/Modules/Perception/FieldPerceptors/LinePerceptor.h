@@ -15,11 +15,13 @@
 #include "Representations/Perception/ImagePreprocessing/CameraMatrix.h"
 #include "Representations/Perception/ImagePreprocessing/ECImage.h"
 #include "Representations/Perception/ImagePreprocessing/FieldBoundary.h"
+#include "Representations/Perception/ImagePreprocessing/ImageChange.h"
 #include "Representations/Perception/ImagePreprocessing/ImageCoordinateSystem.h"
 #include "Representations/Perception/ImagePreprocessing/ColorScanLineRegions.h"
 #include "Representations/Perception/FieldPercepts/LinesPercept.h"
 #include "Representations/Perception/FieldPercepts/CirclePercept.h"
 #include "Representations/Perception/ObstaclesPercepts/ObstaclesImagePercept.h"
+#include "Tools/FrameArena.h"
 #include "Tools/Math/LeastSquares.h"
 
 #include <vector>
@@ -34,6 +36,7 @@ MODULE(LinePerceptor,
   REQUIRES(FieldDimensions),
   REQUIRES(ColorScanLineRegionsVerticalClipped),
   REQUIRES(ColorScanLineRegionsHorizontal),
+  REQUIRES(ImageChange),
   REQUIRES(ImageCoordinateSystem),
   REQUIRES(ObstaclesImagePercept),
   PROVIDES(LinesPercept),
@@ -89,7 +92,7 @@ private:
   {
     Vector2f n0;
     float d;
-    std::vector<const Spot*> spots;
+    FrameVector<const Spot*> spots;
 
     inline Candidate(const Spot* anchor) : spots()
     {
@@ -126,7 +129,7 @@ private:
   {
     Vector2f center;
     float radius;
-    std::vector<Vector2f> fieldSpots;
+    FrameVector<Vector2f> fieldSpots;
     LeastSquares::CircleFitter fitter;
 
     inline CircleCandidate(const Candidate& line, const Vector2f& spot)
@@ -180,7 +183,7 @@ private:
   struct CircleCluster
   {
     Vector2f center;
-    std::vector<Vector2f> centers;
+    FrameVector<Vector2f> centers;
 
     inline CircleCluster(const Vector2f& center) : center(center) { centers.emplace_back(center); }
   };
@@ -190,6 +193,7 @@ private:
   std::vector<Candidate> candidates;
   std::vector<CircleCandidate, Eigen::aligned_allocator<CircleCandidate>> circleCandidates;
   std::vector<CircleCluster> clusters;
+  bool reused = false; /**< Were the percepts of the previous frame kept, because the image did not change? */
 
   /**
    * Updates the LinesPercept for the current frame.
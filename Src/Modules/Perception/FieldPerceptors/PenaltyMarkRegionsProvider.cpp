@@ -10,6 +10,7 @@
  */
 
 #include "PenaltyMarkRegionsProvider.h"
+#include "Tools/FrameArena.h"
 #include "Tools/ImageProcessing/InImageSizeCalculations.h"
 
 MAKE_MODULE(PenaltyMarkRegionsProvider, perception)
@@ -127,7 +128,7 @@ void PenaltyMarkRegionsProvider::unionFind(int xStep)
 
 void PenaltyMarkRegionsProvider::analyseRegions(unsigned short upperBound, int xStep, std::vector<Boundaryi>& searchRegions)
 {
-  std::vector<Region*> mergedRegions;
+  FrameVector<Region*> mergedRegions;
   mergedRegions.reserve(100);
   for(Region& region : regions)
     if(region.parent == &region)
@@ -153,7 +154,7 @@ void PenaltyMarkRegionsProvider::analyseRegions(unsigned short upperBound, int x
     int xExtent;
     int yExtent;
   } candidate;
-  std::vector<Candidate> candidates;
+  FrameVector<Candidate> candidates;
   for(Region* region : mergedRegions)
     if(region->upper >= upperBound && region->lower < lowerBound)
     {
@@ -5,6 +5,7 @@
  */
 
 #include "CNSRegionsProvider.h"
+#include "Tools/FrameArena.h"
 #include "Tools/ImageProcessing/InImageSizeCalculations.h"
 #include "Tools/Math/Transformation.h"
 #include "Tools/Math/BHMath.h"
@@ -33,7 +34,7 @@ void CNSRegionsProvider::update(BallRegions& ballRegions)
   }
   else
   {
-    std::vector<Vector2i> spots;
+    FrameVector<Vector2i> spots;
     bool predicted = false;
 
     std::memset(searchGrid[0], 0, sizeof(searchGrid));
@@ -5,8 +5,11 @@
  */
 
 #include "ECImageProvider.h"
+#include "Tools/Debugging/Debugging.h"
 #include "Tools/Global.h"
+#include "Tools/Math/Projection.h"
 #include <asmjit/asmjit.h>
+#include <algorithm>
 
 MAKE_MODULE(ECImageProvider, perception)
 
@@ -19,11 +22,13 @@ void ECImageProvider::update(ECImage& ecImage)
 
   if(theCameraImage.timestamp > 10 && static_cast<int>(theCameraImage.width) == theCameraInfo.width / 2)
   {
+    if(!eFunc)
+      compileE();
+
     if(disableClassification)
     {
-      if(!eFunc)
-        compileE();
       eFunc(theCameraInfo.width * theCameraInfo.height / 16, theCameraImage[0], ecImage.grayscaled[0]);
+      ecImage.classifiedTop = ecImage.classifiedBottom = 0;
     }
     else
     {
@@ -44,12 +49,112 @@ void ECImageProvider::update(ECImage& ecImage)
         for(size_t i = 0; i < 16; i++)
           currentFieldHueMax[i] = theFieldColors.fieldHue.max;
 
-      ecFunc(theCameraInfo.width * theCameraInfo.height / 16, theCameraImage[0], ecImage.grayscaled[0], ecImage.saturated[0], ecImage.hued[0], ecImage.colored[0]);
+      int top = 0;
+      int bottom = theCameraInfo.height;
+      if(clipToVisibleField)
+        calcClassifiedRows(top, bottom);
+
+      // Only the grayscaled image is computed for the rows outside of the band.
+      // The functions process 16 pixels per iteration and must not be called with 0 iterations.
+      if(top > 0)
+        eFunc(theCameraInfo.width * top / 16, theCameraImage[0], ecImage.grayscaled[0]);
+      if(bottom > top)
+        ecFunc(theCameraInfo.width * (bottom - top) / 16, theCameraImage[top], ecImage.grayscaled[top], ecImage.saturated[top], ecImage.hued[top], ecImage.colored[top]);
+      if(bottom < theCameraInfo.height)
+        eFunc(theCameraInfo.width * (theCameraInfo.height - bottom) / 16, theCameraImage[bottom], ecImage.grayscaled[bottom]);
+
+      ecImage.classifiedTop = top;
+      ecImage.classifiedBottom = bottom;
+      bool poison = false;
+      DEBUG_RESPONSE("module:ECImageProvider:poison")
+        poison = true;
+      fillUnclassifiedRows(ecImage, poison);
     }
     ecImage.timestamp = theCameraImage.timestamp;
   }
 }
 
+void ECImageProvider::calcClassifiedRows(int& top, int& bottom) const
+{
+  const int height = theCameraInfo.height;
+  const int width = theCameraInfo.width;
+  const int margin = static_cast<int>(clipMargin * static_cast<float>(height));
+
+  // Everything that is looked at in color is below the horizon, because the
+  // camera is higher than the ball and the field. Robots reach a little higher,
+  // which is covered by the margin.
+  if(theCameraMatrix.isValid)
+  {
+    const Geometry::Line horizon = Projection::calculateHorizon(theCameraMatrix, theCameraInfo);
+    if(horizon.direction.x() > 0.1f)
+    {
+      const float slope = horizon.direction.y() / horizon.direction.x();
+      const float yLeft = horizon.base.y() - horizon.base.x() * slope;
+      const float yRight = yLeft + static_cast<float>(width - 1) * slope;
+      top = std::max(0, std::min(height, static_cast<int>(std::floor(std::min(yLeft, yRight))) - margin));
+    }
+  }
+
+  // The contour is piecewise linear, so its lowest point is either at an end of
+  // one of its lines or at the image border.
+  int lowest = std::max(theBodyContour.getBottom(0, height - 1), theBodyContour.getBottom(width - 1, height - 1));
+  for(const BodyContour::Line& line : theBodyContour.lines)
+    for(const Vector2i& p : {line.p1, line.p2})
+      if(p.x() >= 0 && p.x() < width)
+        lowest = std::max(lowest, theBodyContour.getBottom(p.x(), height - 1));
+  bottom = std::max(top, std::min(height, lowest + 1 + margin));
+}
+
+void ECImageProvider::fillUnclassifiedRows(ECImage& ecImage, bool poison) const
+{
+  const size_t width = theCameraInfo.width;
+  for(const auto& [from, to] : {std::make_pair(0, ecImage.classifiedTop), std::make_pair(ecImage.classifiedBottom, theCameraInfo.height)})
+    if(to > from)
+    {
+      const size_t size = width * (to - from);
+      if(poison)
+      {
+        // Illegal reads will show up as white regions or spots.
+        std::fill(ecImage.colored[from], ecImage.colored[from] + size, FieldColors::white);
+        std::fill(ecImage.saturated[from], ecImage.saturated[from] + size, PixelTypes::GrayscaledPixel(255));
+        std::fill(ecImage.hued[from], ecImage.hued[from] + size, PixelTypes::HuePixel());
+      }
+      else
+        std::fill(ecImage.colored[from], ecImage.colored[from] + size, FieldColors::none);
+    }
+}
+
+void ECImageProvider::update(ColoredColumns& coloredColumns)
+{
+  const unsigned width = theECImage.colored.width;
+  const unsigned height = theECImage.colored.height;
+  coloredColumns.columns.setResolution(height, static_cast<unsigned>(theScanGrid.lines.size()));
+
+  // The regionizers only scan the grid rows below the field limit. When they
+  // look for an edge, they search upwards from a grid row for at most the
+  // distance to the grid row below it, so the rows above can be skipped.
+  int maxStep = 1;
+  for(size_t i = 1; i < theScanGrid.y.size(); ++i)
+    maxStep = std::max(maxStep, theScanGrid.y[i - 1] - theScanGrid.y[i]);
+  const unsigned firstRow = static_cast<unsigned>(std::max(0, theScanGrid.fieldLimit + 1 - maxStep));
+
+  // The rows are processed in blocks, so that the source rows of a block stay
+  // in the cache while the pixels of all columns are copied from them.
+  constexpr unsigned blockSize = 16;
+  for(unsigned yStart = firstRow; yStart < height; yStart += blockSize)
+    for(size_t i = 0; i < theScanGrid.lines.size(); ++i)
+    {
+      const ScanGrid::Line& line = theScanGrid.lines[i];
+      const unsigned yEnd = std::min(std::min(yStart + blockSize, height), static_cast<unsigned>(std::max(line.yMax, 0)));
+      const PixelTypes::ColoredPixel* src = &theECImage.colored[yStart][line.x];
+      PixelTypes::ColoredPixel* dest = coloredColumns.columns[i];
+      for(unsigned y = yStart; y < yEnd; ++y, src += width)
+        dest[y] = *src;
+    }
+
+  coloredColumns.timestamp = theECImage.timestamp;
+}
+
 using namespace asmjit;
 
 void ECImageProvider::compileE()
@@ -9,18 +9,29 @@
 #include "Representations/Configuration/FieldColors.h"
 #include "Representations/Infrastructure/CameraImage.h"
 #include "Representations/Infrastructure/CameraInfo.h"
+#include "Representations/Perception/ImagePreprocessing/BodyContour.h"
+#include "Representations/Perception/ImagePreprocessing/CameraMatrix.h"
+#include "Representations/Perception/ImagePreprocessing/ColoredColumns.h"
 #include "Representations/Perception/ImagePreprocessing/ECImage.h"
+#include "Representations/Perception/ImagePreprocessing/ScanGrid.h"
 #include "Tools/Module/Module.h"
 
 MODULE(ECImageProvider,
 {,
   REQUIRES(FieldColors),
+  REQUIRES(BodyContour),
   REQUIRES(CameraInfo),
   REQUIRES(CameraImage),
+  REQUIRES(CameraMatrix),
+  REQUIRES(ScanGrid),
   PROVIDES(ECImage),
+  REQUIRES(ECImage),
+  PROVIDES(ColoredColumns),
   LOADS_PARAMETERS(
   {,
     (bool) disableClassification,
+    (bool) clipToVisibleField, /**< Only classify the rows between the horizon and the lowest point of the body contour. */
+    (float) clipMargin, /**< Rows classified above the horizon and below the body contour (relative to the image height). */
   }),
 });
 
@@ -41,6 +52,32 @@ private:
   EFunc eFunc;
 
   void update(ECImage& ecImage) override;
+
+  /**
+   * Determines the rows that can contain anything the perception modules look
+   * at in color, i.e. the rows between the horizon and the lowest row not
+   * hidden by the robot's body (plus a margin).
+   * @param top The first row is returned here.
+   * @param bottom The row after the last one is returned here.
+   */
+  void calcClassifiedRows(int& top, int& bottom) const;
+
+  /**
+   * Fills the rows of the color planes that were not classified.
+   * @param ecImage The image the rows of which are filled.
+   * @param poison Fill them with values that make reads visible instead of
+   *               marking them as unclassified.
+   */
+  void fillUnclassifiedRows(ECImage& ecImage, bool poison) const;
+
+  /**
+   * Copies the columns of the color classified image that are scanned by the
+   * vertical scan lines into consecutive memory. Only the rows the regionizers
+   * can read are copied, i.e. the ones below the field limit of the ScanGrid
+   * and the step of the grid above it.
+   * @param coloredColumns The representation updated.
+   */
+  void update(ColoredColumns& coloredColumns) override;
   void compileE();
   void compileEC();
 
@@ -21,6 +21,10 @@ void FieldBoundaryProvider::update(FieldBoundary& theFieldBoundary)
 {
   DECLARE_DEBUG_DRAWING("module:FieldBoundaryProvider:spots", "drawingOnImage");
 
+  // Keep the previous boundary if the image did not change.
+  if(theImageChange.isUnchanged())
+    return;
+
   // Only with a valid camera matrix, the field boundary can be computed.
   if(theCameraMatrix.isValid)
   {
@@ -31,7 +35,7 @@ void FieldBoundaryProvider::update(FieldBoundary& theFieldBoundary)
       theFieldBoundary.isValid = false;
 
     // Find field boundary spots. These might also simply be the predicted ones.
-    std::vector<Spot> spots;
+    FrameVector<Spot> spots;
     spots.reserve(theColorScanLineRegionsVertical.scanLines.size());
     STOPWATCH("FieldBoundaryProvider:findSpots")
       findSpots(theFieldBoundary, spots);
@@ -40,7 +44,7 @@ void FieldBoundaryProvider::update(FieldBoundary& theFieldBoundary)
     // Otherwise, the predicted one is used instead.
     if(spots.size() >= minNumberOfSpots)
     {
-      std::vector<Spot> model;
+      FrameVector<Spot> model;
       model.reserve(3);
       STOPWATCH("FieldBoundaryProvider:calcBoundary")
         calcBoundary(spots, model);
@@ -77,7 +81,7 @@ void FieldBoundaryProvider::predict(FieldBoundary& fieldBoundary) const
   fieldBoundary.isValid = fieldBoundary.boundaryInImage.size() > 1;
 }
 
-void FieldBoundaryProvider::findSpots(const FieldBoundary& fieldBoundary, std::vector<Spot>& spots) const
+void FieldBoundaryProvider::findSpots(const FieldBoundary& fieldBoundary, FrameVector<Spot>& spots) const
 {
   for(const ColorScanLineRegionsVertical::ScanLine& scanLine : theColorScanLineRegionsVertical.scanLines)
   {
@@ -126,7 +130,7 @@ void FieldBoundaryProvider::findSpots(const FieldBoundary& fieldBoundary, std::v
   }
 }
 
-void FieldBoundaryProvider::calcBoundary(const std::vector<Spot>& spots, std::vector<Spot>& model) const
+void FieldBoundaryProvider::calcBoundary(const FrameVector<Spot>& spots, FrameVector<Spot>& model) const
 {
   int minError = std::numeric_limits<int>::max();
   const int goodEnough = static_cast<int>(maxSquaredError * spots.size() * acceptanceRatio);
@@ -204,7 +208,7 @@ void FieldBoundaryProvider::calcBoundary(const std::vector<Spot>& spots, std::ve
   }
 }
 
-void FieldBoundaryProvider::fillRepresentation(const std::vector<Spot>& model, FieldBoundary& fieldBoundary) const
+void FieldBoundaryProvider::fillRepresentation(const FrameVector<Spot>& model, FieldBoundary& fieldBoundary) const
 {
   fieldBoundary.boundaryInImage.clear();
   fieldBoundary.boundaryOnField.clear();
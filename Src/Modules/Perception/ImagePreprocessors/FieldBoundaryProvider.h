@@ -15,7 +15,9 @@
 #include "Representations/Perception/ImagePreprocessing/CameraMatrix.h"
 #include "Representations/Perception/ImagePreprocessing/ColorScanLineRegions.h"
 #include "Representations/Perception/ImagePreprocessing/FieldBoundary.h"
+#include "Representations/Perception/ImagePreprocessing/ImageChange.h"
 #include "Representations/Perception/ImagePreprocessing/ImageCoordinateSystem.h"
+#include "Tools/FrameArena.h"
 #include "Tools/Module/Module.h"
 
 MODULE(FieldBoundaryProvider,
@@ -23,6 +25,7 @@ MODULE(FieldBoundaryProvider,
   REQUIRES(CameraInfo),
   REQUIRES(CameraMatrix),
   REQUIRES(ColorScanLineRegionsVertical),
+  REQUIRES(ImageChange),
   REQUIRES(ImageCoordinateSystem),
   REQUIRES(Odometer),
   REQUIRES(OtherFieldBoundary),
@@ -69,7 +72,7 @@ class FieldBoundaryProvider : public FieldBoundaryProviderBase
    *                      determine spots instead of searching them in the image.
    * @param spots The spots found are returned here.
    */
-  void findSpots(const FieldBoundary& fieldBoundary, std::vector<Spot>& spots) const;
+  void findSpots(const FieldBoundary& fieldBoundary, FrameVector<Spot>& spots) const;
 
   /**
    * Return a weighted, squared, and saturated error between boundary spots and a
@@ -89,12 +92,12 @@ class FieldBoundaryProvider : public FieldBoundaryProviderBase
    * @param spots The boundary spots that are sampled.
    * @param model A model of two or three spots describing the single or two lines.
    */
-  void calcBoundary(const std::vector<Spot>& spots, std::vector<Spot>& model) const;
+  void calcBoundary(const FrameVector<Spot>& spots, FrameVector<Spot>& model) const;
 
   /**
    * Fills the representation.
    * @param model The model found.
    * @param fieldBoundary The field boundary that is filled.
    */
-  void fillRepresentation(const std::vector<Spot>& model, FieldBoundary& fieldBoundary) const;
+  void fillRepresentation(const FrameVector<Spot>& model, FieldBoundary& fieldBoundary) const;
 };
@@ -0,0 +1,102 @@
+/**
+ * @file ImageChangeDetector.cpp
+ *
+ * This file implements a module that detects which tiles of the camera image
+ * changed since they were processed the last time.
+ */
+
+#include "ImageChangeDetector.h"
+#include "Tools/ImageProcessing/SIMD.h"
+#include <algorithm>
+#include <cstring>
+
+MAKE_MODULE(ImageChangeDetector, perception)
+
+void ImageChangeDetector::update(ImageChange& imageChange)
+{
+  const int width = theCameraInfo.width;
+  const int height = theCameraInfo.height;
+  const int rowBytes = width * 2; // YUYV
+  const int tileBytes = imageChange.tileSize * 2;
+  const int rows = (height + rowStep - 1) / rowStep;
+  imageChange.tilesPerRow = width / imageChange.tileSize;
+  imageChange.tilesPerColumn = (height + imageChange.tileSize - 1) / imageChange.tileSize;
+  const size_t numOfTiles = imageChange.tilesPerRow * imageChange.tilesPerColumn;
+  imageChange.changed.resize(numOfTiles);
+  imageChange.timestamp = theCameraImage.timestamp;
+
+  if(static_cast<int>(theCameraImage.width) * 2 != width || static_cast<int>(theCameraImage.height) != height
+     || width % imageChange.tileSize != 0 || tileBytes % 16 != 0)
+  {
+    // Nothing can be said about an image that does not fit.
+    reference.clear();
+    imageChange.cameraMoved = true;
+    imageChange.unchangedFrames = 0;
+    return;
+  }
+
+  imageChange.cameraMoved = cameraMoved();
+  prevCameraMatrix = theCameraMatrix;
+
+  // Without a reference, or if the camera moved, everything is considered as changed.
+  if(imageChange.cameraMoved || reference.size() != static_cast<size_t>(rows * rowBytes))
+  {
+    reference.resize(rows * rowBytes);
+    for(int y = 0, row = 0; y < height; y += rowStep, ++row)
+      std::memcpy(&reference[row * rowBytes], theCameraImage[y], rowBytes);
+    std::fill(imageChange.changed.begin(), imageChange.changed.end(), 1);
+    imageChange.cameraMoved = true;
+    imageChange.unchangedFrames = 0;
+    return;
+  }
+
+  // Sum up the absolute differences per tile.
+  differences.assign(numOfTiles, 0);
+  std::vector<int> comparedRows(imageChange.tilesPerColumn, 0);
+  for(int y = 0, row = 0; y < height; y += rowStep, ++row)
+  {
+    const __m128i* current = reinterpret_cast<const __m128i*>(theCameraImage[y]);
+    const __m128i* previous = reinterpret_cast<const __m128i*>(&reference[row * rowBytes]);
+    unsigned* difference = &differences[(y / imageChange.tileSize) * imageChange.tilesPerRow];
+    ++comparedRows[y / imageChange.tileSize];
+    for(int tile = 0; tile < imageChange.tilesPerRow; ++tile, ++difference)
+    {
+      __m128i sum = _mm_setzero_si128();
+      for(int i = 0; i < tileBytes / 16; ++i)
+        sum = _mm_add_epi64(sum, _mm_sad_epu8(_mm_loadu_si128(current++), _mm_loadu_si128(previous++)));
+      *difference += static_cast<unsigned>(_mm_cvtsi128_si32(sum) + _mm_cvtsi128_si32(_mm_srli_si128(sum, 8)));
+    }
+  }
+
+  // Mark changed tiles and make their current version the new reference.
+  bool anyChanged = false;
+  for(int tileY = 0; tileY < imageChange.tilesPerColumn; ++tileY)
+    for(int tileX = 0; tileX < imageChange.tilesPerRow; ++tileX)
+    {
+      const size_t index = tileY * imageChange.tilesPerRow + tileX;
+      const bool changed = static_cast<float>(differences[index]) > maxMeanDifference * static_cast<float>(comparedRows[tileY] * tileBytes);
+      imageChange.changed[index] = changed ? 1 : 0;
+      if(changed)
+      {
+        anyChanged = true;
+        const int yEnd = std::min(height, (tileY + 1) * imageChange.tileSize);
+        for(int y = (tileY * imageChange.tileSize + rowStep - 1) / rowStep * rowStep; y < yEnd; y += rowStep)
+          std::memcpy(&reference[(y / rowStep) * rowBytes + tileX * tileBytes],
+                      reinterpret_cast<const unsigned char*>(theCameraImage[y]) + tileX * tileBytes, tileBytes);
+      }
+    }
+
+  imageChange.unchangedFrames = anyChanged ? 0 : imageChange.unchangedFrames + 1;
+}
+
+bool ImageChangeDetector::cameraMoved() const
+{
+  if(!theCameraMatrix.isValid)
+    return true;
+
+  const Pose3f offset = prevCameraMatrix.inverse() * theCameraMatrix;
+  return offset.translation.norm() > maxCameraTranslation
+         || offset.rotation.getAngleAxis().angle() > maxCameraRotation
+         || theOdometer.odometryOffset.translation.norm() > maxOdometryTranslation
+         || std::abs(theOdometer.odometryOffset.rotation) > maxOdometryRotation;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file ImageChangeDetector.h
+ *
+ * This file declares a module that detects which tiles of the camera image
+ * changed since they were processed the last time. Each tile is compared to
+ * the version of itself that was current when it changed the last time, so
+ * slow changes accumulate until they are detected. A movement of the camera
+ * relative to the field (from the camera matrix or odometry) marks the whole
+ * image as changed.
+ */
+
+#pragma once
+
+#include "Representations/Infrastructure/CameraImage.h"
+#include "Representations/Infrastructure/CameraInfo.h"
+#include "Representations/Modeling/Odometer.h"
+#include "Representations/Perception/ImagePreprocessing/CameraMatrix.h"
+#include "Representations/Perception/ImagePreprocessing/ImageChange.h"
+#include "Tools/Math/Angle.h"
+#include "Tools/Module/Module.h"
+#include <vector>
+
+MODULE(ImageChangeDetector,
+{,
+  REQUIRES(CameraImage),
+  REQUIRES(CameraInfo),
+  REQUIRES(CameraMatrix),
+  REQUIRES(Odometer),
+  PROVIDES(ImageChange),
+  DEFINES_PARAMETERS(
+  {,
+    (int)(4) rowStep, /**< Only every n-th row of the image is compared. */
+    (float)(6.f) maxMeanDifference, /**< The mean absolute difference per Y, U or V value up to which a tile is considered as unchanged. */
+    (float)(2.f) maxCameraTranslation, /**< The camera is considered as moved if its position relative to the robot changed by more than this (in mm). */
+    (Angle)(0.2_deg) maxCameraRotation, /**< The camera is considered as moved if its orientation relative to the robot changed by more than this. */
+    (float)(1.f) maxOdometryTranslation, /**< The camera is considered as moved if the robot moved by more than this (in mm). */
+    (Angle)(0.1_deg) maxOdometryRotation, /**< The camera is considered as moved if the robot turned by more than this. */
+  }),
+});
+
+class ImageChangeDetector : public ImageChangeDetectorBase
+{
+  std::vector<unsigned char> reference; /**< The compared rows of the image as they were when each tile changed the last time. */
+  std::vector<unsigned> differences; /**< The sum of absolute differences per tile. */
+  Pose3f prevCameraMatrix; /**< The camera matrix of the previous image. */
+
+  /**
+   * This method is called when the representation provided needs to be updated.
+   * @param imageChange The representation updated.
+   */
+  void update(ImageChange& imageChange) override;
+
+  /**
+   * Did the camera move relative to the field since the previous image?
+   * @return Did it move?
+   */
+  bool cameraMoved() const;
+};
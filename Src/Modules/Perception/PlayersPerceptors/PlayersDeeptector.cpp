@@ -734,7 +734,7 @@ std::function<bool(int, int)> PlayersDeeptector::getPixelClassifier(const int te
   else if(otherColor == TEAM_WHITE || otherColor == TEAM_BLACK || otherColor == TEAM_GRAY)
     return [this, teamHue](const int x, const int y)
     {
-      return theECImage.colored[y][x] == FieldColors::none
+      return theECImage.isClassified(y) && theECImage.colored[y][x] == FieldColors::none
              && std::abs(static_cast<char>(theECImage.hued[y][x] - teamHue)) <= hueSimilarityThreshold;
     };
 
@@ -742,7 +742,7 @@ std::function<bool(int, int)> PlayersDeeptector::getPixelClassifier(const int te
   else
     return [this, teamHue, otherHue](const int x, const int y)
     {
-      if(theECImage.colored[y][x] == FieldColors::none)
+      if(theECImage.isClassified(y) && theECImage.colored[y][x] == FieldColors::none)
       {
         const int hue = theECImage.hued[y][x];
         // Casting to char should resolve the wraparound cases.
@@ -3,32 +3,49 @@
  */
 
 #include "ColorScanLineRegionizer.h"
+#include "Tools/Debugging/Debugging.h"
+#include "Tools/ImageProcessing/RunBoundaries.h"
+#include <algorithm>
 
 MAKE_MODULE(ColorScanLineRegionizer, perception)
 
 void ColorScanLineRegionizer::update(ColorScanLineRegionsVertical& colorScanLineRegionsVertical)
 {
-  colorScanLineRegionsVertical.scanLines.clear();
-  colorScanLineRegionsVertical.scanLines.reserve((theScanGrid.lines.size() + theScanGrid.lowResStep - theScanGrid.lowResStart - 1) / theScanGrid.lowResStep);
   colorScanLineRegionsVertical.lowResStart = 0;
   colorScanLineRegionsVertical.lowResStep = 1;
 
-  if(theScanGrid.lines.empty())
-    return;
-
+  // The scan lines of the previous frame are reused, so their regions do not have to be allocated again.
+  std::vector<ColorScanLineRegionsVertical::ScanLine>& scanLines = colorScanLineRegionsVertical.scanLines;
+  size_t numOfScanLines = 0;
   for(size_t i = theScanGrid.lowResStart; i < theScanGrid.lines.size(); i += theScanGrid.lowResStep)
   {
-    colorScanLineRegionsVertical.scanLines.emplace_back(static_cast<unsigned short>(theScanGrid.lines[i].x));
-    scanVertical(theScanGrid.lines[i], theScanGrid.fieldLimit, colorScanLineRegionsVertical.scanLines.back().regions);
+    if(numOfScanLines == scanLines.size())
+      scanLines.emplace_back(static_cast<unsigned short>(theScanGrid.lines[i].x));
+    ColorScanLineRegionsVertical::ScanLine& scanLine = scanLines[numOfScanLines++];
+    scanLine.x = static_cast<unsigned short>(theScanGrid.lines[i].x);
+    scanLine.regions.clear();
+    int stride;
+    const FieldColors::Color* column = getColumn(i, stride);
+    scanVertical(theScanGrid.lines[i], column, stride, theScanGrid.fieldLimit, scanLine.regions);
   }
+  scanLines.resize(numOfScanLines);
 }
 
 void ColorScanLineRegionizer::update(ColorScanLineRegionsHorizontal& colorScanLineRegionsHorizontal)
 {
-  colorScanLineRegionsHorizontal.scanLines.clear();
+  // The scan lines of the previous frame are reused, so their regions do not have to be allocated again.
+  std::vector<ColorScanLineRegionsHorizontal::ScanLine>& scanLines = colorScanLineRegionsHorizontal.scanLines;
+  size_t numOfScanLines = 0;
 
   if(theScanGrid.lines.empty())
+  {
+    scanLines.clear();
     return;
+  }
+
+  bool verify = false;
+  DEBUG_RESPONSE("module:ColorScanLineRegionizer:verifyHorizontal")
+    verify = true;
 
   int prevY = theECImage.colored.height + minHorizontalScanLineDistance * theECImage.colored.height / 320;
   for(const int y : theScanGrid.y)
@@ -39,85 +56,56 @@ void ColorScanLineRegionizer::update(ColorScanLineRegionsHorizontal& colorScanLi
     }
     prevY = y;
 
-    colorScanLineRegionsHorizontal.scanLines.emplace_back(y);
-    ColorScanLineRegionsHorizontal::ScanLine& scanLine = colorScanLineRegionsHorizontal.scanLines.back();
+    if(numOfScanLines == scanLines.size())
+      scanLines.emplace_back(y);
+    ColorScanLineRegionsHorizontal::ScanLine& scanLine = scanLines[numOfScanLines++];
+    scanLine.y = static_cast<unsigned short>(y);
+    scanLine.regions.clear();
+    RunBoundaries::findSSE(reinterpret_cast<const unsigned char*>(theECImage.colored[y]), 0, theECImage.colored.width, boundaries);
+    RunBoundaries::scanHorizontal(theECImage.colored[y], y, theScanGrid, minHorizontalRegionSize, boundaries, scanLine.regions);
 
-    FieldColors::Color curColor = FieldColors::Color::none;
-    unsigned short count = 0;
-    int x = 0;
-
-    for(size_t i = theScanGrid.lowResStart; i < theScanGrid.lines.size(); i += theScanGrid.lowResStep)
+    if(verify)
     {
-      const ScanGrid::Line& line = theScanGrid.lines[i];
-      if(line.yMax >= y)
-      {
-        if(count == 0)
-        {
-          x = line.x;
-          count = 1;
-          curColor = theECImage.colored[y][x];
-        }
-        else
-        {
-          while(x < line.x)
-          {
-            x++;
-            const FieldColors::Color color = theECImage.colored[y][x];
-            if(color != curColor)
-            {
-              if(count >= minHorizontalRegionSize)
-              {
-                scanLine.regions.emplace_back(x - count, x, curColor);
-                count = 1;
-              }
-              else if(!scanLine.regions.empty())
-              {
-                count /= 2;
-                scanLine.regions.back().range.right += count;
-              }
-              curColor = color;
-            }
-            else
-            {
-              count++;
-            }
-          }
-        }
-      }
-      else if(count != 0)
-      {
-        if(count >= minHorizontalRegionSize)
-          scanLine.regions.emplace_back(x - count, x, curColor);
-        else if(!scanLine.regions.empty())
-          scanLine.regions.back().range.right += count;
-        count = 0;
-      }
+      std::vector<ScanLineRegion> regions;
+      RunBoundaries::scanHorizontalScalar(theECImage.colored[y], y, theScanGrid, minHorizontalRegionSize, regions);
+      if(regions.size() != scanLine.regions.size()
+         || !std::equal(regions.begin(), regions.end(), scanLine.regions.begin(), [](const ScanLineRegion& a, const ScanLineRegion& b)
+                        {
+                          return a.range.left == b.range.left && a.range.right == b.range.right && a.color == b.color;
+                        }))
+        OUTPUT_WARNING("ColorScanLineRegionizer: horizontal scan line " << y << " differs from the scalar implementation");
     }
+  }
+  scanLines.resize(numOfScanLines);
+}
 
-    if(count != 0)
-    {
-      if(count >= minHorizontalRegionSize)
-        scanLine.regions.emplace_back(x - count, x, curColor);
-      else if(!scanLine.regions.empty())
-        scanLine.regions.back().range.right += count;
-    }
+const FieldColors::Color* ColorScanLineRegionizer::getColumn(size_t index, int& stride) const
+{
+  if(theColoredColumns.isValid(theECImage.timestamp, theScanGrid.lines.size()))
+  {
+    stride = 1;
+    return theColoredColumns[index];
+  }
+  else
+  {
+    stride = theECImage.colored.width;
+    return &theECImage.colored[0][theScanGrid.lines[index].x];
   }
 }
 
-void ColorScanLineRegionizer::scanVertical(const ScanGrid::Line& line, const int top, std::vector<ScanLineRegion>& regions) const
+void ColorScanLineRegionizer::scanVertical(const ScanGrid::Line& line, const FieldColors::Color* column, const int stride, const int top, std::vector<ScanLineRegion>& regions) const
 {
   auto y = theScanGrid.y.begin() + line.yMaxIndex;
   const auto yEnd = theScanGrid.y.end();
-  const int width = theECImage.colored.width;
   if(y != yEnd && *y > top && line.yMax - 1 > top)
   {
     int prevY = line.yMax - 1 > *y ? line.yMax - 1 : *y++;
     int currentY = prevY + 1;
-    const FieldColors::Color* pImg = &theECImage.colored[prevY][line.x];
+    const FieldColors::Color* pImg = column + prevY * stride;
     FieldColors::Color currentColor = *pImg;
     for(; y != yEnd && *y > top; ++y)
     {
-      pImg += (*y - prevY) * width;
+      pImg += (*y - prevY) * stride;
 
       // If color changes, determine edge position between last and current scanpoint
       const FieldColors::Color& color = *pImg;
@@ -127,7 +115,7 @@ void ColorScanLineRegionizer::scanVertical(const ScanGrid::Line& line, const int
         const int yMin = std::max(*y - otherColorThreshold + 1, 0);
         int counter = 0;
         int yy = std::min(prevY - 1, line.yMax - 1);
-        for(const FieldColors::Color* pImg2 = pImg + (yy - *y) * width; yy >= yMin && counter < otherColorThreshold; --yy, pImg2 -= width)
+        for(const FieldColors::Color* pImg2 = pImg + (yy - *y) * stride; yy >= yMin && counter < otherColorThreshold; --yy, pImg2 -= stride)
           if(*pImg2 != currentColor)
             ++counter;
           else
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "Tools/Module/Module.h"
+#include "Representations/Perception/ImagePreprocessing/ColoredColumns.h"
 #include "Representations/Perception/ImagePreprocessing/ECImage.h"
 #include "Representations/Perception/ImagePreprocessing/ScanGrid.h"
 #include "Representations/Perception/ImagePreprocessing/ColorScanLineRegions.h"
@@ -13,6 +14,7 @@
 
 MODULE(ColorScanLineRegionizer,
 {,
+  REQUIRES(ColoredColumns),
   REQUIRES(ECImage),
   REQUIRES(ScanGrid),
   PROVIDES(ColorScanLineRegionsVertical),
@@ -29,8 +31,18 @@ MODULE(ColorScanLineRegionizer,
 class ColorScanLineRegionizer : public ColorScanLineRegionizerBase
 {
 private:
+  std::vector<unsigned short> boundaries; /**< The color changes in the current horizontal scan line. */
+
   void update(ColorScanLineRegionsVertical& colorScanLineRegionsVertical) override;
   void update(ColorScanLineRegionsHorizontal& colorScanLineRegionsHorizontal) override;
 
-  void scanVertical(const ScanGrid::Line& line, const int top, std::vector<ScanLineRegion>& regions) const;
+  /**
+   * Returns the pixels of a vertical scan line.
+   * @param index The index of the scan line in the ScanGrid.
+   * @param stride Is set to the distance between the pixels of two consecutive rows.
+   * @return The pixel of the scan line in image row 0.
+   */
+  const FieldColors::Color* getColumn(size_t index, int& stride) const;
+
+  void scanVertical(const ScanGrid::Line& line, const FieldColors::Color* column, const int stride, const int top, std::vector<ScanLineRegion>& regions) const;
 };
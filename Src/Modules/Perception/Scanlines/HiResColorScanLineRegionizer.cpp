@@ -17,8 +17,9 @@ void HiResColorScanLineRegionizer::update(ColorScanLineRegionsVerticalClipped& c
     return;
 
   auto loRes = theColorScanLineRegionsVertical.scanLines.cbegin();
-  for(const ScanGrid::Line& line : theScanGrid.lines)
+  for(size_t i = 0; i < theScanGrid.lines.size(); ++i)
   {
+    const ScanGrid::Line& line = theScanGrid.lines[i];
     colorScanLineRegionsVerticalClipped.scanLines.emplace_back(static_cast<unsigned short>(line.x));
     std::vector<ScanLineRegion>& regions = colorScanLineRegionsVerticalClipped.scanLines.back().regions;
 
@@ -34,25 +35,40 @@ void HiResColorScanLineRegionizer::update(ColorScanLineRegionsVerticalClipped& c
     }
     else
     {
-      scanVertical(line, yBoundary, regions);
+      int stride;
+      const FieldColors::Color* column = getColumn(i, stride);
+      scanVertical(line, column, stride, yBoundary, regions);
     }
   }
 }
 
-void HiResColorScanLineRegionizer::scanVertical(const ScanGrid::Line& line, const int top, std::vector<ScanLineRegion>& regions) const
+const FieldColors::Color* HiResColorScanLineRegionizer::getColumn(size_t index, int& stride) const
+{
+  if(theColoredColumns.isValid(theECImage.timestamp, theScanGrid.lines.size()))
+  {
+    stride = 1;
+    return theColoredColumns[index];
+  }
+  else
+  {
+    stride = theECImage.colored.width;
+    return &theECImage.colored[0][theScanGrid.lines[index].x];
+  }
+}
+
+void HiResColorScanLineRegionizer::scanVertical(const ScanGrid::Line& line, const FieldColors::Color* column, const int stride, const int top, std::vector<ScanLineRegion>& regions) const
 {
   auto y = theScanGrid.y.begin() + line.yMaxIndex;
   const auto yEnd = theScanGrid.y.end();
-  const int width = theECImage.colored.width;
   if(y != yEnd && *y >= top && line.yMax - 1 > top)
   {
     int prevY = line.yMax - 1 > *y ? line.yMax - 1 : *y++;
     int currentY = prevY + 1;
-    const FieldColors::Color* pImg = &theECImage.colored[prevY][line.x];
+    const FieldColors::Color* pImg = column + prevY * stride;
     FieldColors::Color currentColor = *pImg;
     for(; y != yEnd && *y > top; ++y)
     {
-      pImg += (*y - prevY) * width;
+      pImg += (*y - prevY) * stride;
 
       // If color changes, determine edge position between last and current scanpoint
       const FieldColors::Color& color = *pImg;
@@ -62,7 +78,7 @@ void HiResColorScanLineRegionizer::scanVertical(const ScanGrid::Line& line, cons
         const int yMin = std::max(*y - otherColorThreshold + 1, 0);
         int counter = 0;
         int yy = std::min(prevY - 1, line.yMax - 1);
-        for(const FieldColors::Color* pImg2 = pImg + (yy - *y) * width; yy >= yMin && counter < otherColorThreshold; --yy, pImg2 -= width)
+        for(const FieldColors::Color* pImg2 = pImg + (yy - *y) * stride; yy >= yMin && counter < otherColorThreshold; --yy, pImg2 -= stride)
           if(*pImg2 != currentColor)
             ++counter;
           else
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "Tools/Module/Module.h"
+#include "Representations/Perception/ImagePreprocessing/ColoredColumns.h"
 #include "Representations/Perception/ImagePreprocessing/ECImage.h"
 #include "Representations/Perception/ImagePreprocessing/FieldBoundary.h"
 #include "Representations/Perception/ImagePreprocessing/ScanGrid.h"
@@ -14,6 +15,7 @@
 
 MODULE(HiResColorScanLineRegionizer,
 {,
+  REQUIRES(ColoredColumns),
   REQUIRES(ECImage),
   REQUIRES(FieldBoundary),
   REQUIRES(ColorScanLineRegionsVertical),
@@ -32,5 +34,13 @@ class HiResColorScanLineRegionizer : public HiResColorScanLineRegionizerBase
 private:
   void update(ColorScanLineRegionsVerticalClipped& colorScanLineRegionsVerticalClipped) override;
 
-  void scanVertical(const ScanGrid::Line& line, const int top, std::vector<ScanLineRegion>& regions) const;
+  /**
+   * Returns the pixels of a vertical scan line.
+   * @param index The index of the scan line in the ScanGrid.
+   * @param stride Is set to the distance between the pixels of two consecutive rows.
+   * @return The pixel of the scan line in image row 0.
+   */
+  const FieldColors::Color* getColumn(size_t index, int& stride) const;
+
+  void scanVertical(const ScanGrid::Line& line, const FieldColors::Color* column, const int stride, const int top, std::vector<ScanLineRegion>& regions) const;
 };
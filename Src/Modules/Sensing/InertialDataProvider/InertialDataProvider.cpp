@@ -143,13 +143,13 @@ void InertialDataProvider::processGyroscope(const Vector3a& gyro)
 
 void InertialDataProvider::filterAcc(InertialData& id)
 {
-  auto dynamicModel = [](Vector3f& state) {};
-  auto measurementModel = [&](const Vector3f& state)
+  auto dynamicModel = [](UKF<3>::SigmaMatrix<3>& states) {};
+  auto measurementModel = [](const UKF<3>::SigmaMatrix<3>& states)
   {
-    return state;
+    return states;
   };
-  filteredAccUKF.predict(dynamicModel, accDynamicFilterDeviation.asDiagonal());
-  filteredAccUKF.update<3>(id.acc, measurementModel, accDeviation.asDiagonal());
+  filteredAccUKF.predictAll(dynamicModel, accDynamicFilterDeviation.asDiagonal());
+  filteredAccUKF.updateAll<3>(id.acc, measurementModel, accDeviation.asDiagonal());
 
   id.filteredAcc = filteredAccUKF.mean;
 }
@@ -0,0 +1,33 @@
+/**
+ * @file KinematicsProvider.cpp
+ *
+ * This file implements a module that provides memoized forward kinematics to
+ * the modules of the Motion thread.
+ */
+
+#include "KinematicsProvider.h"
+#include "Tools/Debugging/DebugDrawings.h"
+
+MAKE_MODULE(KinematicsProvider, sensing)
+
+void KinematicsProvider::update(Kinematics& kinematics)
+{
+  const KinematicsCache::Statistics& statistics = cache.getStatistics();
+  kinematics.modelsRequested = statistics.models;
+  kinematics.modelsComputed = statistics.models - statistics.modelsReused;
+  kinematics.chainsComputed = statistics.chains - statistics.chainsReused;
+  DECLARE_PLOT("module:KinematicsProvider:modelsComputed");
+  DECLARE_PLOT("module:KinematicsProvider:chainsComputed");
+  PLOT("module:KinematicsProvider:modelsComputed", kinematics.modelsComputed);
+  PLOT("module:KinematicsProvider:chainsComputed", kinematics.chainsComputed);
+
+  cache.reset(theRobotDimensions, theMassCalibration);
+  kinematics.getRobotModel = [this](const JointAngles& jointAngles) -> RobotModel
+  {
+    return cache.getRobotModel(jointAngles);
+  };
+  kinematics.getLegJacobian = [this](Legs::Leg leg, const JointAngles& jointAngles) -> Matrix6f
+  {
+    return cache.getLegJacobian(leg, jointAngles);
+  };
+}
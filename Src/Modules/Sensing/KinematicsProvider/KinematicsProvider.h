@@ -0,0 +1,32 @@
+/**
+ * @file KinematicsProvider.h
+ *
+ * This file declares a module that provides memoized forward kinematics to
+ * the modules of the Motion thread.
+ */
+
+#pragma once
+
+#include "Representations/Configuration/MassCalibration.h"
+#include "Representations/Configuration/RobotDimensions.h"
+#include "Representations/Sensing/Kinematics.h"
+#include "Tools/Module/Module.h"
+#include "Tools/Motion/KinematicsCache.h"
+
+MODULE(KinematicsProvider,
+{,
+  REQUIRES(MassCalibration),
+  REQUIRES(RobotDimensions),
+  PROVIDES(Kinematics),
+});
+
+class KinematicsProvider : public KinematicsProviderBase
+{
+  KinematicsCache cache; /**< The results computed in the current frame. */
+
+  /**
+   * Empties the cache and provides access to it.
+   * @param kinematics The representation updated.
+   */
+  void update(Kinematics& kinematics) override;
+};
@@ -13,7 +13,7 @@ MAKE_MODULE(RobotModelProvider, sensing)
 
 void RobotModelProvider::update(RobotModel& robotModel)
 {
-  robotModel.setJointData(theJointAngles, theRobotDimensions, theMassCalibration);
+  robotModel = theKinematics.getRobotModel(theJointAngles);
 
   DEBUG_DRAWING3D("module:RobotModelProvider:massOffsets", "robot")
   {
@@ -11,12 +11,14 @@
 #include "Representations/Configuration/MassCalibration.h"
 #include "Representations/Configuration/RobotDimensions.h"
 #include "Representations/Infrastructure/JointAngles.h"
+#include "Representations/Sensing/Kinematics.h"
 #include "Representations/Sensing/RobotModel.h"
 #include "Tools/Module/Module.h"
 
 MODULE(RobotModelProvider,
 {,
   REQUIRES(JointAngles),
+  REQUIRES(Kinematics),
   REQUIRES(MassCalibration),
   REQUIRES(RobotDimensions),
   PROVIDES(RobotModel),
@@ -4,7 +4,7 @@
 * @author Francesco Riccio, Emanuele Borzi
 */
 
-//NOTICE: this version of the ContextCoordinator assigns roles statically. For a complete version, please contact suriani@diag.uniroma1.it
+//NOTICE: this version of the ContextCoordinator assigns roles statically unless use_utility_assignment is set. For a complete version, please contact suriani@diag.uniroma1.it
 
 #include "ContextCoordinator.h"
 
@@ -55,8 +55,17 @@ void ContextCoordinator::update(Role& role)
         }
 
 
+        /// utility based assignment
+        /// (the own ball is not known to the teammates, so only the team ball decides between the contexts)
+        if(use_utility_assignment && theRobotInfo.number != 1)
+        {
+            if(theTeamBallModel.isValid)
+                role.role = assignRoles(role, {{Role::striker, Role::supporter, Role::defender, Role::jolly}});
+            else
+                role.role = assignRoles(role, {{Role::searcher_1, Role::searcher_2, Role::searcher_3, Role::searcher_4}});
+        }
         /// playing context
-        if(current_status == Role::playing)
+        else if(current_status == Role::playing)
         {
             switch(theRobotInfo.number)
             {
@@ -120,4 +129,36 @@ void ContextCoordinator::update(Role& role)
     {
         role.role = Role::goalie;
     }
+
+    // Remember what the teammates will receive (the message is sent at the end of this frame)
+    if(theBHumanMessageOutputGenerator.sendThisFrame)
+    {
+        sent = {theRobotInfo.number, theRobotPose.translation,
+                theFallDownState.state == FallDownState::upright || theFallDownState.state == FallDownState::staggering || theFallDownState.state == FallDownState::squatting,
+                role.role};
+        hasSent = true;
+    }
+}
+
+Role::RoleType ContextCoordinator::assignRoles(const Role& role, const RoleAssignment::Roles& roles)
+{
+    roleAssignment.field = {theFieldDimensions.xPosOwnGroundline, theFieldDimensions.xPosOpponentGroundline,
+                            theFieldDimensions.xPosOpponentPenaltyMark, theFieldDimensions.yPosLeftSideline};
+    roleAssignment.parameters = {role_priority, role_switch_hysteresis, fallen_penalty, obstacle_penalty, obstacle_radius};
+
+    // Every robot has to build the same matrix to come to the same result, so this robot
+    // takes part with the state its teammates received from it
+    roleAssignment.clear();
+    if(hasSent)
+        roleAssignment.add(sent);
+    else
+        roleAssignment.add({theRobotInfo.number, theRobotPose.translation,
+                            theFallDownState.state == FallDownState::upright || theFallDownState.state == FallDownState::staggering || theFallDownState.state == FallDownState::squatting,
+                            role.role});
+    for(const Teammate& teammate : theTeamData.teammates)
+        if(teammate.number != 1 && teammate.status != Teammate::PENALIZED)
+            roleAssignment.add({teammate.number, teammate.theRobotPose.translation, teammate.isUpright, teammate.role});
+
+    roleAssignment.assign(roles, theTeamBallModel.position);
+    return roleAssignment.getRole(theRobotInfo.number);
 }
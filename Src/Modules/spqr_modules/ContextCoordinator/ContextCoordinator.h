@@ -16,14 +16,16 @@
 #include "Representations/BehaviorControl/Role.h"
 #include "Representations/Configuration/FieldDimensions.h"
 #include "Representations/Perception/ObstaclesPercepts/ObstaclesFieldPercept.h"
+#include "Representations/Communication/BHumanMessage.h"
 #include "Representations/BehaviorControl/Libraries/LibCheck.h"
+#include "Tools/BehaviorControl/RoleAssignment.h"
 
 
 #include "Platform/SystemCall.h"
 #include "Platform/Time.h"
 #include <mutex>
 
-//NOTICE: this version of the ContextCoordinator assigns roles statically. For a complete version, please contact suriani@diag.uniroma1.it
+//NOTICE: this version of the ContextCoordinator assigns roles statically unless use_utility_assignment is set. For a complete version, please contact suriani@diag.uniroma1.it
 
 MODULE(ContextCoordinator, 
 {,
@@ -39,6 +41,7 @@ MODULE(ContextCoordinator,
  REQUIRES(TeamBallModel),
  REQUIRES(FieldDimensions),
  REQUIRES(ObstaclesFieldPercept),
+ REQUIRES(BHumanMessageOutputGenerator),
  REQUIRES(LibCheck),
  USES(Role),
  PROVIDES(Role),
@@ -47,6 +50,12 @@ MODULE(ContextCoordinator,
  {,
   (int) fall_down_penalty,
   (unsigned int) time_when_last_seen,
+  (bool) use_utility_assignment,     /** Assign the field player roles by solving an assignment problem over all teammates instead of by robot number */
+  (float) role_priority,             /** Cost bonus (in mm) between two consecutive roles, so that more important roles are assigned first if players are missing */
+  (float) role_switch_hysteresis,    /** Cost bonus (in mm) for keeping the current role */
+  (float) fallen_penalty,            /** Cost penalty (in mm) for players that are not upright */
+  (float) obstacle_penalty,          /** Cost penalty (in mm) for each other player close to the path to a role position */
+  (float) obstacle_radius,           /** Maximum distance (in mm) of another player to the path to be penalized */
  }),
        });
 
@@ -63,6 +72,13 @@ private:
     bool ballSeen;
     bool teamBall;
 
+    RoleAssignment roleAssignment;     /* Assigns the field player roles from the data shared by all robots */
+    RoleAssignment::Player sent;       /* The state of this robot as it was sent in its last team message */
+    bool hasSent = false;              /* Was a team message sent yet? */
+
+    /** Assigns the given roles to the field players that are not penalized and returns the role of this robot */
+    Role::RoleType assignRoles(const Role& role, const RoleAssignment::Roles& roles);
+
 public:
 
     bool flag = true;
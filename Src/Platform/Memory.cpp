@@ -0,0 +1,126 @@
+/**
+ * @file Platform/Memory.cpp
+ *
+ * A heap allocator that counts the allocations of each thread and keeps
+ * freed small blocks in free lists per thread and size class, so
+ * that the many small allocations of each frame do not require malloc, which
+ * might have to synchronize with other threads. Each block is preceded by a
+ * header that stores its size class, so blocks can be freed by any thread
+ * and independent of whether the caches were enabled when they were allocated.
+ * The robot code replaces the global operator new with it (see
+ * Platform/Nao/Memory.cpp).
+ */
+
+#include "Memory.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+  constexpr std::size_t headerSize = 16; /**< Keeps the alignment of malloc. */
+  constexpr std::size_t granularity = 16; /**< The difference between two size classes. */
+  constexpr unsigned numOfSizeClasses = 64; /**< Blocks of up to 1024 bytes are cached. */
+  constexpr unsigned uncached = numOfSizeClasses; /**< The size class of larger blocks. */
+  constexpr std::size_t maxCachedBytes = 32768; /**< The maximum memory cached per thread and size class. */
+
+  std::atomic<bool> threadCacheEnabled(true);
+
+  thread_local unsigned numOfAllocations = 0;
+  thread_local std::size_t numOfAllocatedBytes = 0;
+
+  /** The state of the cache of a thread. */
+  enum CacheState : unsigned char {unused, active, released};
+  thread_local CacheState cacheState = unused;
+
+  /** The free lists of a thread. Each free block stores the next one after its header. */
+  thread_local void* freeLists[numOfSizeClasses] = {nullptr};
+  thread_local unsigned numOfFreeBlocks[numOfSizeClasses] = {0};
+
+  /** Returns the blocks cached to malloc when a thread ends. */
+  struct CacheReleaser
+  {
+    ~CacheReleaser()
+    {
+      cacheState = released;
+      for(unsigned sizeClass = 0; sizeClass < numOfSizeClasses; ++sizeClass)
+        while(freeLists[sizeClass])
+        {
+          void* block = freeLists[sizeClass];
+          freeLists[sizeClass] = *reinterpret_cast<void**>(static_cast<char*>(block) + headerSize);
+          std::free(block);
+        }
+    }
+  };
+
+  /**
+   * Checks whether the cache of the calling thread can be used.
+   * @return Can it be used?
+   */
+  inline bool useCache()
+  {
+    if(cacheState == unused)
+    {
+      cacheState = active; // Registering the releaser might allocate itself.
+      static thread_local CacheReleaser releaser;
+      static_cast<void>(releaser);
+    }
+    return cacheState == active;
+  }
+}
+
+void* Memory::allocate(size_t size)
+{
+  ++numOfAllocations;
+  numOfAllocatedBytes += size;
+
+  const std::size_t sizeClass = (size + granularity - 1) / granularity;
+  if(sizeClass < numOfSizeClasses && threadCacheEnabled.load(std::memory_order_relaxed) && useCache() && freeLists[sizeClass])
+  {
+    char* block = static_cast<char*>(freeLists[sizeClass]);
+    freeLists[sizeClass] = *reinterpret_cast<void**>(block + headerSize);
+    --numOfFreeBlocks[sizeClass];
+    return block + headerSize;
+  }
+
+  // Cached blocks must be large enough to store the link to the next free block.
+  const bool cacheable = sizeClass < numOfSizeClasses;
+  char* block = static_cast<char*>(std::malloc(headerSize + (cacheable ? std::max<std::size_t>(sizeClass, 1) * granularity : size)));
+  if(!block)
+    return nullptr;
+  *reinterpret_cast<unsigned*>(block) = cacheable ? static_cast<unsigned>(sizeClass) : uncached;
+  return block + headerSize;
+}
+
+void Memory::deallocate(void* ptr)
+{
+  if(!ptr)
+    return;
+  char* block = static_cast<char*>(ptr) - headerSize;
+  const unsigned sizeClass = *reinterpret_cast<unsigned*>(block);
+  if(sizeClass < numOfSizeClasses && threadCacheEnabled.load(std::memory_order_relaxed) && useCache()
+     && (numOfFreeBlocks[sizeClass] + 1) * (sizeClass + 1) * granularity <= maxCachedBytes)
+  {
+    *reinterpret_cast<void**>(ptr) = freeLists[sizeClass];
+    freeLists[sizeClass] = block;
+    ++numOfFreeBlocks[sizeClass];
+  }
+  else
+    std::free(block);
+}
+
+unsigned Memory::getNumOfAllocations()
+{
+  return numOfAllocations;
+}
+
+size_t Memory::getNumOfAllocatedBytes()
+{
+  return numOfAllocatedBytes;
+}
+
+void Memory::setThreadCacheEnabled(bool enable)
+{
+  threadCacheEnabled.store(enable, std::memory_order_relaxed);
+}
@@ -9,4 +9,42 @@ namespace Memory
 
   /** Free aligned memory. */
   void alignedFree(void* ptr);
+
+  /**
+   * Allocates memory with the alignment of malloc. Counts the allocation and
+   * reuses a block from the cache of the calling thread if possible. On the
+   * robot, the global operator new is implemented with this function.
+   * @param size The number of bytes requested.
+   * @return The memory or nullptr if it could not be allocated.
+   */
+  void* allocate(size_t size);
+
+  /**
+   * Frees memory allocated by allocate. It can be called by any thread.
+   * @param ptr The memory. nullptr is ignored.
+   */
+  void deallocate(void* ptr);
+
+  /**
+   * Returns the number of allocations made through allocate
+   * by the calling thread so far. The difference between two calls is the
+   * number of heap allocations made in between.
+   */
+  unsigned getNumOfAllocations();
+
+  /**
+   * Returns the number of bytes requested through allocate
+   * by the calling thread so far.
+   */
+  size_t getNumOfAllocatedBytes();
+
+  /**
+   * Enables or disables the thread caches of allocate. If
+   * enabled, freed small blocks are kept in size-class free lists of the
+   * thread that freed them and are reused by its next allocations of the
+   * same size class without locking. Switching is possible at any time.
+   * The caches are enabled by default.
+   * @param enable Use the thread caches?
+   */
+  void setThreadCacheEnabled(bool enable);
 };
@@ -8,8 +8,7 @@
 
 #include "DebugHandler.h"
 #include "Platform/BHAssert.h"
-#include "Tools/Streams/OutStreams.h"
-#include "Tools/Streams/InStreams.h"
+#include "Platform/Time.h"
 #include <limits>
 
 DebugHandler::DebugHandler(MessageQueue& in, MessageQueue& out, int maxPacketSendSize, int maxPacketReceiveSize) :
@@ -20,30 +19,39 @@ DebugHandler::DebugHandler(MessageQueue& in, MessageQueue& out, int maxPacketSen
 
 void DebugHandler::communicate(bool send)
 {
-  if(send && !sendData && !out.isEmpty())
-  {
-    sendSize = out.getStreamedSize();
-    OutBinaryMemory memory(sendSize);
-    memory << out;
-    sendData = reinterpret_cast<unsigned char*>(memory.obtainData());
-    out.clear();
-  }
+  // Packets are only built when they can be sent immediately, so they contain the latest data.
+  if(send && sendData.empty() && !out.isEmpty() && isAcknowledged())
+    transport.pack(out, sendData);
 
   unsigned char* receivedData;
   int receivedSize = 0;
 
-  ASSERT(sendSize <= std::numeric_limits<int>::max());
-  if(sendAndReceive(sendData, static_cast<int>(sendSize), receivedData, receivedSize) && sendSize)
+  ASSERT(sendData.size() <= static_cast<size_t>(std::numeric_limits<int>::max()));
+  if(sendAndReceive(sendData.data(), static_cast<int>(sendData.size()), receivedData, receivedSize) && !sendData.empty())
+  {
+    sentSize = sendData.size();
+    sentTime = Time::getRealSystemTime();
+    sendData.clear();
+  }
+  else if(sentSize && isAcknowledged())
+  {
+    transport.acknowledged(sentSize, Time::getRealTimeSince(sentTime));
+    sentSize = 0;
+  }
+
+  if(!isConnected())
   {
-    delete [] sendData;
-    sendData = nullptr;
-    sendSize = 0;
+    transport.reset();
+    sentSize = 0;
   }
 
   if(receivedSize > 0)
   {
-    InBinaryMemory memory(receivedData);
-    memory >> in;
+    unsigned capabilities;
+    if(DebugTransport::isHello(receivedData, receivedSize, capabilities))
+      transport.compress = (capabilities & DebugTransport::snappyCapability) != 0;
+    else
+      DebugTransport::unpack(receivedData, receivedSize, in);
     delete [] receivedData;
   }
 }
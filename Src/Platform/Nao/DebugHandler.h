@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "Tools/Debugging/DebugTransport.h"
 #include "Tools/Debugging/TcpConnection.h"
 #include "Tools/MessageQueue/MessageQueue.h"
 
@@ -16,9 +17,11 @@ class DebugHandler : TcpConnection
 private:
   MessageQueue& in; /**< Incoming debug data is stored here. */
   MessageQueue& out; /**< Outgoing debug data is stored here. */
+  DebugTransport transport; /**< Compresses and schedules outgoing packets. */
 
-  unsigned char* sendData = nullptr; /**< The data to send next. */
-  size_t sendSize = 0; /**< The size of the data to send next. */
+  std::vector<unsigned char> sendData; /**< The data to send next. */
+  size_t sentSize = 0; /**< The size of the last packet sent that was not acknowledged yet. */
+  unsigned sentTime = 0; /**< When was the last packet sent? */
 
 public:
   /**
@@ -31,11 +34,6 @@ public:
    */
   DebugHandler(MessageQueue& in, MessageQueue& out, int maxPacketSendSize = 0, int maxPacketReceiveSize = 0);
 
-  /**
-   * Delete buffered packet if needed.
-   */
-  ~DebugHandler() {if(sendData) delete [] sendData;}
-
   /**
    * The method performs the communication.
    * It has to be called at the end of each frame.
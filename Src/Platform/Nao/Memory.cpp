@@ -1,2 +1,60 @@
 // Same functionality as on Linux, hence the include
 #include "Platform/Linux/Memory.cpp"
+
+#include <new>
+
+// On the robot, all heap allocations go through Memory::allocate, so that
+// they are counted and use the thread caches.
+
+void* operator new(std::size_t size)
+{
+  void* ptr = Memory::allocate(size);
+  if(!ptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+void* operator new[](std::size_t size)
+{
+  return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+  return Memory::allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+  return Memory::allocate(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+  Memory::deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+  Memory::deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  Memory::deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+  Memory::deallocate(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+  Memory::deallocate(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+  Memory::deallocate(ptr);
+}
@@ -9,6 +9,57 @@
 #include "Platform/Time.h"
 #include "BooleanRegistry.h"
 
+#include <array>
+#include <cctype>
+
 /* This draw function has draw methods that are specific to each task type */
 void BooleanRegistry::draw() const
-{}
\ No newline at end of file
+{}
+
+/* The message names are the enum names converted from camelCase to snake_case, computed only once */
+const std::string& BooleanRegistry::getMessageName(Condition condition)
+{
+  static const std::array<std::string, numOfConditions> names = []
+  {
+    std::array<std::string, numOfConditions> names;
+    FOREACH_ENUM(Condition, c)
+      for(const char* p = TypeRegistry::getEnumName(c); *p; ++p)
+        if(std::isupper(*p))
+        {
+          names[c] += '_';
+          names[c] += static_cast<char>(std::tolower(*p));
+        }
+        else
+          names[c] += *p;
+    return names;
+  }();
+  return names[condition];
+}
+
+std::string BooleanRegistry::getString() const
+{
+  std::string ret_string("booleanFlags");
+  FOREACH_ENUM(Condition, c)
+  {
+    ret_string.append(";");
+    ret_string.append(getMessageName(c));
+    ret_string.append(":");
+    ret_string.append((*this)[c] ? "1" : "0");
+  }
+  return ret_string;
+}
+
+std::string BooleanRegistry::getEventsString() const
+{
+  std::string ret_string("booleanFlags");
+  for(const Event& event : events)
+  {
+    ret_string.append(";");
+    ret_string.append(getMessageName(event.condition));
+    ret_string.append(":");
+    ret_string.append(event.rising ? "1" : "0");
+    ret_string.append(":");
+    ret_string.append(std::to_string(event.timestamp));
+  }
+  return ret_string;
+}
@@ -10,9 +10,9 @@
 #pragma once
 
 #include "Tools/Streams/AutoStreamable.h"
+#include "Tools/Streams/Enum.h"
 #include "Tools/Math/Eigen.h"
 #include "Tools/Math/Pose2f.h"
-#include "Tools/Function.h"
 
 #include <iostream>
 
@@ -20,25 +20,55 @@
 /**
  * @struct BooleanRegistry
  * 
- * Struct containing the functions that compute the booleans to be sent and a function to create a string to be sent as a message
+ * Struct containing the booleans to be sent to the client as a fixed-size set of named conditions. The conditions are
+ * evaluated once per frame by the BooleanRegistryProvider, which also records which of them changed in the current frame,
+ * so that only the edges have to be sent.
  * 
  */
 STREAMABLE(BooleanRegistry,
 {
+  /* Conditions sent to the client (at most 32, as they are stored as bits of an unsigned) */
+  ENUM(Condition,
+  {,
+    //isPassAvailable,
+    isCurrentActionCompleted,
+    isBatteryLow,
+  });
+
+  /* A rising or falling edge of a condition */
+  STREAMABLE(Event,
+  {,
+    (Condition)(isCurrentActionCompleted) condition,  /* The condition that changed */
+    (bool)(false) rising,                             /* true if the condition became true, false if it became false */
+    (unsigned)(0) timestamp,                          /* The frame in which the change was detected */
+  });
+
   void draw() const; //NOT CURRENTLY USED
 
-  /* Functions that compute booleans to send */
-  //FUNCTION(bool()) isPassAvailable;
-  FUNCTION(bool()) isCurrentActionCompleted;
-  FUNCTION(bool()) isBatteryLow;
+  /* Returns the value of a condition in the current frame */
+  bool operator[](Condition condition) const {return (values >> condition) & 1u;}
 
   /* Returns a string with all booleans, ready to be sent to the client */
-  FUNCTION(std::string()) getString;
+  std::string getString() const;
+
+  /* Returns a string with only the booleans that changed in the current frame and the frame timestamps of the changes, ready to be sent to the client */
+  std::string getEventsString() const;
+
+  /* Returns the name of a condition used in the messages to the client (e.g. "is_current_action_completed") */
+  static const std::string& getMessageName(Condition condition);
 
   BooleanRegistry();
   ,
 
+  (unsigned)(0) values,                   /* Bit i is the value of condition i in the current frame */
+  (std::vector<Event>) events,            /* The edges detected in the current frame */
+
   /* When false, booleans are sent only when the TaskController is in Plan mode (overriding the sending frequency of the ExternalCommunicationController) */
   (bool)(false) ALWAYS_SEND,
 });
-inline BooleanRegistry::BooleanRegistry() {}
\ No newline at end of file
+static_assert(BooleanRegistry::numOfConditions <= 32, "BooleanRegistry stores its conditions as bits of an unsigned");
+
+inline BooleanRegistry::BooleanRegistry()
+{
+  events.reserve(numOfConditions);
+}
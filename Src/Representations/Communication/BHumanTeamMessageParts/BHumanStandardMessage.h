@@ -14,7 +14,7 @@
 #include <cstdint>
 
 #define BHUMAN_STANDARD_MESSAGE_STRUCT_HEADER  "BHUM"
-#define BHUMAN_STANDARD_MESSAGE_STRUCT_VERSION 11      /**< This should be incremented with each change. */
+#define BHUMAN_STANDARD_MESSAGE_STRUCT_VERSION 12      /**< This should be incremented with each change. */
 #define BHUMAN_STANDARD_MESSAGE_MAX_NUM_OF_PLAYERS 6   /**< The maximum number of players per team. */
 #define BHUMAN_STANDARD_MESSAGE_MAX_NUM_OF_OBSTACLES 7 /**< The maximum number of obstacles that can be transmitted. */
 
@@ -81,6 +81,14 @@ STREAMABLE(BHumanStandardMessage,
    */
   bool read(const void* data);
 
+  /**
+   * Declares the layout of the message. Each field is passed to the stream
+   * together with its range and precision, so that the same declaration
+   * writes, reads and counts the bits of the message.
+   * @param stream A BitWriter, BitReader or BitCounter.
+   */
+  template<typename Stream> void streamFields(Stream& stream);
+
   /** Constructor. */
   BHumanStandardMessage(),
 
@@ -92,56 +100,56 @@ STREAMABLE(BHumanStandardMessage,
   (bool)     isPenalized,             /**< The name says it all. */
   (bool)     isUpright,               /**< The name says it all. */
   (bool)     hasGroundContact,        /**< The name says it all. */
-  (unsigned) timeOfLastGroundContact, /**< [delta 0..-16320 (64)] The name says it all. */
+  (unsigned) timeOfLastGroundContact, /**< [delta 0..-16256 (64)] The name says it all. */
 
   (float)                robotPoseValidity,   /**< [0..1 (0.0039)] The validity of the RobotPose. */
-  (float)                robotPoseDeviation,  /**< The deviation of the RobotPose. */
-  (std::array<float, 6>) robotPoseCovariance, /**< The covariance matrix of the RobotPose. */
-  (unsigned)             timestampLastJumped, /**< [delta 0..-32640 (128)] The timestamp when the localization jumped. */
+  (float)                robotPoseDeviation,  /**< [0..131070 (2)] The deviation of the RobotPose. */
+  (std::array<float, 6>) robotPoseCovariance, /**< The covariance matrix of the RobotPose. Streamed as standard deviations [0..4095 (1)], [0..pi (pi/1023)] and correlations [-1..1 (1/127)]. */
+  (unsigned)             timestampLastJumped, /**< [delta 0..-32512 (128)] The timestamp when the localization jumped. */
 
-  (unsigned)             ballTimeWhenLastSeen,    /**< The name says it all. */
-  (unsigned)             ballTimeWhenDisappeared, /**< The name says it all. */
-  (unsigned char)        ballSeenPercentage,      /**< The name says it all */
-  (Vector2f)             ballVelocity,            /**< [-32768..32767 (1)] The ball velocity .*/
-  (Vector2f)             ballLastPercept,         /**< [-32768..32767 (1)] The position where the last ball percept was. */
-  (std::array<float, 3>) ballCovariance,          /**< The covariance matrix of the ball position. */
+  (unsigned)             ballTimeWhenLastSeen,    /**< [delta 0..-131056 (8)] The name says it all. */
+  (unsigned)             ballTimeWhenDisappeared, /**< [delta 0..-131056 (8)] The name says it all. */
+  (unsigned char)        ballSeenPercentage,      /**< [0..100] The name says it all */
+  (Vector2f)             ballVelocity,            /**< [-8192..8191 (1)] The ball velocity .*/
+  (Vector2f)             ballLastPercept,         /**< [-8192..8191 (1)] The position where the last ball percept was. */
+  (std::array<float, 3>) ballCovariance,          /**< The covariance matrix of the ball position. Streamed as standard deviations [0..4095 (1)] and correlation [-1..1 (1/127)]. */
 
   (unsigned char) confidenceOfLastWhistleDetection, /**< The name says it all. */
-  (unsigned char) channelsUsedForWhistleDetection,  /**< The name says it all. */
-  (unsigned) lastTimeWhistleDetected,               /**< [delta 0..-65535] The name says it all. */
+  (unsigned char) channelsUsedForWhistleDetection,  /**< [0..15] The name says it all. */
+  (unsigned) lastTimeWhistleDetected,               /**< [delta 0..-65520 (8)] The name says it all. */
 
   (unsigned char)                                    teamActivity,              /**< What team play the robot is doing. */
-  (unsigned)                                         timeWhenReachBall,         /**< [delta 0..524280 (8)] The estimate when this robot reaches the ball. */
-  (unsigned)                                         timeWhenReachBallStriker,  /**< [delta 0..524264 (8)] The estimate when this robot reaches the ball if it is striker. */
+  (unsigned)                                         timeWhenReachBall,         /**< [delta 0..262112 (16)] The estimate when this robot reaches the ball. */
+  (unsigned)                                         timeWhenReachBallStriker,  /**< [delta 0..262112 (16)] The estimate when this robot reaches the ball if it is striker. */
   (bool[BHUMAN_STANDARD_MESSAGE_MAX_NUM_OF_PLAYERS]) teammateRolesIsGoalkeeper, /**< The role assignment for the whole team. */
   (bool[BHUMAN_STANDARD_MESSAGE_MAX_NUM_OF_PLAYERS]) teammateRolesPlayBall,     /**< The role assignment for the whole team. */
   (int[BHUMAN_STANDARD_MESSAGE_MAX_NUM_OF_PLAYERS])  teammateRolesPlayerIndex,  /**< [-1..6] The role assignment for the whole team. */
   (int)                                              captain,                   /**< [-1..6] The captain that provided the teammate roles. */
-  (unsigned)                                         teammateRolesTimestamp,    /**< [delta 0..-8191] The timestamp when the teammate roles have been computed. */
+  (unsigned)                                         teammateRolesTimestamp,    /**< [delta 0..-8190] The timestamp when the teammate roles have been computed. */
   (bool)                                             isGoalkeeper,              /**< Whether this robot is currently a goalkeeper. */
   (bool)                                             playBall,                  /**< Whether this robot currently plays the ball. */
   (int)                                              supporterIndex,            /**< [-1..6] The index of this robot in the supporter set. */
 
   (unsigned char) activity,   /**< What the robot is doing in general. */
   (int)           passTarget, /**< [-1..14] Which teammate this robot wants to pass to (or -1). */
-  (Vector2f)      walkingTo,  /**< [-32768..32767 (1)] Where the robot wants to walk. */
-  (Vector2f)      shootingTo, /**< [-32768..32767 (1)] Where the robot wants to kick the ball. */
-  (Vector2f)      goalTarget, /**< [-32768..32767 (1)] the current target on the goal line. */
+  (Vector2f)      walkingTo,  /**< [-8192..8191 (1)] Where the robot wants to walk. */
+  (Vector2f)      shootingTo, /**< [-8192..8191 (1)] Where the robot wants to kick the ball. */
+  (Vector2f)      goalTarget, /**< [-8192..8191 (1)] the current target on the goal line. */
 
   /**
    * Obstacle has the attributes covariance, center, left, right, velocity, lastSeen and type.
-   * covariance is streamed as float with the nondiagonal entries as one value.
-   * center is streamed in [-32768..32767 (1)].
-   * left is streamed in [-32768..32764 (4)].
-   * right is streamed in [-32768..32764 (4)].
+   * covariance is streamed as standard deviations in [0..4095 (1)] and correlation in [-1..1 (1/127)].
+   * center is streamed in [-8192..8191 (1)].
+   * left is streamed in [-8192..8188 (4)].
+   * right is streamed in [-8192..8188 (4)].
    * velocity is not streamed at all.
-   * lastSeen is streamed in [delta 0..-16320 (64)].
-   * type is streamed in [0..255].
+   * lastSeen is streamed in [delta 0..-16256 (64)].
+   * type is streamed in [0..7].
    */
   (std::vector<Obstacle>) obstacles,
 
   (char) say,
-  (unsigned int) nextTeamTalk,
+  (unsigned int) nextTeamTalk, /**< [delta 0..16256 (64)] */
 
   (bool) requestsNTPMessage,              /**< Whether this robot requests NTP replies from the others. */
   (std::vector<BNTPMessage>) ntpMessages, /**< The NTP replies of this robot to other robots. */
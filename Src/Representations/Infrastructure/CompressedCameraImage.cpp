@@ -0,0 +1,56 @@
+/**
+ * @file CompressedCameraImage.cpp
+ *
+ * Implementation of struct CompressedCameraImage
+ */
+
+#include "CompressedCameraImage.h"
+#include "Platform/BHAssert.h"
+#include "Tools/ImageProcessing/YUYVCodec.h"
+
+CompressedCameraImage::CompressedCameraImage(const CameraImage& src)
+{
+  *this = src;
+}
+
+CompressedCameraImage& CompressedCameraImage::operator=(const CameraImage& src)
+{
+  width = src.width;
+  height = src.height;
+  timestamp = src.timestamp;
+  allocator.resize(YUYVCodec::maxCompressedSize(width, height));
+  size = static_cast<unsigned>(YUYVCodec::compress(src[0], width, height, allocator.data()));
+  return *this;
+}
+
+void CompressedCameraImage::toCameraImage(CameraImage& dest) const
+{
+  dest.setResolution(width, height);
+  dest.timestamp = timestamp;
+  VERIFY(YUYVCodec::decompress(allocator.data(), size, width, height, dest[0]));
+}
+
+void CompressedCameraImage::serialize(In* in, Out* out)
+{
+  STREAM(width);
+  STREAM(height);
+  STREAM(timestamp);
+  STREAM(size);
+  if(in)
+  {
+    allocator.resize(size);
+    in->read(allocator.data(), size);
+  }
+  else
+    out->write(allocator.data(), size);
+}
+
+void CompressedCameraImage::reg()
+{
+  PUBLISH(reg);
+  REG_CLASS(CompressedCameraImage);
+  REG(width);
+  REG(height);
+  REG(timestamp);
+  REG(size);
+}
@@ -0,0 +1,54 @@
+/**
+ * @file CompressedCameraImage.h
+ *
+ * Declaration of struct CompressedCameraImage
+ */
+
+#pragma once
+
+#include "Representations/Infrastructure/CameraImage.h"
+#include "Tools/Streams/Streamable.h"
+
+/**
+ * Definition of a struct for losslessly compressed camera images. In contrast
+ * to the JPEGImage, perception modules produce exactly the same results on
+ * the decompressed image as on the original one.
+ */
+struct CompressedCameraImage : public Streamable
+{
+private:
+  unsigned size = 0; /**< The size of the compressed image. */
+  unsigned width = 0; /**< The width of the image in YUYV pixels. */
+  unsigned height = 0; /**< The height of the image. */
+  std::vector<unsigned char> allocator; /**< The data storage */
+
+public:
+  CompressedCameraImage() = default;
+
+  /**
+   * Constructs a compressed image from an image.
+   * @param src The image used as template.
+   */
+  CompressedCameraImage(const CameraImage& src);
+
+  /**
+   * Assignment operator.
+   * @param src The image used as template.
+   * @return The resulting compressed image.
+   */
+  CompressedCameraImage& operator=(const CameraImage& src);
+
+  /**
+   * Uncompress image.
+   * @param dest Will receive the uncompressed image.
+   */
+  void toCameraImage(CameraImage& dest) const;
+
+  unsigned timestamp = 0; /**< The timestamp of this image. */
+
+protected:
+  void serialize(In* in, Out* out);
+
+private:
+  static void reg();
+};
@@ -8,17 +8,13 @@
 #include "Tools/ImageProcessing/SIMD.h"
 #include "Platform/BHAssert.h"
 #include "Platform/Memory.h"
+#include "Platform/Thread.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <jpeglib.h>
 
-static boolean onDestEmpty(j_compress_ptr)
-{
-  FAIL("Unsupported operation.");
-  return false;
-}
-
-static void onDestIgnore(j_compress_ptr) {}
-
 static void onSrcSkip(j_decompress_ptr, long) {}
 
 static boolean onSrcEmpty(j_decompress_ptr)
@@ -29,6 +25,310 @@ static boolean onSrcEmpty(j_decompress_ptr)
 
 static void onSrcIgnore(j_decompress_ptr) {}
 
+namespace
+{
+  /**
+   * A libjpeg compressor that is kept alive across images, because creating
+   * one allocates and initializes all its submodules. It writes into a buffer
+   * that grows if required.
+   */
+  class SliceCompressor
+  {
+  private:
+    jpeg_compress_struct cInfo;
+    jpeg_error_mgr jem;
+    jpeg_destination_mgr dest;
+    std::vector<unsigned char>* buffer = nullptr; /**< The buffer currently written. */
+    int quality = -1; /**< The quality the tables were computed for. */
+    JPEGImage::ChromaSubsampling chromaSubsampling = JPEGImage::numOfChromaSubsamplings; /**< The subsampling currently set. */
+
+    static void onDestIgnore(j_compress_ptr) {}
+
+    static boolean onDestEmpty(j_compress_ptr cInfo)
+    {
+      std::vector<unsigned char>& buffer = *static_cast<SliceCompressor*>(cInfo->client_data)->buffer;
+      const size_t used = buffer.size();
+      buffer.resize(used * 2);
+      cInfo->dest->next_output_byte = buffer.data() + used;
+      cInfo->dest->free_in_buffer = buffer.size() - used;
+      return true;
+    }
+
+  public:
+    SliceCompressor()
+    {
+      cInfo.err = jpeg_std_error(&jem);
+      jpeg_create_compress(&cInfo);
+      cInfo.client_data = this;
+      dest.init_destination = onDestIgnore;
+      dest.empty_output_buffer = onDestEmpty;
+      dest.term_destination = onDestIgnore;
+      cInfo.dest = &dest;
+    }
+
+    ~SliceCompressor()
+    {
+      jpeg_destroy_compress(&cInfo);
+    }
+
+    /** The height of a row of MCUs for a subsampling. */
+    static int mcuHeight(JPEGImage::ChromaSubsampling chromaSubsampling)
+    {
+      return chromaSubsampling == JPEGImage::none ? DCTSIZE : 2 * DCTSIZE;
+    }
+
+    /** The width of an MCU for a subsampling. */
+    static int mcuWidth(JPEGImage::ChromaSubsampling chromaSubsampling)
+    {
+      return chromaSubsampling == JPEGImage::both ? 2 * DCTSIZE : DCTSIZE;
+    }
+
+    /**
+     * Compresses some rows of an image as a complete JPEG.
+     * @param src The image.
+     * @param yFrom The first row.
+     * @param yTo The row after the last one.
+     * @param quality The JPEG quality.
+     * @param chromaSubsampling The resolution of the U and V channels.
+     * @param buffer The buffer that receives the JPEG. Its size is the number of bytes written afterwards.
+     */
+    void compress(const CameraImage& src, int yFrom, int yTo, int quality, JPEGImage::ChromaSubsampling chromaSubsampling,
+                  std::vector<unsigned char>& buffer)
+    {
+      if(quality != this->quality || chromaSubsampling != this->chromaSubsampling)
+      {
+        cInfo.input_components = 4;
+        cInfo.in_color_space = JCS_CMYK;
+        jpeg_set_defaults(&cInfo);
+        cInfo.dct_method = JDCT_FASTEST;
+        jpeg_set_quality(&cInfo, quality, true);
+
+        // Components are Y0, U, Y1, V. The sampling factors are relative to each other.
+        const int h = mcuWidth(chromaSubsampling) / DCTSIZE;
+        const int v = mcuHeight(chromaSubsampling) / DCTSIZE;
+        cInfo.comp_info[0].h_samp_factor = cInfo.comp_info[2].h_samp_factor = h;
+        cInfo.comp_info[0].v_samp_factor = cInfo.comp_info[2].v_samp_factor = v;
+        this->quality = quality;
+        this->chromaSubsampling = chromaSubsampling;
+      }
+
+      cInfo.image_width = src.width;
+      cInfo.image_height = yTo - yFrom;
+
+      this->buffer = &buffer;
+      buffer.resize(std::max(buffer.capacity(), static_cast<size_t>(src.width * (yTo - yFrom) * sizeof(CameraImage::PixelType)) / 2 + 1024));
+      dest.next_output_byte = buffer.data();
+      dest.free_in_buffer = buffer.size();
+
+      jpeg_start_compress(&cInfo, true);
+      JSAMPROW rowPointers[2 * DCTSIZE];
+      while(cInfo.next_scanline < cInfo.image_height)
+      {
+        const unsigned rows = std::min(static_cast<unsigned>(2 * DCTSIZE), cInfo.image_height - cInfo.next_scanline);
+        for(unsigned i = 0; i < rows; ++i)
+          rowPointers[i] = const_cast<JSAMPROW>(reinterpret_cast<const unsigned char*>(src[yFrom + cInfo.next_scanline + i]));
+        jpeg_write_scanlines(&cInfo, rowPointers, rows);
+      }
+      jpeg_finish_compress(&cInfo);
+      buffer.resize(buffer.size() - dest.free_in_buffer);
+    }
+  };
+
+  /**
+   * Encodes the slices of an image on a small pool of worker threads. The
+   * calling thread encodes slices as well. If the pool is busy with an image
+   * of another thread, the calling thread encodes all slices on its own.
+   */
+  class SliceEncoder
+  {
+  private:
+    static constexpr int numOfWorkers = 2; /**< The number of threads in the pool. */
+    static constexpr int slicesPerThread = 2; /**< More slices than threads balance the load. */
+
+    /** The slices of an image being encoded. */
+    struct Job
+    {
+      const CameraImage* src;
+      int quality;
+      JPEGImage::ChromaSubsampling chromaSubsampling;
+      int sliceHeight;
+      int numOfSlices;
+      std::atomic<int> nextSlice;
+      std::vector<std::vector<unsigned char>> slices; /**< The JPEG of each slice. */
+
+      /** Encodes slices that were not taken by another thread yet. */
+      void process(SliceCompressor& compressor)
+      {
+        for(int i = nextSlice++; i < numOfSlices; i = nextSlice++)
+          compressor.compress(*src, i * sliceHeight, std::min((i + 1) * sliceHeight, static_cast<int>(src->height)),
+                              quality, chromaSubsampling, slices[i]);
+      }
+    };
+
+    struct Worker
+    {
+      SliceEncoder* encoder;
+      Thread thread;
+      SliceCompressor compressor;
+
+      void run()
+      {
+        Thread::nameCurrentThread("JPEGEncoder");
+        while(encoder->workAvailable.wait() && thread.isRunning())
+        {
+          encoder->job.process(compressor);
+          encoder->workDone.post();
+        }
+      }
+    };
+
+    std::mutex mutex; /**< Only one image is encoded by the pool at a time. */
+    Job job; /**< The image encoded by the pool. */
+    Semaphore workAvailable;
+    Semaphore workDone;
+    std::array<Worker, numOfWorkers> workers;
+    bool started = false;
+
+    /**
+     * Finds the segments of a JPEG that are relevant for joining slices.
+     * @param data The JPEG.
+     * @param sofHeight Receives the offset of the image height in the start of frame segment.
+     * @param sos Receives the offset of the start of scan segment.
+     * @return The offset of the entropy-coded data.
+     */
+    static size_t parseHeader(const std::vector<unsigned char>& data, size_t& sofHeight, size_t& sos)
+    {
+      size_t pos = 2; // SOI
+      while(pos + 4 <= data.size())
+      {
+        ASSERT(data[pos] == 0xff);
+        const unsigned char marker = data[pos + 1];
+        const size_t length = data[pos + 2] << 8 | data[pos + 3];
+        if(marker >= 0xc0 && marker <= 0xc2)
+          sofHeight = pos + 5;
+        else if(marker == 0xda)
+        {
+          sos = pos;
+          return pos + 2 + length;
+        }
+        pos += 2 + length;
+      }
+      FAIL("No start of scan found.");
+      return data.size();
+    }
+
+    /**
+     * Joins the slices to a single JPEG. The header of the first slice is used
+     * for the whole image with the total height and the restart interval
+     * inserted. The entropy-coded data of the slices is separated by restart
+     * markers. This is valid, because each slice starts with DC predictions
+     * of zero and ends byte-aligned, exactly as after a restart marker.
+     */
+    static void join(const Job& job, std::vector<unsigned char>& dest)
+    {
+      const std::vector<unsigned char>& first = job.slices[0];
+      size_t sofHeight = 0, sos = 0;
+      const size_t header = parseHeader(first, sofHeight, sos);
+      ASSERT(sofHeight);
+
+      const int mcusPerRow = (job.src->width + SliceCompressor::mcuWidth(job.chromaSubsampling) - 1) / SliceCompressor::mcuWidth(job.chromaSubsampling);
+      const int restartInterval = mcusPerRow * job.sliceHeight / SliceCompressor::mcuHeight(job.chromaSubsampling);
+      ASSERT(restartInterval <= 0xffff);
+
+      dest.clear();
+      dest.insert(dest.end(), first.begin(), first.begin() + sos);
+      dest.insert(dest.end(), {0xff, 0xdd, 0, 4, static_cast<unsigned char>(restartInterval >> 8), static_cast<unsigned char>(restartInterval)});
+      dest.insert(dest.end(), first.begin() + sos, first.begin() + header);
+      dest[sofHeight] = static_cast<unsigned char>(job.src->height >> 8);
+      dest[sofHeight + 1] = static_cast<unsigned char>(job.src->height);
+
+      for(int i = 0; i < job.numOfSlices; ++i)
+      {
+        const std::vector<unsigned char>& slice = job.slices[i];
+        const size_t data = i ? parseHeader(slice, sofHeight, sos) : header;
+        ASSERT(slice.size() >= data + 2 && slice[slice.size() - 2] == 0xff && slice.back() == 0xd9);
+        dest.insert(dest.end(), slice.begin() + data, slice.end() - 2);
+        if(i < job.numOfSlices - 1)
+          dest.insert(dest.end(), {0xff, static_cast<unsigned char>(0xd0 + (i & 7))});
+      }
+      dest.insert(dest.end(), {0xff, 0xd9});
+    }
+
+    /** Initializes the slicing of an image. */
+    static void prepare(Job& job, const CameraImage& src, int quality, JPEGImage::ChromaSubsampling chromaSubsampling)
+    {
+      const int mcuHeight = SliceCompressor::mcuHeight(chromaSubsampling);
+      const int slices = (numOfWorkers + 1) * slicesPerThread;
+      job.src = &src;
+      job.quality = quality;
+      job.chromaSubsampling = chromaSubsampling;
+      job.sliceHeight = std::max(1, (static_cast<int>(src.height) + slices * mcuHeight - 1) / (slices * mcuHeight)) * mcuHeight;
+      job.numOfSlices = (src.height + job.sliceHeight - 1) / job.sliceHeight;
+      job.nextSlice = 0;
+      job.slices.resize(job.numOfSlices);
+    }
+
+  public:
+    static SliceEncoder& getInstance()
+    {
+      static SliceEncoder instance;
+      return instance;
+    }
+
+    ~SliceEncoder()
+    {
+      if(started)
+      {
+        for(Worker& worker : workers)
+          worker.thread.announceStop();
+        for(int i = 0; i < numOfWorkers; ++i)
+          workAvailable.post();
+        for(Worker& worker : workers)
+          worker.thread.stop();
+      }
+    }
+
+    /**
+     * Encodes an image.
+     * @param src The image.
+     * @param quality The JPEG quality.
+     * @param chromaSubsampling The resolution of the U and V channels.
+     * @param dest Receives the JPEG.
+     */
+    void encode(const CameraImage& src, int quality, JPEGImage::ChromaSubsampling chromaSubsampling, std::vector<unsigned char>& dest)
+    {
+      thread_local SliceCompressor compressor;
+      std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+      if(!lock.owns_lock())
+      {
+        thread_local Job ownJob;
+        prepare(ownJob, src, quality, chromaSubsampling);
+        ownJob.process(compressor);
+        join(ownJob, dest);
+        return;
+      }
+
+      if(!started)
+      {
+        for(Worker& worker : workers)
+        {
+          worker.encoder = this;
+          worker.thread.start(&worker, &Worker::run);
+        }
+        started = true;
+      }
+
+      prepare(job, src, quality, chromaSubsampling);
+      for(int i = 0; i < numOfWorkers; ++i)
+        workAvailable.post();
+      job.process(compressor);
+      for(int i = 0; i < numOfWorkers; ++i)
+        workDone.wait();
+      join(job, dest);
+    }
+  };
+}
+
 JPEGImage::JPEGImage(const CameraImage& src)
 {
   *this = src;
@@ -36,47 +336,17 @@ JPEGImage::JPEGImage(const CameraImage& src)
 
 JPEGImage& JPEGImage::operator=(const CameraImage& src)
 {
-  allocator.resize(src.width * src.height * sizeof(CameraImage::PixelType));
+  compress(src);
+  return *this;
+}
+
+void JPEGImage::compress(const CameraImage& src, int quality, ChromaSubsampling chromaSubsampling)
+{
   width = src.width;
   height = src.height / 2;
   timestamp = src.timestamp;
-
-  jpeg_compress_struct cInfo;
-  jpeg_error_mgr jem;
-  cInfo.err = jpeg_std_error(&jem);
-  jpeg_create_compress(&cInfo);
-
-  if(!cInfo.dest)
-    cInfo.dest = static_cast<jpeg_destination_mgr*>(
-                 (*cInfo.mem->alloc_small)(reinterpret_cast<j_common_ptr>(&cInfo), JPOOL_PERMANENT, sizeof(jpeg_destination_mgr)));
-  cInfo.dest->init_destination = onDestIgnore;
-  cInfo.dest->empty_output_buffer = onDestEmpty;
-  cInfo.dest->term_destination = onDestIgnore;
-  cInfo.dest->next_output_byte = static_cast<JOCTET*>(allocator.data());
-  cInfo.dest->free_in_buffer = allocator.size();
-
-  cInfo.image_width = width;
-  cInfo.image_height = height * 2;
-  cInfo.input_components = 4;
-  cInfo.in_color_space = JCS_CMYK;
-  cInfo.jpeg_color_space = JCS_CMYK;
-  jpeg_set_defaults(&cInfo);
-  cInfo.dct_method = JDCT_FASTEST;
-  jpeg_set_quality(&cInfo, 75, true);
-
-  jpeg_start_compress(&cInfo, true);
-
-  while(cInfo.next_scanline < cInfo.image_height)
-  {
-    JSAMPROW rowPointer = const_cast<JSAMPROW>(reinterpret_cast<const unsigned char*>(src[0] + width * cInfo.next_scanline));
-    jpeg_write_scanlines(&cInfo, &rowPointer, 1);
-  }
-
-  jpeg_finish_compress(&cInfo);
-  size = unsigned((char unsigned*)cInfo.dest->next_output_byte - allocator.data());
-  jpeg_destroy_compress(&cInfo);
-
-  return *this;
+  SliceEncoder::getInstance().encode(src, quality, chromaSubsampling, allocator);
+  size = static_cast<unsigned>(allocator.size());
 }
 
 void JPEGImage::toCameraImage(CameraImage& dest) const
@@ -7,13 +7,28 @@
 #pragma once
 
 #include "Representations/Infrastructure/CameraImage.h"
+#include "Tools/Streams/Enum.h"
 #include "Tools/Streams/Streamable.h"
 
 /**
  * Definition of a struct for JPEG-compressed images.
+ * The image is split into horizontal slices that are encoded in parallel and
+ * joined with restart markers, i.e. the result is a single standard JPEG.
  */
 struct JPEGImage : public Streamable
 {
+  /**
+   * The resolution of the U and V channels in the JPEG. The YUYV pixel pairs
+   * are compressed as four channels, so U and V always have half the
+   * horizontal resolution of the original image.
+   */
+  ENUM(ChromaSubsampling,
+  {,
+    none, /**< U and V are encoded with the resolution of the pixel pairs. */
+    vertical, /**< U and V are halved vertically (4:2:0). */
+    both, /**< U and V are halved in both directions (4:1:0). */
+  });
+
 private:
   unsigned size; /**< The size of the compressed image. */
   int width; /**< The width of the image in pixel */
@@ -36,6 +51,14 @@ public:
    */
   JPEGImage& operator=(const CameraImage& src);
 
+  /**
+   * Compresses an image.
+   * @param src The image to compress.
+   * @param quality The JPEG quality (0..100).
+   * @param chromaSubsampling The resolution of the U and V channels.
+   */
+  void compress(const CameraImage& src, int quality = 75, ChromaSubsampling chromaSubsampling = none);
+
   /**
    * Uncompress image.
    * @param dest Will receive the uncompressed image.
@@ -102,6 +102,8 @@ void Thumbnail::toECImage(ECImage& dest) const
   dest.colored.setResolution(imageY.width * scale, imageY.height * scale);
   dest.hued.setResolution(imageY.width * scale, imageY.height * scale);
   dest.saturated.setResolution(imageY.width * scale, imageY.height * scale);
+  dest.classifiedTop = 0;
+  dest.classifiedBottom = imageY.height * scale;
 
   std::fill_n(dest.hued[0], dest.hued.width * dest.hued.height, PixelTypes::HuePixel(0));
   std::fill_n(dest.saturated[0], dest.saturated.width * dest.saturated.height, 0);
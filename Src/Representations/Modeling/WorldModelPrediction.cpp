@@ -27,6 +27,7 @@ void WorldModelPrediction::verify() const
   ASSERT(std::isfinite(ballPosition.y()));
   ASSERT(std::isfinite(ballVelocity.x()));
   ASSERT(std::isfinite(ballVelocity.y()));
+  ASSERT(ballPositionCovariance.allFinite());
   ASSERT(std::isfinite(robotPose.translation.x()));
   ASSERT(std::isfinite(robotPose.translation.y()));
   ASSERT(std::isfinite(robotPose.rotation));
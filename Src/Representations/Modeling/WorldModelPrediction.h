@@ -27,6 +27,7 @@ STREAMABLE(WorldModelPrediction,
 
   (Vector2f)(Vector2f::Zero()) ballPosition,    /*< 2D position of the ball in robot coordinates, i.e. relative to the robot on the field */
   (Vector2f)(Vector2f::Zero()) ballVelocity,    /*< 2D velocity of the ball in robot coordinates, i.e. relative to the robot on the field */
+  (Matrix2f)(Matrix2f::Identity()) ballPositionCovariance, /*< The covariance of ballPosition, rotated into the current robot coordinates */
   (unsigned)(0) timeWhenBallLastSeen,           /*< as the name says */
   (bool)(false) ballIsPredictedByRule,          /*< whether the prediction is based on the soccer rules and not on the ball model (which means it should not be used for some purposes) */
   (Pose2f) robotPose,                           /*< the current pose of the robot in 2D field coordinates */
@@ -0,0 +1,18 @@
+/**
+ * @file WalkEvaluation.h
+ *
+ * This file declares a representation that rates how well the walk
+ * parameters currently used performed during a sequence of walk phases.
+ */
+
+#pragma once
+
+#include "Tools/Streams/AutoStreamable.h"
+
+STREAMABLE(WalkEvaluation,
+{,
+  (float)(0.f) speedRatio, /**< The average ratio between the measured and the requested speeds of all phases. */
+  (float)(0.f) gyroDeviation, /**< The root mean square of the gyro around the x and y axes while walking (in radians/s). */
+  (int)(0) falls, /**< How often did the robot fall? */
+  (bool)(false) finished, /**< Have all phases been executed? */
+});
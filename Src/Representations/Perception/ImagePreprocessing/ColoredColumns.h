@@ -0,0 +1,39 @@
+/**
+ * @file ColoredColumns.h
+ *
+ * Declares a representation that contains the columns of the color classified
+ * image that are scanned by the vertical scan lines of the ScanGrid. Each
+ * column is stored as a consecutive row of an image, so walking a scan line
+ * from the bottom to the top only touches consecutive bytes instead of one
+ * cache line per image row.
+ */
+
+#pragma once
+
+#include "Tools/ImageProcessing/Image.h"
+#include "Tools/ImageProcessing/PixelTypes.h"
+#include "Tools/Streams/AutoStreamable.h"
+
+STREAMABLE(ColoredColumns,
+{
+  /**
+   * Returns the pixels of a scan line, starting with image row 0.
+   * @param index The index of the scan line in ScanGrid::lines.
+   * @return The first pixel of the column.
+   */
+  const PixelTypes::ColoredPixel* operator[](size_t index) const {return columns[index];}
+
+  /**
+   * Are the columns a copy of the given image and grid?
+   * @param timestamp The timestamp of the ECImage.
+   * @param numOfLines The number of lines in the ScanGrid.
+   * @return Can the columns be used instead of the image?
+   */
+  bool isValid(unsigned timestamp, size_t numOfLines) const
+  {
+    return this->timestamp == timestamp && columns.height == numOfLines && numOfLines > 0;
+  },
+
+  (unsigned)(0) timestamp, /**< The timestamp of the ECImage the columns were copied from. */
+  (Image<PixelTypes::ColoredPixel>) columns, /**< Row i contains the column ScanGrid::lines[i].x of ECImage::colored (up to ScanGrid::lines[i].yMax). Rows far above ScanGrid::fieldLimit are undefined. */
+});
@@ -29,9 +29,20 @@ STREAMABLE(ECImage,
     SEND_DEBUG_IMAGE("GrayscaledImage", grayscaled);
     SEND_DEBUG_IMAGE("SaturatedImage", saturated);
     SEND_DEBUG_IMAGE("HuedImage", hued);
-  },
+  }
+
+  /**
+   * Were the colored, saturated and hued images computed for a row? The
+   * grayscaled image is always computed completely. In the other rows,
+   * colored is FieldColors::none and saturated and hued are undefined.
+   * @param y The row.
+   * @return Is the row classified?
+   */
+  bool isClassified(int y) const {return y >= classifiedTop && y < classifiedBottom;},
 
   (unsigned)(0) timestamp,
+  (int)(0) classifiedTop, /**< The first row for which colored, saturated and hued were computed. */
+  (int)(0) classifiedBottom, /**< The row after the last one for which colored, saturated and hued were computed. */
   (Image<PixelTypes::GrayscaledPixel>) grayscaled,
   (Image<PixelTypes::ColoredPixel>) colored,
   (Image<PixelTypes::GrayscaledPixel>) saturated,
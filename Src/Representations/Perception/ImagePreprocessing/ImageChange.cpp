@@ -0,0 +1,35 @@
+/**
+ * @file ImageChange.cpp
+ *
+ * Implements a representation that describes which parts of the camera image
+ * changed since they were last processed.
+ */
+
+#include "ImageChange.h"
+#include "Tools/Debugging/DebugDrawings.h"
+#include <algorithm>
+
+bool ImageChange::isUnchanged(int yFrom, int yTo) const
+{
+  if(cameraMoved || tilesPerColumn == 0)
+    return false;
+
+  const int rowFrom = std::max(0, yFrom / tileSize);
+  const int rowTo = std::min(tilesPerColumn, (yTo + tileSize - 1) / tileSize);
+  for(int i = rowFrom * tilesPerRow; i < rowTo * tilesPerRow; ++i)
+    if(changed[i])
+      return false;
+  return true;
+}
+
+void ImageChange::draw() const
+{
+  DEBUG_DRAWING("representation:ImageChange", "drawingOnImage")
+  {
+    for(int y = 0; y < tilesPerColumn; ++y)
+      for(int x = 0; x < tilesPerRow; ++x)
+        if(cameraMoved || changed[y * tilesPerRow + x])
+          RECTANGLE("representation:ImageChange", x * tileSize, y * tileSize, (x + 1) * tileSize - 1, (y + 1) * tileSize - 1,
+                    1, Drawings::solidPen, cameraMoved ? ColorRGBA::orange : ColorRGBA::red);
+  }
+}
@@ -0,0 +1,40 @@
+/**
+ * @file ImageChange.h
+ *
+ * Declares a representation that describes which parts of the camera image
+ * changed since they were last processed. Providers whose output only depends
+ * on an unchanged part of the image can keep their previous output.
+ */
+
+#pragma once
+
+#include "Tools/Streams/AutoStreamable.h"
+#include <vector>
+
+STREAMABLE(ImageChange,
+{
+  /**
+   * Is a range of rows unchanged, i.e. did none of the tiles overlapping it
+   * change and did the camera not move relative to the field?
+   * @param yFrom The first row.
+   * @param yTo The row after the last one.
+   * @return Can results computed from these rows in the previous frame be kept?
+   */
+  bool isUnchanged(int yFrom, int yTo) const;
+
+  /**
+   * Is the whole image unchanged?
+   * @return Can results computed from the whole previous image be kept?
+   */
+  bool isUnchanged() const {return isUnchanged(0, tileSize * tilesPerColumn);}
+
+  void draw() const,
+
+  (unsigned)(0) timestamp, /**< The timestamp of the camera image compared. */
+  (bool)(true) cameraMoved, /**< Did the camera move relative to the field since the previous image? */
+  (int)(32) tileSize, /**< The edge length of a tile in pixels. */
+  (int)(0) tilesPerRow, /**< The number of tiles in horizontal direction. */
+  (int)(0) tilesPerColumn, /**< The number of tiles in vertical direction. If 0, everything is considered as changed. */
+  (std::vector<unsigned char>) changed, /**< Row-major flags (0 or 1) whether each tile changed. */
+  (unsigned)(0) unchangedFrames, /**< The number of consecutive images in which nothing changed. */
+});
@@ -0,0 +1,39 @@
+/**
+ * @file Kinematics.h
+ *
+ * This file declares a representation that provides forward kinematics for
+ * arbitrary joint angles. The results are computed when they are requested and
+ * are memoized for the rest of the frame, so modules requesting the model for
+ * the same joint angles share the computation.
+ */
+
+#pragma once
+
+#include "Representations/Sensing/RobotModel.h"
+#include "Tools/Function.h"
+#include "Tools/RobotParts/Legs.h"
+
+STREAMABLE(Kinematics,
+{
+  /**
+   * Returns the model of the robot for the given joint angles.
+   * @param jointAngles The joint angles, e.g. the measured ones or a joint request.
+   * @return The limb poses and the center of mass relative to the torso.
+   */
+  FUNCTION(RobotModel(const JointAngles& jointAngles)) getRobotModel;
+
+  /**
+   * Returns the Jacobian of the pose of a foot relative to the torso with
+   * respect to the joints of its leg (from hip yaw pitch to ankle roll).
+   * The first three rows belong to the translation (in mm/rad), the last
+   * three to the rotation (as angle axis).
+   * @param leg The leg.
+   * @param jointAngles The joint angles.
+   * @return The Jacobian.
+   */
+  FUNCTION(Matrix6f(Legs::Leg leg, const JointAngles& jointAngles)) getLegJacobian,
+
+  (unsigned)(0) modelsRequested, /**< The number of robot models requested in the previous frame. */
+  (unsigned)(0) modelsComputed, /**< The number of robot models computed in the previous frame. */
+  (unsigned)(0) chainsComputed, /**< The number of kinematic chains computed in the previous frame. */
+});
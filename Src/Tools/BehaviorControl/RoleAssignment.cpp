@@ -0,0 +1,112 @@
+/**
+ * @file RoleAssignment.cpp
+ *
+ * This file implements the utility-based assignment of the field player roles.
+ */
+
+#include "RoleAssignment.h"
+#include <algorithm>
+
+/**
+ * Returns the distance of a point to a line segment.
+ * @param point The point.
+ * @param start The start of the segment.
+ * @param end The end of the segment.
+ * @return The distance.
+ */
+static float distanceToSegment(const Vector2f& point, const Vector2f& start, const Vector2f& end)
+{
+  const Vector2f direction = end - start;
+  const float squaredLength = direction.squaredNorm();
+  const float t = squaredLength > 0.f ? std::max(0.f, std::min(1.f, (point - start).dot(direction) / squaredLength)) : 0.f;
+  return (start + direction * t - point).norm();
+}
+
+void RoleAssignment::add(const Player& player)
+{
+  if(numOfPlayers < maxPlayers)
+    players[numOfPlayers++] = player;
+}
+
+void RoleAssignment::assign(const Roles& roles, const Vector2f& ballPosition)
+{
+  std::sort(players.begin(), players.begin() + numOfPlayers, [](const Player& a, const Player& b) {return a.number < b.number;});
+
+  // Missing players and missing roles are filled up with dummies of cost 0
+  const int size = std::max(numOfPlayers, numOfRoles);
+  cost.setZero();
+  for(int j = 0; j < numOfRoles; ++j)
+  {
+    const Vector2f target = getRolePosition(roles[j], ballPosition);
+    for(int i = 0; i < numOfPlayers; ++i)
+    {
+      const Player& player = players[i];
+      float c = (player.position - target).norm() - parameters.rolePriority * static_cast<float>(numOfRoles - j);
+      if(player.role == roles[j])
+        c -= parameters.roleSwitchHysteresis;
+      if(!player.upright)
+        c += parameters.fallenPenalty;
+      for(int k = 0; k < numOfPlayers; ++k)
+        if(k != i && distanceToSegment(players[k].position, player.position, target) < parameters.obstacleRadius)
+          c += parameters.obstaclePenalty;
+      cost(i, j) = c;
+    }
+  }
+
+  // The previous assignment is only a valid start for the same players
+  if(numOfPlayers != numOfSolvedPlayers
+     || !std::equal(players.begin(), players.begin() + numOfPlayers, solvedNumbers.begin(),
+                    [](const Player& player, int number) {return player.number == number;}))
+  {
+    solver.reset();
+    numOfSolvedPlayers = numOfPlayers;
+    for(int i = 0; i < numOfPlayers; ++i)
+      solvedNumbers[i] = players[i].number;
+  }
+  solver.solve(cost, size);
+
+  // Robots that started from scratch could resolve a near tie differently
+  if(!solver.isUnique(cost, numOfPlayers))
+  {
+    solver.reset();
+    solver.solve(cost, size);
+  }
+
+  for(int i = 0; i < numOfPlayers; ++i)
+    assignedRoles[i] = solver[i] < numOfRoles ? roles[solver[i]] : Role::none;
+}
+
+Role::RoleType RoleAssignment::getRole(int number) const
+{
+  for(int i = 0; i < numOfPlayers; ++i)
+    if(players[i].number == number)
+      return assignedRoles[i];
+  return Role::none;
+}
+
+Vector2f RoleAssignment::getRolePosition(Role::RoleType role, const Vector2f& ballPosition) const
+{
+  const float halfX = field.xPosOpponentGroundline / 2.f;
+  const float halfY = field.yPosLeftSideline / 2.f;
+  switch(role)
+  {
+    case Role::striker:
+      return ballPosition;
+    case Role::supporter:
+      return Vector2f(ballPosition.x() - 1200.f, ballPosition.y() / 2.f);
+    case Role::defender:
+      return Vector2f((ballPosition.x() + field.xPosOwnGroundline) / 2.f, ballPosition.y() / 2.f);
+    case Role::jolly:
+      return Vector2f(std::min(ballPosition.x() + 1500.f, field.xPosOpponentPenaltyMark), ballPosition.y() > 0.f ? -halfY : halfY);
+    case Role::searcher_1:
+      return Vector2f(-halfX, halfY);
+    case Role::searcher_2:
+      return Vector2f(-halfX, -halfY);
+    case Role::searcher_3:
+      return Vector2f(halfX, halfY);
+    case Role::searcher_4:
+      return Vector2f(halfX, -halfY);
+    default:
+      return ballPosition;
+  }
+}
@@ -0,0 +1,106 @@
+/**
+ * @file RoleAssignment.h
+ *
+ * This file declares the utility-based assignment of the field player roles
+ * used by the ContextCoordinator.
+ *
+ * All robots of the team have to come to the same result without negotiating.
+ * Therefore, the cost matrix is only built from data that all of them share:
+ * the team ball and the state of every player as it was sent in its last team
+ * message. The own robot takes part with the state it sent itself, not with its
+ * current state. Penalties are computed the same way for every row and players
+ * are sorted by number. The solver continues from the assignment of the previous
+ * frame as long as the same players take part and starts from scratch whenever
+ * one joins or leaves. If another assignment of the players is almost as good as
+ * the one found, the solver starts from scratch as well, so that the result never
+ * depends on the previous frame.
+ */
+
+#pragma once
+
+#include "Representations/BehaviorControl/Role.h"
+#include "Tools/Math/Eigen.h"
+#include "Tools/Math/HungarianMethod.h"
+#include <array>
+
+class RoleAssignment
+{
+public:
+  static constexpr int maxPlayers = 5;
+  static constexpr int numOfRoles = 4;
+  using Roles = std::array<Role::RoleType, numOfRoles>;
+
+  /** A field player as it was sent in its last team message. */
+  struct Player
+  {
+    int number;
+    Vector2f position;
+    bool upright;
+    Role::RoleType role;
+  };
+
+  /** The dimensions of the field the role positions depend on. */
+  struct Field
+  {
+    float xPosOwnGroundline;
+    float xPosOpponentGroundline;
+    float xPosOpponentPenaltyMark;
+    float yPosLeftSideline;
+  };
+
+  /** The weights of the cost function (all in mm). */
+  struct Parameters
+  {
+    float rolePriority; /**< Bonus between two consecutive roles, so that more important roles are assigned first if players are missing. */
+    float roleSwitchHysteresis; /**< Bonus for keeping the current role. */
+    float fallenPenalty; /**< Penalty for players that are not upright. */
+    float obstaclePenalty; /**< Penalty for each other player close to the path to a role position. */
+    float obstacleRadius; /**< Maximum distance of another player to the path to be penalized. */
+  };
+
+  Field field;
+  Parameters parameters;
+
+  /** Removes all players. */
+  void clear() {numOfPlayers = 0;}
+
+  /**
+   * Adds a player. Players beyond maxPlayers are ignored.
+   * @param player The player.
+   */
+  void add(const Player& player);
+
+  /**
+   * Assigns the roles to the players added since the last call of clear().
+   * @param roles The roles in descending order of importance.
+   * @param ballPosition The position of the team ball in global coordinates.
+   */
+  void assign(const Roles& roles, const Vector2f& ballPosition);
+
+  /**
+   * Returns the role assigned to a player in the last call of assign().
+   * @param number The number of the player.
+   * @return The role or Role::none if the player was not assigned a role.
+   */
+  Role::RoleType getRole(int number) const;
+
+  /**
+   * Returns the target position of a role.
+   * @param role The role.
+   * @param ballPosition The position of the team ball in global coordinates.
+   * @return The position in global coordinates.
+   */
+  Vector2f getRolePosition(Role::RoleType role, const Vector2f& ballPosition) const;
+
+  /** The cost matrix of the last call of assign() (players x roles). */
+  const HungarianMethod<maxPlayers>::Matrix& getCost() const {return cost;}
+
+private:
+  std::array<Player, maxPlayers> players; /**< The players sorted by number. */
+  int numOfPlayers = 0;
+  std::array<Role::RoleType, maxPlayers> assignedRoles;
+  std::array<int, maxPlayers> solvedNumbers; /**< The numbers of the players the solver state belongs to. */
+  int numOfSolvedPlayers = -1; /**< The number of players the solver state belongs to (-1: none). */
+  HungarianMethod<maxPlayers> solver;
+  HungarianMethod<maxPlayers>::Matrix cost;
+};
@@ -0,0 +1,209 @@
+/**
+ * @file Tools/Communication/BitStream.h
+ *
+ * Streams that pack quantized values into a buffer bit by bit. A message format
+ * is declared once as a template function that passes each field together with
+ * its range and precision to a stream. The same declaration is then used to
+ * write (BitWriter), read (BitReader) and compute the size (BitCounter) of a
+ * message, so these can never disagree.
+ *
+ * Example:
+ *   template<typename Stream> void serialize(Stream& stream)
+ *   {
+ *     stream.real(x, -8192.f, 8191.f, 1.f); // 14 bits
+ *     stream.flag(isUpright);               // 1 bit
+ *   }
+ */
+
+#pragma once
+
+#include "Platform/BHAssert.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * The coders shared by all streams. Derived classes implement
+ * transfer(uint32_t& raw, unsigned count), which either writes, reads or
+ * counts the lowest count bits of raw.
+ */
+template<typename Derived> class BitStream
+{
+public:
+  /**
+   * Returns the number of bits required to represent all values from 0 to maxValue.
+   * @param maxValue The largest value.
+   * @return The number of bits.
+   */
+  static constexpr unsigned bitsFor(uint32_t maxValue)
+  {
+    unsigned count = 0;
+    while(count < 32 && (maxValue >> count) != 0)
+      ++count;
+    return count;
+  }
+
+  /**
+   * Streams an unsigned value with a fixed number of bits. Larger values are clipped.
+   * @param value The value.
+   * @param count The number of bits (1..32).
+   */
+  template<typename T> void uint(T& value, unsigned count)
+  {
+    ASSERT(count > 0 && count <= 32);
+    const uint32_t max = count >= 32 ? 0xFFFFFFFFu : (1u << count) - 1u;
+    uint32_t raw = 0;
+    if constexpr(!Derived::reading)
+      raw = std::min(static_cast<uint32_t>(value), max);
+    self().transfer(raw, count);
+    if constexpr(Derived::reading)
+      value = static_cast<T>(raw);
+  }
+
+  /**
+   * Streams a boolean as a single bit.
+   * @param value The value.
+   */
+  void flag(bool& value)
+  {
+    uint32_t raw = 0;
+    if constexpr(!Derived::reading)
+      raw = value ? 1 : 0;
+    self().transfer(raw, 1);
+    if constexpr(Derived::reading)
+      value = raw != 0;
+  }
+
+  /**
+   * Streams an integer from a range. Values outside of the range are clipped.
+   * @param value The value.
+   * @param min The smallest value that can be represented.
+   * @param max The largest value that can be represented.
+   */
+  template<typename T> void integer(T& value, int min, int max)
+  {
+    uint32_t raw = 0;
+    if constexpr(!Derived::reading)
+      raw = static_cast<uint32_t>(std::min(std::max(static_cast<int>(value), min), max) - min);
+    self().transfer(raw, bitsFor(static_cast<uint32_t>(max - min)));
+    if constexpr(Derived::reading)
+      value = static_cast<T>(static_cast<int>(raw) + min);
+  }
+
+  /**
+   * Streams a real number from a range with a fixed precision. Values outside of
+   * the range are clipped, values inside are rounded to the nearest step.
+   * @param value The value.
+   * @param min The smallest value that can be represented.
+   * @param max The largest value that can be represented.
+   * @param precision The distance between two representable values.
+   */
+  void real(float& value, float min, float max, float precision)
+  {
+    const uint32_t steps = static_cast<uint32_t>(std::lround((max - min) / precision));
+    uint32_t raw = 0;
+    if constexpr(!Derived::reading)
+      raw = std::isnan(value) ? 0 : static_cast<uint32_t>(std::lround((std::min(std::max(value, min), max) - min) / precision));
+    self().transfer(raw, bitsFor(steps));
+    if constexpr(Derived::reading)
+      value = min + static_cast<float>(raw) * precision;
+  }
+
+  /**
+   * Streams a timestamp relative to a reference timestamp. The difference is
+   * divided by 2^shift and clipped to count bits. The largest value of the
+   * field is reserved for the timestamp 0 ("never"), which is kept as is.
+   * @param time The timestamp.
+   * @param reference The reference timestamp, e.g. the time when the message was sent.
+   * @param future Whether the timestamp lies in the future relative to the reference.
+   * @param shift The precision as power of two ms.
+   * @param count The number of bits.
+   */
+  void timestamp(unsigned& time, unsigned reference, bool future, unsigned shift, unsigned count)
+  {
+    const uint32_t invalid = (1u << count) - 1u;
+    uint32_t raw = invalid;
+    if constexpr(!Derived::reading)
+      if(time)
+        raw = std::min((future ? std::max(time, reference) - reference : reference - std::min(time, reference)) >> shift, invalid - 1);
+    self().transfer(raw, count);
+    if constexpr(Derived::reading)
+      time = raw == invalid ? 0 : future ? reference + (raw << shift) : reference - (raw << shift);
+  }
+
+private:
+  Derived& self() {return *static_cast<Derived*>(this);}
+};
+
+/** Writes fields into a buffer. */
+class BitWriter : public BitStream<BitWriter>
+{
+public:
+  static constexpr bool reading = false;
+
+  /**
+   * Constructor.
+   * @param data The buffer. It must be large enough for all fields written.
+   */
+  BitWriter(void* data) : data(reinterpret_cast<uint8_t*>(data)) {}
+
+  void transfer(uint32_t raw, unsigned count)
+  {
+    for(unsigned i = 0; i < count; ++i, ++bits)
+    {
+      uint8_t& byte = data[bits >> 3];
+      const uint8_t mask = static_cast<uint8_t>(1u << (bits & 7));
+      byte = static_cast<uint8_t>((raw >> i) & 1u ? byte | mask : byte & ~mask);
+    }
+  }
+
+  /** The number of bytes written (including the partially used last byte). */
+  std::size_t size() const {return (bits + 7) >> 3;}
+
+private:
+  uint8_t* data;
+  std::size_t bits = 0;
+};
+
+/** Reads fields from a buffer. */
+class BitReader : public BitStream<BitReader>
+{
+public:
+  static constexpr bool reading = true;
+
+  /**
+   * Constructor.
+   * @param data The buffer.
+   */
+  BitReader(const void* data) : data(reinterpret_cast<const uint8_t*>(data)) {}
+
+  void transfer(uint32_t& raw, unsigned count)
+  {
+    raw = 0;
+    for(unsigned i = 0; i < count; ++i, ++bits)
+      raw |= static_cast<uint32_t>((data[bits >> 3] >> (bits & 7)) & 1u) << i;
+  }
+
+  /** The number of bytes read (including the partially used last byte). */
+  std::size_t size() const {return (bits + 7) >> 3;}
+
+private:
+  const uint8_t* data;
+  std::size_t bits = 0;
+};
+
+/** Only counts the bits that would be written. */
+class BitCounter : public BitStream<BitCounter>
+{
+public:
+  static constexpr bool reading = false;
+
+  void transfer(uint32_t, unsigned count) {bits += count;}
+
+  /** The number of bytes required (including the partially used last byte). */
+  std::size_t size() const {return (bits + 7) >> 3;}
+
+private:
+  std::size_t bits = 0;
+};
@@ -97,6 +97,11 @@ public:
    */
   bool write(const char* data, const int len);
 
+  /**
+   * Returns the underlying socket handle, e.g. to wait for it with poll/epoll.
+   */
+  socket_t getSocket() const {return sock;}
+
   static std::string getWifiBroadcastAddress();
 
   static unsigned char getLastByteOfIP();
@@ -52,6 +52,17 @@ const char* DrawingManager::getString(const std::string& string)
   return i->second;
 }
 
+DrawingBatch& DrawingManager::shape(MessageID message, char shapeType, const char* name)
+{
+  return batch.begin(Global::getDebugOut(), message, shapeType, getDrawingId(name));
+}
+
+void DrawingManager::flush()
+{
+  if(!batch.empty())
+    batch.flush(Global::getDebugOut());
+}
+
 In& operator>>(In& stream, DrawingManager& drawingManager)
 {
   // note that this operator appends the data read to the drawingManager
@@ -8,6 +8,7 @@
 
 #include "Tools/Debugging/ColorRGBA.h"
 #include "Tools/Debugging/Debugging.h"
+#include "Tools/Debugging/DrawingBatch.h"
 #include "Tools/Math/BHMath.h"
 #include "Tools/Math/Covariance.h"
 #include "Tools/Math/Eigen.h"
@@ -60,6 +61,8 @@ private:
   std::unordered_map<char, const char*> drawingsById;
   std::unordered_map<char, const char*> typesById;
 
+  DrawingBatch batch; /**< The primitives that were not sent yet. */
+
   friend class ThreadFrame; /**< A thread is allowed to create the instance. */
   friend class RobotConsole;
   friend class DrawingManager3D;
@@ -82,6 +85,22 @@ public:
   const char* getDrawingName(char id) const;
   const char* getString(const std::string& string);
 
+  /**
+   * Starts a primitive in the compact encoding (see DrawingBatch).
+   * @param message The id of the message (idDebugDrawing or idDebugDrawing3D).
+   * @param shapeType The shape type of the primitive.
+   * @param name The name of the drawing the primitive belongs to.
+   * @return The batch the fields of the primitive are added to.
+   */
+  DrawingBatch& shape(MessageID message, char shapeType, const char* name);
+
+  /**
+   * Sends the primitives that are still waiting in the batch. Must be called
+   * at the end of each frame and before a primitive is sent without the batch,
+   * so that all primitives arrive in the order they were drawn.
+   */
+  void flush();
+
 private:
   const char* getTypeName(char id) const;
 };
@@ -172,14 +191,10 @@ inline const char* DrawingManager::getTypeName(char id) const
   do \
     COMPLEX_DRAWING(id) \
     { \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::circle) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             static_cast<int>(center_x) << static_cast<int>(center_y) << \
-             static_cast<int>(radius) << static_cast<char>(penWidth) << \
-             static_cast<char>(penStyle) << ColorRGBA(penColor) << \
-             static_cast<char>(brushStyle) << ColorRGBA(brushColor)\
-            ); \
+      Global::getDrawingManager().shape(idDebugDrawing, Drawings::circle, id) \
+      .addCoordinate(static_cast<int>(center_x)).addCoordinate(static_cast<int>(center_y)).addCoordinate(static_cast<int>(radius)) \
+      .addByte(static_cast<char>(penWidth)).addByte(static_cast<char>((penStyle) | (brushStyle) << 4)) \
+      .addColor(ColorRGBA(penColor)).addColor(ColorRGBA(brushColor)); \
     } \
   while(false)
 
@@ -201,15 +216,11 @@ inline const char* DrawingManager::getTypeName(char id) const
   do \
     COMPLEX_DRAWING(id) \
     { \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::arc) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             static_cast<int>(center_x) << static_cast<int>(center_y) << static_cast<int>(radius) << \
-             Angle(startAngle) << Angle(spanAngle) << \
-             static_cast<char>(penWidth) << \
-             static_cast<char>(penStyle) << ColorRGBA(penColor) << \
-             static_cast<char>(brushStyle) << ColorRGBA(brushColor)\
-            ); \
+      Global::getDrawingManager().shape(idDebugDrawing, Drawings::arc, id) \
+      .addCoordinate(static_cast<int>(center_x)).addCoordinate(static_cast<int>(center_y)).addCoordinate(static_cast<int>(radius)) \
+      .addAngle(startAngle).addAngle(spanAngle) \
+      .addByte(static_cast<char>(penWidth)).addByte(static_cast<char>((penStyle) | (brushStyle) << 4)) \
+      .addColor(ColorRGBA(penColor)).addColor(ColorRGBA(brushColor)); \
     } \
   while(false)
 
@@ -230,14 +241,11 @@ inline const char* DrawingManager::getTypeName(char id) const
   do \
     COMPLEX_DRAWING(id) \
     { \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::ellipse) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             static_cast<int>((center).x()) << static_cast<int>((center).y()) << \
-             static_cast<int>(radiusX) << static_cast<int>(radiusY) << static_cast<float>(rotation) << \
-             static_cast<char>(penWidth) << static_cast<char>(penStyle) << ColorRGBA(penColor) << \
-             static_cast<char>(brushStyle) << ColorRGBA(brushColor) \
-            ); \
+      Global::getDrawingManager().shape(idDebugDrawing, Drawings::ellipse, id) \
+      .addCoordinate(static_cast<int>((center).x())).addCoordinate(static_cast<int>((center).y())) \
+      .addCoordinate(static_cast<int>(radiusX)).addCoordinate(static_cast<int>(radiusY)).addAngle(static_cast<float>(rotation)) \
+      .addByte(static_cast<char>(penWidth)).addByte(static_cast<char>((penStyle) | (brushStyle) << 4)) \
+      .addColor(ColorRGBA(penColor)).addColor(ColorRGBA(brushColor)); \
     } \
   while(false)
 
@@ -256,14 +264,11 @@ inline const char* DrawingManager::getTypeName(char id) const
   do \
     COMPLEX_DRAWING(id) \
     { \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::rectangle) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             static_cast<int>((topLeft).x()) << static_cast<int>((topLeft).y()) << \
-             static_cast<int>(width) << static_cast<int>(height) << static_cast<float>(rotation) << \
-             static_cast<char>(penWidth) << static_cast<char>(penStyle) << ColorRGBA(penColor) << \
-             static_cast<char>(brushStyle) << ColorRGBA(brushColor)\
-            ); \
+      Global::getDrawingManager().shape(idDebugDrawing, Drawings::rectangle, id) \
+      .addCoordinate(static_cast<int>((topLeft).x())).addCoordinate(static_cast<int>((topLeft).y())) \
+      .addCoordinate(static_cast<int>(width)).addCoordinate(static_cast<int>(height)).addAngle(static_cast<float>(rotation)) \
+      .addByte(static_cast<char>(penWidth)).addByte(static_cast<char>((penStyle) | (brushStyle) << 4)) \
+      .addColor(ColorRGBA(penColor)).addColor(ColorRGBA(brushColor)); \
     } \
   while(false)
 
@@ -282,17 +287,12 @@ inline const char* DrawingManager::getTypeName(char id) const
   do \
     COMPLEX_DRAWING(id) \
     { \
-      OutTextMemory _stream(static_cast<int>(numberOfPoints) * 12); \
+      DrawingBatch& _batch = Global::getDrawingManager().shape(idDebugDrawing, Drawings::polygon, id) \
+                             .addNumber(static_cast<unsigned short>(numberOfPoints)); \
       for(int _i = 0; _i < static_cast<int>(numberOfPoints); ++_i) \
-        _stream << static_cast<int>(points[_i].x()) << static_cast<int>(points[_i].y()); \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::polygon) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             static_cast<int>(numberOfPoints) << \
-             _stream.data() << \
-             static_cast<char>(penWidth) << static_cast<char>(penStyle) << ColorRGBA(penColor) << \
-             static_cast<char>(brushStyle) << ColorRGBA(brushColor) \
-            );  \
+        _batch.addCoordinate(static_cast<int>(points[_i].x())).addCoordinate(static_cast<int>(points[_i].y())); \
+      _batch.addByte(static_cast<char>(penWidth)).addByte(static_cast<char>((penStyle) | (brushStyle) << 4)) \
+      .addColor(ColorRGBA(penColor)).addColor(ColorRGBA(brushColor)); \
     } \
   while(false)
 
@@ -308,11 +308,8 @@ inline const char* DrawingManager::getTypeName(char id) const
   do \
     COMPLEX_DRAWING(id) \
     { \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::dot) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             static_cast<int>(x) << static_cast<int>(y) << ColorRGBA(penColor) << ColorRGBA(brushColor) \
-            ); \
+      Global::getDrawingManager().shape(idDebugDrawing, Drawings::dot, id) \
+      .addCoordinate(static_cast<int>(x)).addCoordinate(static_cast<int>(y)).addColor(ColorRGBA(penColor)).addColor(ColorRGBA(brushColor)); \
     } \
   while(false)
 
@@ -327,12 +324,9 @@ inline const char* DrawingManager::getTypeName(char id) const
   do \
     COMPLEX_DRAWING(id) \
     { \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::dot) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             static_cast<int>((xy).x()) << static_cast<int>((xy).y()) << \
-             ColorRGBA(penColor) << ColorRGBA(brushColor) \
-            ); \
+      Global::getDrawingManager().shape(idDebugDrawing, Drawings::dot, id) \
+      .addCoordinate(static_cast<int>((xy).x())).addCoordinate(static_cast<int>((xy).y())) \
+      .addColor(ColorRGBA(penColor)).addColor(ColorRGBA(brushColor)); \
     } \
   while(false)
 
@@ -348,11 +342,8 @@ inline const char* DrawingManager::getTypeName(char id) const
   do \
     COMPLEX_DRAWING(id) \
     { \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::dotMedium) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             static_cast<int>(x) << static_cast<int>(y) << ColorRGBA(penColor) << ColorRGBA(brushColor) \
-            ); \
+      Global::getDrawingManager().shape(idDebugDrawing, Drawings::dotMedium, id) \
+      .addCoordinate(static_cast<int>(x)).addCoordinate(static_cast<int>(y)).addColor(ColorRGBA(penColor)).addColor(ColorRGBA(brushColor)); \
     } \
   while(false)
 
@@ -368,11 +359,8 @@ inline const char* DrawingManager::getTypeName(char id) const
   do \
     COMPLEX_DRAWING(id) \
     { \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::dotLarge) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             static_cast<int>(x) << static_cast<int>(y) << ColorRGBA(penColor) << ColorRGBA(brushColor) \
-            ); \
+      Global::getDrawingManager().shape(idDebugDrawing, Drawings::dotLarge, id) \
+      .addCoordinate(static_cast<int>(x)).addCoordinate(static_cast<int>(y)).addColor(ColorRGBA(penColor)).addColor(ColorRGBA(brushColor)); \
     } \
   while(false)
 
@@ -391,13 +379,10 @@ inline const char* DrawingManager::getTypeName(char id) const
   do \
     COMPLEX_DRAWING(id) \
     { \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::line) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             static_cast<float>(x1) << static_cast<float>(y1) << \
-             static_cast<float>(x2) << static_cast<float>(y2) << \
-             static_cast<float>(penWidth) << static_cast<char>(penStyle) << ColorRGBA(penColor) \
-            ); \
+      Global::getDrawingManager().shape(idDebugDrawing, Drawings::line, id) \
+      .addCoordinate(static_cast<float>(x1)).addCoordinate(static_cast<float>(y1)) \
+      .addCoordinate(static_cast<float>(x2)).addCoordinate(static_cast<float>(y2)) \
+      .addCoordinate(static_cast<float>(penWidth)).addByte(static_cast<char>(penStyle)).addColor(ColorRGBA(penColor)); \
     } \
   while(false)
 
@@ -423,13 +408,10 @@ inline const char* DrawingManager::getTypeName(char id) const
   do \
     COMPLEX_DRAWING(id) \
     { \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::arrow) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             static_cast<float>(x1) << static_cast<float>(y1) << \
-             static_cast<float>(x2) << static_cast<float>(y2) << \
-             static_cast<float>(penWidth) << static_cast<char>(penStyle) << ColorRGBA(penColor) \
-            ); \
+      Global::getDrawingManager().shape(idDebugDrawing, Drawings::arrow, id) \
+      .addCoordinate(static_cast<float>(x1)).addCoordinate(static_cast<float>(y1)) \
+      .addCoordinate(static_cast<float>(x2)).addCoordinate(static_cast<float>(y2)) \
+      .addCoordinate(static_cast<float>(penWidth)).addByte(static_cast<char>(penStyle)).addColor(ColorRGBA(penColor)); \
     } \
   while(false)
 
@@ -527,12 +509,9 @@ inline const char* DrawingManager::getTypeName(char id) const
     { \
       OutTextRawMemory _stream; \
       _stream << txt; \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::text) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             static_cast<int>(x) << static_cast<int>(y) << \
-             static_cast<short>(fontSize) << ColorRGBA(color) << _stream.data() \
-            ); \
+      Global::getDrawingManager().shape(idDebugDrawing, Drawings::text, id) \
+      .addCoordinate(static_cast<int>(x)).addCoordinate(static_cast<int>(y)) \
+      .addNumber(static_cast<unsigned short>(fontSize)).addColor(ColorRGBA(color)).addString(_stream.data()); \
     } \
   while(false)
 
@@ -545,12 +524,9 @@ inline const char* DrawingManager::getTypeName(char id) const
     { \
       OutTextRawMemory _stream(1024); \
       _stream << action; \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::spot) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             static_cast<int>(x1) << static_cast<int>(y1) << \
-             static_cast<int>(x2) << static_cast<int>(y2) << _stream.data() \
-            ); \
+      Global::getDrawingManager().shape(idDebugDrawing, Drawings::spot, id) \
+      .addCoordinate(static_cast<int>(x1)).addCoordinate(static_cast<int>(y1)) \
+      .addCoordinate(static_cast<int>(x2)).addCoordinate(static_cast<int>(y2)).addString(_stream.data()); \
     } \
   while(false)
 
@@ -568,11 +544,9 @@ inline const char* DrawingManager::getTypeName(char id) const
     { \
       OutTextRawMemory _stream(1024); \
       _stream << text; \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::tip) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             static_cast<int>(x) << static_cast<int>(y) << static_cast<int>(radius) << _stream.data() \
-            ); \
+      Global::getDrawingManager().shape(idDebugDrawing, Drawings::tip, id) \
+      .addCoordinate(static_cast<int>(x)).addCoordinate(static_cast<int>(y)).addCoordinate(static_cast<int>(radius)) \
+      .addString(_stream.data()); \
     } \
   while(false)
 
@@ -585,11 +559,7 @@ inline const char* DrawingManager::getTypeName(char id) const
   do \
     COMPLEX_DRAWING(id) \
     { \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::thread) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             (threadName) \
-            ); \
+      Global::getDrawingManager().shape(idDebugDrawing, Drawings::thread, id).addString(threadName); \
     } \
   while(false)
 
@@ -604,12 +574,9 @@ inline const char* DrawingManager::getTypeName(char id) const
   do \
     COMPLEX_DRAWING(id) \
     { \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::origin) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             static_cast<int>(x) << static_cast<int>(y) << static_cast<float>(angle) \
-    ); \
-  } \
+      Global::getDrawingManager().shape(idDebugDrawing, Drawings::origin, id) \
+      .addCoordinate(static_cast<int>(x)).addCoordinate(static_cast<int>(y)).addAngle(static_cast<float>(angle)); \
+    } \
   while(false)
 
 /**
@@ -627,11 +594,14 @@ inline const char* DrawingManager::getTypeName(char id) const
   do \
     COMPLEX_DRAWING(id) \
     { \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::robot) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             Pose2f(p) << Vector2f(dirVec) << Vector2f(dirHeadVec) << \
-             static_cast<float>(alphaRobot) << ColorRGBA(colorBody) << ColorRGBA(colorDirVec) << ColorRGBA(colorDirHeadVec)); \
+      const Pose2f _p(p); \
+      const Vector2f _dirVec(dirVec); \
+      const Vector2f _dirHeadVec(dirHeadVec); \
+      Global::getDrawingManager().shape(idDebugDrawing, Drawings::robot, id) \
+      .addCoordinate(_p.translation.x()).addCoordinate(_p.translation.y()).addAngle(_p.rotation) \
+      .addCoordinate(_dirVec.x()).addCoordinate(_dirVec.y()).addCoordinate(_dirHeadVec.x()).addCoordinate(_dirHeadVec.y()) \
+      .addByte(static_cast<char>(std::lround(static_cast<float>(alphaRobot) * 255.f))) \
+      .addColor(ColorRGBA(colorBody)).addColor(ColorRGBA(colorDirVec)).addColor(ColorRGBA(colorDirHeadVec)); \
     } \
   while(false)
 
@@ -88,14 +88,10 @@ class DrawingManager3D : public DrawingManager {};
   do \
     DECLARED_DEBUG_RESPONSE("debug drawing 3d:" id) \
     { \
-      OUTPUT(idDebugDrawing3D, bin, \
-             static_cast<char>(Drawings3D::line) << \
-             Global::getDrawingManager3D().getDrawingId(id) << \
-             static_cast<float>(fromX) << static_cast<float>(fromY) << static_cast<float>(fromZ) << \
-             static_cast<float>(toX) << static_cast<float>(toY) << static_cast<float>(toZ) << \
-             static_cast<float>(size) << \
-             ColorRGBA(color) \
-            ); \
+      Global::getDrawingManager3D().shape(idDebugDrawing3D, Drawings3D::line, id) \
+      .addCoordinate(static_cast<float>(fromX)).addCoordinate(static_cast<float>(fromY)).addCoordinate(static_cast<float>(fromZ)) \
+      .addCoordinate(static_cast<float>(toX)).addCoordinate(static_cast<float>(toY)).addCoordinate(static_cast<float>(toZ)) \
+      .addCoordinate(static_cast<float>(size)).addColor(ColorRGBA(color)); \
     } \
   while(false)
 
@@ -191,12 +187,11 @@ class DrawingManager3D : public DrawingManager {};
   do \
     COMPLEX_DRAWING3D(id) \
     { \
-      OUTPUT(idDebugDrawing3D, bin, \
-             static_cast<char>(Drawings3D::quad) << \
-             Global::getDrawingManager3D().getDrawingId(id) << \
-             Vector3f(corner1) << Vector3f(corner2) << Vector3f(corner3) << Vector3f(corner4) << \
-             ColorRGBA(color) \
-            ); \
+      const Vector3f _corners[4] = {Vector3f(corner1), Vector3f(corner2), Vector3f(corner3), Vector3f(corner4)}; \
+      DrawingBatch& _batch = Global::getDrawingManager3D().shape(idDebugDrawing3D, Drawings3D::quad, id); \
+      for(const Vector3f& _corner : _corners) \
+        _batch.addCoordinate(_corner.x()).addCoordinate(_corner.y()).addCoordinate(_corner.z()); \
+      _batch.addColor(ColorRGBA(color)); \
     } \
   while(false)
 
@@ -215,12 +210,11 @@ class DrawingManager3D : public DrawingManager {};
       LINE3D(id, corner2.x(), corner2.y(), corner2.z(), corner3.x(), corner3.y(), corner3.z(), size, color); \
       LINE3D(id, corner3.x(), corner3.y(), corner3.z(), corner4.x(), corner4.y(), corner4.z(), size, color); \
       LINE3D(id, corner4.x(), corner4.y(), corner4.z(), corner1.x(), corner1.y(), corner1.z(), size, color); \
-      OUTPUT(idDebugDrawing3D, bin, \
-             static_cast<char>(Drawings3D::quad) << \
-             Global::getDrawingManager3D().getDrawingId(id) << \
-             Vector3f(corner1) << Vector3f(corner2) << Vector3f(corner3) << Vector3f(corner4) << \
-             ColorRGBA(color) \
-            ); \
+      const Vector3f _corners[4] = {Vector3f(corner1), Vector3f(corner2), Vector3f(corner3), Vector3f(corner4)}; \
+      DrawingBatch& _batch = Global::getDrawingManager3D().shape(idDebugDrawing3D, Drawings3D::quad, id); \
+      for(const Vector3f& _corner : _corners) \
+        _batch.addCoordinate(_corner.x()).addCoordinate(_corner.y()).addCoordinate(_corner.z()); \
+      _batch.addColor(ColorRGBA(color)); \
     } \
   while(false)
 
@@ -235,6 +229,7 @@ class DrawingManager3D : public DrawingManager {};
   do \
     COMPLEX_DRAWING3D(id) \
     { \
+      Global::getDrawingManager3D().flush(); \
       OUTPUT(idDebugDrawing3D, bin, \
              static_cast<char>(Drawings3D::cube) << \
              Global::getDrawingManager3D().getDrawingId(id) << \
@@ -257,6 +252,7 @@ class DrawingManager3D : public DrawingManager {};
     do \
       COMPLEX_DRAWING3D(id) \
       { \
+        Global::getDrawingManager3D().flush(); \
         OUTPUT(idDebugDrawing3D, bin, \
               static_cast<char>(Drawings3D::cube) << \
               Global::getDrawingManager3D().getDrawingId(id) << \
@@ -278,6 +274,7 @@ class DrawingManager3D : public DrawingManager {};
   do \
     COMPLEX_DRAWING3D(id) \
     { \
+      Global::getDrawingManager3D().flush(); \
       OUTPUT(idDebugDrawing3D, bin, \
              static_cast<char>(Drawings3D::coordinates) << \
              Global::getDrawingManager3D().getDrawingId(id) << \
@@ -313,6 +310,7 @@ class DrawingManager3D : public DrawingManager {};
   do \
     COMPLEX_DRAWING3D(id) \
     { \
+      Global::getDrawingManager3D().flush(); \
       OUTPUT(idDebugDrawing3D, bin, \
              static_cast<char>(Drawings3D::scale) << \
              Global::getDrawingManager3D().getDrawingId(id) << \
@@ -333,6 +331,7 @@ class DrawingManager3D : public DrawingManager {};
   do \
     COMPLEX_DRAWING3D(id) \
     { \
+      Global::getDrawingManager3D().flush(); \
       OUTPUT(idDebugDrawing3D, bin, \
              static_cast<char>(Drawings3D::rotate) << \
              Global::getDrawingManager3D().getDrawingId(id) << \
@@ -353,6 +352,7 @@ class DrawingManager3D : public DrawingManager {};
   do \
     COMPLEX_DRAWING3D(id) \
     { \
+      Global::getDrawingManager3D().flush(); \
       OUTPUT(idDebugDrawing3D, bin, \
              static_cast<char>(Drawings3D::translate) << \
              Global::getDrawingManager3D().getDrawingId(id) << \
@@ -374,13 +374,9 @@ class DrawingManager3D : public DrawingManager {};
   do \
     COMPLEX_DRAWING3D(id) \
     { \
-      OUTPUT(idDebugDrawing3D, bin, \
-             static_cast<char>(Drawings3D::dot) << \
-             Global::getDrawingManager3D().getDrawingId(id) << \
-             static_cast<float>(x) << static_cast<float>(y) << static_cast<float>(z) << \
-             static_cast<float>(size) << \
-             ColorRGBA(color) << false \
-            ); \
+      Global::getDrawingManager3D().shape(idDebugDrawing3D, Drawings3D::dot, id) \
+      .addCoordinate(static_cast<float>(x)).addCoordinate(static_cast<float>(y)).addCoordinate(static_cast<float>(z)) \
+      .addCoordinate(static_cast<float>(size)).addColor(ColorRGBA(color)); \
     } \
   while(false)
 
@@ -397,13 +393,9 @@ class DrawingManager3D : public DrawingManager {};
   do \
     COMPLEX_DRAWING3D(id) \
     { \
-      OUTPUT(idDebugDrawing3D, bin, \
-             static_cast<char>(Drawings3D::sphere) << \
-             Global::getDrawingManager3D().getDrawingId(id) << \
-             static_cast<float>(x) << static_cast<float>(y) << static_cast<float>(z) << \
-             static_cast<float>(radius) << \
-             ColorRGBA(color) \
-            ); \
+      Global::getDrawingManager3D().shape(idDebugDrawing3D, Drawings3D::sphere, id) \
+      .addCoordinate(static_cast<float>(x)).addCoordinate(static_cast<float>(y)).addCoordinate(static_cast<float>(z)) \
+      .addCoordinate(static_cast<float>(radius)).addColor(ColorRGBA(color)); \
     } \
   while(false)
 
@@ -418,6 +410,7 @@ class DrawingManager3D : public DrawingManager {};
   do \
     COMPLEX_DRAWING3D(id) \
     { \
+      Global::getDrawingManager3D().flush(); \
       OUTPUT(idDebugDrawing3D, bin, \
              static_cast<char>(Drawings3D::ellipsoid) << \
              Global::getDrawingManager3D().getDrawingId(id) << \
@@ -442,6 +435,7 @@ class DrawingManager3D : public DrawingManager {};
   do \
     COMPLEX_DRAWING3D(id) \
     { \
+      Global::getDrawingManager3D().flush(); \
       OUTPUT(idDebugDrawing3D, bin, \
              static_cast<char>(Drawings3D::cylinder) << \
              Global::getDrawingManager3D().getDrawingId(id) << \
@@ -471,6 +465,7 @@ class DrawingManager3D : public DrawingManager {};
   do \
     COMPLEX_DRAWING3D(id) \
     { \
+      Global::getDrawingManager3D().flush(); \
       OUTPUT(idDebugDrawing3D, bin, \
              static_cast<char>(Drawings3D::cylinder) << \
              Global::getDrawingManager3D().getDrawingId(id) << \
@@ -580,6 +575,7 @@ class DrawingManager3D : public DrawingManager {};
       ry = (forward.x() != 0.f || d != 0.f) ? std::atan2(forward.x(), d) : 0.f; \
       DECLARED_DEBUG_RESPONSE("debug drawing 3d:" id) \
       { \
+        Global::getDrawingManager3D().flush(); \
         OUTPUT(idDebugDrawing3D, bin, \
                 static_cast<char>(Drawings3D::partDisc) << \
                 Global::getDrawingManager3D().getDrawingId(id) << \
@@ -637,6 +633,7 @@ class DrawingManager3D : public DrawingManager {};
   do \
     COMPLEX_DRAWING3D(id) \
     { \
+      Global::getDrawingManager3D().flush(); \
       OUTPUT(idDebugDrawing3D, bin, \
              static_cast<char>(Drawings3D::image) << \
              Global::getDrawingManager3D().getDrawingId(id) << \
@@ -0,0 +1,183 @@
+/**
+ * @file Tools/Debugging/DebugTransport.cpp
+ *
+ * Implementation of the packet format and scheduling of debug data.
+ */
+
+#include "DebugTransport.h"
+#include "Platform/BHAssert.h"
+#include "Tools/Streams/InStreams.h"
+#include <algorithm>
+#include <cstring>
+#include <snappy-c.h>
+
+/**
+ * Distributes the messages of a queue to the messages sent now and the bulk
+ * messages deferred. Deferred messages keep the brackets of their frame.
+ */
+class PacketSplitter : public MessageHandler
+{
+private:
+  MessageQueue& packetQueue;
+  MessageQueue& deferredQueue;
+  const size_t bulkBudget;
+  size_t bulkSent = 0; /**< The bulk bytes already accepted for the packet. */
+  std::vector<char> frameBegin; /**< The idFrameBegin message of the current frame. Empty outside of frames. */
+  bool frameDeferred = false; /**< Was a message of the current frame deferred? */
+
+public:
+  PacketSplitter(MessageQueue& packetQueue, MessageQueue& deferredQueue, size_t bulkBudget) :
+    packetQueue(packetQueue), deferredQueue(deferredQueue), bulkBudget(bulkBudget) {}
+
+  bool handleMessage(InMessage& message) override
+  {
+    const MessageID id = message.getMessageID();
+    const size_t size = static_cast<size_t>(message.getMessageSize());
+    if(id == idFrameBegin)
+    {
+      frameBegin.resize(size);
+      message.bin.read(frameBegin.data(), size);
+      frameDeferred = false;
+    }
+    else if(id == idFrameFinished)
+    {
+      if(frameDeferred)
+        message >> deferredQueue;
+      frameBegin.clear();
+      frameDeferred = false;
+    }
+    else if(DebugTransport::isBulk(id) && bulkSent && bulkSent + size > bulkBudget)
+    {
+      if(!frameBegin.empty() && !frameDeferred)
+      {
+        deferredQueue.out.bin.write(frameBegin.data(), frameBegin.size());
+        deferredQueue.out.finishMessage(idFrameBegin);
+        frameDeferred = true;
+      }
+      message >> deferredQueue;
+      return true;
+    }
+    else if(DebugTransport::isBulk(id))
+      bulkSent += size;
+
+    message >> packetQueue;
+    return true;
+  }
+};
+
+std::vector<unsigned char> DebugTransport::hello()
+{
+  const unsigned words[4] = {0, 0, helloMagic, snappyCapability};
+  std::vector<unsigned char> packet(sizeof(words));
+  std::memcpy(packet.data(), words, sizeof(words));
+  return packet;
+}
+
+bool DebugTransport::isHello(const unsigned char* data, int size, unsigned& capabilities)
+{
+  unsigned words[4];
+  if(size != static_cast<int>(sizeof(words)))
+    return false;
+  std::memcpy(words, data, sizeof(words));
+  if(words[0] || words[1] || words[2] != helloMagic)
+    return false;
+  capabilities = words[3];
+  return true;
+}
+
+bool DebugTransport::unpack(const unsigned char* data, int size, MessageQueue& queue)
+{
+  unsigned magic = 0;
+  if(size >= static_cast<int>(sizeof(magic)))
+    std::memcpy(&magic, data, sizeof(magic));
+  if(magic != compressedMagic)
+  {
+    InBinaryMemory stream(data, size);
+    stream >> queue;
+    return true;
+  }
+
+  const char* compressed = reinterpret_cast<const char*>(data) + sizeof(magic);
+  const size_t compressedSize = size - sizeof(magic);
+  size_t uncompressedSize;
+  if(snappy_uncompressed_length(compressed, compressedSize, &uncompressedSize) != SNAPPY_OK)
+    return false;
+  std::vector<char> buffer(uncompressedSize);
+  if(snappy_uncompress(compressed, compressedSize, buffer.data(), &uncompressedSize) != SNAPPY_OK)
+    return false;
+  InBinaryMemory stream(buffer.data(), uncompressedSize);
+  stream >> queue;
+  return true;
+}
+
+bool DebugTransport::isBulk(MessageID id)
+{
+  switch(id)
+  {
+    case idCameraImage:
+    case idCompressedCameraImage:
+    case idJPEGImage:
+    case idThumbnail:
+    case idDebugImage:
+    case idDebugDrawing:
+    case idDebugDrawing3D:
+      return true;
+    default:
+      return false;
+  }
+}
+
+void DebugTransport::pack(MessageQueue& out, std::vector<unsigned char>& packet)
+{
+  ASSERT(!out.isEmpty());
+  if(!initialized)
+  {
+    packetQueue.setSize(out.getSize());
+    deferredQueue.setSize(out.getSize());
+    initialized = true;
+  }
+
+  PacketSplitter splitter(packetQueue, deferredQueue, getBulkBudget());
+  out.handleAllMessages(splitter);
+  out.clear();
+  deferredQueue.moveAllMessages(out);
+
+  const char* data = packetQueue.getStreamedData();
+  const size_t size = packetQueue.getStreamedSize();
+  size_t compressedSize = 0;
+  if(compress)
+  {
+    compressedSize = snappy_max_compressed_length(size);
+    packet.resize(sizeof(compressedMagic) + compressedSize);
+    std::memcpy(packet.data(), &compressedMagic, sizeof(compressedMagic));
+    if(snappy_compress(data, size, reinterpret_cast<char*>(packet.data()) + sizeof(compressedMagic), &compressedSize) != SNAPPY_OK)
+      compressedSize = 0;
+  }
+
+  // Images are usually compressed already, so compression might not pay off.
+  if(compressedSize && sizeof(compressedMagic) + compressedSize < size)
+    packet.resize(sizeof(compressedMagic) + compressedSize);
+  else
+    packet.assign(data, data + size);
+  packetQueue.clear();
+}
+
+void DebugTransport::acknowledged(size_t size, int duration)
+{
+  if(size >= minMeasuredSize)
+  {
+    const float measured = static_cast<float>(size) * 1000.f / static_cast<float>(std::max(duration, 1));
+    throughput = 0.7f * throughput + 0.3f * measured;
+  }
+}
+
+void DebugTransport::reset()
+{
+  compress = false;
+  throughput = initialThroughput;
+}
+
+size_t DebugTransport::getBulkBudget() const
+{
+  return std::max(minBulkBudget, static_cast<size_t>(throughput * maxBulkDuration));
+}
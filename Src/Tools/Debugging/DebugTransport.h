@@ -0,0 +1,107 @@
+/**
+ * @file Tools/Debugging/DebugTransport.h
+ *
+ * The packet format and scheduling of debug data exchanged between a robot
+ * and a PC over a TcpConnection.
+ *
+ * A packet is normally a streamed MessageQueue. Right after connecting, the
+ * PC sends a hello packet that announces its capabilities. It is an empty
+ * queue followed by a magic number, so older robots simply ignore it. Only
+ * if the hello announced snappy support, the robot sends packets that are
+ * compressed, which are marked by a magic number in their first word.
+ *
+ * When building a packet, bulk data (images and drawings) is limited to the
+ * amount that can be transmitted within a short time at the throughput
+ * measured for the previous packets. Bulk messages that do not fit remain
+ * in the queue, together with the brackets of their frame, and are
+ * replaced by newer data from the same thread when the queue removes
+ * repetitions. All other messages are always sent, so text and debug
+ * responses never wait behind a long transfer of images.
+ */
+
+#pragma once
+
+#include "Tools/MessageQueue/MessageQueue.h"
+#include <vector>
+
+class DebugTransport
+{
+public:
+  static constexpr unsigned helloMagic = 0x54444842; /**< "BHDT" in the hello packet. */
+  static constexpr unsigned compressedMagic = 0xfffffffe; /**< The first word of a compressed packet. */
+  static constexpr unsigned snappyCapability = 1; /**< The peer can decompress snappy packets. */
+
+  static constexpr float maxBulkDuration = 0.1f; /**< The time the bulk data in a packet may take to transmit (in s). */
+  static constexpr size_t minBulkBudget = 16384; /**< The bulk data that is always allowed per packet (in bytes). */
+  static constexpr size_t minMeasuredSize = 16384; /**< Smaller packets do not update the throughput. */
+  static constexpr float initialThroughput = 1000000.f; /**< The throughput assumed before it was measured (in bytes/s). */
+
+  bool compress = false; /**< Compress outgoing packets? Set when the peer announced support. */
+
+  /**
+   * Creates the packet the PC sends right after connecting.
+   * @return The packet.
+   */
+  static std::vector<unsigned char> hello();
+
+  /**
+   * Checks whether a received packet is a hello.
+   * @param data The packet.
+   * @param size The size of the packet.
+   * @param capabilities Receives the capabilities of the peer if it is a hello.
+   * @return Is it a hello packet?
+   */
+  static bool isHello(const unsigned char* data, int size, unsigned& capabilities);
+
+  /**
+   * Appends the messages of a received packet to a queue.
+   * @param data The packet.
+   * @param size The size of the packet.
+   * @param queue The queue the messages are added to.
+   * @return Could the packet be decoded?
+   */
+  static bool unpack(const unsigned char* data, int size, MessageQueue& queue);
+
+  /**
+   * Is a message bulk data that is subject to the rate limit?
+   * @param id The id of the message.
+   * @return Is it bulk data?
+   */
+  static bool isBulk(MessageID id);
+
+  /**
+   * Creates a packet from the messages in a queue. The messages sent are
+   * removed from the queue, the bulk messages deferred remain.
+   * @param out The queue. It must not be empty.
+   * @param packet Receives the packet.
+   */
+  void pack(MessageQueue& out, std::vector<unsigned char>& packet);
+
+  /**
+   * Updates the throughput when a packet was acknowledged by the peer.
+   * @param size The size of the packet.
+   * @param duration The time between sending the packet and receiving the acknowledgement (in ms).
+   */
+  void acknowledged(size_t size, int duration);
+
+  /** Forgets everything learned about the peer, e.g. after the connection was lost. */
+  void reset();
+
+  /**
+   * Returns the number of bulk bytes allowed per packet.
+   * @return The budget in bytes.
+   */
+  size_t getBulkBudget() const;
+
+  /**
+   * Returns the throughput measured.
+   * @return The throughput in bytes/s.
+   */
+  float getThroughput() const {return throughput;}
+
+private:
+  float throughput = initialThroughput; /**< The throughput measured (in bytes/s). */
+  MessageQueue packetQueue; /**< The messages that are sent. */
+  MessageQueue deferredQueue; /**< The bulk messages that are deferred. */
+  bool initialized = false; /**< Were the sizes of the queues set? */
+};
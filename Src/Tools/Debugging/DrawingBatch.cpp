@@ -0,0 +1,194 @@
+/**
+ * @file Tools/Debugging/DrawingBatch.cpp
+ *
+ * Implementation of the compact encoding of debug drawing primitives.
+ */
+
+#include "DrawingBatch.h"
+#include "Tools/Math/Angle.h"
+#include "Tools/MessageQueue/OutMessage.h"
+#include "Tools/Streams/InOut.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+DrawingBatch::Reader::Reader(In& stream) :
+  stream(stream)
+{
+  stream >> numOfShapes;
+}
+
+bool DrawingBatch::Reader::next()
+{
+  if(!numOfShapes)
+    return false;
+  --numOfShapes;
+  signed char exponent;
+  stream >> exponent;
+  scale = std::ldexp(1.f, -exponent);
+  return true;
+}
+
+float DrawingBatch::Reader::coordinate()
+{
+  short value;
+  stream >> value;
+  return static_cast<float>(value) * scale;
+}
+
+float DrawingBatch::Reader::angle()
+{
+  short value;
+  stream >> value;
+  return static_cast<float>(value) / 4096.f;
+}
+
+char DrawingBatch::Reader::byte()
+{
+  char value;
+  stream >> value;
+  return value;
+}
+
+unsigned short DrawingBatch::Reader::number()
+{
+  unsigned short value;
+  stream >> value;
+  return value;
+}
+
+ColorRGBA DrawingBatch::Reader::color()
+{
+  unsigned char index;
+  stream >> index;
+  if(index == palette.size())
+  {
+    palette.emplace_back();
+    stream.read(&palette.back(), sizeof(ColorRGBA));
+  }
+  return palette[index];
+}
+
+const std::string& DrawingBatch::Reader::string()
+{
+  unsigned short index;
+  stream >> index;
+  if(index == strings.size())
+  {
+    unsigned short length;
+    stream >> length;
+    strings.emplace_back(length, '\0');
+    if(length)
+      stream.read(&strings.back()[0], length);
+  }
+  return strings[index];
+}
+
+DrawingBatch& DrawingBatch::begin(OutMessage& out, MessageID message, char shapeType, char id)
+{
+  // A primitive adds at most three colors, so the palette must not be full afterwards.
+  if(message != this->message || shapeType != this->shapeType || id != this->id
+     || data.size() >= maxSize
+     || palette.size() > std::numeric_limits<unsigned char>::max() - 3
+     || strings.size() >= std::numeric_limits<unsigned short>::max()
+     || numOfShapes == std::numeric_limits<unsigned short>::max())
+  {
+    flush(out);
+    this->message = message;
+    this->shapeType = shapeType;
+    this->id = id;
+  }
+  else if(!empty())
+    finishShape();
+  ++numOfShapes;
+  shapeStart = data.size();
+  data.push_back(0); // The exponent is filled in by finishShape.
+  return *this;
+}
+
+DrawingBatch& DrawingBatch::addAngle(float value)
+{
+  if(std::abs(value) > pi2)
+    value = Angle::normalize(value);
+  const short quantized = static_cast<short>(std::lround(value * 4096.f));
+  data.insert(data.end(), reinterpret_cast<const char*>(&quantized), reinterpret_cast<const char*>(&quantized + 1));
+  return *this;
+}
+
+DrawingBatch& DrawingBatch::addNumber(unsigned short value)
+{
+  data.insert(data.end(), reinterpret_cast<const char*>(&value), reinterpret_cast<const char*>(&value + 1));
+  return *this;
+}
+
+DrawingBatch& DrawingBatch::addColor(const ColorRGBA& color)
+{
+  unsigned key;
+  static_assert(sizeof(key) == sizeof(color), "ColorRGBA must have 32 bits");
+  std::memcpy(&key, &color, sizeof(key));
+  auto i = palette.find(key);
+  if(i != palette.end())
+    data.push_back(static_cast<char>(i->second));
+  else
+  {
+    const unsigned char index = static_cast<unsigned char>(palette.size());
+    palette.emplace(key, index);
+    data.push_back(static_cast<char>(index));
+    data.insert(data.end(), reinterpret_cast<const char*>(&color), reinterpret_cast<const char*>(&color + 1));
+  }
+  return *this;
+}
+
+DrawingBatch& DrawingBatch::addString(const std::string& string)
+{
+  auto i = strings.find(string);
+  if(i != strings.end())
+    addNumber(i->second);
+  else
+  {
+    const unsigned short index = static_cast<unsigned short>(strings.size());
+    strings.emplace(string, index);
+    addNumber(index);
+    const unsigned short length = static_cast<unsigned short>(std::min(string.size(), static_cast<size_t>(std::numeric_limits<unsigned short>::max())));
+    addNumber(length);
+    data.insert(data.end(), string.data(), string.data() + length);
+  }
+  return *this;
+}
+
+void DrawingBatch::finishShape()
+{
+  // Use the finest scale at which the largest absolute value still fits into a short.
+  float maxAbs = 0.f;
+  for(const auto& coordinate : coordinates)
+    maxAbs = std::max(maxAbs, std::abs(coordinate.second));
+  int exponent = maxExponent;
+  while(exponent > minExponent && maxAbs * std::ldexp(1.f, exponent) > static_cast<float>(std::numeric_limits<short>::max()))
+    --exponent;
+  const float scale = std::ldexp(1.f, exponent);
+
+  data[shapeStart] = static_cast<char>(exponent);
+  for(const auto& coordinate : coordinates)
+  {
+    const short quantized = static_cast<short>(std::max(static_cast<float>(std::numeric_limits<short>::min()),
+                                                        std::min(static_cast<float>(std::numeric_limits<short>::max()), std::round(coordinate.second * scale))));
+    std::memcpy(&data[coordinate.first], &quantized, sizeof(quantized));
+  }
+  coordinates.clear();
+}
+
+void DrawingBatch::flush(OutMessage& out)
+{
+  if(empty())
+    return;
+
+  finishShape();
+  out.bin << static_cast<char>(static_cast<unsigned char>(shapeType) | batched) << id << numOfShapes;
+  out.bin.write(data.data(), data.size());
+  out.finishMessage(message);
+
+  numOfShapes = 0;
+  data.clear();
+  palette.clear();
+  strings.clear();
+}
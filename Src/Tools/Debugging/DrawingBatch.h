@@ -0,0 +1,135 @@
+/**
+ * @file Tools/Debugging/DrawingBatch.h
+ *
+ * The compact encoding of debug drawing primitives.
+ *
+ * Consecutive primitives of the same shape type that belong to the same
+ * drawing are collected and sent as a single message. The shape type in its
+ * header is marked with the flag DrawingBatch::batched, so that messages in
+ * the original format (e.g. in older log files) can still be decoded.
+ *
+ * A batch message contains:
+ * - the shape type (with the flag set) and the drawing id as chars,
+ * - the number of primitives (unsigned short),
+ * - the primitives. Each starts with the scale of its coordinates as exponent
+ *   of 2 (signed char), followed by its fields in the order they were added.
+ *   Coordinates are shorts, i.e. quantized with the scale that fits the
+ *   largest absolute value of this primitive into 16 bits. Thereby, a
+ *   primitive far away from the origin does not reduce the resolution of the
+ *   others.
+ * Colors are indices into a palette and strings are indices into a string
+ * table. Both are built while the batch is written: an index that equals the
+ * number of entries so far is followed by the new entry. The palette and the
+ * string table only live as long as the batch, so each message can be
+ * decoded on its own.
+ */
+
+#pragma once
+
+#include "Tools/Debugging/ColorRGBA.h"
+#include "Tools/MessageQueue/MessageIDs.h"
+#include <cmath>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class In;
+class OutMessage;
+
+class DrawingBatch
+{
+public:
+  static constexpr unsigned char batched = 0x80; /**< The flag in the shape type of a batch message. */
+  static constexpr size_t maxSize = 16384; /**< A batch is sent when it reaches this size (in bytes). */
+
+  /** Decodes the fields of a batch message in the order they were written. */
+  class Reader
+  {
+  public:
+    /**
+     * Reads the header that follows the shape type and the drawing id.
+     * @param stream The stream the batch is read from.
+     */
+    Reader(In& stream);
+
+    /**
+     * Starts reading the next primitive.
+     * @return Is there another primitive in this batch?
+     */
+    bool next();
+
+    float coordinate();
+    int integer() {return static_cast<int>(std::lround(coordinate()));}
+    float angle();
+    char byte();
+    unsigned short number();
+    ColorRGBA color();
+    const std::string& string();
+
+  private:
+    In& stream;
+    unsigned short numOfShapes; /**< The number of primitives that were not read yet. */
+    float scale = 1.f; /**< The factor that converts the quantized coordinates of the current primitive back. */
+    std::vector<ColorRGBA> palette;
+    std::vector<std::string> strings;
+  };
+
+  /** Is no primitive waiting to be sent? */
+  bool empty() const {return !numOfShapes;}
+
+  /**
+   * Starts a new primitive. If it cannot be appended to the current batch,
+   * the current batch is sent first.
+   * @param out The message queue the batch is sent to.
+   * @param message The id of the message (idDebugDrawing or idDebugDrawing3D).
+   * @param shapeType The shape type of the primitive.
+   * @param id The id of the drawing the primitive belongs to.
+   * @return This batch, to which the fields of the primitive are added.
+   */
+  DrawingBatch& begin(OutMessage& out, MessageID message, char shapeType, char id);
+
+  /** Adds a coordinate or a length in the coordinate system of the drawing. */
+  DrawingBatch& addCoordinate(float value)
+  {
+    coordinates.emplace_back(data.size(), value);
+    data.resize(data.size() + sizeof(short));
+    return *this;
+  }
+
+  /** Adds an angle (with a resolution of 1/4096 rad). */
+  DrawingBatch& addAngle(float value);
+
+  DrawingBatch& addByte(char value)
+  {
+    data.push_back(value);
+    return *this;
+  }
+
+  DrawingBatch& addNumber(unsigned short value);
+  DrawingBatch& addColor(const ColorRGBA& color);
+  DrawingBatch& addString(const std::string& string);
+
+  /**
+   * Sends the current batch if it is not empty.
+   * @param out The message queue the batch is sent to.
+   */
+  void flush(OutMessage& out);
+
+private:
+  /** Quantizes the coordinates of the current primitive and stores their scale. */
+  void finishShape();
+
+  static constexpr int minExponent = -8; /**< The coarsest scale is 1/256. */
+  static constexpr int maxExponent = 12; /**< The finest scale is 4096. */
+
+  MessageID message = undefined;
+  char shapeType = 0;
+  char id = 0;
+  unsigned short numOfShapes = 0;
+  size_t shapeStart = 0; /**< The offset of the current primitive in data. */
+  std::vector<std::pair<size_t, float>> coordinates; /**< The coordinates of the current primitive with their offsets in data. */
+  std::vector<char> data;
+  std::unordered_map<unsigned, unsigned char> palette; /**< Maps colors (as 32 bit) to their indices. */
+  std::unordered_map<std::string, unsigned short> strings;
+};
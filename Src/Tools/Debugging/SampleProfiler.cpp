@@ -0,0 +1,140 @@
+/**
+ * @file SampleProfiler.cpp
+ *
+ * Implementation of a sampling profiler.
+ */
+
+#include "SampleProfiler.h"
+#include "Platform/Thread.h"
+#include "Platform/SystemCall.h"
+#include <algorithm>
+
+/**
+ * The thread that samples the shadow stacks of all registered profilers.
+ * It is started when profiling is enabled for the first time.
+ */
+class SampleProfilerThread
+{
+private:
+  std::mutex mutex; /**< Protects the list of profilers. */
+  std::vector<SampleProfiler*> profilers; /**< All profilers that currently exist. */
+  Thread thread;
+  bool started = false;
+
+  void run()
+  {
+    Thread::nameCurrentThread("SampleProfiler");
+    while(thread.isRunning())
+    {
+      Thread::sleep(SampleProfiler::samplingInterval);
+      std::lock_guard<std::mutex> lock(mutex);
+      for(SampleProfiler* profiler : profilers)
+        if(profiler->enabled.load(std::memory_order_relaxed))
+          profiler->sample();
+    }
+  }
+
+public:
+  static SampleProfilerThread& getInstance()
+  {
+    static SampleProfilerThread instance;
+    return instance;
+  }
+
+  ~SampleProfilerThread()
+  {
+    if(started)
+      thread.stop();
+  }
+
+  void add(SampleProfiler* profiler)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    profilers.push_back(profiler);
+  }
+
+  void remove(SampleProfiler* profiler)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    profilers.erase(std::remove(profilers.begin(), profilers.end(), profiler), profilers.end());
+  }
+
+  void start()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if(!started)
+    {
+      started = true;
+      thread.start(this, &SampleProfilerThread::run);
+      // The sampler must preempt the threads it samples.
+      if(SystemCall::getMode() == SystemCall::physicalRobot)
+        thread.setPriority(50);
+    }
+  }
+};
+
+SampleProfiler::SampleProfiler()
+{
+  for(std::atomic<const char*>& frame : frames)
+    frame.store(nullptr, std::memory_order_relaxed);
+  SampleProfilerThread::getInstance().add(this);
+}
+
+SampleProfiler::~SampleProfiler()
+{
+  SampleProfilerThread::getInstance().remove(this);
+}
+
+void SampleProfiler::setEnabled(bool enable)
+{
+  if(enable == enabled.load(std::memory_order_relaxed))
+    return;
+
+  if(enable)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      samples.clear();
+      numOfDiscardedSamples = 0;
+    }
+    depth.store(0, std::memory_order_relaxed);
+    SampleProfilerThread::getInstance().start();
+  }
+  enabled.store(enable, std::memory_order_relaxed);
+}
+
+void SampleProfiler::sample()
+{
+  // Sequence lock: the copy is only valid if no change was in progress and none happened while copying.
+  std::array<const char*, maxDepth> stack;
+  const unsigned before = generation.load(std::memory_order_acquire);
+  const unsigned depth = std::min(this->depth.load(std::memory_order_relaxed), maxDepth);
+  for(unsigned i = 0; i < depth; ++i)
+    stack[i] = frames[i].load(std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const unsigned after = generation.load(std::memory_order_relaxed);
+
+  std::lock_guard<std::mutex> lock(mutex);
+  if(before != after || (before & 1))
+    ++numOfDiscardedSamples;
+  else
+    ++samples[std::vector<const char*>(stack.begin(), stack.begin() + depth)];
+}
+
+std::string SampleProfiler::getFoldedStacks() const
+{
+  std::string lines;
+  std::lock_guard<std::mutex> lock(mutex);
+  for(const auto& sample : samples)
+  {
+    lines += name;
+    for(const char* frame : sample.first)
+      lines += std::string(";") + frame;
+    if(sample.first.empty())
+      lines += ";[idle]";
+    lines += " " + std::to_string(sample.second) + "\n";
+  }
+  if(numOfDiscardedSamples)
+    lines += name + ";[discarded] " + std::to_string(numOfDiscardedSamples) + "\n";
+  return lines;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file SampleProfiler.h
+ *
+ * Declaration of a sampling profiler. Each thread owns a shadow stack that
+ * contains the names of the providers and stopwatches it is currently
+ * executing. While profiling is enabled for a thread, a separate sampling
+ * thread copies its shadow stack periodically and counts how often each stack
+ * was seen. The counts can be exported in the folded format of flame graph
+ * tools, i.e. one line "Thread;frame;frame;... count" per stack.
+ *
+ * If profiling is disabled, pushing and popping only cost a relaxed load of a
+ * flag.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class SampleProfiler
+{
+public:
+  static constexpr unsigned maxDepth = 32; /**< Deeper stacks are cut off. */
+  static constexpr unsigned samplingInterval = 1; /**< The time between two samples in ms. */
+
+  SampleProfiler();
+  ~SampleProfiler();
+
+  /**
+   * Sets the name of the thread that is used as root of all stacks.
+   * @param name The name of the thread.
+   */
+  void setName(const std::string& name) {this->name = name;}
+
+  /**
+   * Enables or disables sampling of this thread. Must be called by the owning
+   * thread while its shadow stack is empty, e.g. at the beginning of a frame.
+   * Enabling a disabled profiler discards all previous samples.
+   * @param enable Should this thread be sampled?
+   */
+  void setEnabled(bool enable);
+
+  /**
+   * Adds a frame to the shadow stack of this thread.
+   * @param frame The name of the frame. It must stay valid as long as the
+   *              profiler exists, i.e. usually a string literal or the name of
+   *              a module or representation.
+   */
+  void push(const char* frame)
+  {
+    if(enabled.load(std::memory_order_relaxed))
+    {
+      beginChange();
+      const unsigned depth = this->depth.load(std::memory_order_relaxed);
+      if(depth < maxDepth)
+        frames[depth].store(frame, std::memory_order_relaxed);
+      this->depth.store(depth + 1, std::memory_order_relaxed);
+      endChange();
+    }
+  }
+
+  /** Removes the topmost frame from the shadow stack of this thread. */
+  void pop()
+  {
+    if(enabled.load(std::memory_order_relaxed))
+    {
+      beginChange();
+      depth.store(depth.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+      endChange();
+    }
+  }
+
+  /**
+   * Returns the samples collected so far in the folded format, one line per stack.
+   * Stacks sampled while the thread was not executing anything end in "[idle]".
+   * @return The lines, each terminated by a line feed.
+   */
+  std::string getFoldedStacks() const;
+
+private:
+  std::string name; /**< The name of the thread. */
+  std::atomic<bool> enabled{false}; /**< Is this thread sampled? */
+  std::atomic<unsigned> depth{0}; /**< The number of frames on the shadow stack (may exceed maxDepth). */
+  std::atomic<unsigned> generation{0}; /**< Odd while the shadow stack is changed. Used to detect torn samples. */
+  std::array<std::atomic<const char*>, maxDepth> frames; /**< The shadow stack. */
+
+  mutable std::mutex mutex; /**< Protects the samples. */
+  std::map<std::vector<const char*>, unsigned> samples; /**< How often was each stack seen? */
+  unsigned numOfDiscardedSamples = 0; /**< Samples that were dropped because the stack changed while it was copied. */
+
+  /** Marks the shadow stack as being changed (only called by the owning thread). */
+  void beginChange()
+  {
+    generation.store(generation.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  /** Marks the change of the shadow stack as finished (only called by the owning thread). */
+  void endChange()
+  {
+    generation.store(generation.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  /** Takes a sample of the shadow stack. Called by the sampling thread. */
+  void sample();
+
+  friend class SampleProfilerThread;
+};
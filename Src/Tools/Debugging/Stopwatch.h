@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "SampleProfiler.h"
 #include "TimingManager.h"
 #include "Debugging.h"
 
@@ -22,13 +23,18 @@ public:
    * Start the stopwatch.
    * @param name The name of the plot.
    */
-  Stopwatch(const char* name) : name(name) {Global::getTimingManager().startTiming(name + 15);}
+  Stopwatch(const char* name) : name(name)
+  {
+    Global::getSampleProfiler().push(name + 15);
+    Global::getTimingManager().startTiming(name + 15);
+  }
 
   /** Stop the stopwatch.*/
   ~Stopwatch()
   {
     const unsigned time = Global::getTimingManager().stopTiming(name + 15);
     static_cast<void>(time);
+    Global::getSampleProfiler().pop();
     DEBUG_RESPONSE(name)
       OUTPUT(idPlot, bin, (name + 5) << static_cast<float>(time) * 0.001f);
   }
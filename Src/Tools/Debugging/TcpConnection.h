@@ -89,6 +89,13 @@ public:
    */
   bool isConnected() const { return tcpComm && tcpComm->connected(); }
 
+  /**
+   * The function states whether the next call of sendAndReceive would send
+   * data, i.e. whether a receiver got an acknowledgement for its last packet.
+   * @return Can data be sent?
+   */
+  bool isAcknowledged() const { return handshake != receiver || ack; }
+
   /**
    * The function states whether this system is the client in the connection.
    * @return Is it the client?
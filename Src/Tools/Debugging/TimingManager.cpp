@@ -9,6 +9,7 @@
 #include <unordered_map>
 #include <vector>
 #include "Platform/BHAssert.h"
+#include "Platform/Memory.h"
 #include "Platform/Time.h"
 #include "Debugging.h"
 #include "Tools/MessageQueue/MessageQueue.h"
@@ -37,6 +38,8 @@ struct TimingManager::Pimpl
   bool threadRunning = false; /**< Is a thread iteration running right now? */
   bool dataPrepared = false; /**< True if data hs already been prepared this frame */
   int watchNameIndex = 0; /**< Every frame a few watch names are transmitted. This is the index of the watchname that is to be transmitted next */
+  unsigned allocations = 0; /**< The number of heap allocations of the thread. While running: the count at the start of the iteration. Else: during the iteration. */
+  size_t allocatedBytes = 0; /**< The number of bytes allocated by the thread. While running: the count at the start of the iteration. Else: during the iteration. */
 };
 
 TimingManager::TimingManager() : prvt(new TimingManager::Pimpl)
@@ -81,11 +84,15 @@ void TimingManager::signalThreadStart()
   prvt->dataPrepared = false;
   for(const pair<const char* const, unsigned long long>& it : prvt->timing)
     prvt->timing[it.first] = 0;
+  prvt->allocations = Memory::getNumOfAllocations();
+  prvt->allocatedBytes = Memory::getNumOfAllocatedBytes();
 }
 
 void TimingManager::signalThreadStop()
 {
   prvt->threadRunning = false;
+  prvt->allocations = Memory::getNumOfAllocations() - prvt->allocations;
+  prvt->allocatedBytes = Memory::getNumOfAllocatedBytes() - prvt->allocatedBytes;
 }
 
 MessageQueue& TimingManager::getData()
@@ -114,6 +121,8 @@ void TimingManager::prepareData()
    *
    * unsigned : timestamp at which the last iteration started.
    * unsigned : frame number of the current frame
+   * unsigned : number of heap allocations during the last iteration
+   * unsigned : number of bytes allocated during the last iteration
    */
   OutBinaryMessage& out = prvt->data.out.bin;
 
@@ -134,6 +143,7 @@ void TimingManager::prepareData()
   }
   out << prvt->currentThreadStartTime;
   out << prvt->frameNo;
+  out << prvt->allocations << static_cast<unsigned>(prvt->allocatedBytes);
   if(!prvt->data.out.finishMessage(idStopwatch))
     OUTPUT_WARNING("TimingManager: queue is full!!!");
 }
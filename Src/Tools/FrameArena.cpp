@@ -0,0 +1,53 @@
+/**
+ * @file Tools/FrameArena.cpp
+ *
+ * Implementation of a memory arena for data that only lives during a single frame.
+ */
+
+#include "FrameArena.h"
+#include "Platform/Memory.h"
+#include <algorithm>
+
+FrameArena::~FrameArena()
+{
+  for(char* block : overflowBlocks)
+    Memory::alignedFree(block);
+  Memory::alignedFree(begin);
+}
+
+void FrameArena::reset()
+{
+  if(!overflowBlocks.empty())
+  {
+    const std::size_t required = getUsed();
+    for(char* block : overflowBlocks)
+      Memory::alignedFree(block);
+    overflowBlocks.clear();
+    Memory::alignedFree(begin);
+    const std::size_t size = std::max(minBlockSize, required + required / 2);
+    begin = static_cast<char*>(Memory::alignedMalloc(size, 64));
+    end = begin + size;
+  }
+  blockBegin = top = begin;
+  overflowUsed = 0;
+}
+
+void* FrameArena::allocateBlock(std::size_t size, std::size_t alignment)
+{
+  if(!begin)
+  {
+    // The first allocation ever.
+    begin = static_cast<char*>(Memory::alignedMalloc(std::max(minBlockSize, size + alignment), 64));
+    end = begin + std::max(minBlockSize, size + alignment);
+    blockBegin = top = begin;
+    return allocate(size, alignment);
+  }
+
+  // The current block is full: continue in an additional one.
+  overflowUsed += top - blockBegin;
+  const std::size_t blockSize = std::max(minBlockSize, size + alignment);
+  overflowBlocks.emplace_back(static_cast<char*>(Memory::alignedMalloc(blockSize, 64)));
+  blockBegin = top = overflowBlocks.back();
+  end = top + blockSize;
+  return allocate(size, alignment);
+}
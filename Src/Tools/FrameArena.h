@@ -0,0 +1,112 @@
+/**
+ * @file Tools/FrameArena.h
+ *
+ * A memory arena for data that only lives during a single frame of a thread.
+ * Each thread owns an arena that is reset at the beginning of each frame.
+ * Allocating is just advancing a pointer and freeing does nothing. If the
+ * memory of a frame did not fit into the arena, it is enlarged when it is
+ * reset, so after a few frames, no heap allocations are required anymore.
+ *
+ * Containers using a FrameAllocator must be destroyed before the frame
+ * ends. The only exception are containers of trivially destructible
+ * elements, which may also be cleared or destroyed in a later frame, as
+ * long as they are not accessed otherwise.
+ */
+
+#pragma once
+
+#include "Tools/Global.h"
+#include <cstddef>
+#include <vector>
+
+class FrameArena
+{
+public:
+  static constexpr std::size_t minBlockSize = 65536; /**< The minimum size of a block allocated from the heap. */
+
+  FrameArena() = default;
+  FrameArena(const FrameArena&) = delete;
+  FrameArena& operator=(const FrameArena&) = delete;
+  ~FrameArena();
+
+  /**
+   * Allocates memory that stays valid until the next reset.
+   * @param size The number of bytes.
+   * @param alignment The alignment. Must be a power of 2.
+   * @return The memory.
+   */
+  void* allocate(std::size_t size, std::size_t alignment)
+  {
+    char* const aligned = reinterpret_cast<char*>((reinterpret_cast<std::size_t>(top) + alignment - 1) & ~(alignment - 1));
+    if(aligned + size <= end)
+    {
+      top = aligned + size;
+      return aligned;
+    }
+    else
+      return allocateBlock(size, alignment);
+  }
+
+  /**
+   * Frees all memory allocated. If additional blocks were required since the
+   * last reset, they are replaced by a single block that is large enough.
+   */
+  void reset();
+
+  /**
+   * Returns the number of bytes allocated since the last reset.
+   * @return The number of bytes including padding.
+   */
+  std::size_t getUsed() const {return overflowUsed + (top - blockBegin);}
+
+  /**
+   * Returns the size of the main block, i.e. the memory a frame can use
+   * without allocating from the heap.
+   * @return The capacity in bytes.
+   */
+  std::size_t getCapacity() const {return end - begin;}
+
+private:
+  char* begin = nullptr; /**< The main block. */
+  char* blockBegin = nullptr; /**< The current block. */
+  char* top = nullptr; /**< The next free byte in the current block. */
+  char* end = nullptr; /**< The end of the current block. */
+  std::vector<char*> overflowBlocks; /**< Additional blocks allocated since the last reset. */
+  std::size_t overflowUsed = 0; /**< The bytes used in the blocks before the current one. */
+
+  /**
+   * Allocates memory from a new block, because the current one is full.
+   * @param size The number of bytes.
+   * @param alignment The alignment. Must be a power of 2.
+   * @return The memory.
+   */
+  void* allocateBlock(std::size_t size, std::size_t alignment);
+};
+
+/**
+ * A standard allocator that allocates from the frame arena of the current
+ * thread or from a given arena.
+ */
+template<typename T> class FrameAllocator
+{
+private:
+  FrameArena* arena;
+
+  template<typename U> friend class FrameAllocator;
+
+public:
+  using value_type = T;
+
+  FrameAllocator() : arena(&Global::getFrameArena()) {}
+  FrameAllocator(FrameArena& arena) : arena(&arena) {}
+  template<typename U> FrameAllocator(const FrameAllocator<U>& other) : arena(other.arena) {}
+
+  T* allocate(std::size_t n) {return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));}
+  void deallocate(T*, std::size_t) {}
+
+  template<typename U> bool operator==(const FrameAllocator<U>& other) const {return arena == other.arena;}
+  template<typename U> bool operator!=(const FrameAllocator<U>& other) const {return arena != other.arena;}
+};
+
+/** A vector for the current frame. */
+template<typename T> using FrameVector = std::vector<T, FrameAllocator<T>>;
@@ -11,6 +11,7 @@
 #include "Platform/Time.h"
 #include "Threads/Debug.h"
 #include "Tools/Framework/FrameExecutionUnit.h"
+#include "Tools/Debugging/SampleProfiler.h"
 #include "Tools/Logging/Logger.h"
 #include "Tools/Math/Constants.h"
 
@@ -88,12 +89,18 @@ bool ModuleContainer::main()
 
   if((executionUnit->beforeFrame() || moduleGraphRunner.hasChanged()) && moduleGraphRunner.isValid())
   {
+    bool sampleProfilerEnabled = false;
+    DEBUG_RESPONSE("timing:sampleProfiler") sampleProfilerEnabled = true;
+    Global::getSampleProfiler().setEnabled(sampleProfilerEnabled);
+
     Global::getTimingManager().signalThreadStart();
     Global::getAnnotationManager().signalThreadStart();
 
     executionUnit->beforeModules();
     STOPWATCH("AllModules") moduleGraphRunner.execute();
     executionUnit->afterModules();
+    Global::getDrawingManager().flush();
+    Global::getDrawingManager3D().flush();
 
     DEBUG_RESPONSE_ONCE("automated requests:DrawingManager") OUTPUT(idDrawingManager, bin, Global::getDrawingManager());
     DEBUG_RESPONSE_ONCE("automated requests:DrawingManager3D") OUTPUT(idDrawingManager3D, bin, Global::getDrawingManager3D());
@@ -109,6 +116,7 @@ bool ModuleContainer::main()
     logger->execute(getName());
 
     DEBUG_RESPONSE("timing") Global::getTimingManager().getData().copyAllMessages(*debugSender);
+    DEBUG_RESPONSE_ONCE("timing:sampleProfiler:dump") OUTPUT(idSampleProfile, bin, Global::getSampleProfiler().getFoldedStacks());
 
     DEBUG_RESPONSE("annotation") Global::getAnnotationManager().getOut().copyAllMessages(*debugSender);
     Global::getAnnotationManager().clear();
@@ -55,7 +55,9 @@ void ThreadFrame::setGlobals()
   Global::theDebugDataTable = &debugDataTable;
   Global::theDrawingManager = &drawingManager;
   Global::theDrawingManager3D = &drawingManager3D;
+  Global::theFrameArena = &frameArena;
   Global::theTimingManager = &timingManager;
+  Global::theSampleProfiler = &sampleProfiler;
   Global::theAsmjitRuntime = asmjitRuntime;
 
   Blackboard::setInstance(blackboard); // blackboard is NOT globally accessible
@@ -75,6 +77,7 @@ void ThreadFrame::threadMain()
     setPriority(0);
   Thread::yield(); // always leave processing time to other threads
   setGlobals();
+  sampleProfiler.setName(getName());
   init();
   while(isRunning())
   {
@@ -82,6 +85,7 @@ void ThreadFrame::threadMain()
     handleAllMessages(*debugReceiver);
     debugReceiver->clear();
 
+    frameArena.reset();
     const bool shouldWait = main();
 
     if(Global::getDebugRequestTable().pollCounter > 0 &&
@@ -17,8 +17,10 @@
 #include "Tools/Debugging/DebugDataTable.h"
 #include "Tools/Debugging/DebugDrawings.h"
 #include "Tools/Debugging/DebugDrawings3D.h"
+#include "Tools/Debugging/SampleProfiler.h"
 #include "Tools/Debugging/TimingManager.h"
 #include "Tools/Framework/Communication.h"
+#include "Tools/FrameArena.h"
 #include "Tools/Module/Blackboard.h"
 #include "Tools/Settings.h"
 #ifdef TARGET_ROBOT
@@ -57,8 +59,10 @@ private:
   DebugDataTable debugDataTable; /**< The debug data table of this thread. */
   DrawingManager drawingManager;
   DrawingManager3D drawingManager3D;
+  FrameArena frameArena; /**< The memory for data that only lives during a single frame. */
   asmjit::JitRuntime* asmjitRuntime; /**< JIT and Remote Assembler for C++ in this thread. */
   TimingManager timingManager; /**< Keeps track of the module timing in this thread. */
+  SampleProfiler sampleProfiler; /**< Samples the providers and stopwatches executed by this thread. */
 
 public:
   /**
@@ -13,5 +13,7 @@ thread_local DebugRequestTable* Global::theDebugRequestTable = nullptr;
 thread_local DebugDataTable* Global::theDebugDataTable = nullptr;
 thread_local DrawingManager* Global::theDrawingManager = nullptr;
 thread_local DrawingManager3D* Global::theDrawingManager3D = nullptr;
+thread_local FrameArena* Global::theFrameArena = nullptr;
 thread_local TimingManager* Global::theTimingManager = nullptr;
+thread_local SampleProfiler* Global::theSampleProfiler = nullptr;
 thread_local asmjit::JitRuntime* Global::theAsmjitRuntime = nullptr;
@@ -15,7 +15,9 @@ class DebugRequestTable;
 class DebugDataTable;
 class DrawingManager;
 class DrawingManager3D;
+class FrameArena;
 class ReleaseOptions;
+class SampleProfiler;
 class TimingManager;
 namespace asmjit
 {
@@ -36,7 +38,9 @@ private:
   static thread_local DebugDataTable* theDebugDataTable;
   static thread_local DrawingManager* theDrawingManager;
   static thread_local DrawingManager3D* theDrawingManager3D;
+  static thread_local FrameArena* theFrameArena;
   static thread_local TimingManager* theTimingManager;
+  static thread_local SampleProfiler* theSampleProfiler;
   static thread_local asmjit::JitRuntime* theAsmjitRuntime;
 
 public:
@@ -94,12 +98,24 @@ public:
    */
   static DrawingManager3D& getDrawingManager3D() {return *theDrawingManager3D;}
 
+  /**
+   * The method returns a reference to the thread wide instance.
+   * @return The instance of the frame arena in this thread.
+   */
+  static FrameArena& getFrameArena() {return *theFrameArena;}
+
   /**
    * The method returns a reference to the thread wide instance.
    * @return the instance of the timing manager in this thread.
    */
   static TimingManager& getTimingManager() { return *theTimingManager; }
 
+  /**
+   * The method returns a reference to the thread wide instance.
+   * @return the instance of the sample profiler in this thread.
+   */
+  static SampleProfiler& getSampleProfiler() { return *theSampleProfiler; }
+
   /**
    * The method returns a reference to the thread wide instance.
    * @return the instance of the asmjit runtime in this thread.
@@ -0,0 +1,196 @@
+/**
+ * @file RunBoundaries.cpp
+ *
+ * Implementation of the search for boundaries between runs of equal bytes
+ * and of the horizontal scan lines built from them.
+ */
+
+#include "RunBoundaries.h"
+#include "SIMD.h"
+
+/**
+ * Returns the index of the lowest bit set.
+ * @param mask A mask that is not zero.
+ * @return The index.
+ */
+static ALWAYSINLINE unsigned lowestBit(unsigned mask)
+{
+#ifdef _MSC_VER
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return static_cast<unsigned>(index);
+#else
+  return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+/**
+ * Adds the positions of all bits set in a mask.
+ * @param mask The bits mark the boundaries.
+ * @param x The position that corresponds to bit 0.
+ * @param boundaries The positions are appended to this list.
+ */
+static ALWAYSINLINE void addBoundaries(unsigned mask, int x, std::vector<unsigned short>& boundaries)
+{
+  while(mask)
+  {
+    boundaries.emplace_back(static_cast<unsigned short>(x + lowestBit(mask)));
+    mask &= mask - 1;
+  }
+}
+
+void RunBoundaries::findSSE(const unsigned char* row, int from, int to, std::vector<unsigned short>& boundaries)
+{
+  boundaries.clear();
+  int x = from + 1;
+#ifdef __AVX2__
+  for(; x + 32 <= to; x += 32)
+  {
+    const __m256i current = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + x));
+    const __m256i previous = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + x - 1));
+    addBoundaries(~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(current, previous))), x, boundaries);
+  }
+#endif
+  for(; x + 16 <= to; x += 16)
+  {
+    const __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x));
+    const __m128i previous = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x - 1));
+    addBoundaries(~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(current, previous))) & 0xffff, x, boundaries);
+  }
+  for(; x < to; ++x)
+    if(row[x] != row[x - 1])
+      boundaries.emplace_back(static_cast<unsigned short>(x));
+}
+
+void RunBoundaries::find(const unsigned char* row, int from, int to, std::vector<unsigned short>& boundaries)
+{
+  boundaries.clear();
+  for(int x = from + 1; x < to; ++x)
+    if(row[x] != row[x - 1])
+      boundaries.emplace_back(static_cast<unsigned short>(x));
+}
+
+void RunBoundaries::scanHorizontal(const FieldColors::Color* row, int y, const ScanGrid& scanGrid, unsigned short minRegionSize,
+                                   const std::vector<unsigned short>& boundaries, std::vector<ScanLineRegion>& regions)
+{
+  // Replays scanHorizontalScalar, but skips from one color change to the next.
+  // Between two boundaries, the color is constant, so the pixels only increase the count.
+  unsigned short count = 0;
+  int x = 0;
+  auto boundary = boundaries.begin();
+
+  for(size_t i = scanGrid.lowResStart; i < scanGrid.lines.size(); i += scanGrid.lowResStep)
+  {
+    const ScanGrid::Line& line = scanGrid.lines[i];
+    if(line.yMax >= y)
+    {
+      if(count == 0)
+      {
+        x = line.x;
+        count = 1;
+      }
+      else
+      {
+        while(boundary != boundaries.end() && *boundary <= x)
+          ++boundary;
+        for(; boundary != boundaries.end() && *boundary <= line.x; ++boundary)
+        {
+          count += static_cast<unsigned short>(*boundary - x - 1);
+          x = *boundary;
+          if(count >= minRegionSize)
+          {
+            regions.emplace_back(x - count, x, row[x - 1]);
+            count = 1;
+          }
+          else if(!regions.empty())
+          {
+            count /= 2;
+            regions.back().range.right += count;
+          }
+        }
+        count += static_cast<unsigned short>(line.x - x);
+        x = line.x;
+      }
+    }
+    else if(count != 0)
+    {
+      if(count >= minRegionSize)
+        regions.emplace_back(x - count, x, row[x]);
+      else if(!regions.empty())
+        regions.back().range.right += count;
+      count = 0;
+    }
+  }
+
+  if(count != 0)
+  {
+    if(count >= minRegionSize)
+      regions.emplace_back(x - count, x, row[x]);
+    else if(!regions.empty())
+      regions.back().range.right += count;
+  }
+}
+
+void RunBoundaries::scanHorizontalScalar(const FieldColors::Color* row, int y, const ScanGrid& scanGrid, unsigned short minRegionSize,
+                                         std::vector<ScanLineRegion>& regions)
+{
+  FieldColors::Color curColor = FieldColors::Color::none;
+  unsigned short count = 0;
+  int x = 0;
+
+  for(size_t i = scanGrid.lowResStart; i < scanGrid.lines.size(); i += scanGrid.lowResStep)
+  {
+    const ScanGrid::Line& line = scanGrid.lines[i];
+    if(line.yMax >= y)
+    {
+      if(count == 0)
+      {
+        x = line.x;
+        count = 1;
+        curColor = row[x];
+      }
+      else
+      {
+        while(x < line.x)
+        {
+          x++;
+          const FieldColors::Color color = row[x];
+          if(color != curColor)
+          {
+            if(count >= minRegionSize)
+            {
+              regions.emplace_back(x - count, x, curColor);
+              count = 1;
+            }
+            else if(!regions.empty())
+            {
+              count /= 2;
+              regions.back().range.right += count;
+            }
+            curColor = color;
+          }
+          else
+          {
+            count++;
+          }
+        }
+      }
+    }
+    else if(count != 0)
+    {
+      if(count >= minRegionSize)
+        regions.emplace_back(x - count, x, curColor);
+      else if(!regions.empty())
+        regions.back().range.right += count;
+      count = 0;
+    }
+  }
+
+  if(count != 0)
+  {
+    if(count >= minRegionSize)
+      regions.emplace_back(x - count, x, curColor);
+    else if(!regions.empty())
+      regions.back().range.right += count;
+  }
+}
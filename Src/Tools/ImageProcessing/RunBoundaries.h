@@ -0,0 +1,68 @@
+/**
+ * @file RunBoundaries.h
+ *
+ * Functions that find the positions in a row of bytes at which a run of equal
+ * values ends, e.g. the color changes in a row of the colored ECImage, and that
+ * build the horizontal scan lines of the ColorScanLineRegionizer from them.
+ */
+
+#pragma once
+
+#include "Representations/Configuration/FieldColors.h"
+#include "Representations/Perception/ImagePreprocessing/ColorScanLineRegions.h"
+#include "Representations/Perception/ImagePreprocessing/ScanGrid.h"
+#include <vector>
+
+namespace RunBoundaries
+{
+  /**
+   * Finds all boundaries between runs of equal bytes with SSE. 16 bytes
+   * (32 with AVX2) are compared with their left neighbors at once and the
+   * positions of the differences are extracted from the resulting bit mask.
+   *
+   * @param row The row. The bytes row[from] to row[to - 1] must be readable.
+   * @param from The first position of the row that is examined.
+   * @param to The end of the row examined (exclusive).
+   * @param boundaries Receives all positions x with from < x < to and
+   *                   row[x] != row[x - 1] in ascending order. Previous
+   *                   contents are replaced.
+   */
+  void findSSE(const unsigned char* row, int from, int to, std::vector<unsigned short>& boundaries);
+
+  /**
+   * The scalar reference implementation of findSSE.
+   * @param row The row. The bytes row[from] to row[to - 1] must be readable.
+   * @param from The first position of the row that is examined.
+   * @param to The end of the row examined (exclusive).
+   * @param boundaries Receives all positions x with from < x < to and
+   *                   row[x] != row[x - 1] in ascending order.
+   */
+  void find(const unsigned char* row, int from, int to, std::vector<unsigned short>& boundaries);
+
+  /**
+   * Creates the regions of a horizontal scan line from the color changes
+   * found by findSSE. Only the pixels of the low resolution scan grid are
+   * considered, i.e. the same ones as in scanHorizontalScalar, but the
+   * search jumps from one color change to the next.
+   * @param row The row of the colored image.
+   * @param y The row of the scan line.
+   * @param scanGrid The scan grid.
+   * @param minRegionSize Shorter regions are merged with their predecessor.
+   * @param boundaries The color changes in the whole row.
+   * @param regions The regions are added to this list.
+   */
+  void scanHorizontal(const FieldColors::Color* row, int y, const ScanGrid& scanGrid, unsigned short minRegionSize,
+                      const std::vector<unsigned short>& boundaries, std::vector<ScanLineRegion>& regions);
+
+  /**
+   * Creates the regions of a horizontal scan line pixel by pixel. This is the
+   * reference for scanHorizontal, which must create exactly the same regions.
+   * @param row The row of the colored image.
+   * @param y The row of the scan line.
+   * @param scanGrid The scan grid.
+   * @param minRegionSize Shorter regions are merged with their predecessor.
+   * @param regions The regions are added to this list.
+   */
+  void scanHorizontalScalar(const FieldColors::Color* row, int y, const ScanGrid& scanGrid, unsigned short minRegionSize,
+                            std::vector<ScanLineRegion>& regions);
+}
@@ -0,0 +1,223 @@
+/**
+ * @file YUYVCodec.cpp
+ *
+ * Implements a fast lossless codec for YUYV images.
+ */
+
+#include "YUYVCodec.h"
+#include "Platform/BHAssert.h"
+#include "Tools/ImageProcessing/SIMD.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace
+{
+  constexpr unsigned blockSize = 16;
+
+  /**
+   * Returns the distance to the previous byte of the same channel.
+   * Y values are at even offsets, U and V at odd offsets of a YUYV row.
+   */
+  inline size_t leftOffset(size_t x) {return x & 1 ? 4 : 2;}
+
+  /** The median edge detector of LOCO-I. */
+  inline uint8_t med(uint8_t a, uint8_t b, uint8_t c)
+  {
+    const uint8_t mn = std::min(a, b);
+    const uint8_t mx = std::max(a, b);
+    if(c >= mx)
+      return mn;
+    else if(c <= mn)
+      return mx;
+    else
+      return static_cast<uint8_t>(a + b - c);
+  }
+
+  /**
+   * Predicts a byte from the bytes already processed.
+   * @param row The current row.
+   * @param x The offset of the byte in the row.
+   * @param rowBytes The number of bytes per row.
+   * @param firstRow Is this the first row of the image?
+   * @return The prediction.
+   */
+  inline uint8_t predict(const uint8_t* row, size_t x, size_t rowBytes, bool firstRow)
+  {
+    const size_t offset = leftOffset(x);
+    if(firstRow)
+      return x >= offset ? row[x - offset] : 0;
+    else if(x < offset)
+      return row[x - rowBytes];
+    else
+      return med(row[x - offset], row[x - rowBytes], row[x - rowBytes - offset]);
+  }
+
+  /** Maps a residual to an unsigned value: 0, -1, 1, -2, 2, ... -> 0, 1, 2, 3, 4, ... */
+  inline uint8_t zigzag(uint8_t residual)
+  {
+    const int8_t r = static_cast<int8_t>(residual);
+    return static_cast<uint8_t>((r << 1) ^ (r >> 7));
+  }
+
+  inline uint8_t unzigzag(uint8_t value)
+  {
+    return static_cast<uint8_t>((value >> 1) ^ -(value & 1));
+  }
+
+  /** Returns the number of bits required for a value. */
+  inline unsigned bitsFor(unsigned value)
+  {
+    unsigned bits = 0;
+    while(value >> bits)
+      ++bits;
+    return bits;
+  }
+
+  /** Writes packed blocks and their bit widths. */
+  class BlockWriter
+  {
+    uint8_t* header;
+    uint8_t* payload;
+    size_t numOfBlocks = 0;
+
+  public:
+    BlockWriter(uint8_t* dest, size_t numOfBlocks) : header(dest), payload(dest + (numOfBlocks + 1) / 2)
+    {
+      std::memset(header, 0, (numOfBlocks + 1) / 2);
+    }
+
+    /**
+     * Appends a block.
+     * @param values The 16 zigzag coded residuals.
+     * @param bits The number of bits required by the largest of them.
+     */
+    void write(const uint8_t* values, unsigned bits)
+    {
+      header[numOfBlocks >> 1] |= static_cast<uint8_t>(bits << ((numOfBlocks & 1) * 4));
+      ++numOfBlocks;
+      if(bits)
+        for(unsigned half = 0; half < 2; ++half)
+        {
+          uint64_t packed = 0;
+          for(unsigned i = 0; i < 8; ++i)
+            packed |= static_cast<uint64_t>(values[half * 8 + i]) << (i * bits);
+          std::memcpy(payload, &packed, bits); // Little endian: the lowest bits bytes.
+          payload += bits;
+        }
+    }
+
+    uint8_t* end() const {return payload;}
+  };
+}
+
+size_t YUYVCodec::maxCompressedSize(unsigned width, unsigned height)
+{
+  const size_t numOfBlocks = (static_cast<size_t>(width) * height * 4 + blockSize - 1) / blockSize;
+  return (numOfBlocks + 1) / 2 + numOfBlocks * blockSize;
+}
+
+size_t YUYVCodec::compress(const void* src, unsigned width, unsigned height, unsigned char* dest)
+{
+  const size_t rowBytes = width * 4;
+  ASSERT(rowBytes % blockSize == 0);
+  BlockWriter writer(dest, rowBytes * height / blockSize);
+  alignas(16) uint8_t values[blockSize];
+
+  const __m128i yMask = _mm_set1_epi16(0x00FF);
+  const __m128i zero = _mm_setzero_si128();
+  for(unsigned y = 0; y < height; ++y)
+  {
+    const uint8_t* row = static_cast<const uint8_t*>(src) + y * rowBytes;
+    size_t x = 0;
+
+    // The first row and the first block of every other row are predicted sequentially.
+    for(; x < (y ? blockSize : rowBytes); x += blockSize)
+    {
+      uint8_t max = 0;
+      for(size_t i = 0; i < blockSize; ++i)
+      {
+        values[i] = zigzag(static_cast<uint8_t>(row[x + i] - predict(row, x + i, rowBytes, y == 0)));
+        max = std::max(max, values[i]);
+      }
+      writer.write(values, bitsFor(max));
+    }
+
+    for(; x < rowBytes; x += blockSize)
+    {
+      const uint8_t* p = row + x;
+      const __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+      const __m128i up = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p - rowBytes));
+
+      // Y values use the value two bytes before, U and V the value four bytes before.
+      const __m128i left = _mm_or_si128(_mm_and_si128(yMask, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p - 2))),
+                                        _mm_andnot_si128(yMask, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p - 4))));
+      const __m128i upLeft = _mm_or_si128(_mm_and_si128(yMask, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p - rowBytes - 2))),
+                                          _mm_andnot_si128(yMask, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p - rowBytes - 4))));
+
+      // Median edge detector
+      const __m128i mn = _mm_min_epu8(left, up);
+      const __m128i mx = _mm_max_epu8(left, up);
+      const __m128i gradient = _mm_sub_epi8(_mm_add_epi8(left, up), upLeft);
+      const __m128i aboveMax = _mm_cmpeq_epi8(_mm_max_epu8(upLeft, mx), upLeft);
+      const __m128i belowMin = _mm_cmpeq_epi8(_mm_min_epu8(upLeft, mn), upLeft);
+      const __m128i prediction = _mm_or_si128(_mm_and_si128(aboveMax, mn),
+                                              _mm_andnot_si128(aboveMax, _mm_or_si128(_mm_and_si128(belowMin, mx),
+                                                                                      _mm_andnot_si128(belowMin, gradient))));
+
+      // Zigzag coding of the residuals
+      const __m128i residual = _mm_sub_epi8(current, prediction);
+      const __m128i coded = _mm_xor_si128(_mm_add_epi8(residual, residual), _mm_cmplt_epi8(residual, zero));
+
+      __m128i max = _mm_max_epu8(coded, _mm_srli_si128(coded, 8));
+      max = _mm_max_epu8(max, _mm_srli_si128(max, 4));
+      max = _mm_max_epu8(max, _mm_srli_si128(max, 2));
+      max = _mm_max_epu8(max, _mm_srli_si128(max, 1));
+
+      _mm_store_si128(reinterpret_cast<__m128i*>(values), coded);
+      writer.write(values, bitsFor(static_cast<unsigned>(_mm_cvtsi128_si32(max) & 0xFF)));
+    }
+  }
+
+  return writer.end() - dest;
+}
+
+bool YUYVCodec::decompress(const unsigned char* src, size_t size, unsigned width, unsigned height, void* dest)
+{
+  const size_t rowBytes = width * 4;
+  const size_t numOfBlocks = rowBytes * height / blockSize;
+  const size_t headerSize = (numOfBlocks + 1) / 2;
+  if(rowBytes % blockSize != 0 || size < headerSize)
+    return false;
+
+  const uint8_t* payload = src + headerSize;
+  const uint8_t* const end = src + size;
+  uint8_t values[blockSize];
+  size_t block = 0;
+  for(unsigned y = 0; y < height; ++y)
+  {
+    uint8_t* row = static_cast<uint8_t*>(dest) + y * rowBytes;
+    for(size_t x = 0; x < rowBytes; x += blockSize, ++block)
+    {
+      const unsigned bits = (src[block >> 1] >> ((block & 1) * 4)) & 15;
+      if(bits > 8 || payload + bits * 2 > end)
+        return false;
+      if(bits)
+        for(unsigned half = 0; half < 2; ++half)
+        {
+          uint64_t packed = 0;
+          std::memcpy(&packed, payload, bits);
+          payload += bits;
+          const uint64_t mask = (uint64_t(1) << bits) - 1;
+          for(unsigned i = 0; i < 8; ++i)
+            values[half * 8 + i] = static_cast<uint8_t>((packed >> (i * bits)) & mask);
+        }
+      else
+        std::memset(values, 0, blockSize);
+
+      for(size_t i = 0; i < blockSize; ++i)
+        row[x + i] = static_cast<uint8_t>(predict(row, x + i, rowBytes, y == 0) + unzigzag(values[i]));
+    }
+  }
+  return payload == end;
+}
@@ -0,0 +1,51 @@
+/**
+ * @file YUYVCodec.h
+ *
+ * Declares a fast lossless codec for YUYV images. Each byte is predicted
+ * from its neighbors in the same channel (the left, upper and upper left
+ * Y, U or V value) with the median edge detector of LOCO-I. The residuals
+ * are mapped to unsigned values and packed in blocks of 16 with the
+ * smallest number of bits that can represent all values of the block.
+ * The encoder is vectorized with SSE2. The decoder is sequential, because
+ * each prediction depends on the value decoded just before.
+ *
+ * Format: one nibble per block (the number of bits, two blocks per byte),
+ * followed by the packed blocks (2 * bits bytes each).
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace YUYVCodec
+{
+  /**
+   * Returns the maximum size of a compressed image.
+   * @param width The width of the image in YUYV pixels (i.e. two image pixels each).
+   * @param height The height of the image.
+   * @return The size in bytes.
+   */
+  size_t maxCompressedSize(unsigned width, unsigned height);
+
+  /**
+   * Compresses an image.
+   * @param src The YUYV image. Its width must be a multiple of 4 YUYV pixels.
+   * @param width The width of the image in YUYV pixels.
+   * @param height The height of the image.
+   * @param dest The buffer the compressed image is written to. It must be at
+   *             least maxCompressedSize(width, height) bytes large.
+   * @return The size of the compressed image in bytes.
+   */
+  size_t compress(const void* src, unsigned width, unsigned height, unsigned char* dest);
+
+  /**
+   * Decompresses an image.
+   * @param src The compressed image.
+   * @param size The size of the compressed image in bytes.
+   * @param width The width of the image in YUYV pixels.
+   * @param height The height of the image.
+   * @param dest The buffer the image is written to (width * height * 4 bytes).
+   * @return Did the size of the compressed image match its contents?
+   */
+  bool decompress(const unsigned char* src, size_t size, unsigned width, unsigned height, void* dest);
+}
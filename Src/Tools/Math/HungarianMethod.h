@@ -0,0 +1,183 @@
+/**
+ * @file HungarianMethod.h
+ *
+ * This file declares and implements a solver for the linear assignment problem
+ * (Hungarian method with potentials, in the shortest augmenting path variant).
+ *
+ * The solver keeps its dual potentials and the assignment between calls. If the
+ * cost matrix only changed slightly since the last call, all previous pairs that are
+ * still tight under the (repaired) potentials are kept and only the remaining rows
+ * are augmented. The worst case is n augmentations of O(n^2) each, i.e. the run
+ * time is bounded by O(maxSize^3) and no memory is allocated.
+ */
+
+#pragma once
+
+#include "Tools/Math/Eigen.h"
+#include "Platform/BHAssert.h"
+#include <array>
+#include <limits>
+
+template<int maxSize>
+class HungarianMethod
+{
+public:
+  using Matrix = Eigen::Matrix<float, maxSize, maxSize>;
+
+  /**
+   * Computes the assignment of rows to columns with minimal total cost.
+   * @param cost The cost matrix. Only the upper left size x size block is used.
+   * @param size The number of rows and columns used (at most maxSize).
+   * @return The number of augmenting paths that had to be searched (0 if the
+   *         previous assignment was still optimal).
+   */
+  int solve(const Matrix& cost, int size)
+  {
+    ASSERT(size >= 0 && size <= maxSize);
+    if(size != lastSize)
+      reset();
+    lastSize = size;
+
+    // Repair the potentials, so that u[i] + v[j] <= cost(i, j) holds again, and keep
+    // all previous pairs that are still tight.
+    for(int i = 1; i <= size; ++i)
+    {
+      float minimum = std::numeric_limits<float>::max();
+      for(int j = 1; j <= size; ++j)
+        minimum = std::min(minimum, cost(i - 1, j - 1) - v[j]);
+      u[i] = minimum;
+    }
+    for(int j = 1; j <= size; ++j)
+      if(p[j] && cost(p[j] - 1, j - 1) - u[p[j]] - v[j] > tolerance(cost(p[j] - 1, j - 1)))
+        p[j] = 0;
+
+    std::array<bool, maxSize + 1> assigned;
+    assigned.fill(false);
+    for(int j = 1; j <= size; ++j)
+      assigned[p[j]] = true;
+
+    int augmentations = 0;
+    for(int i = 1; i <= size; ++i)
+      if(!assigned[i])
+      {
+        augment(cost, size, i);
+        ++augmentations;
+      }
+
+    for(int j = 1; j <= size; ++j)
+      rowToColumn[p[j] - 1] = j - 1;
+    return augmentations;
+  }
+
+  /**
+   * The column assigned to a row in the last call of solve().
+   * @param row The row.
+   * @return The column.
+   */
+  int operator[](int row) const {return rowToColumn[row];}
+
+  /**
+   * Checks whether every other assignment of the first rows is clearly worse than
+   * the one found by the last call of solve(). Only then a cold start is guaranteed
+   * to find the same assignment despite rounding errors.
+   * @param cost The cost matrix of the last call of solve().
+   * @param rows The number of rows whose assignment matters.
+   * @return Is the assignment of these rows unique?
+   */
+  bool isUnique(const Matrix& cost, int rows) const
+  {
+    ASSERT(rows <= lastSize);
+    for(int i = 1; i <= rows; ++i)
+      for(int j = 1; j <= lastSize; ++j)
+        if(p[j] != i && cost(i - 1, j - 1) - u[i] - v[j] <= margin(cost(i - 1, j - 1)))
+          return false;
+    return true;
+  }
+
+  /** Forgets the previous assignment, so that the next call of solve() starts from scratch. */
+  void reset()
+  {
+    u.fill(0.f);
+    v.fill(0.f);
+    p.fill(0);
+    rowToColumn.fill(-1);
+  }
+
+private:
+  std::array<float, maxSize + 1> u; /**< The potentials of the rows (1-based). */
+  std::array<float, maxSize + 1> v; /**< The potentials of the columns (1-based). */
+  std::array<int, maxSize + 1> p; /**< The row (1-based) assigned to each column (1-based), 0 if none. */
+  std::array<int, maxSize> rowToColumn; /**< The result (0-based). */
+  int lastSize = -1; /**< The size of the previous problem. */
+
+  /**
+   * The reduced cost up to which a previous pair is still considered tight. It only
+   * covers the rounding errors, because every pair kept with a larger slack could
+   * make the result worse than that of a cold start.
+   */
+  static float tolerance(float value) {return 1e-6f * (1.f + std::abs(value));}
+
+  /** The reduced cost an unassigned pair must exceed, so that the assignment is unique. */
+  static float margin(float value) {return 1e-4f * (1.f + std::abs(value));}
+
+  /**
+   * Assigns a free row by searching a shortest augmenting path with respect to
+   * the reduced costs and updating the potentials along the way.
+   * @param cost The cost matrix.
+   * @param size The number of rows and columns used.
+   * @param row The free row (1-based).
+   */
+  void augment(const Matrix& cost, int size, int row)
+  {
+    std::array<float, maxSize + 1> minv;
+    std::array<int, maxSize + 1> way;
+    std::array<bool, maxSize + 1> used;
+    minv.fill(std::numeric_limits<float>::max());
+    used.fill(false);
+
+    // The dummy column 0 holds the row to be assigned.
+    p[0] = row;
+    int j0 = 0;
+    do
+    {
+      used[j0] = true;
+      const int i0 = p[j0];
+      float delta = std::numeric_limits<float>::max();
+      int j1 = 0;
+      for(int j = 1; j <= size; ++j)
+        if(!used[j])
+        {
+          const float reduced = cost(i0 - 1, j - 1) - u[i0] - v[j];
+          if(reduced < minv[j])
+          {
+            minv[j] = reduced;
+            way[j] = j0;
+          }
+          if(minv[j] < delta)
+          {
+            delta = minv[j];
+            j1 = j;
+          }
+        }
+      for(int j = 0; j <= size; ++j)
+        if(used[j])
+        {
+          u[p[j]] += delta;
+          v[j] -= delta;
+        }
+        else
+          minv[j] -= delta;
+      j0 = j1;
+    }
+    while(p[j0] != 0);
+
+    // Flip the assignment along the augmenting path.
+    do
+    {
+      const int j1 = way[j0];
+      p[j0] = p[j1];
+      j0 = j1;
+    }
+    while(j0);
+  }
+};
@@ -70,7 +70,8 @@ public:
     return *this;
   }
 
-  inline MeanCalculator& add(const std::vector<ValueType>& data)
+  template<typename Allocator>
+  inline MeanCalculator& add(const std::vector<ValueType, Allocator>& data)
   {
     return add(data.cbegin(), data.cend());
   }
@@ -13,7 +13,7 @@
 #include "Eigen.h"
 #include "Platform/BHAssert.h"
 
-#include <functional>
+#include <array>
 #include <limits>
 
 /**
@@ -34,36 +34,33 @@ struct Manifold
 namespace impl
 {
   /**
-   * A struct to run a calculation of mean for given sigma points.
+   * The storage of the sigma points of a filter and the operations on them.
    */
-  template<typename State, unsigned DOF, typename Array, bool IsManifold>
-  struct MeanOfSigmaPoints
-  {
-    static State run(const Array& sigmaPoints);
-  };
+  template<typename State, unsigned DOF, bool IsManifold>
+  struct SigmaPoints;
 
   /**
    * The class for the Unscented Kalman Filter for hypotheses generation by using
    * Kalman filtering using Sigma Points.
+   * The dynamic and measurement models are template parameters of the steps, so
+   * that lambdas are inlined instead of being called through std::function.
    */
   template<typename State, unsigned DOF, bool Manifold>
   class UnscentedKalmanFilter
   {
   public:
+    static constexpr unsigned numOfSigmaPoints = DOF * 2 + 1; // The number of sigma points
     using CovarianceType = Eigen::Matrix<float, DOF, DOF>; // The covariance size to use
     template<unsigned N>
     using Vectorf = Eigen::Matrix<float, N, 1>; // The vector size to use
+    template<unsigned N>
+    using SigmaMatrix = Eigen::Matrix<float, N, numOfSigmaPoints>; // All sigma points (or their measurements) with one point per column
 
-  private:
-    template<typename T>
-    using SigmaArray = std::array < T, DOF * 2 + 1 >; // The array type for the sigma points
-
-  public:
     State mean; // The mean of the hypothesis that is generated
     CovarianceType cov = CovarianceType::Zero(); // The covariance of the hypothesis to quantify the certainty
 
   private:
-    SigmaArray<State> sigmaPoints; // The array for the sigma points
+    SigmaPoints<State, DOF, Manifold> sigmaPoints; // The sigma points
 
   public:
     /**
@@ -82,29 +79,48 @@ namespace impl
     /**
      * The prediction step to propagate the whole hypothesis with a given dynamic model and an operation specific noise.
      * In other works this function is referred as dynamic step.
-     * @param dynamicModel, a function to propagate the state
+     * @param dynamicModel, a function void(State&) to propagate the state
+     * @param noise, the propagation specific noise (as a variance) to quantify the uncertainty
+     */
+    template<typename DynamicModel>
+    void predict(const DynamicModel& dynamicModel, const CovarianceType& noise);
+
+    /**
+     * The prediction step for filters without manifold with a dynamic model that propagates all sigma points at once.
+     * @param dynamicModel, a function void(SigmaMatrix<DOF>&) to propagate all sigma points
      * @param noise, the propagation specific noise (as a variance) to quantify the uncertainty
      */
-    void predict(std::function<void(State&)> dynamicModel, const CovarianceType& noise);
+    template<typename DynamicModel>
+    void predictAll(const DynamicModel& dynamicModel, const CovarianceType& noise);
 
     /**
      * The multi dimensional update step to integrate a measurement into an existing hypothesis.
      * In other works this function is referred as measurement step.
      * @param measurement, a vector that stores all relevant data of a measurement
-     * @param measurementModel, a function that returns a measurement for a state
+     * @param measurementModel, a function Vectorf<N>(const State&) that returns a measurement for a state
      * @param measurementNoise, the measurement specific noise (as a variance) to quantify the uncertainty
      */
-    template<unsigned N>
-    void update(const Vectorf<N>& measurement, std::function<Vectorf<N>(const State&)> measurementModel, const Eigen::Matrix<float, N, N>& measurementNoise);
+    template<unsigned N, typename MeasurementModel>
+    void update(const Vectorf<N>& measurement, const MeasurementModel& measurementModel, const Eigen::Matrix<float, N, N>& measurementNoise);
+
+    /**
+     * The multi dimensional update step for filters without manifold with a measurement model that measures all sigma points at once.
+     * @param measurement, a vector that stores all relevant data of a measurement
+     * @param measurementModel, a function SigmaMatrix<N>(const SigmaMatrix<DOF>&) that returns the measurements of all sigma points
+     * @param measurementNoise, the measurement specific noise (as a variance) to quantify the uncertainty
+     */
+    template<unsigned N, typename MeasurementModel>
+    void updateAll(const Vectorf<N>& measurement, const MeasurementModel& measurementModel, const Eigen::Matrix<float, N, N>& measurementNoise);
 
     /**
      * The single dimensional update step to integrate a measurement into an existing hypothesis.
      * In other works this function is referred as measurement step.
      * @param measurement, a float value that represents a measurement
-     * @param measurementModel, a function that returns a measurement for a state
+     * @param measurementModel, a function float(const State&) that returns a measurement for a state
      * @param measurementNoise, the measurement specific noise (as a variance) to quantify the uncertainty
      */
-    void update(float measurement, std::function<float(const State&)> measurementModel, float measurementNoise);
+    template<typename MeasurementModel>
+    void update(float measurement, const MeasurementModel& measurementModel, float measurementNoise);
 
   private:
     /**
@@ -113,10 +129,19 @@ namespace impl
     void updateSigmaPoints();
 
     /**
-     * The function to call a new mean out of the sigma points.
-     * @return the state that is the new mean
+     * Derives mean and covariance from the propagated sigma points.
+     * @param noise, the propagation specific noise (as a variance) to quantify the uncertainty
+     */
+    void finishPrediction(const CovarianceType& noise);
+
+    /**
+     * Integrates the measurements of the sigma points into the hypothesis.
+     * @param measurement, the actual measurement
+     * @param Z, the measurements of the sigma points, one per column
+     * @param measurementNoise, the measurement specific noise (as a variance) to quantify the uncertainty
      */
-    State meanOfSigmaPoints() const;
+    template<unsigned N>
+    void correct(const Vectorf<N>& measurement, const SigmaMatrix<N>& Z, const Eigen::Matrix<float, N, N>& measurementNoise);
 
     /**
      * A helper function to validate if a covariance is still a covariance.
@@ -159,173 +184,144 @@ namespace impl
   /**
    * The prediction step to propagate the whole hypothesis with a given dynamic model and an operation specific noise.
    * In other works this function is referred as dynamic step.
-   * @param dynamicModel, a function to propagate the state
+   * @param dynamicModel, a function void(State&) to propagate the state
    * @param noise, the propagation specific noise (as variance) to quantify the uncertainty
    */
   template<typename State, unsigned DOF, bool Manifold>
-  void UnscentedKalmanFilter<State, DOF, Manifold>::predict(std::function<void(State&)> dynamicModel, const CovarianceType& noise)
+  template<typename DynamicModel>
+  void UnscentedKalmanFilter<State, DOF, Manifold>::predict(const DynamicModel& dynamicModel, const CovarianceType& noise)
   {
-    ASSERT((noise.array() >= 0.f).all());
-    ASSERT(noise.trace() > 0.f);
-
     updateSigmaPoints();
+    sigmaPoints.propagate(dynamicModel);
+    finishPrediction(noise);
+  }
 
-    for(State& sigmaPoint : sigmaPoints)
-      dynamicModel(sigmaPoint);
-
-    mean = meanOfSigmaPoints();
-
-    cov = CovarianceType::Zero();
-    for(State& sigmaPoint : sigmaPoints)
-    {
-      const Vectorf<DOF> dist = sigmaPoint - mean;
-      cov += dist * dist.transpose();
-    }
-    cov *= 0.5f;
-    cov += noise;
-
-    fixCovarianceMatrix(cov);
-    covarianceMatrixValidation(cov);
+  /**
+   * The prediction step for filters without manifold with a dynamic model that propagates all sigma points at once.
+   * @param dynamicModel, a function void(SigmaMatrix<DOF>&) to propagate all sigma points
+   * @param noise, the propagation specific noise (as a variance) to quantify the uncertainty
+   */
+  template<typename State, unsigned DOF, bool Manifold>
+  template<typename DynamicModel>
+  void UnscentedKalmanFilter<State, DOF, Manifold>::predictAll(const DynamicModel& dynamicModel, const CovarianceType& noise)
+  {
+    static_assert(!Manifold, "Sigma points on a manifold cannot be propagated as a matrix");
+    updateSigmaPoints();
+    dynamicModel(sigmaPoints.points);
+    finishPrediction(noise);
   }
 
   /**
    * The multi dimensional update step to integrate a measurement into an existing hypothesis.
    * In other works this function is referred as measurement step.
    * @param measurement, a vector that stores all relevant data of a measurement
-   * @param measurementModel, a function that returns a measurement for a state
+   * @param measurementModel, a function Vectorf<N>(const State&) that returns a measurement for a state
    * @param measurementNoise, the measurement specific noise (as variance) to quantify the uncertainty
    */
-  template<typename State, unsigned DOF, bool IsManifold>
-  template<unsigned N>
-  void UnscentedKalmanFilter<State, DOF, IsManifold>::update(const Vectorf<N>& measurement, std::function<Vectorf<N>(const State&)> measurementModel, const Eigen::Matrix<float, N, N>& measurementNoise)
+  template<typename State, unsigned DOF, bool Manifold>
+  template<unsigned N, typename MeasurementModel>
+  void UnscentedKalmanFilter<State, DOF, Manifold>::update(const Vectorf<N>& measurement, const MeasurementModel& measurementModel, const Eigen::Matrix<float, N, N>& measurementNoise)
   {
-    ASSERT((measurementNoise.diagonal().array() >= 0.f).all());
-    ASSERT(measurementNoise.trace() > 0.f);
-
-    using MeasurementType = Vectorf<N>;
-    using MeasurementCovarianceType = Eigen::Matrix<float, N, N>;
-    using MixedCovarianceType = Eigen::Matrix<float, DOF, N>;
-
     updateSigmaPoints();
+    correct<N>(measurement, sigmaPoints.template measure<N>(measurementModel), measurementNoise);
+  }
 
-    SigmaArray<MeasurementType> Z;
-    for(size_t i = 0; i < sigmaPoints.size(); ++i)
-      Z[i] = measurementModel(sigmaPoints[i]);
-
-    MeasurementType z = MeasurementType::Zero();
-    for(MeasurementType& Zi : Z)
-      z += Zi;
-    z /= static_cast<float>(sigmaPoints.size());
-
-    MeasurementCovarianceType sigmaz = MeasurementCovarianceType::Zero();
-    for(MeasurementType& Zi : Z)
-    {
-      const MeasurementType dist = Zi - z;
-      sigmaz += dist * dist.transpose();
-    }
-    sigmaz *= 0.5f;
-    sigmaz += measurementNoise;
-
-    MixedCovarianceType simgaxz = MixedCovarianceType::Zero();
-    for(size_t i = 0; i < sigmaPoints.size(); ++i)
-    {
-      const State& Xi = sigmaPoints[i];
-      const MeasurementType& Zi = Z[i];
-      simgaxz += (Xi - mean) * (Zi - z).transpose();
-    }
-    simgaxz *= 0.5f;
-    //The kalman gain
-    const MixedCovarianceType K = simgaxz * sigmaz.inverse();
-    //Derive the mean and the covariance using the kalman gain
-    mean += K * (measurement - z);
-    cov -= K * sigmaz * K.transpose();
-
-    fixCovarianceMatrix(cov);
-    covarianceMatrixValidation(cov);
+  /**
+   * The multi dimensional update step for filters without manifold with a measurement model that measures all sigma points at once.
+   * @param measurement, a vector that stores all relevant data of a measurement
+   * @param measurementModel, a function SigmaMatrix<N>(const SigmaMatrix<DOF>&) that returns the measurements of all sigma points
+   * @param measurementNoise, the measurement specific noise (as a variance) to quantify the uncertainty
+   */
+  template<typename State, unsigned DOF, bool Manifold>
+  template<unsigned N, typename MeasurementModel>
+  void UnscentedKalmanFilter<State, DOF, Manifold>::updateAll(const Vectorf<N>& measurement, const MeasurementModel& measurementModel, const Eigen::Matrix<float, N, N>& measurementNoise)
+  {
+    static_assert(!Manifold, "Sigma points on a manifold cannot be measured as a matrix");
+    updateSigmaPoints();
+    correct<N>(measurement, measurementModel(sigmaPoints.points), measurementNoise);
   }
 
   /**
    * The single dimensional update step to integrate a measurement into an existing hypothesis.
    * In other works this function is referred as measurement step.
    * @param measurement, a float value that represents a measurement
-   * @param measurementModel, a function that returns a measurement for a state
+   * @param measurementModel, a function float(const State&) that returns a measurement for a state
    * @param measurementNoise, the measurement specific noise (as variance) to quantify the uncertainty
    */
-  template<typename State, unsigned DOF, bool IsManifold>
-  void UnscentedKalmanFilter<State, DOF, IsManifold>::update(float measurement, std::function<float(const State&)> measurementModel, float measurementNoise)
+  template<typename State, unsigned DOF, bool Manifold>
+  template<typename MeasurementModel>
+  void UnscentedKalmanFilter<State, DOF, Manifold>::update(float measurement, const MeasurementModel& measurementModel, float measurementNoise)
   {
     ASSERT(measurementNoise > 0.f);
 
-    using MixedCovarianceType = Eigen::Matrix<float, DOF, 1>;
-
     updateSigmaPoints();
-
-    SigmaArray<float> Z;
-    for(size_t i = 0; i < sigmaPoints.size(); ++i)
-      Z[i] = measurementModel(sigmaPoints[i]);
-
-    float z = 0.f;
-    for(float& Zi : Z)
-      z += Zi;
-    z /= static_cast<float>(sigmaPoints.size());
-
-    float sigmaz = 0.f;
-    for(float& Zi : Z)
-      sigmaz += sqr(Zi - z);
-    sigmaz *= 0.5f;
-    sigmaz += measurementNoise;
-
-    MixedCovarianceType simgaxz = MixedCovarianceType::Zero();
-    for(size_t i = 0; i < sigmaPoints.size(); ++i)
-    {
-      const State& Xi = sigmaPoints[i];
-      const float& Zi = Z[i];
-      simgaxz += (Xi - mean) * (Zi - z);
-    }
-    simgaxz *= 0.5f;
-
-    const MixedCovarianceType K = simgaxz * (1.f / sigmaz);
-
-    mean += K * (measurement - z);
-    cov -= K * sigmaz * K.transpose();
-
-    fixCovarianceMatrix(cov);
-    covarianceMatrixValidation(cov);
+    correct<1>(Vectorf<1>(measurement),
+               sigmaPoints.template measure<1>([&](const State& state) {return Vectorf<1>(measurementModel(state));}),
+               Eigen::Matrix<float, 1, 1>(measurementNoise));
   }
 
   /**
    * The helper function to calculate sigma points using the given mean and the covariance.
    */
-  template<typename State, unsigned DOF, bool IsManifold>
-  void UnscentedKalmanFilter<State, DOF, IsManifold>::updateSigmaPoints()
+  template<typename State, unsigned DOF, bool Manifold>
+  void UnscentedKalmanFilter<State, DOF, Manifold>::updateSigmaPoints()
   {
     Eigen::LLT<CovarianceType> llt = cov.llt();
     Eigen::ComputationInfo info = llt.info();
     if(info == Eigen::ComputationInfo::Success)
-    {
-      CovarianceType l = llt.matrixL();
-      sigmaPoints[0] = mean;
-      for(unsigned i = 0; i < DOF; ++i)
-        sigmaPoints[i + 1] = mean + l.col(i);
-      for(unsigned i = 0; i < DOF; ++i)
-        sigmaPoints[i + DOF + 1] = mean + (-l.col(i));
-    }
+      sigmaPoints.generate(mean, llt.matrixL());
     else
-    {
       // maybe adding 1 sigma or something is better?
-      for(State& sigmaPoint : sigmaPoints)
-        sigmaPoint = mean;
-    }
+      sigmaPoints.fill(mean);
   }
 
   /**
-   * The function to call a new mean out of the sigma points.
-   * @return the state that is the new mean
+   * Derives mean and covariance from the propagated sigma points.
+   * @param noise, the propagation specific noise (as a variance) to quantify the uncertainty
    */
-  template<typename State, unsigned DOF, bool IsManifold>
-  inline State UnscentedKalmanFilter<State, DOF, IsManifold>::meanOfSigmaPoints() const
+  template<typename State, unsigned DOF, bool Manifold>
+  void UnscentedKalmanFilter<State, DOF, Manifold>::finishPrediction(const CovarianceType& noise)
+  {
+    ASSERT((noise.array() >= 0.f).all());
+    ASSERT(noise.trace() > 0.f);
+
+    mean = sigmaPoints.mean();
+
+    const SigmaMatrix<DOF> dist = sigmaPoints.deviations(mean);
+    cov = dist * dist.transpose() * 0.5f + noise;
+
+    fixCovarianceMatrix(cov);
+    covarianceMatrixValidation(cov);
+  }
+
+  /**
+   * Integrates the measurements of the sigma points into the hypothesis.
+   * @param measurement, the actual measurement
+   * @param Z, the measurements of the sigma points, one per column
+   * @param measurementNoise, the measurement specific noise (as a variance) to quantify the uncertainty
+   */
+  template<typename State, unsigned DOF, bool Manifold>
+  template<unsigned N>
+  void UnscentedKalmanFilter<State, DOF, Manifold>::correct(const Vectorf<N>& measurement, const SigmaMatrix<N>& Z, const Eigen::Matrix<float, N, N>& measurementNoise)
   {
-    return MeanOfSigmaPoints<State, DOF, SigmaArray<State>, IsManifold>::run(sigmaPoints);
+    ASSERT((measurementNoise.diagonal().array() >= 0.f).all());
+    ASSERT(measurementNoise.trace() > 0.f);
+
+    using MixedCovarianceType = Eigen::Matrix<float, DOF, N>;
+
+    const Vectorf<N> z = Z.rowwise().mean();
+    const SigmaMatrix<N> distZ = Z.colwise() - z;
+    const Eigen::Matrix<float, N, N> sigmaz = distZ * distZ.transpose() * 0.5f + measurementNoise;
+    const MixedCovarianceType sigmaxz = sigmaPoints.deviations(mean) * distZ.transpose() * 0.5f;
+
+    //The kalman gain
+    const MixedCovarianceType K = sigmaxz * sigmaz.inverse();
+    //Derive the mean and the covariance using the kalman gain
+    mean += K * (measurement - z);
+    cov -= K * sigmaz * K.transpose();
+
+    fixCovarianceMatrix(cov);
+    covarianceMatrixValidation(cov);
   }
 
   /**
@@ -333,8 +329,8 @@ namespace impl
    * The validation is done via asserts.
    * @param cov, the covariance to check
    */
-  template<typename State, unsigned DOF, bool IsManifold>
-  inline void UnscentedKalmanFilter<State, DOF, IsManifold>::covarianceMatrixValidation(const CovarianceType& cov) const
+  template<typename State, unsigned DOF, bool Manifold>
+  inline void UnscentedKalmanFilter<State, DOF, Manifold>::covarianceMatrixValidation(const CovarianceType& cov) const
   {
     for(unsigned i = 0; i < DOF; ++i)
     {
@@ -354,8 +350,8 @@ namespace impl
    * A helper function to fix a covariance by forcing the symmetric property.
    * @param cov, the covariance to fix
    */
-  template<typename State, unsigned DOF, bool IsManifold>
-  inline void UnscentedKalmanFilter<State, DOF, IsManifold>::fixCovarianceMatrix(CovarianceType& cov)
+  template<typename State, unsigned DOF, bool Manifold>
+  inline void UnscentedKalmanFilter<State, DOF, Manifold>::fixCovarianceMatrix(CovarianceType& cov)
   {
     for(unsigned i = 0; i < DOF; ++i)
     {
@@ -367,21 +363,68 @@ namespace impl
   }
 
   /**
-   * A struct to run a calculation of mean for given sigma points with manifold.
+   * The sigma points of a state on a manifold, which are stored as an array of states.
    */
-  template<typename State, unsigned DOF, typename Array>
-  struct MeanOfSigmaPoints<State, DOF, Array, true>
+  template<typename State, unsigned DOF>
+  struct SigmaPoints<State, DOF, true>
   {
+    static constexpr unsigned numOfSigmaPoints = DOF * 2 + 1; // The number of sigma points
     using Vectorf = Eigen::Matrix<float, DOF, 1>; // The vector type to operate on
 
+    std::array<State, numOfSigmaPoints> points; // The sigma points
+
+    /**
+     * Sets all sigma points to a state.
+     * @param state, the state to set
+     */
+    void fill(const State& state) {points.fill(state);}
+
+    /**
+     * Places the sigma points around the mean.
+     * @param mean, the mean
+     * @param l, the lower triangle of the Cholesky decomposition of the covariance
+     */
+    void generate(const State& mean, const Eigen::Matrix<float, DOF, DOF>& l)
+    {
+      points[0] = mean;
+      for(unsigned i = 0; i < DOF; ++i)
+        points[i + 1] = mean + l.col(i);
+      for(unsigned i = 0; i < DOF; ++i)
+        points[i + DOF + 1] = mean + (-l.col(i));
+    }
+
+    /**
+     * Applies a dynamic model to all sigma points.
+     * @param dynamicModel, a function void(State&)
+     */
+    template<typename DynamicModel>
+    void propagate(const DynamicModel& dynamicModel)
+    {
+      for(State& point : points)
+        dynamicModel(point);
+    }
+
+    /**
+     * Applies a measurement model to all sigma points.
+     * @param measurementModel, a function Eigen::Matrix<float, N, 1>(const State&)
+     * @return the measurements, one per column
+     */
+    template<unsigned N, typename MeasurementModel>
+    Eigen::Matrix<float, N, numOfSigmaPoints> measure(const MeasurementModel& measurementModel) const
+    {
+      Eigen::Matrix<float, N, numOfSigmaPoints> Z;
+      for(unsigned i = 0; i < numOfSigmaPoints; ++i)
+        Z.col(i) = measurementModel(points[i]);
+      return Z;
+    }
+
     /**
      * Calculate the mean of states via manifold convergence algorithm.
-     * @param sigmaPoints, an array of states to get a mean of
      * @return the mean
      */
-    static State run(const Array& sigmaPoints)
+    State mean() const
     {
-      State mean = sigmaPoints[0]; // The mean to use for convergence
+      State mean = points[0]; // The mean to use for convergence
       State lastMean; // The mean to check convergence with
       unsigned iterations = 0; // The iteration counter
       // Move the mean each step into the direction of the sigma points till the difference is minimal or the limit is reached
@@ -390,33 +433,98 @@ namespace impl
         lastMean = mean;
         ++iterations;
         Vectorf sum = Vectorf::Zero();
-        for(const State& sigmaPoint : sigmaPoints)
-          sum += sigmaPoint - mean;
-        mean += sum / static_cast<float>(sigmaPoints.size());
+        for(const State& point : points)
+          sum += point - mean;
+        mean += sum / static_cast<float>(numOfSigmaPoints);
       }
       while(!Approx::isZero((lastMean - mean).norm()) && iterations <= 20);
       return mean;
     }
+
+    /**
+     * Calculates the differences between all sigma points and a state.
+     * @param mean, the state to subtract
+     * @return the differences, one per column
+     */
+    Eigen::Matrix<float, DOF, numOfSigmaPoints> deviations(const State& mean) const
+    {
+      Eigen::Matrix<float, DOF, numOfSigmaPoints> dist;
+      for(unsigned i = 0; i < numOfSigmaPoints; ++i)
+        dist.col(i) = points[i] - mean;
+      return dist;
+    }
   };
 
   /**
-   * A struct to run a calculation of mean for given sigma points without manifold.
+   * The sigma points of a vector state, which are stored as the columns of a single matrix,
+   * so that all steps are computed as matrix operations.
    */
-  template<typename State, unsigned DOF, typename Array>
-  struct MeanOfSigmaPoints<State, DOF, Array, false>
+  template<typename State, unsigned DOF>
+  struct SigmaPoints<State, DOF, false>
   {
+    static constexpr unsigned numOfSigmaPoints = DOF * 2 + 1; // The number of sigma points
+
+    Eigen::Matrix<float, DOF, numOfSigmaPoints> points; // The sigma points, one per column
+
     /**
-     * Calculate the arithmetic mean of vectors.
-     * @param sigmaPoints, an array of vectors to get a mean of
-     * @return the mean
+     * Sets all sigma points to a state.
+     * @param state, the state to set
      */
-    static State run(const Array& sigmaPoints)
+    void fill(const State& state) {points = state.template replicate<1, numOfSigmaPoints>();}
+
+    /**
+     * Places the sigma points around the mean.
+     * @param mean, the mean
+     * @param l, the lower triangle of the Cholesky decomposition of the covariance
+     */
+    void generate(const State& mean, const Eigen::Matrix<float, DOF, DOF>& l)
+    {
+      points.col(0) = mean;
+      points.template middleCols<DOF>(1) = l.colwise() + mean;
+      points.template rightCols<DOF>() = (-l).colwise() + mean;
+    }
+
+    /**
+     * Applies a dynamic model to all sigma points.
+     * @param dynamicModel, a function void(State&)
+     */
+    template<typename DynamicModel>
+    void propagate(const DynamicModel& dynamicModel)
+    {
+      for(unsigned i = 0; i < numOfSigmaPoints; ++i)
+      {
+        State point = points.col(i);
+        dynamicModel(point);
+        points.col(i) = point;
+      }
+    }
+
+    /**
+     * Applies a measurement model to all sigma points.
+     * @param measurementModel, a function Eigen::Matrix<float, N, 1>(const State&)
+     * @return the measurements, one per column
+     */
+    template<unsigned N, typename MeasurementModel>
+    Eigen::Matrix<float, N, numOfSigmaPoints> measure(const MeasurementModel& measurementModel) const
     {
-      State sum = State::Zero();
-      for(const State& sigmaPoint : sigmaPoints)
-        sum += sigmaPoint;
-      return sum / static_cast<float>(sigmaPoints.size());
+      Eigen::Matrix<float, N, numOfSigmaPoints> Z;
+      for(unsigned i = 0; i < numOfSigmaPoints; ++i)
+        Z.col(i) = measurementModel(State(points.col(i)));
+      return Z;
     }
+
+    /**
+     * Calculate the arithmetic mean of the sigma points.
+     * @return the mean
+     */
+    State mean() const {return points.rowwise().mean();}
+
+    /**
+     * Calculates the differences between all sigma points and a state.
+     * @param mean, the state to subtract
+     * @return the differences, one per column
+     */
+    Eigen::Matrix<float, DOF, numOfSigmaPoints> deviations(const State& mean) const {return points.colwise() - mean;}
   };
 }
 
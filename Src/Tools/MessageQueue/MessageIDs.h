@@ -34,6 +34,7 @@ ENUM(MessageID,
   idCameraInfo,
   idCameraMatrix,
   idCirclePercept,
+  idCompressedCameraImage,
   idFallDownState,
   idFieldBoundary,
   idFieldColors,
@@ -109,6 +110,7 @@ ENUM(MessageID,
   idMotionNet,
   idPlot,
   idRobotname,
+  idSampleProfile,
   idText,
   idTypeInfo,
   idTypeInfoRequest,
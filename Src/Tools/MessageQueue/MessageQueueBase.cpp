@@ -275,6 +275,7 @@ void MessageQueueBase::removeRepetitions()
       case idAudioData:
       case idAnnotation:
       case idLogResponse:
+      case idSampleProfile:
         copy = true;
         break;
 
@@ -0,0 +1,388 @@
+/**
+ * @file ConfigBundle.cpp
+ *
+ * Implementation of a binary bundle of module parameters.
+ *
+ * Layout (all numbers in native byte order):
+ * unsigned           : magic
+ * unsigned           : version
+ * unsigned long long : hash of the TypeInfo of the executable that wrote it
+ * unsigned           : number of entries
+ * for each entry:
+ *   unsigned, chars  : full path of the configuration file and key
+ *   long long        : modification time of the file
+ *   long long        : size of the file
+ *   unsigned, bytes  : the parameters streamed with OutBinary
+ */
+
+#include "ConfigBundle.h"
+#include "Platform/File.h"
+#include "Platform/Semaphore.h"
+#include "Platform/Thread.h"
+#include "Tools/Streams/InStreams.h"
+#include "Tools/Streams/MapCache.h"
+#include "Tools/Streams/OutStreams.h"
+#include "Tools/Streams/TypeInfo.h"
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#ifdef WINDOWS
+#include <Windows.h>
+#include <fstream>
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+  /** A file mapped into memory read-only. */
+  class MappedFile
+  {
+  public:
+    const char* data = nullptr;
+    size_t size = 0;
+
+    MappedFile(const std::string& path)
+    {
+#ifdef WINDOWS
+      std::ifstream stream(path, std::ios::binary | std::ios::ate);
+      if(stream)
+      {
+        buffer.resize(static_cast<size_t>(stream.tellg()));
+        stream.seekg(0);
+        if(stream.read(buffer.data(), buffer.size()))
+        {
+          data = buffer.data();
+          size = buffer.size();
+        }
+      }
+#else
+      const int fd = ::open(path.c_str(), O_RDONLY);
+      if(fd != -1)
+      {
+        struct stat buffer;
+        if(fstat(fd, &buffer) == 0 && buffer.st_size > 0)
+        {
+          void* mapping = mmap(nullptr, static_cast<size_t>(buffer.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+          if(mapping != MAP_FAILED)
+          {
+            data = static_cast<const char*>(mapping);
+            size = static_cast<size_t>(buffer.st_size);
+          }
+        }
+        ::close(fd);
+      }
+#endif
+    }
+
+    ~MappedFile()
+    {
+#ifndef WINDOWS
+      if(data)
+        munmap(const_cast<char*>(data), size);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+#ifdef WINDOWS
+  private:
+    std::vector<char> buffer;
+#endif
+  };
+
+  /** Reads the bundle from mapped memory and checks the bounds. */
+  class Reader
+  {
+  private:
+    const char* current;
+    const char* end;
+
+  public:
+    Reader(const char* data, size_t size) : current(data), end(data + size) {}
+
+    template<typename T> bool get(T& value)
+    {
+      if(static_cast<size_t>(end - current) < sizeof(T))
+        return false;
+      std::memcpy(&value, current, sizeof(T));
+      current += sizeof(T);
+      return true;
+    }
+
+    bool get(const char*& data, unsigned& size)
+    {
+      if(!get(size) || static_cast<size_t>(end - current) < size)
+        return false;
+      data = current;
+      current += size;
+      return true;
+    }
+  };
+
+  struct Entry
+  {
+    MapCache::Stamp stamp;
+    const char* data = nullptr; /**< The streamed parameters, either in the mapped file or in "payload". */
+    unsigned size = 0;
+    std::vector<char> payload; /**< Parameters added while running. */
+  };
+
+  /**
+   * Writes the bundle in a thread of its own, so that the threads that create
+   * modules, e.g. Motion, are not blocked by the file system.
+   */
+  class Writer
+  {
+  private:
+    Thread thread;
+    Semaphore requests; /**< Posted whenever the bundle should be written. */
+    std::mutex mutex; /**< Protects starting the thread and the counters. */
+    std::condition_variable finished; /**< Notified whenever a request was processed. */
+    bool started = false;
+    unsigned numOfRequests = 0; /**< The number of requests so far. */
+    unsigned numOfProcessed = 0; /**< The number of requests processed so far. */
+
+    void run()
+    {
+      Thread::nameCurrentThread("ConfigBundle");
+      while(requests.wait() && thread.isRunning())
+      {
+        ConfigBundle::save();
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          ++numOfProcessed;
+        }
+        finished.notify_all();
+      }
+    }
+
+  public:
+    Writer() : thread(-1) {}
+
+    ~Writer()
+    {
+      if(started)
+      {
+        thread.announceStop();
+        requests.post();
+        thread.stop();
+      }
+    }
+
+    /** Lets the thread write the bundle. The thread is started when this is called the first time. */
+    void request()
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(!started)
+        {
+          thread.start(this, &Writer::run);
+          started = true;
+        }
+        ++numOfRequests;
+      }
+      requests.post();
+    }
+
+    /** Waits until all requests made so far were processed. */
+    void wait()
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      finished.wait(lock, [this] {return numOfProcessed == numOfRequests;});
+    }
+  };
+
+  /**
+   * Returns the writer thread.
+   * @return The only instance.
+   */
+  Writer& getWriter()
+  {
+    static Writer writer;
+    return writer;
+  }
+
+  std::mutex mutex; /**< Protects the data below. */
+  unsigned numOfSaves = 0; /**< Makes the names of temporary files unique within this process. */
+  bool opened = false; /**< Was the bundle read? */
+  bool changed = false; /**< Were entries added since the bundle was read? */
+  std::string bundlePath;
+  std::unique_ptr<MappedFile> mappedFile;
+  std::unordered_map<std::string, Entry> entries; /**< Key: full path of the file + '\n' + key. */
+  ConfigBundle::Statistics statistics;
+
+  /**
+   * Returns the hash of the type information of this executable.
+   * If any streamed type changes, the hash changes.
+   * @return The hash.
+   */
+  unsigned long long getTypeHash()
+  {
+    static const unsigned long long hash = []
+    {
+      OutBinaryMemory stream(200000);
+      stream << TypeInfo(true);
+      unsigned long long hash = 14695981039346656037ull; // FNV-1a
+      for(const char* p = stream.data(), *end = p + stream.size(); p < end; ++p)
+        hash = (hash ^ static_cast<unsigned char>(*p)) * 1099511628211ull;
+      return hash;
+    }();
+    return hash;
+  }
+
+  /** Reads the bundle if it was not read yet. Must be called while holding the lock. */
+  void readBundle()
+  {
+    if(opened)
+      return;
+    opened = true;
+    if(bundlePath.empty())
+      bundlePath = std::string(File::getBHDir()) + "/Config/configBundle.bin";
+    mappedFile = std::make_unique<MappedFile>(bundlePath);
+    Reader reader(mappedFile->data, mappedFile->size);
+    unsigned fileMagic, fileVersion, numOfEntries;
+    unsigned long long typeHash;
+    if(!mappedFile->data || !reader.get(fileMagic) || fileMagic != ConfigBundle::magic
+       || !reader.get(fileVersion) || fileVersion != ConfigBundle::version
+       || !reader.get(typeHash) || typeHash != getTypeHash() || !reader.get(numOfEntries))
+      return;
+
+    for(unsigned i = 0; i < numOfEntries; ++i)
+    {
+      const char* key;
+      unsigned keySize;
+      Entry entry;
+      if(!reader.get(key, keySize) || !reader.get(entry.stamp.modified) || !reader.get(entry.stamp.size)
+         || !reader.get(entry.data, entry.size))
+      {
+        entries.clear();
+        return;
+      }
+      entries.emplace(std::string(key, keySize), std::move(entry));
+    }
+  }
+}
+
+void ConfigBundle::open(const std::string& path)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  entries.clear();
+  mappedFile.reset();
+  bundlePath = path;
+  opened = false;
+  changed = false;
+}
+
+bool ConfigBundle::read(Streamable& parameters, const std::string& name, const std::string& key)
+{
+  std::string fullName;
+  MapCache::Stamp stamp;
+  if(!MapCache::find(name, fullName, stamp))
+    return false;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  readBundle();
+  const auto entry = entries.find(fullName + '\n' + key);
+  if(entry == entries.end() || entry->second.stamp != stamp)
+  {
+    ++statistics.misses;
+    return false;
+  }
+  InBinaryMemory stream(entry->second.data, entry->second.size);
+  stream >> parameters;
+  ++statistics.hits;
+  return true;
+}
+
+void ConfigBundle::write(const Streamable& parameters, const std::string& name, const std::string& key)
+{
+  std::string fullName;
+  MapCache::Stamp stamp;
+  if(!MapCache::find(name, fullName, stamp))
+    return;
+
+  OutBinaryMemory stream;
+  stream << parameters;
+  Entry entry;
+  entry.stamp = stamp;
+  entry.payload.assign(stream.data(), stream.data() + stream.size());
+  entry.data = entry.payload.data();
+  entry.size = static_cast<unsigned>(entry.payload.size());
+
+  std::lock_guard<std::mutex> lock(mutex);
+  readBundle();
+  entries[fullName + '\n' + key] = std::move(entry);
+  changed = true;
+}
+
+void ConfigBundle::save()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if(!changed)
+    return;
+  changed = false;
+
+  // The new bundle replaces the old one atomically, which stays mapped. The temporary
+  // file is unique, because several processes may share the same bundle (e.g. in the
+  // simulator).
+#ifdef WINDOWS
+  const int pid = _getpid();
+#else
+  const int pid = static_cast<int>(getpid());
+#endif
+  const std::string tempPath = bundlePath + "." + std::to_string(pid) + "." + std::to_string(numOfSaves++) + ".tmp";
+  FILE* file = std::fopen(tempPath.c_str(), "wb");
+  if(!file)
+    return;
+  const unsigned long long typeHash = getTypeHash();
+  const unsigned numOfEntries = static_cast<unsigned>(entries.size());
+  bool ok = std::fwrite(&magic, sizeof(magic), 1, file) == 1
+            && std::fwrite(&version, sizeof(version), 1, file) == 1
+            && std::fwrite(&typeHash, sizeof(typeHash), 1, file) == 1
+            && std::fwrite(&numOfEntries, sizeof(numOfEntries), 1, file) == 1;
+  for(const auto& entry : entries)
+  {
+    const unsigned keySize = static_cast<unsigned>(entry.first.size());
+    ok = ok && std::fwrite(&keySize, sizeof(keySize), 1, file) == 1
+         && std::fwrite(entry.first.data(), 1, keySize, file) == keySize
+         && std::fwrite(&entry.second.stamp.modified, sizeof(entry.second.stamp.modified), 1, file) == 1
+         && std::fwrite(&entry.second.stamp.size, sizeof(entry.second.stamp.size), 1, file) == 1
+         && std::fwrite(&entry.second.size, sizeof(entry.second.size), 1, file) == 1
+         && std::fwrite(entry.second.data, 1, entry.second.size, file) == entry.second.size;
+  }
+  ok = std::fclose(file) == 0 && ok;
+#ifdef WINDOWS
+  // In contrast to POSIX, rename does not replace an existing file on Windows.
+  ok = ok && MoveFileExA(tempPath.c_str(), bundlePath.c_str(), MOVEFILE_REPLACE_EXISTING);
+#else
+  ok = ok && std::rename(tempPath.c_str(), bundlePath.c_str()) == 0;
+#endif
+  if(!ok)
+    std::remove(tempPath.c_str());
+}
+
+void ConfigBundle::saveInBackground()
+{
+  getWriter().request();
+}
+
+void ConfigBundle::waitForBackgroundSave()
+{
+  getWriter().wait();
+}
+
+ConfigBundle::Statistics ConfigBundle::getStatistics()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return statistics;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file ConfigBundle.h
+ *
+ * Declaration of a binary bundle of module parameters. When a module loads its
+ * parameters from a configuration file, their binary form is added to the
+ * bundle, which is written to Config/configBundle.bin by a background thread
+ * after modules were created. At the next start, the bundle is mapped into memory and parameters
+ * are read from it with InBinary instead of parsing the text files.
+ *
+ * The bundle is only used if it was written by an executable with the same
+ * type information, i.e. the hash of the streamed TypeInfo must match. Each
+ * entry remembers the path and stamp of the file it was created from. If the
+ * name of the file resolves to a different file or the file was changed, the
+ * entry is stale, the text file is read instead and the entry is replaced.
+ */
+
+#pragma once
+
+#include <string>
+
+class Streamable;
+
+class ConfigBundle
+{
+public:
+  static constexpr unsigned magic = 0x42434842; /**< "BHCB" */
+  static constexpr unsigned version = 1; /**< Incremented when the layout changes. */
+
+  /** Statistics about the use of the bundle since the start of the process. */
+  struct Statistics
+  {
+    unsigned hits = 0; /**< Parameters read from the bundle. */
+    unsigned misses = 0; /**< Parameters read from text files. */
+  };
+
+  /**
+   * Uses a different file as bundle. Entries added before are discarded.
+   * Normally, Config/configBundle.bin is used.
+   * @param path The path of the file.
+   */
+  static void open(const std::string& path);
+
+  /**
+   * Reads parameters from the bundle.
+   * @param parameters The parameters that are read.
+   * @param name The name of the configuration file they would be read from.
+   * @param key An additional key that distinguishes parameters read from
+   *            the same file, e.g. the name of the module.
+   * @return Were the parameters read? If not, there was no valid entry.
+   */
+  static bool read(Streamable& parameters, const std::string& name, const std::string& key);
+
+  /**
+   * Adds parameters to the bundle that were read from a configuration file.
+   * The bundle is only written when save is called.
+   * @param parameters The parameters.
+   * @param name The name of the configuration file they were read from.
+   * @param key An additional key that distinguishes parameters read from
+   *            the same file, e.g. the name of the module.
+   */
+  static void write(const Streamable& parameters, const std::string& name, const std::string& key);
+
+  /** Writes the bundle if entries were added since it was read. */
+  static void save();
+
+  /**
+   * Lets a background thread call save(), so that the caller is not blocked
+   * by writing the file.
+   */
+  static void saveInBackground();
+
+  /**
+   * Waits until the background thread has processed all calls of
+   * saveInBackground made so far.
+   */
+  static void waitForBackgroundSave();
+
+  /**
+   * Returns the statistics collected so far.
+   * @return The statistics.
+   */
+  static Statistics getStatistics();
+};
@@ -5,6 +5,7 @@
  */
 
 #include "Module.h"
+#include "ConfigBundle.h"
 #include "Tools/Streams/InStreams.h"
 #include "Platform/File.h"
 #include <iostream>
@@ -28,9 +29,13 @@ void loadModuleParameters(Streamable& parameters, const char* moduleName, const
   if(prefix)
     name = prefix + name;
   std::cout << "Loading module: " << name << std::endl;
-  InMapFile stream(name);
+  if(ConfigBundle::read(parameters, name, moduleName))
+    return;
+  InCachedMapFile stream(name);
   ASSERT(stream.exists());
   stream >> parameters;
+  if(stream.exists())
+    ConfigBundle::write(parameters, name, moduleName);
 }
 
 void saveModuleParameters(const Streamable& parameters, const char* moduleName, const char* fileName)
@@ -114,6 +114,27 @@ public:
   static void verify(void*) {}
   static void verify(const void*) {}
 
+  /**
+   * Returns the head of the list of all modules available.
+   * @return The first module or nullptr if there are none.
+   */
+  static const ModuleBase* getFirst() {return first;}
+
+  /**
+   * Returns the next entry in the list of all modules.
+   * @return The next module or nullptr if this is the last one.
+   */
+  const ModuleBase* getNext() const {return next;}
+
+  /** Returns the name of the module that can be created by this instance. */
+  const char* getName() const {return name;}
+
+  /** Returns the category of this module. */
+  Category getCategory() const {return category;}
+
+  /** Returns information about the requirements and provisions of the module. */
+  std::vector<Info> getInfo() const {return getModuleInfo();}
+
 private:
   static ModuleBase* first; /**< The head of the list of all modules available. */
   ModuleBase* next; /**< The next entry in the list of all modules. */
@@ -8,9 +8,11 @@
  */
 
 #include "ModuleGraphRunner.h"
-#ifdef TARGET_ROBOT
+#include "Platform/Memory.h"
+#include "ConfigBundle.h"
+#include "Tools/Debugging/SampleProfiler.h"
+#include "Tools/Streams/MapCache.h"
 #include "Platform/Time.h"
-#endif
 
 void ModuleGraphRunner::destroy()
 {
@@ -84,17 +86,39 @@ void ModuleGraphRunner::update(In& stream)
 
 void ModuleGraphRunner::execute()
 {
+  SampleProfiler& sampleProfiler = Global::getSampleProfiler();
+  bool countAllocations = false;
+  DEBUG_RESPONSE("allocations")
+    countAllocations = true;
+  std::string allocations;
+  unsigned numOfCreatedModules = 0;
+  unsigned creationTime = 0;
+
   // Execute all providers in the given sequence
   for(Provider& p : providers)
   {
     ASSERT(p.moduleState->required);
     if(!p.moduleState->instance)
+    {
+      const unsigned start = Time::getRealSystemTime();
       p.moduleState->instance = p.moduleState->module->createNew();
+      creationTime += Time::getRealTimeSince(start);
+      ++numOfCreatedModules;
+    }
 #ifdef TARGET_ROBOT
     unsigned timestamp = Time::getCurrentSystemTime();
 #endif
     if(p.moduleState->instance)
+    {
+      const unsigned allocationsBefore = Memory::getNumOfAllocations();
+      // The representation itself is pushed by the STOPWATCH around the update method
+      sampleProfiler.push(p.moduleState->module->name);
       p.update(*p.moduleState->instance);
+      sampleProfiler.pop();
+      const unsigned allocationsAfter = Memory::getNumOfAllocations();
+      if(countAllocations && allocationsAfter != allocationsBefore)
+        allocations += std::string(allocations.empty() ? "" : ", ") + p.representation + " " + std::to_string(allocationsAfter - allocationsBefore);
+    }
 #ifdef TARGET_ROBOT
     int duration = Time::getTimeSince(timestamp);
     if(timestamp > 110000 &&
@@ -108,6 +132,22 @@ void ModuleGraphRunner::execute()
   }
   BH_TRACE;
 
+  // Report how long creating the modules took and how well the configuration maps were shared.
+  if(numOfCreatedModules)
+  {
+    ConfigBundle::saveInBackground();
+    // The statistics are only collected if the text is actually sent.
+    OUTPUT_TEXT("Created " << numOfCreatedModules << " modules in " << creationTime << " ms (all threads so far: "
+                << ConfigBundle::getStatistics().hits << " configurations from bundle, "
+                << MapCache::getStatistics().loads << " configurations loaded, "
+                << MapCache::getStatistics().parses << " parsed in " << MapCache::getStatistics().parseTime / 1000 << " ms, "
+                << MapCache::getStatistics().probes << " paths checked)");
+  }
+
+  // Report the heap allocations of each provider that allocated in this frame.
+  if(!allocations.empty())
+    OUTPUT_TEXT("allocations: " << allocations);
+
   if(!timestamp) // Configuration changed recently?
   {
     // all representations must be constructed now, so we can receive data
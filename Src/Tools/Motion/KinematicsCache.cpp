@@ -0,0 +1,146 @@
+/**
+ * @file KinematicsCache.cpp
+ *
+ * Implementation of a class that memoizes forward kinematics.
+ */
+
+#include "KinematicsCache.h"
+#include "Tools/Math/BHMath.h"
+#include "Tools/Math/Rotation.h"
+#include "Tools/Motion/ForwardKinematic.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+  /** The joints and limbs of a chain. Each joint moves the limb with the same index. */
+  struct ChainInfo
+  {
+    Joints::Joint firstJoint;
+    Limbs::Limb firstLimb;
+    size_t numOfJoints;
+  };
+
+  const ChainInfo chainInfos[] =
+  {
+    {Joints::headYaw, Limbs::neck, 2},
+    {Joints::lShoulderPitch, Limbs::shoulderLeft, 5},
+    {Joints::rShoulderPitch, Limbs::shoulderRight, 5},
+    {Joints::lHipYawPitch, Limbs::pelvisLeft, 6},
+    {Joints::rHipYawPitch, Limbs::pelvisRight, 6}
+  };
+}
+
+void KinematicsCache::reset(const RobotDimensions& robotDimensions, const MassCalibration& massCalibration)
+{
+  this->robotDimensions = &robotDimensions;
+  this->massCalibration = &massCalibration;
+  numOfModels = 0;
+  numOfChainEntries.fill(0);
+  statistics = Statistics();
+}
+
+const RobotModel& KinematicsCache::getRobotModel(const JointAngles& jointAngles)
+{
+  return getEntry(jointAngles).robotModel;
+}
+
+const Matrix6f& KinematicsCache::getLegJacobian(Legs::Leg leg, const JointAngles& jointAngles)
+{
+  ModelEntry& entry = getEntry(jointAngles);
+  ++statistics.jacobians;
+  Matrix6f& jacobian = entry.legJacobians[leg];
+  if(entry.hasLegJacobian[leg])
+  {
+    ++statistics.jacobiansReused;
+    return jacobian;
+  }
+
+  // Each joint rotates around an axis through the origin of the limb it moves.
+  // Its column is the motion of the foot caused by rotating around that axis.
+  const int sign = leg == Legs::left ? 1 : -1;
+  const auto& limbs = entry.robotModel.limbs;
+  const Limbs::Limb pelvis = leg == Legs::left ? Limbs::pelvisLeft : Limbs::pelvisRight;
+  const Vector3f& foot = limbs[pelvis + 5].translation;
+  const Vector3f axes[6] =
+  {
+    Rotation::aroundX(pi_4 * sign) * Vector3f(0.f, 0.f, static_cast<float>(-sign)),
+    limbs[pelvis].rotation * Vector3f::UnitX(),
+    limbs[pelvis + 1].rotation * Vector3f::UnitY(),
+    limbs[pelvis + 2].rotation * Vector3f::UnitY(),
+    limbs[pelvis + 3].rotation * Vector3f::UnitY(),
+    limbs[pelvis + 4].rotation * Vector3f::UnitX()
+  };
+  for(int i = 0; i < 6; ++i)
+  {
+    jacobian.block<3, 1>(0, i) = axes[i].cross(foot - limbs[pelvis + i].translation);
+    jacobian.block<3, 1>(3, i) = axes[i];
+  }
+  entry.hasLegJacobian[leg] = true;
+  return jacobian;
+}
+
+KinematicsCache::ModelEntry& KinematicsCache::getEntry(const JointAngles& jointAngles)
+{
+  ++statistics.models;
+  for(size_t i = 0; i < std::min(numOfModels, maxEntries); ++i)
+    if(!std::memcmp(models[i].angles.data(), jointAngles.angles.data(), Joints::numOfJoints * sizeof(Angle)))
+    {
+      ++statistics.modelsReused;
+      return models[i];
+    }
+
+  ModelEntry& entry = getFreeEntry(models, numOfModels);
+  entry.angles = jointAngles.angles;
+  entry.hasLegJacobian.fill(false);
+
+  RobotModel& robotModel = entry.robotModel;
+  for(int chain = 0; chain < numOfChains; ++chain)
+    setChain(static_cast<Chain>(chain), jointAngles, robotModel);
+  robotModel.soleLeft = robotModel.limbs[Limbs::footLeft] + Vector3f(0.f, 0.f, -robotDimensions->footHeight);
+  robotModel.soleRight = robotModel.limbs[Limbs::footRight] + Vector3f(0.f, 0.f, -robotDimensions->footHeight);
+  robotModel.updateCenterOfMass(*massCalibration);
+  return entry;
+}
+
+void KinematicsCache::setChain(Chain chain, const JointAngles& jointAngles, RobotModel& robotModel)
+{
+  const ChainInfo& info = chainInfos[chain];
+  const Angle* angles = &jointAngles.angles[info.firstJoint];
+  Pose3f* limbs = &robotModel.limbs[info.firstLimb];
+  std::vector<ChainEntry>& entries = chains[chain];
+  ++statistics.chains;
+
+  for(size_t i = 0; i < std::min(numOfChainEntries[chain], maxEntries); ++i)
+    if(!std::memcmp(entries[i].angles.data(), angles, info.numOfJoints * sizeof(Angle)))
+    {
+      std::copy(entries[i].limbs.begin(), entries[i].limbs.begin() + info.numOfJoints, limbs);
+      ++statistics.chainsReused;
+      return;
+    }
+
+  switch(chain)
+  {
+    case head:
+      ForwardKinematic::calculateHeadChain(jointAngles, *robotDimensions, robotModel.limbs);
+      break;
+    case leftArm:
+    case rightArm:
+      ForwardKinematic::calculateArmChain(chain == leftArm ? Arms::left : Arms::right, jointAngles, *robotDimensions, robotModel.limbs);
+      break;
+    default:
+      ForwardKinematic::calculateLegChain(chain == leftLeg ? Legs::left : Legs::right, jointAngles, *robotDimensions, robotModel.limbs);
+  }
+
+  ChainEntry& entry = getFreeEntry(entries, numOfChainEntries[chain]);
+  std::copy(angles, angles + info.numOfJoints, entry.angles.begin());
+  std::copy(limbs, limbs + info.numOfJoints, entry.limbs.begin());
+}
+
+template<typename T> T& KinematicsCache::getFreeEntry(std::vector<T>& entries, size_t& numOfEntries)
+{
+  const size_t index = numOfEntries++ % maxEntries;
+  if(index == entries.size())
+    entries.emplace_back();
+  return entries[index];
+}
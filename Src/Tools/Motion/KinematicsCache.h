@@ -0,0 +1,124 @@
+/**
+ * @file KinematicsCache.h
+ *
+ * Declaration of a class that memoizes forward kinematics. Robot models are
+ * computed once per distinct joint vector. The kinematic chains they consist of
+ * are memoized separately, so a model that only differs from a previous one in
+ * some chains, e.g. the legs, only recomputes these chains.
+ */
+
+#pragma once
+
+#include "Representations/Sensing/RobotModel.h"
+#include "Tools/RobotParts/Legs.h"
+#include <array>
+#include <vector>
+
+class KinematicsCache
+{
+public:
+  /** Statistics about the use of the cache since the last reset. */
+  struct Statistics
+  {
+    unsigned models = 0; /**< The number of robot models requested. */
+    unsigned modelsReused = 0; /**< The number of robot models returned from the cache. */
+    unsigned chains = 0; /**< The number of kinematic chains needed for models not in the cache. */
+    unsigned chainsReused = 0; /**< The number of these chains taken from the cache. */
+    unsigned jacobians = 0; /**< The number of leg Jacobians requested. */
+    unsigned jacobiansReused = 0; /**< The number of leg Jacobians returned from the cache. */
+  };
+
+  /**
+   * Empties the cache. Must be called whenever the joint angles or the
+   * configuration of the robot might have changed, i.e. once per frame.
+   * @param robotDimensions The dimensions of the robot. Must exist until the next reset.
+   * @param massCalibration The mass calibration of the robot. Must exist until the next reset.
+   */
+  void reset(const RobotDimensions& robotDimensions, const MassCalibration& massCalibration);
+
+  /**
+   * Returns the robot model for the given joint angles.
+   * @param jointAngles The joint angles.
+   * @return The robot model. It is valid until the next call of a method of this object.
+   */
+  const RobotModel& getRobotModel(const JointAngles& jointAngles);
+
+  /**
+   * Returns the Jacobian of the pose of a foot relative to the torso with
+   * respect to the joints of its leg. The first three rows belong to the
+   * translation (in mm/rad), the last three to the rotation (as angle axis).
+   * @param leg The leg.
+   * @param jointAngles The joint angles.
+   * @return The Jacobian. It is valid until the next call of a method of this object.
+   */
+  const Matrix6f& getLegJacobian(Legs::Leg leg, const JointAngles& jointAngles);
+
+  /**
+   * Returns the statistics collected since the last reset.
+   * @return The statistics.
+   */
+  const Statistics& getStatistics() const {return statistics;}
+
+private:
+  static constexpr size_t maxEntries = 16; /**< The maximum number of models and of each chain kept. */
+
+  /** The kinematic chains that are memoized separately. */
+  enum Chain
+  {
+    head,
+    leftArm,
+    rightArm,
+    leftLeg,
+    rightLeg,
+    numOfChains
+  };
+
+  /** The joint angles and resulting limb poses of a chain. */
+  struct ChainEntry
+  {
+    std::array<Angle, 6> angles;
+    std::array<Pose3f, 6> limbs;
+  };
+
+  /** A robot model and the joint angles it was computed from. */
+  struct ModelEntry
+  {
+    ENUM_INDEXED_ARRAY(Angle, Joints::Joint) angles;
+    RobotModel robotModel;
+    std::array<Matrix6f, Legs::numOfLegs> legJacobians;
+    std::array<bool, Legs::numOfLegs> hasLegJacobian;
+  };
+
+  const RobotDimensions* robotDimensions = nullptr;
+  const MassCalibration* massCalibration = nullptr;
+  std::vector<ModelEntry> models; /**< The models. Entries are kept over resets to avoid constructing them again. */
+  size_t numOfModels = 0; /**< The number of models computed since the last reset. */
+  std::array<std::vector<ChainEntry>, numOfChains> chains; /**< The chains. Entries are kept over resets. */
+  std::array<size_t, numOfChains> numOfChainEntries = {}; /**< The number of chains computed since the last reset. */
+  Statistics statistics;
+
+  /**
+   * Returns the entry to store a new result in. If all entries are in use,
+   * the oldest one is replaced.
+   * @param entries The entries.
+   * @param numOfEntries The number of entries in use. Will be updated.
+   * @return The entry.
+   */
+  template<typename T> static T& getFreeEntry(std::vector<T>& entries, size_t& numOfEntries);
+
+  /**
+   * Returns the entry for the given joint angles, computing it if necessary.
+   * @param jointAngles The joint angles.
+   * @return The entry.
+   */
+  ModelEntry& getEntry(const JointAngles& jointAngles);
+
+  /**
+   * Sets the limb poses of a chain in a robot model, either from the cache or
+   * by computing them.
+   * @param chain The chain.
+   * @param jointAngles The joint angles.
+   * @param robotModel The robot model the limb poses are written to.
+   */
+  void setChain(Chain chain, const JointAngles& jointAngles, RobotModel& robotModel);
+};
@@ -0,0 +1,72 @@
+/**
+ * The file declares a bounded lock-free queue for exactly one producer thread
+ * and exactly one consumer thread. The capacity must be a power of two. One
+ * slot is never used, so the queue can hold at most capacity - 1 elements.
+ * The type of the elements must be default constructible and move assignable.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+template<typename T, std::size_t capacity> class SPSCQueue
+{
+  static_assert(capacity >= 2 && (capacity & (capacity - 1)) == 0, "The capacity must be a power of two");
+
+private:
+  static constexpr std::size_t mask = capacity - 1;
+
+  T buffer[capacity]; /**< Stores the elements of the queue. */
+  alignas(64) std::atomic<std::size_t> head{0}; /**< The next entry that will be read. Only written by the consumer. */
+  alignas(64) std::atomic<std::size_t> tail{0}; /**< The next entry that will be written. Only written by the producer. */
+
+public:
+  /**
+   * Adds an element to the queue. May only be called by the producer thread.
+   * @param value The element that is moved into the queue.
+   * @return Was there space left? If not, the element was not added.
+   */
+  bool push(T&& value)
+  {
+    const std::size_t t = tail.load(std::memory_order_relaxed);
+    const std::size_t next = (t + 1) & mask;
+    if(next == head.load(std::memory_order_acquire))
+      return false;
+    buffer[t] = std::move(value);
+    tail.store(next, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Adds a copy of an element to the queue. May only be called by the producer thread.
+   * @param value The element that is copied into the queue.
+   * @return Was there space left? If not, the element was not added.
+   */
+  bool push(const T& value)
+  {
+    T copy(value);
+    return push(std::move(copy));
+  }
+
+  /**
+   * Removes the oldest element from the queue. May only be called by the consumer thread.
+   * @param value The element is moved to this variable if one was available.
+   * @return Was an element available?
+   */
+  bool pop(T& value)
+  {
+    const std::size_t h = head.load(std::memory_order_relaxed);
+    if(h == tail.load(std::memory_order_acquire))
+      return false;
+    value = std::move(buffer[h]);
+    head.store((h + 1) & mask, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Is the queue empty? The result is only a snapshot if called by the producer.
+   * @return Whether there are no elements in the queue.
+   */
+  bool empty() const {return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);}
+};
@@ -12,6 +12,7 @@
 #include <cstdio>
 
 #include "InStreams.h"
+#include "MapCache.h"
 #include "Platform/BHAssert.h"
 #include "Platform/File.h"
 #include "Tools/Debugging/Debugging.h"
@@ -393,7 +394,12 @@ void InMemory::readFromStream(void* p, size_t size)
 
 void InMap::parse(In& stream, const std::string& name)
 {
-  map = new SimpleMap(stream, name);
+  setMap(std::make_shared<const SimpleMap>(stream, name), name);
+}
+
+void InMap::setMap(const std::shared_ptr<const SimpleMap>& map, const std::string& name)
+{
+  this->map = map;
   this->name = name;
   stack.reserve(20);
 }
@@ -436,7 +442,7 @@ void InMap::inChar(char& value)
     const SimpleMap::Literal* literal = dynamic_cast<const SimpleMap::Literal*>(e.value);
     if(literal)
     {
-      In& stream = *literal;
+      InTextMemory stream(literal->getString().c_str(), literal->getString().size());
       int i;
       stream >> i;
       value = static_cast<char>(i);
@@ -456,7 +462,7 @@ void InMap::inSChar(signed char& value)
     const SimpleMap::Literal* literal = dynamic_cast<const SimpleMap::Literal*>(e.value);
     if(literal)
     {
-      In& stream = *literal;
+      InTextMemory stream(literal->getString().c_str(), literal->getString().size());
       int i;
       stream >> i;
       value = static_cast<signed char>(i);
@@ -476,7 +482,7 @@ void InMap::inUChar(unsigned char& value)
     const SimpleMap::Literal* literal = dynamic_cast<const SimpleMap::Literal*>(e.value);
     if(literal)
     {
-      In& stream = *literal;
+      InTextMemory stream(literal->getString().c_str(), literal->getString().size());
       if(e.enumType)
       {
         std::string s;
@@ -514,7 +520,7 @@ void InMap::inInt(int& value)
     const SimpleMap::Literal* literal = dynamic_cast<const SimpleMap::Literal*>(e.value);
     if(literal)
     {
-      In& stream = *literal;
+      InTextMemory stream(literal->getString().c_str(), literal->getString().size());
       stream >> value;
       if(!stream.eof())
         printError("wrong format");
@@ -545,7 +551,7 @@ void InMap::inUInt(unsigned int& value)
     const SimpleMap::Literal* literal = dynamic_cast<const SimpleMap::Literal*>(e.value);
     if(literal)
     {
-      In& stream = *literal;
+      InTextMemory stream(literal->getString().c_str(), literal->getString().size());
       stream >> value;
       if(!stream.eof())
         printError("wrong format");
@@ -628,6 +634,18 @@ InMapFile::InMapFile(const std::string& name, bool showErrors) :
     parse(stream, stream.getFullName());
 }
 
+InCachedMapFile::InCachedMapFile(const std::string& name, bool showErrors) :
+  InMap(showErrors)
+{
+  std::string fullName;
+  std::shared_ptr<const SimpleMap> map = MapCache::get(name, fullName);
+  if(map)
+  {
+    found = true;
+    setMap(map, fullName);
+  }
+}
+
 InMapMemory::InMapMemory(const void* memory, size_t size, bool showErrors) :
   InMap(showErrors),
   stream(memory, size)
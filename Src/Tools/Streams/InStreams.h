@@ -10,6 +10,7 @@
 #pragma once
 
 #include "SimpleMap.h"
+#include <memory>
 
 class File;
 
@@ -1026,7 +1027,7 @@ private:
     {}
   };
 
-  SimpleMap* map = nullptr; /**< The configuration map that was read. */
+  std::shared_ptr<const SimpleMap> map; /**< The configuration map that was read. It is never changed, so it can be shared. */
   std::string name; /**< The name of the opened file. */
   std::vector<Entry> stack; /**< The hierarchy of values to read. */
   bool showErrors; /**< Show error messages if specification does not match. */
@@ -1050,7 +1051,8 @@ private:
       const SimpleMap::Literal* literal = dynamic_cast<const SimpleMap::Literal*>(e.value);
       if(literal)
       {
-        In& stream = *literal;
+        // The map might be shared with other threads, so the literal's own stream is not used.
+        InTextMemory stream(literal->getString().c_str(), literal->getString().size());
         stream >> value;
         if(!stream.eof())
           printError("wrong format");
@@ -1067,12 +1069,6 @@ protected:
    */
   InMap(bool showErrors) : showErrors(showErrors) {}
 
-  ~InMap()
-  {
-    if(map != nullptr)
-      delete map;
-  }
-
   /** No assignment operator. */
   InMap& operator=(const InMap&) = delete;
 
@@ -1083,6 +1079,13 @@ protected:
    */
   void parse(In& stream, const std::string& name = "");
 
+  /**
+   * Uses a map that was already parsed.
+   * @param map The map. It must not be changed while it is read.
+   * @param name The name of the map if it is a file.
+   */
+  void setMap(const std::shared_ptr<const SimpleMap>& map, const std::string& name);
+
   /**
    * Virtual redirection for operator>>(bool& value).
    */
@@ -1188,7 +1191,7 @@ public:
    * This is only the case if the file does not exist or
    * reading failed.
    */
-  bool eof() const override {return (const SimpleMap::Value*) *map == 0;}
+  bool eof() const override {return !map || (const SimpleMap::Value*) *map == 0;}
 
   friend class DebugDataStreamer; // needs access to printError to report suppressible error message
 };
@@ -1218,6 +1221,33 @@ public:
   bool exists() const {return stream.exists();}
 };
 
+/**
+ * @class InCachedMapFile
+ *
+ * A stream that reads data from a text file in config map format. The file is
+ * parsed only once per process and shared with all other readers through the
+ * MapCache. Files are parsed again when they were changed.
+ */
+class InCachedMapFile : public InMap
+{
+private:
+  bool found = false; /**< Was the file found? */
+
+public:
+  /**
+   * Constructor.
+   * @param name The name of the config file to read.
+   * @param showErrors Show error messages if specification does not match.
+   */
+  InCachedMapFile(const std::string& name, bool showErrors = true);
+
+  /**
+   * The function states whether this stream actually exists.
+   * @return Does the stream exist?
+   */
+  bool exists() const {return found;}
+};
+
 /**
  * @class InMapMemory
  *
@@ -0,0 +1,109 @@
+/**
+ * @file MapCache.cpp
+ *
+ * Implementation of a process-wide cache of parsed configuration maps.
+ */
+
+#include "MapCache.h"
+#include "InStreams.h"
+#include "Platform/File.h"
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+#include <sys/stat.h>
+
+namespace
+{
+  struct Entry
+  {
+    MapCache::Stamp stamp;
+    std::shared_ptr<const SimpleMap> map;
+  };
+
+  std::mutex mutex; /**< Protects the data below. */
+  std::unordered_map<std::string, Entry> entries; /**< The maps parsed. Key: full path. */
+  MapCache::Statistics statistics;
+
+  /**
+   * Determines the stamp of a file.
+   * @param path The path of the file.
+   * @param stamp Receives the stamp if the file exists.
+   * @return Does the file exist?
+   */
+  bool getStamp(const std::string& path, MapCache::Stamp& stamp)
+  {
+    struct stat buffer;
+    if(stat(path.c_str(), &buffer) != 0 || (buffer.st_mode & S_IFMT) != S_IFREG)
+      return false;
+#ifdef LINUX
+    stamp.modified = static_cast<long long>(buffer.st_mtim.tv_sec) * 1000000000 + buffer.st_mtim.tv_nsec;
+#else
+    stamp.modified = static_cast<long long>(buffer.st_mtime);
+#endif
+    stamp.size = static_cast<long long>(buffer.st_size);
+    return true;
+  }
+}
+
+bool MapCache::find(const std::string& name, std::string& fullName, Stamp& stamp)
+{
+  // stat is used instead of opening the files, so no descriptors are created.
+  unsigned probes = 0;
+  fullName = name;
+  bool found = false;
+  for(const std::string& path : File::getFullNames(name))
+  {
+    ++probes;
+    if(getStamp(path, stamp))
+    {
+      fullName = path;
+      found = true;
+      break;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  statistics.probes += probes;
+  return found;
+}
+
+std::shared_ptr<const SimpleMap> MapCache::get(const std::string& name, std::string& fullName)
+{
+  Stamp stamp;
+  const bool found = find(name, fullName, stamp);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    ++statistics.loads;
+    if(!found)
+      return nullptr;
+    const auto entry = entries.find(fullName);
+    if(entry != entries.end() && entry->second.stamp == stamp)
+      return entry->second.map;
+  }
+
+  // Parsing happens outside the lock, so other threads are not blocked.
+  const auto start = std::chrono::steady_clock::now();
+  InBinaryFile stream(fullName);
+  if(!stream.exists())
+    return nullptr;
+  std::shared_ptr<const SimpleMap> map = std::make_shared<const SimpleMap>(stream, fullName);
+  const unsigned duration = static_cast<unsigned>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ++statistics.parses;
+  statistics.parseTime += duration;
+  entries[fullName] = {stamp, map};
+  return map;
+}
+
+MapCache::Statistics MapCache::getStatistics()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return statistics;
+}
+
+void MapCache::clear()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  entries.clear();
+}
@@ -0,0 +1,67 @@
+/**
+ * @file MapCache.h
+ *
+ * Declaration of a process-wide cache of parsed configuration maps. Many
+ * threads (and, in the simulator, many robots) load the same configuration
+ * files when their modules are created. The cache resolves the name of a file
+ * the same way File does, but parses each file only once. Parsed maps are
+ * shared read-only between all readers and are parsed again if the file's
+ * modification time or size changed.
+ */
+
+#pragma once
+
+#include "SimpleMap.h"
+#include <memory>
+#include <string>
+
+class MapCache
+{
+public:
+  /** What is remembered about a file to detect changes. */
+  struct Stamp
+  {
+    long long modified = 0; /**< The modification time (in the resolution of the file system). */
+    long long size = 0; /**< The size in bytes. */
+
+    bool operator==(const Stamp& other) const {return modified == other.modified && size == other.size;}
+    bool operator!=(const Stamp& other) const {return !(*this == other);}
+  };
+
+  /** Statistics about the use of the cache since the start of the process. */
+  struct Statistics
+  {
+    unsigned loads = 0; /**< The number of maps requested. */
+    unsigned parses = 0; /**< The number of files actually parsed. */
+    unsigned probes = 0; /**< The number of candidate paths checked. */
+    unsigned parseTime = 0; /**< The time spent reading and parsing files in us. */
+  };
+
+  /**
+   * Returns the parsed map of a configuration file.
+   * @param name The name of the file. Relative names are searched in the
+   *             configuration directories like in File.
+   * @param fullName Receives the full path of the file found.
+   * @return The map or nullptr if the file was not found.
+   */
+  static std::shared_ptr<const SimpleMap> get(const std::string& name, std::string& fullName);
+
+  /**
+   * Searches a configuration file in the same sequence as File does, but
+   * without opening any files.
+   * @param name The name of the file.
+   * @param fullName Receives the full path of the file found.
+   * @param stamp Receives the stamp of the file found.
+   * @return Was the file found?
+   */
+  static bool find(const std::string& name, std::string& fullName, Stamp& stamp);
+
+  /**
+   * Returns the statistics collected so far.
+   * @return The statistics.
+   */
+  static Statistics getStatistics();
+
+  /** Removes all maps from the cache. Readers still using them keep them. */
+  static void clear();
+};
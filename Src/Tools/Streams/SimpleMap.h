@@ -59,7 +59,9 @@ public:
         delete stream;
     }
 
-    operator In&() const; /**< Returns a stream that can parse the literal. */
+    operator In&() const; /**< Returns a stream that can parse the literal. Not thread-safe. */
+
+    const std::string& getString() const {return literal;} /**< Returns the literal itself. */
   };
 
   /** A class representing a record of attributes, i.e. a mapping of names to values. */
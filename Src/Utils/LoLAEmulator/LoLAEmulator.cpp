@@ -0,0 +1,297 @@
+/**
+ * @file LoLAEmulator.cpp
+ *
+ * A standalone emulation of the LoLA endpoint of the NAO. It listens on the
+ * Unix socket NaoProvider connects to and sends sensor packets in LoLA's
+ * cycle. The packets are either replayed from a recording (as written by
+ * "dr module:NaoProvider:recordSensorPackets") or a packet of a standing robot
+ * is generated. The actuator packets received are written to a file and
+ * the time between sending each sensor packet and receiving the reply is
+ * reported, so the latency of the Motion thread can be measured on an
+ * ordinary Linux machine.
+ *
+ * Usage: lolaEmulator [-s <socket>] [-r <recording>] [-o <actuators>]
+ *                     [-c <cycle in ms>] [-j <jitter in ms>] [-n <packets>]
+ */
+
+#include <algorithm>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <random>
+#include <string>
+#include <vector>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static volatile std::sig_atomic_t running = 1;
+
+/** Writes the subset of MsgPack used by LoLA. */
+class PacketWriter
+{
+public:
+  std::vector<unsigned char> data;
+
+  void mapHeader(size_t n) {data.push_back(static_cast<unsigned char>(0x80 | n));}
+
+  void arrayHeader(size_t n)
+  {
+    if(n < 16)
+      data.push_back(static_cast<unsigned char>(0x90 | n));
+    else
+    {
+      data.push_back(0xdc);
+      data.push_back(static_cast<unsigned char>(n >> 8));
+      data.push_back(static_cast<unsigned char>(n));
+    }
+  }
+
+  void string(const std::string& s)
+  {
+    data.push_back(static_cast<unsigned char>(0xa0 | s.size()));
+    data.insert(data.end(), s.begin(), s.end());
+  }
+
+  void float32(float value)
+  {
+    unsigned bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    data.push_back(0xca);
+    for(int shift = 24; shift >= 0; shift -= 8)
+      data.push_back(static_cast<unsigned char>(bits >> shift));
+  }
+
+  void floats(const std::string& key, const std::vector<float>& values)
+  {
+    string(key);
+    arrayHeader(values.size());
+    for(float value : values)
+      float32(value);
+  }
+};
+
+/**
+ * Creates the sensor packet of a robot standing upright with its joints at zero.
+ * @return The packet.
+ */
+static std::vector<unsigned char> createStandingPacket()
+{
+  PacketWriter writer;
+  writer.mapHeader(13);
+  writer.string("RobotConfig");
+  writer.arrayHeader(4);
+  for(const char* s : {"P0000073A07S8C700011", "6.0.0", "P0000074A05S93M00061", "6.0.0"})
+    writer.string(s);
+  writer.floats("Accelerometer", {0.f, 0.f, -9.81f});
+  writer.floats("Angles", {0.f, 0.f});
+  writer.floats("Battery", {1.f, 0.f, -0.5f, 30.f});
+  writer.floats("Current", std::vector<float>(25, 0.05f));
+  writer.floats("FSR", std::vector<float>(8, 0.6f));
+  writer.floats("Gyroscope", {0.f, 0.f, 0.f});
+  writer.floats("Position", std::vector<float>(25, 0.f));
+  writer.floats("Sonar", {2.55f, 2.55f});
+  writer.floats("Stiffness", std::vector<float>(25, 0.f));
+  writer.floats("Temperature", std::vector<float>(25, 35.f));
+  writer.floats("Touch", std::vector<float>(14, 0.f));
+  writer.string("Status");
+  writer.arrayHeader(25);
+  writer.data.insert(writer.data.end(), 25, 0); // positive fixint 0
+  return writer.data;
+}
+
+/**
+ * Reads a recording of sensor packets, each preceded by its size as 32 bit integer.
+ * @param path The path of the recording.
+ * @return The packets. Empty if the file could not be read.
+ */
+static std::vector<std::vector<unsigned char>> readRecording(const char* path)
+{
+  std::vector<std::vector<unsigned char>> packets;
+  FILE* file = std::fopen(path, "rb");
+  if(!file)
+    return packets;
+  unsigned size;
+  while(std::fread(&size, sizeof(size), 1, file) == 1 && size <= 65536)
+  {
+    packets.emplace_back(size);
+    if(std::fread(packets.back().data(), 1, size, file) != size)
+    {
+      packets.pop_back();
+      break;
+    }
+  }
+  std::fclose(file);
+  return packets;
+}
+
+static long long now()
+{
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<long long>(ts.tv_sec) * 1000000000ll + ts.tv_nsec;
+}
+
+static void report(std::vector<double>& latencies, unsigned sent, unsigned missed)
+{
+  if(latencies.empty())
+  {
+    std::printf("%u packets sent, no replies\n", sent);
+    return;
+  }
+  std::sort(latencies.begin(), latencies.end());
+  double sum = 0.;
+  for(double latency : latencies)
+    sum += latency;
+  std::printf("%u packets sent, %u without reply, sensor to actuator latency: avg %.2f ms, median %.2f ms, 99%% %.2f ms, max %.2f ms\n",
+              sent, missed, sum / latencies.size(), latencies[latencies.size() / 2],
+              latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)], latencies.back());
+  std::fflush(stdout);
+}
+
+int main(int argc, char* argv[])
+{
+  const char* socketPath = "/tmp/robocup";
+  const char* recordingPath = nullptr;
+  const char* actuatorPath = nullptr;
+  double cycleTime = 12.;
+  double jitter = 0.;
+  long long numOfPackets = -1;
+  for(int i = 1; i + 1 < argc; i += 2)
+  {
+    if(!std::strcmp(argv[i], "-s"))
+      socketPath = argv[i + 1];
+    else if(!std::strcmp(argv[i], "-r"))
+      recordingPath = argv[i + 1];
+    else if(!std::strcmp(argv[i], "-o"))
+      actuatorPath = argv[i + 1];
+    else if(!std::strcmp(argv[i], "-c"))
+      cycleTime = std::atof(argv[i + 1]);
+    else if(!std::strcmp(argv[i], "-j"))
+      jitter = std::atof(argv[i + 1]);
+    else if(!std::strcmp(argv[i], "-n"))
+      numOfPackets = std::atoll(argv[i + 1]);
+    else
+    {
+      std::fprintf(stderr, "usage: %s [-s <socket>] [-r <recording>] [-o <actuators>] [-c <cycle in ms>] [-j <jitter in ms>] [-n <packets>]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  std::vector<std::vector<unsigned char>> packets;
+  if(recordingPath)
+  {
+    packets = readRecording(recordingPath);
+    if(packets.empty())
+    {
+      std::fprintf(stderr, "Could not read recording %s\n", recordingPath);
+      return 1;
+    }
+  }
+  else
+    packets.push_back(createStandingPacket());
+
+  FILE* actuators = actuatorPath ? std::fopen(actuatorPath, "wb") : nullptr;
+  if(actuatorPath && !actuators)
+  {
+    std::fprintf(stderr, "Could not create %s\n", actuatorPath);
+    return 1;
+  }
+
+  const int server = socket(AF_UNIX, SOCK_STREAM, 0);
+  sockaddr_un address = {};
+  address.sun_family = AF_UNIX;
+  std::strncpy(address.sun_path, socketPath, sizeof(address.sun_path) - 1);
+  unlink(socketPath);
+  if(server < 0 || bind(server, reinterpret_cast<sockaddr*>(&address), sizeof(address)) || listen(server, 1))
+  {
+    std::perror("Could not listen");
+    return 1;
+  }
+
+  std::signal(SIGINT, [](int) {running = 0;});
+  std::signal(SIGTERM, [](int) {running = 0;});
+  std::signal(SIGPIPE, SIG_IGN);
+
+  std::printf("Waiting for a connection on %s\n", socketPath);
+  std::fflush(stdout);
+  const int client = accept(server, nullptr, nullptr);
+  if(client < 0)
+    return 1;
+
+  std::mt19937 random(42);
+  std::uniform_real_distribution<double> jitterDistribution(-jitter, jitter);
+  std::vector<double> latencies;
+  std::vector<unsigned char> buffer(4096);
+  unsigned sent = 0;
+  unsigned missed = 0;
+  long long nextCycle = now();
+  long long lastSent = 0;
+  bool replied = true;
+  size_t index = 0;
+
+  while(running && numOfPackets)
+  {
+    // Wait for the next cycle, receiving actuator packets in the meantime.
+    const long long sendTime = nextCycle + static_cast<long long>(jitterDistribution(random) * 1e6);
+    for(long long time = now(); time < sendTime && running; time = now())
+    {
+      pollfd fd = {client, POLLIN, 0};
+      const int timeout = static_cast<int>((sendTime - time + 999999) / 1000000);
+      if(poll(&fd, 1, timeout) > 0)
+      {
+        const ssize_t size = read(client, buffer.data(), buffer.size());
+        if(size <= 0)
+        {
+          running = 0;
+          break;
+        }
+        const long long receiveTime = now();
+        if(!replied)
+        {
+          latencies.push_back(static_cast<double>(receiveTime - lastSent) / 1e6);
+          replied = true;
+        }
+        if(actuators)
+        {
+          const unsigned packetSize = static_cast<unsigned>(size);
+          std::fwrite(&receiveTime, sizeof(receiveTime), 1, actuators);
+          std::fwrite(&packetSize, sizeof(packetSize), 1, actuators);
+          std::fwrite(buffer.data(), 1, packetSize, actuators);
+        }
+      }
+    }
+    if(!running)
+      break;
+
+    // Busy wait for the remaining fraction of a millisecond.
+    while(now() < sendTime)
+      ;
+
+    if(!replied)
+      ++missed;
+    const std::vector<unsigned char>& packet = packets[index];
+    index = (index + 1) % packets.size();
+    if(write(client, packet.data(), packet.size()) != static_cast<ssize_t>(packet.size()))
+      break;
+    lastSent = now();
+    replied = false;
+    ++sent;
+    if(numOfPackets > 0)
+      --numOfPackets;
+    nextCycle += static_cast<long long>(cycleTime * 1e6);
+    if(sent % 1000 == 0)
+      report(latencies, sent, missed);
+  }
+
+  report(latencies, sent, missed);
+  if(actuators)
+    std::fclose(actuators);
+  close(client);
+  close(server);
+  unlink(socketPath);
+  return 0;
+}
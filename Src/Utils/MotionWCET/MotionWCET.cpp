@@ -0,0 +1,537 @@
+/**
+ * @file MotionWCET.cpp
+ *
+ * An offline harness that determines the worst-case execution time of the
+ * Motion thread. It replays the inputs of the Motion thread from a log file,
+ * i.e. the sensor data logged in the Motion thread (JointSensorData,
+ * InertialSensorData, FsrSensorData, KeyStates, FrameInfo) and the
+ * representations the Motion thread receives from other threads (e.g.
+ * MotionRequest), through the actual module graph of the Motion thread
+ * configured in threads.cfg. No robot and no simulator are required. The
+ * execution time of each provider (thread time as measured by the
+ * stopwatches) and of each frame (wall clock time) is recorded. Optionally,
+ * the caches are flushed before each frame and other threads compete for the
+ * caches and the memory bandwidth. The program fails if the 99.9th percentile
+ * of the frame times exceeds a budget.
+ *
+ * Usage: motionWCET [-b <budget in us>] [-r <repetitions>] [-s <frames to skip>]
+ *                   [-f] [-t <noisy neighbours>] [-o <csv file>] <log file>
+ */
+
+#include "Modules/Infrastructure/LogDataProvider/LogDataProvider.h"
+#include "Tools/Debugging/Stopwatch.h"
+#include "Tools/Framework/Configuration.h"
+#include "Tools/Framework/ThreadFrame.h"
+#include "Tools/FunctionList.h"
+#include "Tools/Global.h"
+#include "Tools/Logging/LoggingTools.h"
+#include "Tools/Math/Constants.h"
+#include "Tools/Module/ModuleGraphCreator.h"
+#include "Tools/Module/ModuleGraphRunner.h"
+#include "Tools/Streams/InStreams.h"
+#include "Tools/Streams/OutStreams.h"
+#include "Tools/Streams/TypeInfo.h"
+
+#include <snappy-c.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/** The representations of the Motion thread that are replaced by their logged versions if they were logged. */
+static const char* const replayedRepresentations[] =
+{
+  "FrameInfo",
+  "FsrSensorData",
+  "InertialSensorData",
+  "JointSensorData",
+  "KeyStates"
+};
+
+static constexpr size_t cacheBufferSize = 64 << 20; /**< The size of the memory touched to evict all caches. */
+
+/**
+ * Writes to a buffer in steps of a cache line.
+ * @param buffer The buffer.
+ * @param value The value added to each byte written.
+ */
+static void touch(std::vector<unsigned char>& buffer, unsigned char value)
+{
+  volatile unsigned char* data = buffer.data();
+  for(size_t i = 0; i < buffer.size(); i += 64)
+    data[i] += value;
+}
+
+/** Forwards messages to a function. */
+class FunctionHandler : public MessageHandler
+{
+  std::function<bool(InMessage&)> handler;
+
+public:
+  FunctionHandler(const std::function<bool(InMessage&)>& handler) : handler(handler) {}
+
+  bool handleMessage(InMessage& message) override {return handler(message);}
+};
+
+/**
+ * Executes the modules of the Motion thread for each Motion frame of a log
+ * file and records the execution times.
+ */
+class MotionWCET : public ThreadFrame
+{
+  MessageQueue log; /**< The messages of the log file. */
+  std::unique_ptr<TypeInfo> logTypeInfo; /**< The specification of the types in the log file if it contains one. */
+  std::string motionThread; /**< The name of the thread that runs the Motion execution unit. */
+  std::unordered_set<std::string> received; /**< The representations the Motion thread requires from other threads. They are provided by default. */
+  std::unique_ptr<ModuleGraphRunner> moduleGraphRunner; /**< Executes the modules of the Motion thread. */
+  std::vector<unsigned char> cacheBuffer; /**< Memory written before each frame to evict the caches. Empty if caches are not flushed. */
+  unsigned framesToSkip; /**< The number of frames at the beginning that are not measured. */
+  unsigned numOfFrames = 0; /**< The number of frames executed so far. */
+  std::vector<unsigned> frameTimes; /**< The wall clock time of each measured frame in us. */
+  std::unordered_map<unsigned short, std::string> watchNames; /**< The names of the stopwatches by their ids. */
+  std::unordered_map<unsigned short, std::vector<unsigned>> watchTimes; /**< The times of the stopwatches in each measured frame in us. */
+
+public:
+  /**
+   * Constructor.
+   * @param framesToSkip The number of frames at the beginning that are not measured.
+   * @param flushCaches Evict all caches before each frame?
+   */
+  MotionWCET(unsigned framesToSkip, bool flushCaches) :
+    ThreadFrame(nullptr, nullptr), framesToSkip(framesToSkip)
+  {
+    log.setSize(0x40000000); // 1 GB
+    if(flushCaches)
+      cacheBuffer.resize(cacheBufferSize);
+  }
+
+  ~MotionWCET()
+  {
+    setGlobals();
+    moduleGraphRunner.reset();
+  }
+
+  /**
+   * Loads the log file and sets up the modules of the Motion thread.
+   * @param fileName The name of the log file.
+   * @return Was loading successful?
+   */
+  bool load(const std::string& fileName);
+
+  /** Executes all Motion frames of the log file. */
+  void replay();
+
+  /**
+   * Prints the execution times and writes the frame times to a file.
+   * @param budget The maximum time the 99.9th percentile of the frames may take in us.
+   * @param csvFileName The name of the file the frame times are written to or nullptr.
+   * @return Was the budget met?
+   */
+  bool report(unsigned budget, const char* csvFileName) const;
+
+protected:
+  int getPriority() const override {return 0;}
+  void init() override {}
+  bool main() override {return false;}
+  void terminate() override {}
+
+private:
+  /** Reads the messages of the log file. Follows LogPlayer::open. */
+  bool readLog(const std::string& fileName);
+
+  /** Executes the modules once if the data of the current frame is complete. */
+  void executeFrame();
+
+  /**
+   * Collects the stopwatch times of the last frame.
+   * @param message The message containing the timing data of the frame.
+   * @return Was it the message with the timing data?
+   */
+  bool collectTimes(InMessage& message);
+};
+
+bool MotionWCET::load(const std::string& fileName)
+{
+  setGlobals();
+
+  InMapFile stream("threads.cfg");
+  Configuration config;
+  stream >> config;
+  if(!stream.exists() || config().empty())
+  {
+    std::fprintf(stderr, "Cannot open the file threads.cfg or the file is empty.\n");
+    return false;
+  }
+  const auto motion = std::find_if(config().begin(), config().end(), [](const Configuration::Thread& thread) {return thread.executionUnit == "Motion";});
+  if(motion == config().end())
+  {
+    std::fprintf(stderr, "threads.cfg does not contain a thread that executes Motion.\n");
+    return false;
+  }
+  motionThread = motion->name;
+
+  if(!readLog(fileName))
+  {
+    std::fprintf(stderr, "Cannot read the log file %s.\n", fileName.c_str());
+    return false;
+  }
+
+  // Determine which representations were logged in the Motion thread.
+  std::unordered_set<std::string> logged;
+  std::string thread;
+  FunctionHandler scanner([&](InMessage& message)
+  {
+    if(message.getMessageID() == idFrameBegin)
+      thread = message.readThreadIdentifier();
+    else if(thread == motionThread && message.getMessageID() > idFrameFinished && message.getMessageID() < numOfDataMessageIDs)
+      logged.insert(TypeRegistry::getEnumName(message.getMessageID()) + 2);
+    return true;
+  });
+  log.handleAllMessages(scanner);
+
+  // The logged sensor data replaces the data of the NaoProvider, the same as "log mr" does in the simulator.
+  for(Configuration::RepresentationProvider& rp : motion->representationProviders)
+    if(logged.count(rp.representation)
+       && std::find_if(std::begin(replayedRepresentations), std::end(replayedRepresentations),
+                       [&](const char* representation) {return rp.representation == representation;}) != std::end(replayedRepresentations))
+      rp.provider = "LogDataProvider";
+  if(!logged.count("JointSensorData"))
+    std::fprintf(stderr, "Warning: The log file does not contain JointSensorData of the thread %s.\n", motionThread.c_str());
+
+  // Only the modules of the Motion thread are linked into this program. Therefore, the
+  // other threads are removed. Everything the Motion thread would receive from them is
+  // provided by default instead and filled in from their frames in the log.
+  std::unordered_set<std::string> provided;
+  for(const Configuration::RepresentationProvider& rp : motion->representationProviders)
+    provided.insert(rp.representation);
+  for(const Configuration::RepresentationProvider& rp : motion->representationProviders)
+  {
+    const ModuleBase* module = ModuleBase::getFirst();
+    while(module && rp.provider != module->getName())
+      module = module->getNext();
+    if(!module)
+    {
+      std::fprintf(stderr, "The module %s is not part of this program.\n", rp.provider.c_str());
+      return false;
+    }
+    for(const ModuleBase::Info& info : module->getInfo())
+      if(!info.update && !provided.count(info.representation))
+        received.insert(info.representation);
+  }
+  Configuration motionConfig;
+  motionConfig().push_back(*motion);
+  motionConfig.defaultRepresentations.assign(received.begin(), received.end());
+
+  ModuleGraphCreator moduleGraphCreator(motionConfig);
+  OutBinaryMemory configData(20000);
+  configData << motionConfig;
+  InBinaryMemory configStream(configData.data());
+  if(!moduleGraphCreator.update(configStream))
+  {
+    std::fprintf(stderr, "The module configuration of the thread %s is invalid.\n", motionThread.c_str());
+    return false;
+  }
+  const ModuleGraphCreator::ExecutionValues values = moduleGraphCreator.getExecutionValues(0);
+
+  moduleGraphRunner = std::make_unique<ModuleGraphRunner>(motionConfig().size());
+  OutBinaryMemory request(20000);
+  request << values << 0xffffffff;
+  InBinaryMemory requestStream(request.data());
+  moduleGraphRunner->update(requestStream);
+
+  // Create all modules, so that the LogDataProvider exists to receive data.
+  moduleGraphRunner->execute();
+  debugSender->clear();
+
+  if(logTypeInfo)
+  {
+    MessageQueue typeInfoQueue;
+    typeInfoQueue.out.bin << *logTypeInfo;
+    typeInfoQueue.out.finishMessage(idTypeInfo);
+    FunctionHandler forwarder(&LogDataProvider::handleMessage);
+    typeInfoQueue.handleAllMessages(forwarder);
+  }
+  return true;
+}
+
+bool MotionWCET::readLog(const std::string& fileName)
+{
+  InBinaryFile file(fileName);
+  if(!file.exists())
+    return false;
+
+  char magicByte;
+  file >> magicByte;
+  if(magicByte == LoggingTools::logFileMessageIDs)
+  {
+    log.readMessageIDMapping(file);
+    file >> magicByte;
+  }
+  if(magicByte == LoggingTools::logFileTypeInfo)
+  {
+    logTypeInfo = std::make_unique<TypeInfo>(false);
+    file >> *logTypeInfo;
+    file >> magicByte;
+  }
+
+  if(magicByte == LoggingTools::logFileUncompressed)
+    file >> log;
+  else if(magicByte == LoggingTools::logFileCompressed)
+  {
+    std::vector<char> compressedBuffer;
+    std::vector<char> uncompressedBuffer;
+    while(!file.eof())
+    {
+      unsigned compressedSize;
+      file >> compressedSize;
+      compressedBuffer.resize(compressedSize);
+      file.read(compressedBuffer.data(), compressedSize);
+      size_t uncompressedSize = 0;
+      if(snappy_uncompressed_length(compressedBuffer.data(), compressedSize, &uncompressedSize) != SNAPPY_OK)
+        return false;
+      uncompressedBuffer.resize(uncompressedSize);
+      if(snappy_uncompress(compressedBuffer.data(), compressedSize, uncompressedBuffer.data(), &uncompressedSize) != SNAPPY_OK)
+        return false;
+      InBinaryMemory stream(uncompressedBuffer.data(), uncompressedSize);
+      stream >> log;
+    }
+  }
+  else
+    return false;
+  return !log.isEmpty();
+}
+
+void MotionWCET::replay()
+{
+  setGlobals();
+  std::string thread;
+  FunctionHandler player([&](InMessage& message)
+  {
+    switch(message.getMessageID())
+    {
+      case idFrameBegin:
+        thread = message.readThreadIdentifier();
+        break;
+      case idFrameFinished:
+        if(thread == motionThread)
+        {
+          LogDataProvider::handleMessage(message);
+          executeFrame();
+        }
+        break;
+      default:
+        if(thread == motionThread || received.count(TypeRegistry::getEnumName(message.getMessageID()) + 2))
+          LogDataProvider::handleMessage(message);
+    }
+    return true;
+  });
+  log.handleAllMessages(player);
+}
+
+void MotionWCET::executeFrame()
+{
+  if(!LogDataProvider::isFrameDataComplete())
+    return;
+
+  if(!cacheBuffer.empty())
+    touch(cacheBuffer, static_cast<unsigned char>(numOfFrames));
+
+  Global::getFrameArena().reset();
+  Global::getTimingManager().signalThreadStart();
+  const auto start = std::chrono::steady_clock::now();
+  STOPWATCH("AllModules") moduleGraphRunner->execute();
+  const auto duration = std::chrono::steady_clock::now() - start;
+  Global::getTimingManager().signalThreadStop();
+  debugSender->clear();
+
+  if(numOfFrames++ >= framesToSkip)
+  {
+    frameTimes.push_back(static_cast<unsigned>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count()));
+    FunctionHandler collector([this](InMessage& message) {return collectTimes(message);});
+    Global::getTimingManager().getData().handleAllMessages(collector);
+  }
+}
+
+bool MotionWCET::collectTimes(InMessage& message)
+{
+  if(message.getMessageID() != idStopwatch)
+    return false;
+
+  // See TimingManager::prepareData for the format.
+  unsigned short numOfNames;
+  message.bin >> numOfNames;
+  for(unsigned short i = 0; i < numOfNames; ++i)
+  {
+    unsigned short id;
+    std::string name;
+    message.bin >> id >> name;
+    watchNames[id] = name;
+  }
+  unsigned short numOfWatches;
+  message.bin >> numOfWatches;
+  for(unsigned short i = 0; i < numOfWatches; ++i)
+  {
+    unsigned short id;
+    unsigned time;
+    message.bin >> id >> time;
+    watchTimes[id].push_back(time);
+  }
+  return true;
+}
+
+/** The distribution of execution times. */
+struct Distribution
+{
+  std::string name;
+  double mean = 0.;
+  unsigned median = 0;
+  unsigned p99 = 0;
+  unsigned p999 = 0;
+  unsigned max = 0;
+
+  Distribution(const std::string& name, std::vector<unsigned> times) : name(name)
+  {
+    if(times.empty())
+      return;
+    std::sort(times.begin(), times.end());
+    for(unsigned time : times)
+      mean += time;
+    mean /= static_cast<double>(times.size());
+    median = percentile(times, 0.5);
+    p99 = percentile(times, 0.99);
+    p999 = percentile(times, 0.999);
+    max = times.back();
+  }
+
+  /**
+   * Returns the smallest time that is not exceeded by the given fraction of the times.
+   * @param sortedTimes The times in ascending order.
+   * @param fraction The fraction.
+   * @return The time.
+   */
+  static unsigned percentile(const std::vector<unsigned>& sortedTimes, double fraction)
+  {
+    const size_t index = static_cast<size_t>(std::ceil(fraction * static_cast<double>(sortedTimes.size())));
+    return sortedTimes[std::min(sortedTimes.size(), std::max(index, static_cast<size_t>(1))) - 1];
+  }
+
+  void print() const
+  {
+    std::printf("%-36s %9.1f %9u %9u %9u %9u\n", name.c_str(), mean, median, p99, p999, max);
+  }
+};
+
+bool MotionWCET::report(unsigned budget, const char* csvFileName) const
+{
+  if(frameTimes.empty())
+  {
+    std::fprintf(stderr, "No frames of the thread %s were measured.\n", motionThread.c_str());
+    return false;
+  }
+
+  std::vector<Distribution> providers;
+  for(const auto& [id, times] : watchTimes)
+  {
+    const auto name = watchNames.find(id);
+    providers.emplace_back(name == watchNames.end() ? std::to_string(id) : name->second, times);
+  }
+  std::sort(providers.begin(), providers.end(), [](const Distribution& a, const Distribution& b) {return a.p999 > b.p999;});
+  const Distribution frames("Frame (wall clock)", frameTimes);
+
+  std::printf("%u frames of thread %s measured, %u skipped\n", static_cast<unsigned>(frameTimes.size()), motionThread.c_str(), framesToSkip);
+  std::printf("%-36s %9s %9s %9s %9s %9s\n", "Stopwatch (thread time in us)", "mean", "median", "99%", "99.9%", "max");
+  for(const Distribution& provider : providers)
+    provider.print();
+  frames.print();
+
+  if(csvFileName)
+  {
+    FILE* file = std::fopen(csvFileName, "w");
+    if(file)
+    {
+      std::fprintf(file, "frame,time\n");
+      for(size_t i = 0; i < frameTimes.size(); ++i)
+        std::fprintf(file, "%u,%u\n", static_cast<unsigned>(i), frameTimes[i]);
+      std::fclose(file);
+    }
+    else
+      std::fprintf(stderr, "Cannot create %s.\n", csvFileName);
+  }
+
+  const bool met = frames.p999 <= budget;
+  std::printf("99.9%% of the frames took at most %u us, the budget is %u us: %s\n", frames.p999, budget, met ? "passed" : "FAILED");
+  return met;
+}
+
+int main(int argc, char* argv[])
+{
+  unsigned budget = static_cast<unsigned>(Constants::motionCycleTime * 1e6f);
+  unsigned repetitions = 1;
+  unsigned framesToSkip = 10;
+  bool flushCaches = false;
+  unsigned numOfNeighbours = 0;
+  const char* csvFileName = nullptr;
+  const char* logFileName = nullptr;
+  for(int i = 1; i < argc; ++i)
+  {
+    if(!std::strcmp(argv[i], "-f"))
+      flushCaches = true;
+    else if(i + 1 < argc && !std::strcmp(argv[i], "-b"))
+      budget = static_cast<unsigned>(std::atoi(argv[++i]));
+    else if(i + 1 < argc && !std::strcmp(argv[i], "-r"))
+      repetitions = static_cast<unsigned>(std::atoi(argv[++i]));
+    else if(i + 1 < argc && !std::strcmp(argv[i], "-s"))
+      framesToSkip = static_cast<unsigned>(std::atoi(argv[++i]));
+    else if(i + 1 < argc && !std::strcmp(argv[i], "-t"))
+      numOfNeighbours = static_cast<unsigned>(std::atoi(argv[++i]));
+    else if(i + 1 < argc && !std::strcmp(argv[i], "-o"))
+      csvFileName = argv[++i];
+    else if(argv[i][0] != '-' && !logFileName)
+      logFileName = argv[i];
+    else
+    {
+      logFileName = nullptr;
+      break;
+    }
+  }
+  if(!logFileName)
+  {
+    std::fprintf(stderr, "usage: %s [-b <budget in us>] [-r <repetitions>] [-s <frames to skip>] [-f] [-t <noisy neighbours>] [-o <csv file>] <log file>\n", argv[0]);
+    return 2;
+  }
+
+  FunctionList::execute();
+  MotionWCET harness(framesToSkip, flushCaches);
+  if(!harness.load(logFileName))
+    return 2;
+
+  // Noisy neighbours continuously evict the caches and use the memory bandwidth.
+  std::atomic<bool> running(true);
+  std::vector<std::thread> neighbours;
+  for(unsigned i = 0; i < numOfNeighbours; ++i)
+    neighbours.emplace_back([&running]
+    {
+      std::vector<unsigned char> buffer(cacheBufferSize);
+      for(unsigned char value = 0; running; ++value)
+        touch(buffer, value);
+    });
+
+  for(unsigned i = 0; i < repetitions; ++i)
+    harness.replay();
+
+  running = false;
+  for(std::thread& neighbour : neighbours)
+    neighbour.join();
+
+  return harness.report(budget, csvFileName) ? 0 : 1;
+}
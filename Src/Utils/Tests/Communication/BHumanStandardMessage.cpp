@@ -0,0 +1,290 @@
+#include "Representations/Communication/BHumanTeamMessageParts/BHumanStandardMessage.h"
+#include "Tools/Communication/BitStream.h"
+#include "Tools/Math/Constants.h"
+#include "Tools/Math/Random.h"
+#include "Tools/Settings.h"
+#include "Utils/Tests/gPrintf.h"
+
+#include "gtest/gtest.h"
+#include <SPLStandardMessage.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+/** The size of a BHumanStandardMessage in version 11, which was written byte-aligned with raw floats. */
+static int sizeOfVersion11(const BHumanStandardMessage& message)
+{
+  return 102 + static_cast<int>(message.obstacles.size()) * 25 + static_cast<int>(message.ntpMessages.size()) * 5;
+}
+
+static Vector2f randomPosition()
+{
+  return Vector2f(Random::uniform(-5200.f, 5200.f), Random::uniform(-3700.f, 3700.f));
+}
+
+static BHumanStandardMessage randomMessage(size_t numOfObstacles, size_t numOfNTPMessages)
+{
+  BHumanStandardMessage message;
+  message.magicNumber = static_cast<uint8_t>(Random::uniformInt(0, 255));
+  message.timestamp = Random::uniformInt(100000, 1000000);
+  message.isPenalized = Random::bernoulli();
+  message.isUpright = Random::bernoulli();
+  message.hasGroundContact = Random::bernoulli();
+  message.timeOfLastGroundContact = message.timestamp - Random::uniformInt(0, 10000);
+
+  message.robotPoseValidity = Random::uniform(0.f, 1.f);
+  message.robotPoseDeviation = Random::uniform(0.f, 2000.f);
+  const float sx = Random::uniform(10.f, 1000.f), sy = Random::uniform(10.f, 1000.f), sr = Random::uniform(0.01f, 1.f);
+  message.robotPoseCovariance = {{sx * sx, sy * sy, sr * sr, Random::uniform(-0.9f, 0.9f) * sx * sy,
+                                  Random::uniform(-0.9f, 0.9f) * sx * sr, Random::uniform(-0.9f, 0.9f) * sy * sr}};
+  message.timestampLastJumped = message.timestamp - Random::uniformInt(0, 30000);
+
+  message.ballTimeWhenLastSeen = message.timestamp - Random::uniformInt(0, 100000);
+  message.ballTimeWhenDisappeared = message.timestamp - Random::uniformInt(0, 100000);
+  message.ballSeenPercentage = static_cast<unsigned char>(Random::uniformInt(0, 100));
+  message.ballVelocity = Vector2f(Random::uniform(-3000.f, 3000.f), Random::uniform(-3000.f, 3000.f));
+  message.ballLastPercept = randomPosition();
+  const float bx = Random::uniform(10.f, 1000.f), by = Random::uniform(10.f, 1000.f);
+  message.ballCovariance = {{bx * bx, by * by, Random::uniform(-0.9f, 0.9f) * bx * by}};
+
+  message.confidenceOfLastWhistleDetection = static_cast<unsigned char>(Random::uniformInt(0, 255));
+  message.channelsUsedForWhistleDetection = static_cast<unsigned char>(Random::uniformInt(0, 4));
+  message.lastTimeWhistleDetected = message.timestamp - Random::uniformInt(0, 60000);
+
+  message.teamActivity = static_cast<unsigned char>(Random::uniformInt(0, 255));
+  message.timeWhenReachBall = message.timestamp + Random::uniformInt(0, 200000);
+  message.timeWhenReachBallStriker = message.timestamp + Random::uniformInt(0, 200000);
+  for(int i = 0; i < BHUMAN_STANDARD_MESSAGE_MAX_NUM_OF_PLAYERS; ++i)
+  {
+    message.teammateRolesIsGoalkeeper[i] = Random::bernoulli();
+    message.teammateRolesPlayBall[i] = Random::bernoulli();
+    message.teammateRolesPlayerIndex[i] = Random::uniformInt(-1, 6);
+  }
+  message.captain = Random::uniformInt(-1, 6);
+  message.teammateRolesTimestamp = message.timestamp - Random::uniformInt(0, 8000);
+  message.isGoalkeeper = Random::bernoulli();
+  message.playBall = Random::bernoulli();
+  message.supporterIndex = Random::uniformInt(-1, 6);
+
+  message.activity = static_cast<unsigned char>(Random::uniformInt(0, 255));
+  message.passTarget = Random::uniformInt(-1, 14);
+  message.walkingTo = randomPosition();
+  message.shootingTo = randomPosition();
+  message.goalTarget = randomPosition();
+
+  message.obstacles.resize(numOfObstacles);
+  for(Obstacle& obstacle : message.obstacles)
+  {
+    const float ox = Random::uniform(10.f, 1000.f), oy = Random::uniform(10.f, 1000.f), oxy = Random::uniform(-0.9f, 0.9f) * ox * oy;
+    obstacle.covariance << ox * ox, oxy, oxy, oy * oy;
+    obstacle.center = randomPosition();
+    obstacle.left = randomPosition();
+    obstacle.right = randomPosition();
+    obstacle.lastSeen = message.timestamp - Random::uniformInt(0, 16000);
+    obstacle.type = static_cast<Obstacle::Type>(Random::uniformInt(0, Obstacle::numOfTypes - 1));
+  }
+
+  message.say = static_cast<char>(Random::uniformInt(0, 127));
+  message.nextTeamTalk = message.timestamp + Random::uniformInt(0, 16000);
+
+  message.requestsNTPMessage = Random::bernoulli();
+  std::array<uint8_t, BHUMAN_STANDARD_MESSAGE_MAX_NUM_OF_PLAYERS> receivers = {{1, 2, 3, 4, 5, 6}};
+  std::shuffle(receivers.begin(), receivers.end(), Random::getGenerator());
+  for(size_t i = 0; i < numOfNTPMessages; ++i)
+  {
+    message.ntpMessages.emplace_back();
+    message.ntpMessages.back().receiver = receivers[i];
+    message.ntpMessages.back().requestOrigination = Random::uniformInt(0, 0xFFFFFFF);
+    message.ntpMessages.back().requestReceipt = message.timestamp - Random::uniformInt(0, 4000);
+  }
+  return message;
+}
+
+/** Compares a timestamp that was streamed relative to the message timestamp with a precision of 2^shift ms. */
+static void expectTime(unsigned expected, unsigned actual, unsigned shift)
+{
+  EXPECT_LE(std::abs(static_cast<int>(expected) - static_cast<int>(actual)), 1 << shift);
+}
+
+GTEST_TEST(BitStream, RoundTrip)
+{
+  for(int k = 0; k < 1000; ++k)
+  {
+    unsigned u = Random::uniformInt(0, 0x3FFF);
+    bool b = Random::bernoulli();
+    int i = Random::uniformInt(-1, 14);
+    float r = Random::uniform(-100.f, 100.f);
+    unsigned t = 1000000u - Random::uniformInt(0, 1000);
+    unsigned never = 0;
+
+    std::array<uint8_t, 16> buffer;
+    BitWriter writer(buffer.data());
+    writer.uint(u, 14);
+    writer.flag(b);
+    writer.integer(i, -1, 14);
+    writer.real(r, -100.f, 100.f, 0.5f);
+    writer.timestamp(t, 1000000u, false, 2, 10);
+    writer.timestamp(never, 1000000u, false, 2, 10);
+
+    BitCounter counter;
+    counter.uint(u, 14);
+    counter.flag(b);
+    counter.integer(i, -1, 14);
+    counter.real(r, -100.f, 100.f, 0.5f);
+    counter.timestamp(t, 1000000u, false, 2, 10);
+    counter.timestamp(never, 1000000u, false, 2, 10);
+
+    unsigned u2 = 0, t2 = 0, never2 = 1;
+    bool b2 = !b;
+    int i2 = 0;
+    float r2 = 0.f;
+    BitReader reader(buffer.data());
+    reader.uint(u2, 14);
+    reader.flag(b2);
+    reader.integer(i2, -1, 14);
+    reader.real(r2, -100.f, 100.f, 0.5f);
+    reader.timestamp(t2, 1000000u, false, 2, 10);
+    reader.timestamp(never2, 1000000u, false, 2, 10);
+
+    // 14 + 1 + 4 + 9 + 10 + 10 bits
+    EXPECT_EQ(6u, writer.size());
+    EXPECT_EQ(writer.size(), counter.size());
+    EXPECT_EQ(writer.size(), reader.size());
+    EXPECT_EQ(u, u2);
+    EXPECT_EQ(b, b2);
+    EXPECT_EQ(i, i2);
+    EXPECT_NEAR(r, r2, 0.25f + 1e-4f);
+    expectTime(t, t2, 2);
+    EXPECT_EQ(0u, never2);
+  }
+}
+
+GTEST_TEST(BitStream, Clipping)
+{
+  int i = 100;
+  float r = -1000.f;
+  unsigned t = 1;
+  std::array<uint8_t, 8> buffer;
+  BitWriter writer(buffer.data());
+  writer.integer(i, -1, 6);
+  writer.real(r, -10.f, 10.f, 1.f);
+  writer.timestamp(t, 1000000u, false, 0, 8);
+
+  BitReader reader(buffer.data());
+  reader.integer(i, -1, 6);
+  reader.real(r, -10.f, 10.f, 1.f);
+  reader.timestamp(t, 1000000u, false, 0, 8);
+  EXPECT_EQ(6, i);
+  EXPECT_EQ(-10.f, r);
+  EXPECT_EQ(1000000u - 254u, t);
+}
+
+GTEST_TEST(BHumanStandardMessage, RoundTrip)
+{
+  for(int k = 0; k < 200; ++k)
+  {
+    BHumanStandardMessage message = randomMessage(Random::uniformInt(0, BHUMAN_STANDARD_MESSAGE_MAX_NUM_OF_OBSTACLES),
+                                                  Random::uniformInt(0, BHUMAN_STANDARD_MESSAGE_MAX_NUM_OF_PLAYERS));
+    std::array<uint8_t, SPL_STANDARD_MESSAGE_DATA_SIZE> buffer;
+    BitWriter writer(buffer.data());
+    message.streamFields(writer);
+    ASSERT_EQ(static_cast<int>(writer.size()), message.sizeOfBHumanMessage());
+
+    BHumanStandardMessage received;
+    BitReader reader(buffer.data());
+    received.streamFields(reader);
+    EXPECT_EQ(writer.size(), reader.size());
+
+    EXPECT_EQ(0, std::memcmp(message.header, received.header, sizeof(message.header)));
+    EXPECT_EQ(message.version, received.version);
+    EXPECT_EQ(message.magicNumber, received.magicNumber);
+    EXPECT_EQ(message.timestamp, received.timestamp);
+    EXPECT_EQ(message.isPenalized, received.isPenalized);
+    EXPECT_EQ(message.isUpright, received.isUpright);
+    EXPECT_EQ(message.hasGroundContact, received.hasGroundContact);
+    expectTime(message.timeOfLastGroundContact, received.timeOfLastGroundContact, 6);
+
+    EXPECT_NEAR(message.robotPoseValidity, received.robotPoseValidity, 1.f / 255.f);
+    EXPECT_NEAR(message.robotPoseDeviation, received.robotPoseDeviation, 1.f);
+    for(int i = 0; i < 2; ++i)
+      EXPECT_NEAR(std::sqrt(message.robotPoseCovariance[i]), std::sqrt(received.robotPoseCovariance[i]), 0.5f + 1e-3f);
+    EXPECT_NEAR(std::sqrt(message.robotPoseCovariance[2]), std::sqrt(received.robotPoseCovariance[2]), pi / 2046.f + 1e-4f);
+    EXPECT_NEAR(message.robotPoseCovariance[3] / (std::sqrt(message.robotPoseCovariance[0] * message.robotPoseCovariance[1])),
+                received.robotPoseCovariance[3] / (std::sqrt(received.robotPoseCovariance[0] * received.robotPoseCovariance[1])), 1.f / 254.f + 1e-4f);
+    expectTime(message.timestampLastJumped, received.timestampLastJumped, 7);
+
+    expectTime(message.ballTimeWhenLastSeen, received.ballTimeWhenLastSeen, 3);
+    expectTime(message.ballTimeWhenDisappeared, received.ballTimeWhenDisappeared, 3);
+    EXPECT_EQ(message.ballSeenPercentage, received.ballSeenPercentage);
+    EXPECT_LT((message.ballVelocity - received.ballVelocity).norm(), 1.f);
+    EXPECT_LT((message.ballLastPercept - received.ballLastPercept).norm(), 1.f);
+    EXPECT_NEAR(std::sqrt(message.ballCovariance[0]), std::sqrt(received.ballCovariance[0]), 0.5f + 1e-3f);
+    EXPECT_NEAR(std::sqrt(message.ballCovariance[1]), std::sqrt(received.ballCovariance[1]), 0.5f + 1e-3f);
+
+    EXPECT_EQ(message.confidenceOfLastWhistleDetection, received.confidenceOfLastWhistleDetection);
+    EXPECT_EQ(message.channelsUsedForWhistleDetection, received.channelsUsedForWhistleDetection);
+    expectTime(message.lastTimeWhistleDetected, received.lastTimeWhistleDetected, 3);
+
+    EXPECT_EQ(message.teamActivity, received.teamActivity);
+    expectTime(message.timeWhenReachBall, received.timeWhenReachBall, 4);
+    expectTime(message.timeWhenReachBallStriker, received.timeWhenReachBallStriker, 4);
+    for(int i = 0; i < BHUMAN_STANDARD_MESSAGE_MAX_NUM_OF_PLAYERS; ++i)
+    {
+      EXPECT_EQ(message.teammateRolesIsGoalkeeper[i], received.teammateRolesIsGoalkeeper[i]);
+      EXPECT_EQ(message.teammateRolesPlayBall[i], received.teammateRolesPlayBall[i]);
+      EXPECT_EQ(message.teammateRolesPlayerIndex[i], received.teammateRolesPlayerIndex[i]);
+    }
+    EXPECT_EQ(message.captain, received.captain);
+    EXPECT_EQ(message.teammateRolesTimestamp, received.teammateRolesTimestamp);
+    EXPECT_EQ(message.isGoalkeeper, received.isGoalkeeper);
+    EXPECT_EQ(message.playBall, received.playBall);
+    EXPECT_EQ(message.supporterIndex, received.supporterIndex);
+
+    EXPECT_EQ(message.activity, received.activity);
+    EXPECT_EQ(message.passTarget, received.passTarget);
+    EXPECT_LT((message.walkingTo - received.walkingTo).norm(), 1.f);
+    EXPECT_LT((message.shootingTo - received.shootingTo).norm(), 1.f);
+    EXPECT_LT((message.goalTarget - received.goalTarget).norm(), 1.f);
+
+    ASSERT_EQ(message.obstacles.size(), received.obstacles.size());
+    for(size_t i = 0; i < message.obstacles.size(); ++i)
+    {
+      const Obstacle& sent = message.obstacles[i];
+      const Obstacle& got = received.obstacles[i];
+      EXPECT_NEAR(std::sqrt(sent.covariance(0, 0)), std::sqrt(got.covariance(0, 0)), 0.5f + 1e-3f);
+      EXPECT_NEAR(std::sqrt(sent.covariance(1, 1)), std::sqrt(got.covariance(1, 1)), 0.5f + 1e-3f);
+      EXPECT_EQ(got.covariance(0, 1), got.covariance(1, 0));
+      EXPECT_LT((sent.center - got.center).norm(), 1.f);
+      EXPECT_LT((sent.left - got.left).norm(), 3.f);
+      EXPECT_LT((sent.right - got.right).norm(), 3.f);
+      expectTime(sent.lastSeen, got.lastSeen, 6);
+      EXPECT_EQ(sent.type, got.type);
+    }
+
+    EXPECT_EQ(message.say, received.say);
+    expectTime(message.nextTeamTalk, received.nextTeamTalk, 6);
+
+    EXPECT_EQ(message.requestsNTPMessage, received.requestsNTPMessage);
+    ASSERT_EQ(message.ntpMessages.size(), received.ntpMessages.size());
+    for(const BNTPMessage& got : received.ntpMessages)
+    {
+      const auto sent = std::find_if(message.ntpMessages.begin(), message.ntpMessages.end(), [&](const BNTPMessage& m) {return m.receiver == got.receiver;});
+      ASSERT_TRUE(sent != message.ntpMessages.end());
+      EXPECT_EQ(sent->requestOrigination, got.requestOrigination);
+      EXPECT_EQ(sent->requestReceipt, got.requestReceipt);
+    }
+  }
+}
+
+GTEST_TEST(BHumanStandardMessage, Size)
+{
+  for(size_t numOfObstacles : {0, 3, BHUMAN_STANDARD_MESSAGE_MAX_NUM_OF_OBSTACLES})
+    for(size_t numOfNTPMessages : {0, BHUMAN_STANDARD_MESSAGE_MAX_NUM_OF_PLAYERS - 1})
+    {
+      const BHumanStandardMessage message = randomMessage(numOfObstacles, numOfNTPMessages);
+      EXPECT_LT(message.sizeOfBHumanMessage(), sizeOfVersion11(message));
+      PRINTF("%d obstacles, %d NTP messages: %d bytes (version 11: %d bytes)\n",
+             static_cast<int>(numOfObstacles), static_cast<int>(numOfNTPMessages), message.sizeOfBHumanMessage(), sizeOfVersion11(message));
+    }
+}
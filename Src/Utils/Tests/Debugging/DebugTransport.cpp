@@ -0,0 +1,149 @@
+#include "Platform/Nao/DebugHandler.h"
+#include "Tools/Debugging/DebugTransport.h"
+#include "Tools/Streams/OutStreams.h"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+static void addFrame(MessageQueue& queue, const std::string& thread, int numOfImages, size_t imageSize)
+{
+  queue.out.bin << thread;
+  queue.out.finishMessage(idFrameBegin);
+  queue.out.text << "Hello from " << thread;
+  queue.out.finishMessage(idText);
+  for(int i = 0; i < numOfImages; ++i)
+  {
+    const std::string image(imageSize, static_cast<char>('a' + i));
+    queue.out.bin.write(image.data(), image.size());
+    queue.out.finishMessage(idJPEGImage);
+  }
+  queue.out.bin << thread;
+  queue.out.finishMessage(idFrameFinished);
+}
+
+/** Counts the messages of each type. */
+class Counter : public MessageHandler
+{
+public:
+  int numOfMessages[numOfMessageIDs] = {0};
+
+  bool handleMessage(InMessage& message) override
+  {
+    ++numOfMessages[message.getMessageID()];
+    return true;
+  }
+};
+
+GTEST_TEST(DebugTransport, PackAndUnpack)
+{
+  for(bool compress : {false, true})
+  {
+    DebugTransport transport;
+    transport.compress = compress;
+    MessageQueue out;
+    addFrame(out, "Upper", 1, 1000);
+    const size_t streamedSize = out.getStreamedSize();
+
+    std::vector<unsigned char> packet;
+    transport.pack(out, packet);
+    EXPECT_TRUE(out.isEmpty());
+    EXPECT_EQ(compress, packet.size() < streamedSize);
+
+    MessageQueue in;
+    ASSERT_TRUE(DebugTransport::unpack(packet.data(), static_cast<int>(packet.size()), in));
+    Counter counter;
+    in.handleAllMessages(counter);
+    EXPECT_EQ(1, counter.numOfMessages[idText]);
+    EXPECT_EQ(1, counter.numOfMessages[idJPEGImage]);
+    EXPECT_EQ(1, counter.numOfMessages[idFrameBegin]);
+  }
+}
+
+GTEST_TEST(DebugTransport, BulkIsDeferredWithItsFrame)
+{
+  DebugTransport transport;
+  MessageQueue out;
+  const size_t imageSize = transport.getBulkBudget() * 2 / 3;
+  addFrame(out, "Upper", 3, imageSize);
+
+  std::vector<unsigned char> packet;
+  transport.pack(out, packet);
+  MessageQueue in;
+  ASSERT_TRUE(DebugTransport::unpack(packet.data(), static_cast<int>(packet.size()), in));
+  Counter sent;
+  in.handleAllMessages(sent);
+  EXPECT_EQ(1, sent.numOfMessages[idText]);
+  EXPECT_EQ(1, sent.numOfMessages[idJPEGImage]);
+
+  Counter deferred;
+  out.handleAllMessages(deferred);
+  EXPECT_EQ(0, deferred.numOfMessages[idText]);
+  EXPECT_EQ(2, deferred.numOfMessages[idJPEGImage]);
+  EXPECT_EQ(1, deferred.numOfMessages[idFrameBegin]);
+  EXPECT_EQ(1, deferred.numOfMessages[idFrameFinished]);
+}
+
+GTEST_TEST(DebugTransport, ThroughputLimitsBulk)
+{
+  DebugTransport transport;
+  const size_t initialBudget = transport.getBulkBudget();
+  for(int i = 0; i < 20; ++i)
+    transport.acknowledged(100000, 1000); // 100 kB/s
+  EXPECT_LT(transport.getBulkBudget(), initialBudget);
+  EXPECT_GE(transport.getBulkBudget(), DebugTransport::minBulkBudget);
+  transport.reset();
+  EXPECT_EQ(initialBudget, transport.getBulkBudget());
+}
+
+/**
+ * A robot-side DebugHandler and a PC-side connection talk over the loopback
+ * interface. The text of a frame must arrive with the first packet, even if
+ * the images of the frame need several packets.
+ */
+GTEST_TEST(DebugTransport, Loopback)
+{
+  MessageQueue robotIn, robotOut;
+  DebugHandler robot(robotIn, robotOut);
+  TcpConnection pc("127.0.0.1", 9999, TcpConnection::sender);
+  ASSERT_TRUE(pc.isClient());
+
+  const std::vector<unsigned char> hello = DebugTransport::hello();
+  unsigned char* data;
+  int size = 0;
+  ASSERT_TRUE(pc.sendAndReceive(hello.data(), static_cast<int>(hello.size()), data, size));
+
+  addFrame(robotOut, "Upper", 3, static_cast<size_t>(DebugTransport::initialThroughput * DebugTransport::maxBulkDuration));
+  MessageQueue pcIn;
+  Counter all;
+  int numOfPackets = 0;
+  bool compressed = false;
+  for(int i = 0; i < 1000 && all.numOfMessages[idJPEGImage] < 3; ++i)
+  {
+    robot.communicate(true);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    pc.sendAndReceive(nullptr, 0, data, size);
+    if(size > 0)
+    {
+      unsigned magic;
+      std::memcpy(&magic, data, sizeof(magic));
+      compressed |= magic == DebugTransport::compressedMagic;
+      ASSERT_TRUE(DebugTransport::unpack(data, size, pcIn));
+      delete[] data;
+      all = Counter();
+      pcIn.handleAllMessages(all);
+      if(++numOfPackets == 1)
+      {
+        EXPECT_EQ(1, all.numOfMessages[idText]);
+        EXPECT_EQ(1, all.numOfMessages[idJPEGImage]);
+      }
+    }
+  }
+  EXPECT_TRUE(compressed);
+  EXPECT_TRUE(robotOut.isEmpty());
+  EXPECT_EQ(1, all.numOfMessages[idText]);
+  EXPECT_EQ(3, all.numOfMessages[idJPEGImage]);
+}
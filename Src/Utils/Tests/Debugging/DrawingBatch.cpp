@@ -0,0 +1,374 @@
+#include "Controller/Visualization/DebugDrawing.h"
+#include "Tools/Debugging/DebugDrawings.h"
+#include "Tools/Debugging/DrawingBatch.h"
+#include "Tools/Math/Pose2f.h"
+#include "Tools/MessageQueue/MessageQueue.h"
+#include "Tools/Streams/Eigen.h"
+
+#include "gtest/gtest.h"
+#include "Utils/Tests/gPrintf.h"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+static bool operator==(const ColorRGBA& a, const ColorRGBA& b)
+{
+  return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+/** The contents of a typical field drawing: a planned path, obstacles with labels, and robot samples. */
+struct Frame
+{
+  std::vector<Vector2f> path;
+  std::vector<Vector2i> obstacles;
+  std::vector<Pose2f> samples;
+
+  Frame()
+  {
+    for(int i = 0; i < 101; ++i)
+      path.emplace_back(-4500.f + 90.f * static_cast<float>(i), 1500.f * std::sin(static_cast<float>(i) * 0.1f));
+    for(int i = 0; i < 10; ++i)
+      obstacles.emplace_back(-4000 + 800 * i, (i % 3 - 1) * 1200);
+    for(int i = 0; i < 50; ++i)
+      samples.emplace_back(static_cast<float>(i) * 0.1f, 1000.f + 3.7f * static_cast<float>(i), -500.f + 2.3f * static_cast<float>(i));
+  }
+};
+
+/** Writes a frame in the format that sends every primitive as a message of its own. */
+static void writeLegacy(const Frame& frame, MessageQueue& queue)
+{
+  for(size_t i = 1; i < frame.path.size(); ++i)
+  {
+    queue.out.bin << static_cast<char>(Drawings::line) << static_cast<char>(0)
+                  << frame.path[i - 1].x() << frame.path[i - 1].y() << frame.path[i].x() << frame.path[i].y()
+                  << 20.f << static_cast<char>(Drawings::solidPen) << ColorRGBA::blue;
+    queue.out.finishMessage(idDebugDrawing);
+  }
+  for(const Vector2i& obstacle : frame.obstacles)
+  {
+    queue.out.bin << static_cast<char>(Drawings::circle) << static_cast<char>(1)
+                  << obstacle.x() << obstacle.y() << 300 << static_cast<char>(10)
+                  << static_cast<char>(Drawings::solidPen) << ColorRGBA::black
+                  << static_cast<char>(Drawings::solidBrush) << ColorRGBA(255, 0, 0, 100);
+    queue.out.finishMessage(idDebugDrawing);
+  }
+  for(const Vector2i& obstacle : frame.obstacles)
+  {
+    queue.out.bin << static_cast<char>(Drawings::text) << static_cast<char>(1)
+                  << obstacle.x() << obstacle.y() + 400 << static_cast<short>(100) << ColorRGBA::black << "Obstacle";
+    queue.out.finishMessage(idDebugDrawing);
+  }
+  for(const Pose2f& sample : frame.samples)
+  {
+    queue.out.bin << static_cast<char>(Drawings::robot) << static_cast<char>(2)
+                  << sample << Vector2f(0.f, 0.f) << Vector2f(0.f, 0.f) << 0.5f
+                  << ColorRGBA::gray << ColorRGBA(0, 0, 0, 0) << ColorRGBA(0, 0, 0, 0);
+    queue.out.finishMessage(idDebugDrawing);
+  }
+}
+
+/** Writes the same frame in the compact encoding. */
+static void writeCompact(const Frame& frame, MessageQueue& queue)
+{
+  DrawingBatch batch;
+  for(size_t i = 1; i < frame.path.size(); ++i)
+    batch.begin(queue.out, idDebugDrawing, Drawings::line, 0)
+    .addCoordinate(frame.path[i - 1].x()).addCoordinate(frame.path[i - 1].y())
+    .addCoordinate(frame.path[i].x()).addCoordinate(frame.path[i].y())
+    .addCoordinate(20.f).addByte(Drawings::solidPen).addColor(ColorRGBA::blue);
+  for(const Vector2i& obstacle : frame.obstacles)
+    batch.begin(queue.out, idDebugDrawing, Drawings::circle, 1)
+    .addCoordinate(static_cast<float>(obstacle.x())).addCoordinate(static_cast<float>(obstacle.y())).addCoordinate(300.f)
+    .addByte(10).addByte(Drawings::solidPen | Drawings::solidBrush << 4)
+    .addColor(ColorRGBA::black).addColor(ColorRGBA(255, 0, 0, 100));
+  for(const Vector2i& obstacle : frame.obstacles)
+    batch.begin(queue.out, idDebugDrawing, Drawings::text, 1)
+    .addCoordinate(static_cast<float>(obstacle.x())).addCoordinate(static_cast<float>(obstacle.y() + 400))
+    .addNumber(100).addColor(ColorRGBA::black).addString("Obstacle");
+  for(const Pose2f& sample : frame.samples)
+    batch.begin(queue.out, idDebugDrawing, Drawings::robot, 2)
+    .addCoordinate(sample.translation.x()).addCoordinate(sample.translation.y()).addAngle(sample.rotation)
+    .addCoordinate(0.f).addCoordinate(0.f).addCoordinate(0.f).addCoordinate(0.f)
+    .addByte(static_cast<char>(128)).addColor(ColorRGBA::gray).addColor(ColorRGBA(0, 0, 0, 0)).addColor(ColorRGBA(0, 0, 0, 0));
+  batch.flush(queue.out);
+}
+
+/** Decodes all batches of a queue and checks them against the frame. */
+class Checker : public MessageHandler
+{
+public:
+  const Frame& frame;
+  int numOfLines = 0;
+  int numOfCircles = 0;
+  int numOfTexts = 0;
+  int numOfRobots = 0;
+
+  Checker(const Frame& frame) : frame(frame) {}
+
+  bool handleMessage(InMessage& message) override
+  {
+    EXPECT_EQ(idDebugDrawing, message.getMessageID());
+    unsigned char shapeType;
+    char id;
+    message.bin >> shapeType >> id;
+    EXPECT_TRUE(shapeType & DrawingBatch::batched);
+    DrawingBatch::Reader batch(message.bin);
+    while(batch.next())
+      switch(shapeType & ~DrawingBatch::batched)
+      {
+        case Drawings::line:
+        {
+          EXPECT_EQ(0, id);
+          const Vector2f& from = frame.path[numOfLines];
+          const Vector2f& to = frame.path[++numOfLines];
+          EXPECT_NEAR(from.x(), batch.coordinate(), 0.25f);
+          EXPECT_NEAR(from.y(), batch.coordinate(), 0.25f);
+          EXPECT_NEAR(to.x(), batch.coordinate(), 0.25f);
+          EXPECT_NEAR(to.y(), batch.coordinate(), 0.25f);
+          EXPECT_EQ(20.f, batch.coordinate());
+          EXPECT_EQ(Drawings::solidPen, batch.byte());
+          EXPECT_EQ(ColorRGBA::blue, batch.color());
+          break;
+        }
+        case Drawings::circle:
+        {
+          EXPECT_EQ(1, id);
+          const Vector2i& obstacle = frame.obstacles[numOfCircles++];
+          EXPECT_EQ(obstacle.x(), batch.integer());
+          EXPECT_EQ(obstacle.y(), batch.integer());
+          EXPECT_EQ(300, batch.integer());
+          EXPECT_EQ(10, batch.byte());
+          const unsigned char styles = static_cast<unsigned char>(batch.byte());
+          EXPECT_EQ(Drawings::solidPen, styles & 15);
+          EXPECT_EQ(Drawings::solidBrush, styles >> 4);
+          EXPECT_EQ(ColorRGBA::black, batch.color());
+          EXPECT_EQ(ColorRGBA(255, 0, 0, 100), batch.color());
+          break;
+        }
+        case Drawings::text:
+        {
+          const Vector2i& obstacle = frame.obstacles[numOfTexts++];
+          EXPECT_EQ(obstacle.x(), batch.integer());
+          EXPECT_EQ(obstacle.y() + 400, batch.integer());
+          EXPECT_EQ(100, batch.number());
+          EXPECT_EQ(ColorRGBA::black, batch.color());
+          EXPECT_EQ("Obstacle", batch.string());
+          break;
+        }
+        case Drawings::robot:
+        {
+          const Pose2f& sample = frame.samples[numOfRobots++];
+          EXPECT_NEAR(sample.translation.x(), batch.coordinate(), 0.25f);
+          EXPECT_NEAR(sample.translation.y(), batch.coordinate(), 0.25f);
+          EXPECT_NEAR(sample.rotation, batch.angle(), 1.f / 4096.f);
+          for(int j = 0; j < 4; ++j)
+            EXPECT_EQ(0.f, batch.coordinate());
+          EXPECT_EQ(128, static_cast<unsigned char>(batch.byte()));
+          EXPECT_EQ(ColorRGBA::gray, batch.color());
+          EXPECT_EQ(ColorRGBA(0, 0, 0, 0), batch.color());
+          EXPECT_EQ(ColorRGBA(0, 0, 0, 0), batch.color());
+          break;
+        }
+        default:
+          ADD_FAILURE() << "Unexpected shape type " << (shapeType & ~DrawingBatch::batched);
+      }
+    EXPECT_TRUE(message.bin.eof());
+    return true;
+  }
+};
+
+GTEST_TEST(DrawingBatch, RoundTrip)
+{
+  const Frame frame;
+  MessageQueue queue;
+  writeCompact(frame, queue);
+
+  Checker checker(frame);
+  queue.handleAllMessages(checker);
+  EXPECT_EQ(static_cast<int>(frame.path.size()) - 1, checker.numOfLines);
+  EXPECT_EQ(static_cast<int>(frame.obstacles.size()), checker.numOfCircles);
+  EXPECT_EQ(static_cast<int>(frame.obstacles.size()), checker.numOfTexts);
+  EXPECT_EQ(static_cast<int>(frame.samples.size()), checker.numOfRobots);
+}
+
+/** Decodes batches of dots that were drawn row by row in an image. */
+class DotChecker : public MessageHandler
+{
+public:
+  int numOfMessages = 0;
+  int numOfDots = 0;
+
+  bool handleMessage(InMessage& message) override
+  {
+    ++numOfMessages;
+    char shapeType, id;
+    message.bin >> shapeType >> id;
+    DrawingBatch::Reader batch(message.bin);
+    for(; batch.next(); ++numOfDots)
+    {
+      EXPECT_EQ(numOfDots % 640, batch.integer());
+      EXPECT_EQ(numOfDots / 640, batch.integer());
+      EXPECT_EQ(ColorRGBA::red, batch.color());
+      EXPECT_EQ(ColorRGBA::red, batch.color());
+    }
+    return true;
+  }
+};
+
+GTEST_TEST(DrawingBatch, LargeBatchIsSplit)
+{
+  MessageQueue queue;
+  DrawingBatch batch;
+  const int numOfDots = static_cast<int>(DrawingBatch::maxSize);
+  for(int i = 0; i < numOfDots; ++i)
+    batch.begin(queue.out, idDebugDrawing, Drawings::dot, 0)
+    .addCoordinate(static_cast<float>(i % 640)).addCoordinate(static_cast<float>(i / 640))
+    .addColor(ColorRGBA::red).addColor(ColorRGBA::red);
+  batch.flush(queue.out);
+  EXPECT_TRUE(batch.empty());
+
+  DotChecker checker;
+  queue.handleAllMessages(checker);
+  EXPECT_LT(1, checker.numOfMessages);
+  EXPECT_EQ(numOfDots, checker.numOfDots);
+}
+
+/** Decodes all messages of a queue into a drawing the way the RobotConsole does. */
+class DrawingDecoder : public MessageHandler
+{
+public:
+  DebugDrawing drawing;
+
+  bool handleMessage(InMessage& message) override
+  {
+    unsigned char shapeType;
+    char id;
+    message.bin >> shapeType >> id;
+    if(shapeType & DrawingBatch::batched)
+      EXPECT_TRUE(drawing.addShapesFromBatch(message, static_cast<Drawings::ShapeType>(shapeType & ~DrawingBatch::batched)));
+    else
+      EXPECT_TRUE(drawing.addShapeFromQueue(message, static_cast<Drawings::ShapeType>(shapeType)));
+    EXPECT_TRUE(message.bin.eof());
+    return true;
+  }
+};
+
+GTEST_TEST(DrawingBatch, DecodesLikeLegacyFormat)
+{
+  const Frame frame;
+  MessageQueue legacy, compact;
+  writeLegacy(frame, legacy);
+  writeCompact(frame, compact);
+  DrawingDecoder expected, actual;
+  legacy.handleAllMessages(expected);
+  compact.handleAllMessages(actual);
+
+  int numOfElements = 0;
+  const DebugDrawing::Element* e = expected.drawing.getFirst();
+  const DebugDrawing::Element* a = actual.drawing.getFirst();
+  for(; e && a; e = expected.drawing.getNext(e), a = actual.drawing.getNext(a), ++numOfElements)
+  {
+    ASSERT_EQ(e->type, a->type);
+    EXPECT_EQ(e->penStyle, a->penStyle);
+    EXPECT_EQ(e->penColor, a->penColor);
+    EXPECT_EQ(e->width, a->width);
+    switch(e->type)
+    {
+      case DebugDrawing::ElementType::line:
+      {
+        const DebugDrawing::Line& eLine = *static_cast<const DebugDrawing::Line*>(e);
+        const DebugDrawing::Line& aLine = *static_cast<const DebugDrawing::Line*>(a);
+        EXPECT_TRUE(eLine.start.isApprox(aLine.start, 1e-4f));
+        EXPECT_TRUE(eLine.end.isApprox(aLine.end, 1e-4f));
+        break;
+      }
+      case DebugDrawing::ElementType::ellipse:
+      {
+        const DebugDrawing::Ellipse& eEllipse = *static_cast<const DebugDrawing::Ellipse*>(e);
+        const DebugDrawing::Ellipse& aEllipse = *static_cast<const DebugDrawing::Ellipse*>(a);
+        EXPECT_EQ(eEllipse.center, aEllipse.center);
+        EXPECT_EQ(eEllipse.radii, aEllipse.radii);
+        EXPECT_EQ(eEllipse.rotation, aEllipse.rotation);
+        EXPECT_EQ(eEllipse.brushStyle, aEllipse.brushStyle);
+        EXPECT_EQ(eEllipse.brushColor, aEllipse.brushColor);
+        break;
+      }
+      case DebugDrawing::ElementType::text:
+      {
+        const DebugDrawing::Text& eText = *static_cast<const DebugDrawing::Text*>(e);
+        const DebugDrawing::Text& aText = *static_cast<const DebugDrawing::Text*>(a);
+        EXPECT_EQ(eText.x, aText.x);
+        EXPECT_EQ(eText.y, aText.y);
+        EXPECT_EQ(eText.fontSize, aText.fontSize);
+        EXPECT_STREQ(reinterpret_cast<const char*>(&eText + 1), reinterpret_cast<const char*>(&aText + 1));
+        break;
+      }
+      case DebugDrawing::ElementType::robot:
+      {
+        const DebugDrawing::Robot& eRobot = *static_cast<const DebugDrawing::Robot*>(e);
+        const DebugDrawing::Robot& aRobot = *static_cast<const DebugDrawing::Robot*>(a);
+        EXPECT_TRUE(eRobot.p.translation.isApprox(aRobot.p.translation, 1e-4f));
+        EXPECT_NEAR(eRobot.p.rotation, aRobot.p.rotation, 1.f / 4096.f);
+        EXPECT_EQ(eRobot.dirVec, aRobot.dirVec);
+        EXPECT_EQ(eRobot.dirHeadVec, aRobot.dirHeadVec);
+        EXPECT_NEAR(eRobot.alphaRobot, aRobot.alphaRobot, 1.f / 255.f);
+        EXPECT_EQ(eRobot.colorBody, aRobot.colorBody);
+        EXPECT_EQ(eRobot.colorDirVec, aRobot.colorDirVec);
+        EXPECT_EQ(eRobot.colorDirHeadVec, aRobot.colorDirHeadVec);
+        break;
+      }
+      default:
+        ADD_FAILURE() << "Unexpected element type " << static_cast<int>(e->type);
+    }
+  }
+  EXPECT_FALSE(e);
+  EXPECT_FALSE(a);
+  EXPECT_EQ(static_cast<int>(frame.path.size() - 1 + 2 * frame.obstacles.size() + frame.samples.size()), numOfElements);
+}
+
+GTEST_TEST(DrawingBatch, FarPrimitiveKeepsResolutionOfOthers)
+{
+  MessageQueue queue;
+  DrawingBatch batch;
+  for(int i = 0; i < 3; ++i)
+  {
+    const float offset = i == 1 ? 1000000.f : 0.f;
+    batch.begin(queue.out, idDebugDrawing, Drawings::line, 0)
+    .addCoordinate(offset + 0.3f).addCoordinate(-0.7f).addCoordinate(offset + 1.1f).addCoordinate(2.9f)
+    .addCoordinate(1.f).addByte(Drawings::solidPen).addColor(ColorRGBA::blue);
+  }
+  batch.flush(queue.out);
+
+  DrawingDecoder decoder;
+  queue.handleAllMessages(decoder);
+  int i = 0;
+  for(const DebugDrawing::Element* element = decoder.drawing.getFirst(); element; element = decoder.drawing.getNext(element), ++i)
+  {
+    ASSERT_EQ(DebugDrawing::ElementType::line, element->type);
+    const DebugDrawing::Line& line = *static_cast<const DebugDrawing::Line*>(element);
+    // The coarsest scale is 1/256, i.e. far values are off by up to 128.
+    const float tolerance = i == 1 ? 128.f : 1.f / 4096.f;
+    const float offset = i == 1 ? 1000000.f : 0.f;
+    EXPECT_NEAR(offset + 0.3f, line.start.x(), tolerance);
+    EXPECT_NEAR(-0.7f, line.start.y(), tolerance);
+    EXPECT_NEAR(offset + 1.1f, line.end.x(), tolerance);
+    EXPECT_NEAR(2.9f, line.end.y(), tolerance);
+  }
+  EXPECT_EQ(3, i);
+}
+
+GTEST_TEST(DrawingBatch, BytesPerFrame)
+{
+  const Frame frame;
+  MessageQueue legacy, compact;
+  writeLegacy(frame, legacy);
+  writeCompact(frame, compact);
+
+  const size_t legacySize = legacy.getStreamedSize();
+  const size_t compactSize = compact.getStreamedSize();
+  PRINTF("legacy: %d messages, %d bytes\n", legacy.getNumberOfMessages(), static_cast<int>(legacySize));
+  PRINTF("compact: %d messages, %d bytes (%.1f %%)\n", compact.getNumberOfMessages(), static_cast<int>(compactSize),
+         100.f * static_cast<float>(compactSize) / static_cast<float>(legacySize));
+  EXPECT_LT(compactSize * 2, legacySize);
+}
@@ -0,0 +1,56 @@
+#include "Tools/FrameArena.h"
+#include "Tools/Math/Eigen.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+
+GTEST_TEST(FrameArena, Alignment)
+{
+  FrameArena arena;
+  for(std::size_t alignment = 1; alignment <= 64; alignment *= 2)
+  {
+    arena.allocate(1, 1);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(arena.allocate(3, alignment)) % alignment, 0u);
+  }
+}
+
+GTEST_TEST(FrameArena, GrowsToSteadyState)
+{
+  FrameArena arena;
+  std::size_t firstFrame = 0;
+  for(int frame = 0; frame < 3; ++frame)
+  {
+    arena.reset();
+    const std::size_t capacity = arena.getCapacity();
+    {
+      FrameVector<Vector2f> points{FrameAllocator<Vector2f>(arena)};
+      for(int i = 0; i < 50000; ++i)
+        points.emplace_back(static_cast<float>(i), 0.f);
+      FrameVector<int> indices(1000, 0, FrameAllocator<int>(arena));
+      ASSERT_EQ(points[49999].x(), 49999.f);
+      ASSERT_EQ(indices.size(), 1000u);
+    }
+    if(frame == 0)
+      firstFrame = arena.getUsed();
+    else
+    {
+      // After the first frame, the arena is large enough and no additional blocks are allocated anymore.
+      EXPECT_EQ(arena.getCapacity(), capacity);
+      EXPECT_EQ(arena.getUsed(), firstFrame);
+      EXPECT_GE(arena.getCapacity(), firstFrame);
+    }
+  }
+}
+
+GTEST_TEST(FrameArena, ResetReusesMemory)
+{
+  FrameArena arena;
+  arena.reset();
+  void* first = arena.allocate(100, 8);
+  arena.allocate(100, 8);
+  EXPECT_EQ(arena.getUsed(), 204u); // including padding for the alignment
+  arena.reset();
+  EXPECT_EQ(arena.getUsed(), 0u);
+  EXPECT_EQ(arena.allocate(100, 8), first);
+}
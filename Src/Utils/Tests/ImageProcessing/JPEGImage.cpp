@@ -0,0 +1,161 @@
+#include "Representations/Infrastructure/JPEGImage.h"
+#include "Utils/Tests/bench.h"
+#include "Utils/Tests/ImageProcessing/TestImage.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <jpeglib.h>
+
+/**
+ * Encodes an image as a single JPEG in one pass, like JPEGImage did before it
+ * was split into slices.
+ * @param src The image. It is encoded with its full height.
+ * @param quality The JPEG quality.
+ * @param chromaSubsampling The resolution of the U and V channels.
+ * @return The JPEG.
+ */
+static std::vector<unsigned char> encodeSerial(const CameraImage& src, int quality, JPEGImage::ChromaSubsampling chromaSubsampling)
+{
+  std::vector<unsigned char> buffer(src.width * src.height * sizeof(CameraImage::PixelType) + 1024);
+
+  jpeg_compress_struct cInfo;
+  jpeg_error_mgr jem;
+  jpeg_destination_mgr dest;
+  cInfo.err = jpeg_std_error(&jem);
+  jpeg_create_compress(&cInfo);
+  dest.init_destination = [](j_compress_ptr) {};
+  dest.empty_output_buffer = [](j_compress_ptr) -> boolean {std::abort();};
+  dest.term_destination = [](j_compress_ptr) {};
+  dest.next_output_byte = buffer.data();
+  dest.free_in_buffer = buffer.size();
+  cInfo.dest = &dest;
+
+  cInfo.image_width = src.width;
+  cInfo.image_height = src.height;
+  cInfo.input_components = 4;
+  cInfo.in_color_space = JCS_CMYK;
+  jpeg_set_defaults(&cInfo);
+  cInfo.dct_method = JDCT_FASTEST;
+  jpeg_set_quality(&cInfo, quality, true);
+  const int h = chromaSubsampling == JPEGImage::both ? 2 : 1;
+  const int v = chromaSubsampling == JPEGImage::none ? 1 : 2;
+  cInfo.comp_info[0].h_samp_factor = cInfo.comp_info[2].h_samp_factor = h;
+  cInfo.comp_info[0].v_samp_factor = cInfo.comp_info[2].v_samp_factor = v;
+
+  jpeg_start_compress(&cInfo, true);
+  while(cInfo.next_scanline < cInfo.image_height)
+  {
+    JSAMPROW rowPointer = const_cast<JSAMPROW>(reinterpret_cast<const unsigned char*>(src[cInfo.next_scanline]));
+    jpeg_write_scanlines(&cInfo, &rowPointer, 1);
+  }
+  jpeg_finish_compress(&cInfo);
+  buffer.resize(buffer.size() - dest.free_in_buffer);
+  jpeg_destroy_compress(&cInfo);
+  return buffer;
+}
+
+/**
+ * Decodes a JPEG created by encodeSerial.
+ * @param jpeg The JPEG.
+ * @param dest The image that receives the result.
+ */
+static void decode(const std::vector<unsigned char>& jpeg, CameraImage& dest)
+{
+  jpeg_decompress_struct cInfo;
+  jpeg_error_mgr jem;
+  cInfo.err = jpeg_std_error(&jem);
+  jpeg_create_decompress(&cInfo);
+  jpeg_mem_src(&cInfo, const_cast<unsigned char*>(jpeg.data()), static_cast<unsigned long>(jpeg.size()));
+  jpeg_read_header(&cInfo, true);
+  jpeg_start_decompress(&cInfo);
+  dest.setResolution(cInfo.output_width, cInfo.output_height);
+  while(cInfo.output_scanline < cInfo.output_height)
+  {
+    JSAMPROW rowPointer = reinterpret_cast<unsigned char*>(dest[cInfo.output_scanline]);
+    jpeg_read_scanlines(&cInfo, &rowPointer, 1);
+  }
+  jpeg_finish_decompress(&cInfo);
+  jpeg_destroy_decompress(&cInfo);
+}
+
+/**
+ * Compresses an image with JPEGImage and checks the decompressed result against
+ * the original and against a serially encoded JPEG with the same settings.
+ * @param width The width in YUYV pixels.
+ * @param height The height. JPEGImage stores half of it and restores the full height when decoding.
+ */
+static void roundTrip(unsigned width, unsigned height)
+{
+  CameraImage src;
+  createTestImage(src, width, height);
+  src.timestamp = 1234;
+
+  FOREACH_ENUM(JPEGImage::ChromaSubsampling, chromaSubsampling)
+  {
+    JPEGImage jpegImage;
+    jpegImage.compress(src, 75, chromaSubsampling);
+    CameraImage decompressed;
+    jpegImage.toCameraImage(decompressed);
+    ASSERT_EQ(src.width, decompressed.width);
+    ASSERT_EQ(src.height, decompressed.height);
+    EXPECT_EQ(src.timestamp, decompressed.timestamp);
+
+    // The slices are joined with restart markers, which only reset the DC prediction.
+    // Therefore, the decoded pixels must be exactly the same as for a single JPEG.
+    CameraImage reference;
+    decode(encodeSerial(src, 75, chromaSubsampling), reference);
+    ASSERT_EQ(src.height, reference.height);
+
+    int differences = 0;
+    double error = 0.0;
+    for(unsigned y = 0; y < height; ++y)
+      for(unsigned x = 0; x < width; ++x)
+      {
+        if(decompressed[y][x].color != reference[y][x].color)
+          ++differences;
+        error += std::abs(decompressed[y][x].y0 - src[y][x].y0) + std::abs(decompressed[y][x].y1 - src[y][x].y1);
+      }
+    EXPECT_EQ(0, differences) << "subsampling " << chromaSubsampling << ", " << width << "x" << height;
+    EXPECT_LT(error / (2.0 * width * height), 4.0) << "subsampling " << chromaSubsampling << ", " << width << "x" << height;
+  }
+}
+
+GTEST_TEST(JPEGImage, RoundTrip)
+{
+  roundTrip(320, 480);
+  roundTrip(160, 240);
+
+  // The last slice is not a multiple of the MCU height
+  roundTrip(104, 250);
+}
+
+/** Compares the sliced encoder with a single pass over the whole image on an upper camera sized image. */
+GTEST_TEST(JPEGImage, Benchmark)
+{
+  constexpr unsigned width = 320, height = 480;
+  CameraImage src;
+  createTestImage(src, width, height);
+
+  FOREACH_ENUM(JPEGImage::ChromaSubsampling, chromaSubsampling)
+  {
+    JPEGImage jpegImage;
+    jpegImage.compress(src, 75, chromaSubsampling); // Start the workers
+    PRINTF("subsampling %d, sliced:\n", static_cast<int>(chromaSubsampling));
+    RUN_BENCH(5, 10, jpegImage.compress(src, 75, chromaSubsampling));
+    std::vector<unsigned char> serial;
+    PRINTF("subsampling %d, serial:\n", static_cast<int>(chromaSubsampling));
+    RUN_BENCH(5, 10, serial = encodeSerial(src, 75, chromaSubsampling));
+
+    CameraImage sliced, reference;
+    jpegImage.toCameraImage(sliced);
+    decode(serial, reference);
+    ASSERT_EQ(reference.width, sliced.width);
+    ASSERT_EQ(reference.height, sliced.height);
+    EXPECT_EQ(0, std::memcmp(reference[0], sliced[0], width * height * sizeof(CameraImage::PixelType)));
+  }
+}
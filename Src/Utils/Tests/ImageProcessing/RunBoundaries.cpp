@@ -0,0 +1,103 @@
+#include "Tools/ImageProcessing/RunBoundaries.h"
+#include "Tools/Math/Random.h"
+#include "Utils/Tests/bench.h"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+/**
+ * Creates a row of colors that consists of runs of random lengths.
+ * @param width The length of the row.
+ * @param maxRunLength The maximum length of a run.
+ */
+static std::vector<unsigned char> createRow(int width, int maxRunLength)
+{
+  std::vector<unsigned char> row;
+  while(static_cast<int>(row.size()) < width)
+    row.insert(row.end(), Random::uniformInt(1, maxRunLength), static_cast<unsigned char>(Random::uniformInt(0, 6)));
+  row.resize(width);
+  return row;
+}
+
+GTEST_TEST(RunBoundaries, SSEMatchesScalar)
+{
+  std::vector<unsigned short> expected, actual;
+  for(int i = 0; i < 1000; ++i)
+  {
+    const int width = Random::uniformInt(1, 640);
+    const std::vector<unsigned char> row = createRow(width, Random::uniformInt(1, 40));
+    const int from = Random::uniformInt(0, width - 1);
+    const int to = Random::uniformInt(from, width);
+    RunBoundaries::find(row.data(), from, to, expected);
+    RunBoundaries::findSSE(row.data(), from, to, actual);
+    ASSERT_EQ(expected, actual) << "width " << width << ", from " << from << ", to " << to;
+  }
+}
+
+GTEST_TEST(RunBoundaries, ScanHorizontalMatchesScalar)
+{
+  std::vector<unsigned short> boundaries;
+  std::vector<ScanLineRegion> expected, actual;
+  for(int i = 0; i < 1000; ++i)
+  {
+    const int width = Random::uniformInt(1, 640);
+    std::vector<FieldColors::Color> row(width);
+    const std::vector<unsigned char> colors = createRow(width, Random::uniformInt(1, 40));
+    for(int x = 0; x < width; ++x)
+      row[x] = static_cast<FieldColors::Color>(colors[x] % FieldColors::numOfColors);
+
+    // Scan lines at random distances with random lower ends, as the ScanGrid creates them
+    ScanGrid scanGrid;
+    for(int x = Random::uniformInt(0, 8); x < width; x += Random::uniformInt(1, 16))
+      scanGrid.lines.emplace_back(x, Random::uniformInt(0, 480), 0);
+    scanGrid.lowResStart = Random::uniformInt(0, 1);
+    scanGrid.lowResStep = Random::uniformInt(1, 2);
+    const int y = Random::uniformInt(0, 479);
+    const unsigned short minRegionSize = static_cast<unsigned short>(Random::uniformInt(1, 8));
+
+    expected.clear();
+    actual.clear();
+    RunBoundaries::scanHorizontalScalar(row.data(), y, scanGrid, minRegionSize, expected);
+    RunBoundaries::findSSE(reinterpret_cast<const unsigned char*>(row.data()), 0, width, boundaries);
+    RunBoundaries::scanHorizontal(row.data(), y, scanGrid, minRegionSize, boundaries, actual);
+    ASSERT_EQ(expected.size(), actual.size()) << "width " << width << ", y " << y;
+    for(size_t j = 0; j < expected.size(); ++j)
+    {
+      EXPECT_EQ(expected[j].range.left, actual[j].range.left) << "region " << j;
+      EXPECT_EQ(expected[j].range.right, actual[j].range.right) << "region " << j;
+      EXPECT_EQ(expected[j].color, actual[j].color) << "region " << j;
+    }
+  }
+}
+
+GTEST_TEST(RunBoundaries, Extremes)
+{
+  std::vector<unsigned short> boundaries;
+  const std::vector<unsigned char> uniform(320, 3);
+  RunBoundaries::findSSE(uniform.data(), 0, 320, boundaries);
+  EXPECT_TRUE(boundaries.empty());
+
+  std::vector<unsigned char> alternating(320);
+  for(size_t i = 0; i < alternating.size(); ++i)
+    alternating[i] = i & 1 ? 255 : 0;
+  RunBoundaries::findSSE(alternating.data(), 0, 320, boundaries);
+  ASSERT_EQ(boundaries.size(), 319u);
+  for(size_t i = 0; i < boundaries.size(); ++i)
+    EXPECT_EQ(boundaries[i], i + 1);
+}
+
+/** Compares the scalar and the SSE version for rows of the size of the upper ECImage. */
+GTEST_TEST(RunBoundaries, Benchmark)
+{
+  constexpr int width = 640;
+  const std::vector<unsigned char> row = createRow(width, 20);
+  std::vector<unsigned short> scalar, sse;
+
+  PRINTF("RunBoundaries scalar:\n");
+  RUN_BENCH(5, 2000, RunBoundaries::find(row.data(), 0, width, scalar));
+  PRINTF("RunBoundaries SSE:\n");
+  RUN_BENCH(5, 2000, RunBoundaries::findSSE(row.data(), 0, width, sse));
+  EXPECT_FALSE(scalar.empty());
+  EXPECT_EQ(scalar, sse);
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Representations/Infrastructure/CameraImage.h"
+#include "Tools/Math/Random.h"
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * Creates a camera-like image: smooth gradients and an edge with sensor noise.
+ * @param image The image that is filled.
+ * @param width The width in YUYV pixels.
+ * @param height The height.
+ * @param noise The amplitude of the noise in the luminance channels.
+ */
+inline void createTestImage(CameraImage& image, unsigned width, unsigned height, int noise = 3)
+{
+  image.setResolution(width, height);
+  for(unsigned y = 0; y < height; ++y)
+    for(unsigned x = 0; x < width; ++x)
+    {
+      PixelTypes::YUYVPixel& pixel = image[y][x];
+      const float shade = 100.f * std::sin(static_cast<float>(x) / 45.f) * std::cos(static_cast<float>(y) / 70.f) + (y > height / 2 && x > width / 2 ? 60.f : 0.f);
+      pixel.y0 = static_cast<unsigned char>(std::min(255, std::max(0, static_cast<int>(80.f + shade) + (noise ? Random::uniformInt(-noise, noise) : 0))));
+      pixel.y1 = static_cast<unsigned char>(std::min(255, std::max(0, static_cast<int>(82.f + shade) + (noise ? Random::uniformInt(-noise, noise) : 0))));
+      pixel.u = static_cast<unsigned char>(128.f + 30.f * std::sin(static_cast<float>(y) / 40.f));
+      pixel.v = static_cast<unsigned char>(128.f - 20.f * std::sin(static_cast<float>(x) / 30.f));
+    }
+}
@@ -0,0 +1,92 @@
+#include "Tools/ImageProcessing/YUYVCodec.h"
+#include "Tools/Math/Random.h"
+#include "Utils/Tests/bench.h"
+#include "Utils/Tests/ImageProcessing/TestImage.h"
+
+#include "gtest/gtest.h"
+#include <snappy-c.h>
+
+#include <vector>
+
+/**
+ * Creates a camera-like YUYV image.
+ * @param width The width in YUYV pixels.
+ * @param height The height.
+ * @param noise The amplitude of the noise.
+ * @return The bytes of the image.
+ */
+static std::vector<unsigned char> createImage(unsigned width, unsigned height, int noise)
+{
+  CameraImage image;
+  createTestImage(image, width, height, noise);
+  const unsigned char* data = reinterpret_cast<const unsigned char*>(image[0]);
+  return std::vector<unsigned char>(data, data + width * height * sizeof(CameraImage::PixelType));
+}
+
+static void roundTrip(const std::vector<unsigned char>& image, unsigned width, unsigned height)
+{
+  std::vector<unsigned char> compressed(YUYVCodec::maxCompressedSize(width, height));
+  const size_t size = YUYVCodec::compress(image.data(), width, height, compressed.data());
+  ASSERT_LE(size, compressed.size());
+  std::vector<unsigned char> decompressed(image.size());
+  ASSERT_TRUE(YUYVCodec::decompress(compressed.data(), size, width, height, decompressed.data()));
+  EXPECT_EQ(image, decompressed);
+}
+
+GTEST_TEST(YUYVCodec, Lossless)
+{
+  roundTrip(createImage(320, 480, 3), 320, 480);
+  roundTrip(createImage(160, 240, 0), 160, 240);
+
+  // Worst case: uniform noise
+  std::vector<unsigned char> noise(160 * 240 * 4);
+  for(unsigned char& c : noise)
+    c = static_cast<unsigned char>(Random::uniformInt(0, 255));
+  roundTrip(noise, 160, 240);
+
+  // Extremes next to each other
+  std::vector<unsigned char> stripes(16 * 8 * 4);
+  for(size_t i = 0; i < stripes.size(); ++i)
+    stripes[i] = (i / 3) & 1 ? 255 : 0;
+  roundTrip(stripes, 16, 8);
+}
+
+GTEST_TEST(YUYVCodec, RejectsCorruptData)
+{
+  const std::vector<unsigned char> image = createImage(160, 240, 3);
+  std::vector<unsigned char> compressed(YUYVCodec::maxCompressedSize(160, 240));
+  const size_t size = YUYVCodec::compress(image.data(), 160, 240, compressed.data());
+  std::vector<unsigned char> decompressed(image.size());
+  EXPECT_FALSE(YUYVCodec::decompress(compressed.data(), size - 1, 160, 240, decompressed.data()));
+}
+
+/** Compares compression ratio and throughput with snappy on an upper camera sized image. */
+GTEST_TEST(YUYVCodec, Benchmark)
+{
+  constexpr unsigned width = 320, height = 480;
+  const std::vector<unsigned char> image = createImage(width, height, 3);
+  std::vector<unsigned char> compressed(YUYVCodec::maxCompressedSize(width, height));
+  std::vector<unsigned char> decompressed(image.size());
+
+  size_t size = 0;
+  PRINTF("YUYVCodec encode:\n");
+  RUN_BENCH(5, 4, size = YUYVCodec::compress(image.data(), width, height, compressed.data()));
+  bool success = true;
+  PRINTF("YUYVCodec decode:\n");
+  RUN_BENCH(5, 4, success &= YUYVCodec::decompress(compressed.data(), size, width, height, decompressed.data()));
+  EXPECT_TRUE(success);
+  EXPECT_EQ(image, decompressed);
+
+  std::vector<char> snappyCompressed(snappy_max_compressed_length(image.size()));
+  size_t snappySize = 0;
+  PRINTF("snappy encode:\n");
+  RUN_BENCH(5, 4,
+  {
+    snappySize = snappyCompressed.size();
+    success &= snappy_compress(reinterpret_cast<const char*>(image.data()), image.size(), snappyCompressed.data(), &snappySize) == SNAPPY_OK;
+  });
+  EXPECT_TRUE(success);
+
+  PRINTF("ratio: YUYVCodec %.2f, snappy %.2f\n", static_cast<double>(image.size()) / size, static_cast<double>(image.size()) / snappySize);
+  EXPECT_LT(size, snappySize);
+}
@@ -0,0 +1,217 @@
+#include "Tools/BehaviorControl/RoleAssignment.h"
+#include "Tools/Math/HungarianMethod.h"
+#include "Tools/Math/Random.h"
+#include "Utils/Tests/bench.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+using Solver = HungarianMethod<5>;
+
+static float bruteForce(const Solver::Matrix& cost, int size)
+{
+  std::array<int, 5> permutation = {0, 1, 2, 3, 4};
+  float best = std::numeric_limits<float>::max();
+  do
+  {
+    float sum = 0.f;
+    for(int i = 0; i < size; ++i)
+      sum += cost(i, permutation[i]);
+    best = std::min(best, sum);
+  }
+  while(std::next_permutation(permutation.begin(), permutation.begin() + size));
+  return best;
+}
+
+static float totalCost(const Solver& solver, const Solver::Matrix& cost, int size)
+{
+  float sum = 0.f;
+  for(int i = 0; i < size; ++i)
+    sum += cost(i, solver[i]);
+  return sum;
+}
+
+static bool isPermutation(const Solver& solver, int size)
+{
+  std::array<bool, 5> used = {false, false, false, false, false};
+  for(int i = 0; i < size; ++i)
+  {
+    if(solver[i] < 0 || solver[i] >= size || used[solver[i]])
+      return false;
+    used[solver[i]] = true;
+  }
+  return true;
+}
+
+GTEST_TEST(HungarianMethod, ColdStartIsOptimal)
+{
+  for(int k = 0; k < 1000; ++k)
+  {
+    const int size = Random::uniformInt(1, 5);
+    Solver::Matrix cost = Solver::Matrix::Random() * 5000.f;
+    Solver solver;
+    solver.solve(cost, size);
+    ASSERT_TRUE(isPermutation(solver, size));
+    EXPECT_NEAR(bruteForce(cost, size), totalCost(solver, cost, size), 1e-1f);
+  }
+}
+
+GTEST_TEST(HungarianMethod, WarmStartIsOptimal)
+{
+  Solver solver;
+  Solver::Matrix cost = Solver::Matrix::Random() * 5000.f;
+  for(int k = 0; k < 1000; ++k)
+  {
+    // Small perturbations most of the time, occasionally a completely different problem.
+    if(k % 50 == 0)
+      cost = Solver::Matrix::Random() * 5000.f;
+    else
+      cost += Solver::Matrix::Random() * 100.f;
+    solver.solve(cost, 5);
+    ASSERT_TRUE(isPermutation(solver, 5));
+    EXPECT_NEAR(bruteForce(cost, 5), totalCost(solver, cost, 5), 1e-1f);
+  }
+}
+
+GTEST_TEST(HungarianMethod, UnchangedProblemNeedsNoAugmentation)
+{
+  Solver solver;
+  const Solver::Matrix cost = Solver::Matrix::Random() * 5000.f;
+  EXPECT_EQ(5, solver.solve(cost, 5));
+  EXPECT_EQ(0, solver.solve(cost, 5));
+}
+
+GTEST_TEST(HungarianMethod, NearTieIsNotUnique)
+{
+  Solver solver;
+  Solver::Matrix cost = Solver::Matrix::Zero();
+  cost.topLeftCorner<2, 2>() << 10000.f, 12000.f,
+                                12000.f, 10000.f;
+  solver.solve(cost, 2);
+  EXPECT_TRUE(solver.isUnique(cost, 2));
+  cost(0, 1) = cost(1, 0) = 10000.5f;
+  solver.solve(cost, 2);
+  EXPECT_FALSE(solver.isUnique(cost, 2));
+}
+
+/** The parameters and field dimensions the ContextCoordinator uses by default. */
+static RoleAssignment createRoleAssignment()
+{
+  RoleAssignment assignment;
+  assignment.field = {-4500.f, 4500.f, 3200.f, 3000.f};
+  assignment.parameters = {10000.f, 300.f, 1000.f, 500.f, 300.f};
+  return assignment;
+}
+
+static const RoleAssignment::Roles roles = {Role::striker, Role::supporter, Role::defender, Role::jolly};
+
+GTEST_TEST(HungarianMethod, RoleAssignmentReplay)
+{
+  constexpr int frames = 10000;
+  constexpr int numOfRobots = 4;
+  for(float hysteresis : {0.f, 300.f})
+  {
+    RoleAssignment assignment = createRoleAssignment();
+    assignment.parameters.roleSwitchHysteresis = hysteresis;
+    std::array<RoleAssignment::Player, numOfRobots> robots;
+    for(int i = 0; i < numOfRobots; ++i)
+      robots[i] = {i + 2, Vector2f(Random::uniform(-4500.f, 4500.f), Random::uniform(-3000.f, 3000.f)), true, Role::none};
+    Vector2f ball = Vector2f::Zero();
+    int flips = 0;
+
+    for(int frame = 0; frame < frames; ++frame)
+    {
+      ball += Vector2f(Random::uniform(-20.f, 20.f), Random::uniform(-20.f, 20.f));
+      ball = ball.cwiseMax(Vector2f(-4500.f, -3000.f)).cwiseMin(Vector2f(4500.f, 3000.f));
+      for(RoleAssignment::Player& robot : robots)
+        robot.position += Vector2f(Random::uniform(-5.f, 5.f), Random::uniform(-5.f, 5.f));
+
+      assignment.clear();
+      for(const RoleAssignment::Player& robot : robots)
+        assignment.add(robot);
+      assignment.assign(roles, ball);
+
+      // The warm start must not change the result
+      RoleAssignment coldAssignment = createRoleAssignment();
+      coldAssignment.parameters.roleSwitchHysteresis = hysteresis;
+      for(const RoleAssignment::Player& robot : robots)
+        coldAssignment.add(robot);
+      coldAssignment.assign(roles, ball);
+
+      for(RoleAssignment::Player& robot : robots)
+      {
+        const Role::RoleType role = assignment.getRole(robot.number);
+        ASSERT_EQ(coldAssignment.getRole(robot.number), role) << "frame " << frame;
+        if(robot.role != Role::none && robot.role != role)
+          ++flips;
+        robot.role = role;
+      }
+    }
+
+    PRINTF("hysteresis %.0f mm: %.4f role flips per frame\n", hysteresis, static_cast<double>(flips) / frames);
+  }
+}
+
+GTEST_TEST(HungarianMethod, RoleAssignmentIsIndependentOfObserver)
+{
+  constexpr int numOfRobots = 4;
+  for(int run = 0; run < 1000; ++run)
+  {
+    std::array<RoleAssignment::Player, numOfRobots> robots;
+    for(int i = 0; i < numOfRobots; ++i)
+      robots[i] = {i + 2, Vector2f(Random::uniform(-4500.f, 4500.f), Random::uniform(-3000.f, 3000.f)),
+                   Random::uniform() > 0.2f, roles[Random::uniformInt(numOfRobots - 1)]};
+    // Equal distances to provoke ties
+    if(run % 2)
+      robots[1].position = Vector2f(-robots[0].position.x(), robots[0].position.y());
+    const Vector2f ball(0.f, Random::uniform(-3000.f, 3000.f));
+
+    // Every robot adds itself first, followed by its teammates
+    std::array<Role::RoleType, numOfRobots> reference;
+    for(int observer = 0; observer < numOfRobots; ++observer)
+    {
+      RoleAssignment assignment = createRoleAssignment();
+      for(int i = 0; i < numOfRobots; ++i)
+        assignment.add(robots[(observer + i) % numOfRobots]);
+      assignment.assign(roles, ball);
+      for(int i = 0; i < numOfRobots; ++i)
+        if(observer == 0)
+          reference[i] = assignment.getRole(robots[i].number);
+        else
+          EXPECT_EQ(reference[i], assignment.getRole(robots[i].number));
+    }
+    for(Role::RoleType role : roles)
+      EXPECT_EQ(1, std::count(reference.begin(), reference.end(), role));
+  }
+}
+
+GTEST_TEST(HungarianMethod, Benchmark)
+{
+  constexpr int numOfRobots = 4;
+  RoleAssignment assignment = createRoleAssignment();
+  std::array<RoleAssignment::Player, numOfRobots> robots;
+  for(int i = 0; i < numOfRobots; ++i)
+    robots[i] = {i + 2, Vector2f(Random::uniform(-4500.f, 4500.f), Random::uniform(-3000.f, 3000.f)), true, Role::none};
+  Vector2f ball = Vector2f::Zero();
+  int frame = 0;
+
+  PRINTF("role assignment of %d robots:\n", numOfRobots);
+  RUN_BENCH(5, 200,
+  {
+    ball.x() = 4000.f * std::sin(static_cast<float>(frame++) * 0.01f);
+    assignment.clear();
+    for(const RoleAssignment::Player& robot : robots)
+      assignment.add(robot);
+    assignment.assign(roles, ball);
+  });
+
+  std::array<bool, Role::numOfRoleTypes> assigned = {};
+  for(const RoleAssignment::Player& robot : robots)
+  {
+    const Role::RoleType role = assignment.getRole(robot.number);
+    ASSERT_NE(Role::none, role);
+    EXPECT_FALSE(assigned[role]);
+    assigned[role] = true;
+  }
+}
@@ -0,0 +1,270 @@
+#include "Tools/Math/Rotation.h"
+#include "Tools/Math/UnscentedKalmanFilter.h"
+#include "Utils/Tests/bench.h"
+
+#include "gtest/gtest.h"
+
+#include <functional>
+
+/** A rotation in 3D as in InertialDataProvider. */
+struct RotationState : public Manifold<3>
+{
+  Quaternionf orientation;
+
+  RotationState(const Quaternionf& orientation = Quaternionf::Identity()) : orientation(orientation) {}
+
+  RotationState operator+(const Vectorf& angleAxis) const {return RotationState(*this) += angleAxis;}
+
+  RotationState& operator+=(const Vectorf& angleAxis)
+  {
+    orientation = orientation * Rotation::AngleAxis::unpack(angleAxis);
+    return *this;
+  }
+
+  Vectorf operator-(const RotationState& other) const
+  {
+    return Rotation::AngleAxis::pack(AngleAxisf(other.orientation.inverse() * orientation));
+  }
+};
+
+/**
+ * The previous implementation of the filter, which propagates the sigma points one
+ * by one through std::function.
+ */
+template<typename State, unsigned DOF, bool IsManifold>
+struct ReferenceUKF
+{
+  using CovarianceType = Eigen::Matrix<float, DOF, DOF>;
+  template<unsigned N>
+  using Vectorf = Eigen::Matrix<float, N, 1>;
+
+  State mean;
+  CovarianceType cov = CovarianceType::Zero();
+  std::array<State, DOF * 2 + 1> sigmaPoints;
+
+  ReferenceUKF(const State& initState) : mean(initState) {sigmaPoints.fill(initState);}
+
+  void predict(std::function<void(State&)> dynamicModel, const CovarianceType& noise)
+  {
+    updateSigmaPoints();
+    for(State& sigmaPoint : sigmaPoints)
+      dynamicModel(sigmaPoint);
+    mean = meanOfSigmaPoints();
+    cov = CovarianceType::Zero();
+    for(State& sigmaPoint : sigmaPoints)
+    {
+      const Vectorf<DOF> dist = sigmaPoint - mean;
+      cov += dist * dist.transpose();
+    }
+    cov *= 0.5f;
+    cov += noise;
+    fixCovarianceMatrix();
+  }
+
+  template<unsigned N>
+  void update(const Vectorf<N>& measurement, std::function<Vectorf<N>(const State&)> measurementModel, const Eigen::Matrix<float, N, N>& measurementNoise)
+  {
+    updateSigmaPoints();
+    std::array<Vectorf<N>, DOF * 2 + 1> Z;
+    for(size_t i = 0; i < sigmaPoints.size(); ++i)
+      Z[i] = measurementModel(sigmaPoints[i]);
+    Vectorf<N> z = Vectorf<N>::Zero();
+    for(const Vectorf<N>& Zi : Z)
+      z += Zi;
+    z /= static_cast<float>(sigmaPoints.size());
+    Eigen::Matrix<float, N, N> sigmaz = Eigen::Matrix<float, N, N>::Zero();
+    Eigen::Matrix<float, DOF, N> sigmaxz = Eigen::Matrix<float, DOF, N>::Zero();
+    for(size_t i = 0; i < sigmaPoints.size(); ++i)
+    {
+      sigmaz += (Z[i] - z) * (Z[i] - z).transpose();
+      sigmaxz += (sigmaPoints[i] - mean) * (Z[i] - z).transpose();
+    }
+    sigmaz = sigmaz * 0.5f + measurementNoise;
+    sigmaxz *= 0.5f;
+    const Eigen::Matrix<float, DOF, N> K = sigmaxz * sigmaz.inverse();
+    mean += K * (measurement - z);
+    cov -= K * sigmaz * K.transpose();
+    fixCovarianceMatrix();
+  }
+
+  void update(float measurement, std::function<float(const State&)> measurementModel, float measurementNoise)
+  {
+    update<1>(Vectorf<1>(measurement), [&](const State& state) {return Vectorf<1>(measurementModel(state));},
+              Eigen::Matrix<float, 1, 1>(measurementNoise));
+  }
+
+  void updateSigmaPoints()
+  {
+    Eigen::LLT<CovarianceType> llt = cov.llt();
+    if(llt.info() == Eigen::ComputationInfo::Success)
+    {
+      CovarianceType l = llt.matrixL();
+      sigmaPoints[0] = mean;
+      for(unsigned i = 0; i < DOF; ++i)
+        sigmaPoints[i + 1] = mean + l.col(i);
+      for(unsigned i = 0; i < DOF; ++i)
+        sigmaPoints[i + DOF + 1] = mean + (-l.col(i));
+    }
+    else
+      sigmaPoints.fill(mean);
+  }
+
+  State meanOfSigmaPoints() const
+  {
+    if constexpr(IsManifold)
+    {
+      State mean = sigmaPoints[0];
+      State lastMean;
+      unsigned iterations = 0;
+      do
+      {
+        lastMean = mean;
+        ++iterations;
+        Vectorf<DOF> sum = Vectorf<DOF>::Zero();
+        for(const State& sigmaPoint : sigmaPoints)
+          sum += sigmaPoint - mean;
+        mean += sum / static_cast<float>(sigmaPoints.size());
+      }
+      while(!Approx::isZero((lastMean - mean).norm()) && iterations <= 20);
+      return mean;
+    }
+    else
+    {
+      State sum = State::Zero();
+      for(const State& sigmaPoint : sigmaPoints)
+        sum += sigmaPoint;
+      return sum / static_cast<float>(sigmaPoints.size());
+    }
+  }
+
+  void fixCovarianceMatrix()
+  {
+    for(unsigned i = 0; i < DOF; ++i)
+      for(unsigned j = i + 1; j < DOF; ++j)
+        cov(i, j) = cov(j, i) = (cov(i, j) + cov(j, i)) * .5f;
+  }
+};
+
+/** The odometry filter of the MotionCombinator. */
+struct OdometryFilter
+{
+  Vector3f acc;
+  Vector2f offset;
+
+  void dynamicModel(Vector3f& state) const {state += (acc - Vector3f(0, 0, Constants::g_1000)) * Constants::motionCycleTime * 1000.f;}
+  static float pseudoMeasurement(const Vector3f& state) {return state.z();}
+  static Vector2f realMeasurement(const Vector3f& state) {return (state * Constants::motionCycleTime).head<2>();}
+
+  void next(int i)
+  {
+    acc = Vector3f(std::sin(i * 0.1f) * 2.f, std::cos(i * 0.07f), Constants::g_1000 + std::sin(i * 0.3f) * 0.1f);
+    offset = Vector2f(std::sin(i * 0.05f), std::cos(i * 0.05f) * 0.5f);
+  }
+
+  template<typename Filter>
+  void step(Filter& ukf, int i)
+  {
+    next(i);
+    ukf.predict([&](Vector3f& state) {dynamicModel(state);}, Vector3f(10.f, 10.f, 10.f).cwiseAbs2().asDiagonal());
+    ukf.update(0.f, [](const Vector3f& state) {return pseudoMeasurement(state);}, 0.01f);
+    ukf.template update<2>(offset, [](const Vector3f& state) {return realMeasurement(state);}, Vector2f(1.f, 1.f).cwiseAbs2().asDiagonal());
+  }
+
+  void stepAll(UKF<3>& ukf, int i)
+  {
+    next(i);
+    const Vector3f delta = (acc - Vector3f(0, 0, Constants::g_1000)) * Constants::motionCycleTime * 1000.f;
+    ukf.predictAll([&](UKF<3>::SigmaMatrix<3>& states) {states.colwise() += delta;}, Vector3f(10.f, 10.f, 10.f).cwiseAbs2().asDiagonal());
+    ukf.update(0.f, [](const Vector3f& state) {return pseudoMeasurement(state);}, 0.01f);
+    ukf.updateAll<2>(offset, [](const UKF<3>::SigmaMatrix<3>& states) -> UKF<3>::SigmaMatrix<2> {return states.topRows<2>() * Constants::motionCycleTime;},
+                     Vector2f(1.f, 1.f).cwiseAbs2().asDiagonal());
+  }
+};
+
+/** The orientation filter of the InertialDataProvider. */
+struct OrientationFilter
+{
+  Vector3f gyro;
+  Vector3f acc;
+
+  void next(int i)
+  {
+    gyro = Vector3f(std::sin(i * 0.02f) * 0.5f, std::cos(i * 0.03f) * 0.3f, 0.1f);
+    acc = Vector3f(std::sin(i * 0.02f), std::cos(i * 0.03f), Constants::g_1000);
+  }
+
+  template<typename Filter>
+  void step(Filter& ukf, int i)
+  {
+    next(i);
+    ukf.predict([&](RotationState& state) {state.orientation = state.orientation * Rotation::AngleAxis::unpack(gyro * Constants::motionCycleTime);},
+                Vector3f::Constant(0.03_deg * std::sqrt(1.f / Constants::motionCycleTime)).cwiseAbs2().asDiagonal());
+    ukf.template update<3>(acc, [](const RotationState& state) -> Vector3f {return state.orientation.inverse() * Vector3f(0.f, 0.f, Constants::g_1000);},
+                           Vector3f(10.f, 10.f, 10.f).cwiseAbs2().asDiagonal());
+  }
+};
+
+GTEST_TEST(UnscentedKalmanFilter, MatchesReference)
+{
+  UKF<3> ukf(Vector3f::Zero());
+  ReferenceUKF<Vector3f, 3, false> reference(Vector3f::Zero());
+  UKF<3> ukfAll(Vector3f::Zero());
+  OdometryFilter filter;
+  for(int i = 0; i < 500; ++i)
+  {
+    filter.step(ukf, i);
+    filter.step(reference, i);
+    filter.stepAll(ukfAll, i);
+    ASSERT_TRUE(ukf.mean.isApprox(reference.mean, 1e-4f)) << "frame " << i;
+    ASSERT_TRUE(ukf.cov.isApprox(reference.cov, 1e-4f)) << "frame " << i;
+    ASSERT_TRUE(ukfAll.mean.isApprox(reference.mean, 1e-4f)) << "frame " << i;
+    ASSERT_TRUE(ukfAll.cov.isApprox(reference.cov, 1e-4f)) << "frame " << i;
+  }
+}
+
+GTEST_TEST(UnscentedKalmanFilter, ManifoldMatchesReference)
+{
+  UKFM<RotationState> ukf((RotationState()));
+  ReferenceUKF<RotationState, 3, true> reference((RotationState()));
+  ukf.cov = reference.cov = Matrix3f::Identity() * 0.01f;
+  OrientationFilter filter;
+  for(int i = 0; i < 500; ++i)
+  {
+    filter.step(ukf, i);
+    filter.step(reference, i);
+    ASSERT_TRUE(ukf.mean.orientation.isApprox(reference.mean.orientation, 1e-4f)) << "frame " << i;
+    ASSERT_TRUE(ukf.cov.isApprox(reference.cov, 1e-3f)) << "frame " << i;
+  }
+}
+
+GTEST_TEST(UnscentedKalmanFilter, Benchmark)
+{
+  // All filters process the same frames, so they must still agree afterwards.
+  OdometryFilter odometry;
+  UKF<3> ukf(Vector3f::Zero());
+  UKF<3> ukfAll(Vector3f::Zero());
+  ReferenceUKF<Vector3f, 3, false> reference(Vector3f::Zero());
+  int frame = 0;
+  PRINTF("odometry UKF<3>, std::function:\n");
+  RUN_BENCH(5, 200, odometry.step(reference, frame++));
+  frame = 0;
+  PRINTF("odometry UKF<3>, inlined:\n");
+  RUN_BENCH(5, 200, odometry.step(ukf, frame++));
+  frame = 0;
+  PRINTF("odometry UKF<3>, matrix models:\n");
+  RUN_BENCH(5, 200, odometry.stepAll(ukfAll, frame++));
+  EXPECT_TRUE(ukf.mean.isApprox(reference.mean, 1e-4f));
+  EXPECT_TRUE(ukfAll.mean.isApprox(reference.mean, 1e-4f));
+
+  OrientationFilter orientation;
+  UKFM<RotationState> ukfm((RotationState()));
+  ReferenceUKF<RotationState, 3, true> referenceM((RotationState()));
+  ukfm.cov = referenceM.cov = Matrix3f::Identity() * 0.01f;
+  frame = 0;
+  PRINTF("orientation UKFM, std::function:\n");
+  RUN_BENCH(5, 200, orientation.step(referenceM, frame++));
+  frame = 0;
+  PRINTF("orientation UKFM, inlined:\n");
+  RUN_BENCH(5, 200, orientation.step(ukfm, frame++));
+  EXPECT_TRUE(ukfm.mean.orientation.isApprox(referenceM.mean.orientation, 1e-4f));
+}
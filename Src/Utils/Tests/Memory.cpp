@@ -0,0 +1,145 @@
+#include "Platform/Memory.h"
+#include "Tools/Math/Eigen.h"
+#include "Tools/MessageQueue/MessageQueue.h"
+#include "Utils/Tests/bench.h"
+
+#include "gtest/gtest.h"
+
+#include <list>
+#include <new>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+GTEST_TEST(Memory, CountsAllocations)
+{
+  const unsigned allocations = Memory::getNumOfAllocations();
+  const size_t bytes = Memory::getNumOfAllocatedBytes();
+  Memory::deallocate(Memory::allocate(100 * sizeof(int)));
+  EXPECT_EQ(Memory::getNumOfAllocations() - allocations, 1u);
+  EXPECT_EQ(Memory::getNumOfAllocatedBytes() - bytes, 100 * sizeof(int));
+}
+
+GTEST_TEST(Memory, FreeOnOtherThreadAndSwitch)
+{
+  std::vector<char*> blocks;
+  for(int i = 0; i < 1000; ++i)
+  {
+    blocks.push_back(static_cast<char*>(Memory::allocate(static_cast<size_t>(i % 300 + 1))));
+    std::fill(blocks.back(), blocks.back() + i % 300 + 1, static_cast<char>(i));
+  }
+  Memory::setThreadCacheEnabled(false);
+  std::thread([&]
+  {
+    for(size_t i = 0; i < blocks.size(); i += 2)
+      Memory::deallocate(blocks[i]);
+  }).join();
+  Memory::setThreadCacheEnabled(true);
+  std::thread([&]
+  {
+    for(size_t i = 1; i < blocks.size(); i += 2)
+    {
+      EXPECT_EQ(blocks[i][i % 300], static_cast<char>(i));
+      Memory::deallocate(blocks[i]);
+    }
+  }).join();
+
+  for(int i = 0; i < 1000; ++i)
+  {
+    char* block = static_cast<char*>(Memory::allocate(static_cast<size_t>(i)));
+    std::fill(block, block + i, 'y');
+    Memory::deallocate(block);
+  }
+}
+
+/** An allocator for the standard containers that uses Memory::allocate. */
+template<typename T> struct CountingAllocator
+{
+  using value_type = T;
+
+  CountingAllocator() = default;
+  template<typename U> CountingAllocator(const CountingAllocator<U>&) {}
+
+  T* allocate(size_t n)
+  {
+    void* ptr = Memory::allocate(n * sizeof(T));
+    if(!ptr)
+      throw std::bad_alloc();
+    return static_cast<T*>(ptr);
+  }
+
+  void deallocate(T* ptr, size_t) {Memory::deallocate(ptr);}
+
+  template<typename U> bool operator==(const CountingAllocator<U>&) const {return true;}
+  template<typename U> bool operator!=(const CountingAllocator<U>&) const {return false;}
+};
+
+using String = std::basic_string<char, std::char_traits<char>, CountingAllocator<char>>;
+
+struct StringHash
+{
+  size_t operator()(const String& string) const {return std::hash<std::string_view>()(string);}
+};
+
+/**
+ * Simulates the heap usage of a thread during a frame: short-lived containers
+ * of perceptions, strings, functions, hash maps and a message queue.
+ */
+static void frame(int frameNo)
+{
+  std::vector<Vector2f, CountingAllocator<Vector2f>> spots;
+  for(int i = 0; i < 40 + frameNo % 20; ++i)
+    spots.emplace_back(static_cast<float>(i), static_cast<float>(frameNo));
+  std::list<std::vector<int, CountingAllocator<int>>, CountingAllocator<std::vector<int, CountingAllocator<int>>>> regions;
+  for(int i = 0; i < 60; ++i)
+    regions.emplace_back(static_cast<size_t>(i % 8 + 1), i);
+  std::unordered_map<String, float, StringHash, std::equal_to<String>, CountingAllocator<std::pair<const String, float>>> behavior;
+  for(int i = 0; i < 20; ++i)
+    behavior[String("option") + std::to_string(i).c_str() + "_with_a_longer_name"] = spots[i].x();
+  float sum = 0.f;
+  for(auto& option : behavior)
+    sum += option.second;
+  MessageQueue queue;
+  queue.setSize(4096);
+  queue.out.bin << sum << static_cast<unsigned>(regions.size());
+  queue.out.finishMessage(idText);
+}
+
+/** Runs frames on several threads with and without thread caches. */
+GTEST_TEST(Memory, Benchmark)
+{
+  constexpr int numOfThreads = 4, numOfFrames = 1000;
+  std::vector<unsigned> allocationsPerFrame;
+  for(bool enabled : {false, true})
+  {
+    Memory::setThreadCacheEnabled(enabled);
+    std::vector<unsigned> threadAllocations(numOfThreads);
+    const auto run = [&threadAllocations]
+    {
+      std::vector<std::thread> threads;
+      for(int t = 0; t < numOfThreads; ++t)
+        threads.emplace_back([&threadAllocations, t]
+        {
+          const unsigned start = Memory::getNumOfAllocations();
+          for(int i = 0; i < numOfFrames; ++i)
+            frame(i);
+          threadAllocations[t] = Memory::getNumOfAllocations() - start;
+        });
+      for(std::thread& thread : threads)
+        thread.join();
+    };
+    PRINTF("thread caches %s, %d frames on each of %d threads:\n", enabled ? "on" : "off", numOfFrames, numOfThreads);
+    RUN_BENCH(3, 1, run());
+    unsigned allocations = 0;
+    for(unsigned a : threadAllocations)
+      allocations += a;
+    allocationsPerFrame.push_back(allocations / (numOfThreads * numOfFrames));
+  }
+  Memory::setThreadCacheEnabled(true);
+
+  // The caches only change where the memory comes from, not how often it is requested.
+  EXPECT_LT(0u, allocationsPerFrame[0]);
+  EXPECT_EQ(allocationsPerFrame[0], allocationsPerFrame[1]);
+}
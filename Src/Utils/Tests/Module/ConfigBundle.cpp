@@ -0,0 +1,81 @@
+#include "Tools/Module/ConfigBundle.h"
+#include "Tools/Module/Module.h"
+#include "Tools/Streams/AutoStreamable.h"
+#include "Utils/Tests/TemporaryDirectory.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <string>
+
+STREAMABLE(ConfigBundleTestParameters,
+{,
+  (int)(0) value,
+  (std::vector<float>) list,
+});
+
+static void writeConfig(const std::string& path, const std::string& content)
+{
+  FILE* file = std::fopen(path.c_str(), "wb");
+  ASSERT_TRUE(file);
+  std::fwrite(content.data(), 1, content.size(), file);
+  std::fclose(file);
+}
+
+GTEST_TEST(ConfigBundle, ReadsWhatWasSaved)
+{
+  const TemporaryDirectory directory;
+  const std::string bundle = directory / "configBundle.bin";
+  const std::string config = directory / "configBundleTest.cfg";
+  writeConfig(config, "value = 5;\nlist = [1, 2.5];\n");
+
+  // No bundle yet: the text file is parsed and added.
+  ConfigBundle::open(bundle);
+  ConfigBundleTestParameters parameters;
+  const unsigned hits = ConfigBundle::getStatistics().hits;
+  loadModuleParameters(parameters, "ConfigBundleTest", config.c_str());
+  EXPECT_EQ(ConfigBundle::getStatistics().hits, hits);
+  ConfigBundle::save();
+
+  // Now the parameters come from the bundle.
+  ConfigBundle::open(bundle);
+  ConfigBundleTestParameters fromBundle;
+  loadModuleParameters(fromBundle, "ConfigBundleTest", config.c_str());
+  EXPECT_EQ(ConfigBundle::getStatistics().hits, hits + 1);
+  EXPECT_EQ(fromBundle.value, 5);
+  ASSERT_EQ(fromBundle.list.size(), 2u);
+  EXPECT_EQ(fromBundle.list[1], 2.5f);
+
+  // A changed file makes the entry stale.
+  writeConfig(config, "value = 17;\nlist = [];\n");
+  ConfigBundleTestParameters changed;
+  loadModuleParameters(changed, "ConfigBundleTest", config.c_str());
+  EXPECT_EQ(ConfigBundle::getStatistics().hits, hits + 1);
+  EXPECT_EQ(changed.value, 17);
+  EXPECT_TRUE(changed.list.empty());
+}
+
+GTEST_TEST(ConfigBundle, SavesInBackground)
+{
+  const TemporaryDirectory directory;
+  const std::string bundle = directory / "configBundle.bin";
+  const std::string config = directory / "configBundleBackgroundTest.cfg";
+  writeConfig(config, "value = 3;\nlist = [];\n");
+
+  ConfigBundle::open(bundle);
+  ConfigBundleTestParameters parameters;
+  loadModuleParameters(parameters, "ConfigBundleBackgroundTest", config.c_str());
+  ConfigBundle::saveInBackground();
+
+  ConfigBundle::waitForBackgroundSave();
+  FILE* file = std::fopen(bundle.c_str(), "rb");
+  ASSERT_TRUE(file);
+  std::fclose(file);
+
+  ConfigBundle::open(bundle);
+  const unsigned hits = ConfigBundle::getStatistics().hits;
+  ConfigBundleTestParameters fromBundle;
+  loadModuleParameters(fromBundle, "ConfigBundleBackgroundTest", config.c_str());
+  EXPECT_EQ(ConfigBundle::getStatistics().hits, hits + 1);
+  EXPECT_EQ(fromBundle.value, 3);
+}
@@ -0,0 +1,137 @@
+#include "Modules/MotionControl/KickEngine/KickEngineData.h"
+#include "Platform/File.h"
+#include "Tools/FunctionList.h"
+#include "Tools/Motion/KinematicsCache.h"
+#include "Tools/Streams/InStreams.h"
+#include "Utils/Tests/bench.h"
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <string>
+
+/** The inputs of a kick that do not change while it is executed. */
+struct KickSetup
+{
+  RobotDimensions robotDimensions;
+  MassCalibration massCalibration;
+  DamageConfigurationBody damageConfigurationBody;
+  JointAngles jointAngles;
+  TorsoMatrix torsoMatrix;
+  KinematicsCache cache;
+  Kinematics kinematics;
+  std::vector<KickEngineParameters> params;
+  std::vector<KickTrajectory> trajectories;
+
+  KickSetup()
+  {
+    FunctionList::execute(); // Registers the names of the limbs.
+    const std::string path = std::string(File::getBHDir()) + "/Config/";
+    InMapFile dimensions(path + "Robots/Default/robotDimensions.cfg");
+    EXPECT_TRUE(dimensions.exists());
+    dimensions >> robotDimensions;
+    InMapFile masses(path + "Robots/Default/massCalibration.cfg");
+    EXPECT_TRUE(masses.exists());
+    masses >> massCalibration;
+    InMapFile kick(path + "KickEngine/kickForward.kmc");
+    EXPECT_TRUE(kick.exists());
+    params.emplace_back();
+    kick >> params.back();
+    std::strcpy(params.back().name, "kickForward");
+    trajectories.resize(1);
+    trajectories.back().create(params.back(), robotDimensions);
+
+    // Standing with bent knees.
+    jointAngles.angles.fill(0_deg);
+    jointAngles.angles[Joints::lHipPitch] = jointAngles.angles[Joints::rHipPitch] = -25_deg;
+    jointAngles.angles[Joints::lKneePitch] = jointAngles.angles[Joints::rKneePitch] = 50_deg;
+    jointAngles.angles[Joints::lAnklePitch] = jointAngles.angles[Joints::rAnklePitch] = -25_deg;
+    jointAngles.angles[Joints::lShoulderPitch] = jointAngles.angles[Joints::rShoulderPitch] = 90_deg;
+
+    kinematics.getRobotModel = [this](const JointAngles& jointAngles) {return cache.getRobotModel(jointAngles);};
+  }
+
+  /**
+   * Executes a whole kick the way KickEngine does.
+   * @param mirror Execute the kick with the other leg?
+   * @param useTrajectories Use the samples of the kick?
+   * @param jitter Vary the time between frames between 11 and 13 ms as on the robot?
+   * @return The joint requests of all frames.
+   */
+  std::vector<JointRequest> execute(bool mirror, bool useTrajectories, bool jitter = false)
+  {
+    static const std::vector<KickTrajectory> noTrajectories;
+    KickRequest kickRequest;
+    kickRequest.kickMotionType = KickRequest::kickForward;
+    kickRequest.mirror = mirror;
+    FrameInfo frameInfo;
+    frameInfo.time = 10000;
+    KickEngineData data;
+    data.robotModel = RobotModel(jointAngles, robotDimensions, massCalibration);
+    data.currentKickRequest = kickRequest;
+    cache.reset(robotDimensions, massCalibration);
+
+    std::vector<JointRequest> jointRequests(1);
+    data.initData(frameInfo, kickRequest, params, useTrajectories ? trajectories : noTrajectories, jointAngles, torsoMatrix,
+                  jointRequests.back(), robotDimensions, kinematics, damageConfigurationBody);
+    while(data.checkPhaseTime(frameInfo, jointAngles, torsoMatrix))
+    {
+      cache.reset(robotDimensions, massCalibration);
+      data.calcPhaseState();
+      data.calcPositions(torsoMatrix);
+      jointRequests.emplace_back(jointRequests.back());
+      JointRequest& jointRequest = jointRequests.back();
+      data.calcJoints(jointRequest, robotDimensions, damageConfigurationBody);
+      data.balanceCOM(jointRequest, kinematics);
+      data.calcJoints(jointRequest, robotDimensions, damageConfigurationBody);
+      data.mirrorIfNecessary(jointRequest);
+      frameInfo.time += jitter ? 11 + (jointRequests.size() * 7) % 3 : 12;
+    }
+    return jointRequests;
+  }
+};
+
+GTEST_TEST(KickEngine, TrajectoriesMatchComputedPositions)
+{
+  KickSetup setup;
+  for(bool mirror : {false, true})
+  {
+    const std::vector<JointRequest> computed = setup.execute(mirror, false);
+    const std::vector<JointRequest> sampled = setup.execute(mirror, true);
+    ASSERT_EQ(computed.size(), sampled.size());
+    EXPECT_GT(computed.size(), 10u);
+    for(size_t frame = 0; frame < computed.size(); ++frame)
+      for(int joint = 0; joint < Joints::numOfJoints; ++joint)
+        EXPECT_FLOAT_EQ(computed[frame].angles[joint], sampled[frame].angles[joint]) << "frame " << frame << ", joint " << joint;
+  }
+}
+
+GTEST_TEST(KickEngine, InterpolatedTrajectoriesMatchComputedPositions)
+{
+  KickSetup setup;
+  for(bool mirror : {false, true})
+  {
+    const std::vector<JointRequest> computed = setup.execute(mirror, false, true);
+    const std::vector<JointRequest> sampled = setup.execute(mirror, true, true);
+    ASSERT_EQ(computed.size(), sampled.size());
+    // Balancing amplifies the interpolation error to a few tenths of a degree in the fastest parts of the kick.
+    for(size_t frame = 0; frame < computed.size(); ++frame)
+      for(int joint = 0; joint < Joints::numOfJoints; ++joint)
+        EXPECT_NEAR(computed[frame].angles[joint], sampled[frame].angles[joint], 0.5_deg) << "frame " << frame << ", joint " << joint;
+  }
+}
+
+GTEST_TEST(KickEngine, Benchmark)
+{
+  KickSetup setup;
+  size_t numOfFrames[2] = {0, 0};
+  int kick = 0;
+  for(int useTrajectories = 0; useTrajectories < 2; ++useTrajectories)
+  {
+    PRINTF("kick engine per kick, %s:\n", useTrajectories ? "sampled" : "computed");
+    RUN_BENCH(5, 20, numOfFrames[useTrajectories] = setup.execute((++kick & 1) != 0, useTrajectories != 0, true).size());
+  }
+  PRINTF("%d Motion frames per kick\n", static_cast<int>(numOfFrames[0]));
+  EXPECT_LT(0u, numOfFrames[0]);
+  EXPECT_EQ(numOfFrames[0], numOfFrames[1]);
+}
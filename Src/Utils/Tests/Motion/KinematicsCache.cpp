@@ -0,0 +1,167 @@
+#include "Platform/File.h"
+#include "Representations/Infrastructure/JointRequest.h"
+#include "Tools/FunctionList.h"
+#include "Tools/Math/Random.h"
+#include "Tools/Motion/ForwardKinematic.h"
+#include "Tools/Motion/KinematicsCache.h"
+#include "Tools/Streams/InStreams.h"
+#include "Utils/Tests/bench.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+
+static void loadConfiguration(RobotDimensions& robotDimensions, MassCalibration& massCalibration)
+{
+  FunctionList::execute(); // Registers the names of the limbs.
+  const std::string path = std::string(File::getBHDir()) + "/Config/Robots/Default/";
+  InMapFile dimensions(path + "robotDimensions.cfg");
+  ASSERT_TRUE(dimensions.exists());
+  dimensions >> robotDimensions;
+  InMapFile masses(path + "massCalibration.cfg");
+  ASSERT_TRUE(masses.exists());
+  masses >> massCalibration;
+}
+
+static bool isNear(const Pose3f& a, const Pose3f& b)
+{
+  return (a.translation - b.translation).norm() < 1e-3f && a.rotation.isApprox(b.rotation, 1e-5f);
+}
+
+static JointAngles randomJointAngles()
+{
+  JointAngles jointAngles;
+  for(Angle& angle : jointAngles.angles)
+    angle = Random::uniform(-1.f, 1.f);
+  return jointAngles;
+}
+
+GTEST_TEST(KinematicsCache, MatchesRobotModel)
+{
+  RobotDimensions robotDimensions;
+  MassCalibration massCalibration;
+  loadConfiguration(robotDimensions, massCalibration);
+  KinematicsCache cache;
+  cache.reset(robotDimensions, massCalibration);
+
+  JointAngles jointAngles = randomJointAngles();
+  for(int i = 0; i < 40; ++i)
+  {
+    // Change some chains, so that others are reused.
+    jointAngles.angles[Joints::lHipPitch] += 0.01f;
+    if(i % 3 == 0)
+      jointAngles.angles[Joints::rElbowRoll] += 0.01f;
+    const RobotModel expected(jointAngles, robotDimensions, massCalibration);
+    const RobotModel& robotModel = cache.getRobotModel(jointAngles);
+    for(int limb = 0; limb < Limbs::torso; ++limb)
+      EXPECT_TRUE(isNear(robotModel.limbs[limb], expected.limbs[limb])) << "limb " << limb;
+    EXPECT_TRUE(isNear(robotModel.soleLeft, expected.soleLeft));
+    EXPECT_TRUE(isNear(robotModel.soleRight, expected.soleRight));
+    EXPECT_TRUE(robotModel.centerOfMass.isApprox(expected.centerOfMass));
+    EXPECT_TRUE(cache.getRobotModel(jointAngles).centerOfMass.isApprox(expected.centerOfMass));
+  }
+  const KinematicsCache::Statistics& statistics = cache.getStatistics();
+  EXPECT_EQ(statistics.models, 80u);
+  EXPECT_EQ(statistics.modelsReused, 40u);
+  EXPECT_GT(statistics.chainsReused, 40u * 2u);
+}
+
+GTEST_TEST(KinematicsCache, LegJacobian)
+{
+  RobotDimensions robotDimensions;
+  MassCalibration massCalibration;
+  loadConfiguration(robotDimensions, massCalibration);
+  KinematicsCache cache;
+  cache.reset(robotDimensions, massCalibration);
+
+  const JointAngles jointAngles = randomJointAngles();
+  for(int leg = 0; leg < Legs::numOfLegs; ++leg)
+  {
+    const Limbs::Limb foot = leg == Legs::left ? Limbs::footLeft : Limbs::footRight;
+    const Joints::Joint firstJoint = leg == Legs::left ? Joints::lHipYawPitch : Joints::rHipYawPitch;
+    const Matrix6f jacobian = cache.getLegJacobian(static_cast<Legs::Leg>(leg), jointAngles);
+    const Pose3f pose = RobotModel(jointAngles, robotDimensions, massCalibration).limbs[foot];
+    for(int i = 0; i < 6; ++i)
+    {
+      const float delta = 1e-3f;
+      JointAngles moved = jointAngles;
+      moved.angles[firstJoint + i] += delta;
+      const Pose3f movedPose = RobotModel(moved, robotDimensions, massCalibration).limbs[foot];
+      const Vector3f translation = (movedPose.translation - pose.translation) / delta;
+      const AngleAxisf rotation(movedPose.rotation * pose.rotation.inverse());
+      const Vector3f angularVelocity = rotation.axis() * rotation.angle() / delta;
+      const Vector3f translationColumn = jacobian.block<3, 1>(0, i);
+      const Vector3f rotationColumn = jacobian.block<3, 1>(3, i);
+      EXPECT_LT((translationColumn - translation).norm(), 0.5f) << translationColumn.transpose() << " vs. " << translation.transpose();
+      EXPECT_LT((rotationColumn - angularVelocity).norm(), 0.01f) << rotationColumn.transpose() << " vs. " << angularVelocity.transpose();
+    }
+  }
+  cache.getLegJacobian(Legs::left, jointAngles);
+  EXPECT_EQ(cache.getStatistics().jacobiansReused, 1u);
+}
+
+/**
+ * Compares the kinematics computed in a Motion frame while walking:
+ * the model of the measured joint angles (RobotModelProvider) and the models
+ * Walk2014Generator uses to compensate the arm position.
+ */
+GTEST_TEST(KinematicsCache, Benchmark)
+{
+  RobotDimensions robotDimensions;
+  MassCalibration massCalibration;
+  loadConfiguration(robotDimensions, massCalibration);
+  KinematicsCache cache;
+  constexpr int numOfFrames = 20000;
+  std::vector<JointAngles> measured(numOfFrames), requested(numOfFrames), lastRequest(numOfFrames);
+  for(int i = 0; i < numOfFrames; ++i)
+  {
+    measured[i] = randomJointAngles();
+    requested[i] = randomJointAngles();
+    lastRequest[i] = randomJointAngles();
+  }
+
+  const auto direct = [&](int i)
+  {
+    const RobotModel robotModel(measured[i], robotDimensions, massCalibration);
+    JointAngles temp = requested[i];
+    temp.angles[Joints::headYaw] = lastRequest[i].angles[Joints::headYaw];
+    temp.angles[Joints::headPitch] = lastRequest[i].angles[Joints::headPitch];
+    const RobotModel withWalkGeneratorArms(temp, robotDimensions, massCalibration);
+    for(int joint = Joints::firstArmJoint; joint < Joints::firstLegJoint; ++joint)
+      temp.angles[joint] = lastRequest[i].angles[joint];
+    RobotModel balanced(temp, robotDimensions, massCalibration);
+    temp.angles[Joints::lHipPitch] += 0.01f;
+    ForwardKinematic::calculateLegChain(Legs::left, temp, robotDimensions, balanced.limbs);
+    ForwardKinematic::calculateLegChain(Legs::right, temp, robotDimensions, balanced.limbs);
+    balanced.updateCenterOfMass(massCalibration);
+    return robotModel.centerOfMass.x() + withWalkGeneratorArms.centerOfMass.x() + balanced.centerOfMass.x();
+  };
+
+  const auto cached = [&](int i)
+  {
+    cache.reset(robotDimensions, massCalibration);
+    const Vector3f robotModel = cache.getRobotModel(measured[i]).centerOfMass;
+    JointAngles temp = requested[i];
+    temp.angles[Joints::headYaw] = lastRequest[i].angles[Joints::headYaw];
+    temp.angles[Joints::headPitch] = lastRequest[i].angles[Joints::headPitch];
+    const Vector3f withWalkGeneratorArms = cache.getRobotModel(temp).centerOfMass;
+    for(int joint = Joints::firstArmJoint; joint < Joints::firstLegJoint; ++joint)
+      temp.angles[joint] = lastRequest[i].angles[joint];
+    temp.angles[Joints::lHipPitch] += 0.01f;
+    const Vector3f balanced = cache.getRobotModel(temp).centerOfMass;
+    return robotModel.x() + withWalkGeneratorArms.x() + balanced.x();
+  };
+
+  // Each version processes every frame exactly once.
+  float sum = 0.f;
+  int frame = 0;
+  PRINTF("kinematics per Motion frame, direct:\n");
+  RUN_BENCH(5, numOfFrames / 5, sum += direct(frame++));
+  float cachedSum = 0.f;
+  frame = 0;
+  PRINTF("kinematics per Motion frame, cached:\n");
+  RUN_BENCH(5, numOfFrames / 5, cachedSum += cached(frame++));
+
+  ASSERT_EQ(numOfFrames, frame);
+  EXPECT_NEAR(sum, cachedSum, std::abs(sum) * 1e-4f + 1e-2f);
+}
@@ -0,0 +1,59 @@
+#include "Tools/Streams/InStreams.h"
+#include "Tools/Streams/MapCache.h"
+#include "Utils/Tests/TemporaryDirectory.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+static void writeConfig(const std::string& path, const std::string& content)
+{
+  FILE* file = std::fopen(path.c_str(), "wb");
+  ASSERT_TRUE(file);
+  std::fwrite(content.data(), 1, content.size(), file);
+  std::fclose(file);
+}
+
+static int readValue(const std::string& path)
+{
+  InCachedMapFile stream(path);
+  EXPECT_TRUE(stream.exists());
+  int value = 0;
+  stream.select("value", -2, nullptr);
+  stream >> value;
+  stream.deselect();
+  return value;
+}
+
+GTEST_TEST(MapCache, ParsesOnce)
+{
+  const TemporaryDirectory directory;
+  const std::string path = directory / "mapCacheParsesOnce.cfg";
+  writeConfig(path, "value = 42;\n");
+  const unsigned parses = MapCache::getStatistics().parses;
+  std::vector<std::thread> threads;
+  for(int i = 0; i < 4; ++i)
+    threads.emplace_back([&path]
+    {
+      for(int j = 0; j < 100; ++j)
+        EXPECT_EQ(readValue(path), 42);
+    });
+  for(std::thread& thread : threads)
+    thread.join();
+  EXPECT_LE(MapCache::getStatistics().parses - parses, 4u);
+}
+
+GTEST_TEST(MapCache, ReloadsChangedFiles)
+{
+  const TemporaryDirectory directory;
+  const std::string path = directory / "mapCacheReloads.cfg";
+  writeConfig(path, "value = 1;\n");
+  EXPECT_EQ(readValue(path), 1);
+  writeConfig(path, "value = 23;\n");
+  EXPECT_EQ(readValue(path), 23);
+  std::remove(path.c_str());
+  EXPECT_FALSE(InCachedMapFile(path).exists());
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <filesystem>
+#include <random>
+#include <string>
+
+/** A directory with a unique name for the files of a test. It is removed with its contents at the end of the test. */
+class TemporaryDirectory
+{
+public:
+  TemporaryDirectory()
+  {
+    std::random_device random;
+    do
+      path = std::filesystem::temp_directory_path() / ("bhumanTest" + std::to_string(random()));
+    while(!std::filesystem::create_directory(path));
+  }
+
+  ~TemporaryDirectory()
+  {
+    std::error_code error;
+    std::filesystem::remove_all(path, error);
+  }
+
+  TemporaryDirectory(const TemporaryDirectory&) = delete;
+  TemporaryDirectory& operator=(const TemporaryDirectory&) = delete;
+
+  /**
+   * Returns the path of a file in this directory.
+   * @param name The name of the file.
+   * @return The path.
+   */
+  std::string operator/(const std::string& name) const {return (path / name).string();}
+
+private:
+  std::filesystem::path path;
+};
@@ -3,8 +3,17 @@
 #include "gPrintf.h"
 #include "bench/BenchTimer.h"
 
+/** Passes code that contains commas as a single macro argument. */
+#define PROTECT(...) __VA_ARGS__
+
+/**
+ * Runs code REP times in each of TRIES tries and prints the best, average, and
+ * worst wall clock time of a single run. Wall clock time is used, because the
+ * code might distribute its work over several threads.
+ */
 #define RUN_BENCH(TRIES,REP, ...) do { \
     Eigen::BenchTimer timer; \
     BENCH(timer, TRIES, REP, PROTECT(__VA_ARGS__)) \
-    PRINTF("best: %.3fs, avg: %.3fs, worst: %.3fs \n", timer.best(), timer.total() / TRIES, timer.worst()); \
+    PRINTF("best: %.2fus, avg: %.2fus, worst: %.2fus \n", timer.best(Eigen::REAL_TIMER) * 1e6 / (REP), \
+           timer.total(Eigen::REAL_TIMER) * 1e6 / ((TRIES) * (REP)), timer.worst(Eigen::REAL_TIMER) * 1e6 / (REP)); \
   } while(false)
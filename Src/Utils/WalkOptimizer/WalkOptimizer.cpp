@@ -0,0 +1,769 @@
+/**
+ * @file WalkOptimizer.cpp
+ *
+ * An offline optimizer for the parameters of the Walk2014Generator. It
+ * evaluates candidate parameter sets in many headless SimRobot processes in
+ * parallel and searches with CMA-ES for the set that walks fastest, most
+ * stably and with the fewest falls. Which parameters are optimized and
+ * within which ranges is read from walk2014Learner.cfg. Each simulation runs a
+ * single robot whose behavior is replaced by the WalkEvaluator, which walks a
+ * sequence of speeds and writes its rating to a file. The best parameters
+ * found are written in the format of walk2014Generator.cfg.
+ *
+ * Usage: walkOptimizer [-j <processes>] [-g <generations>] [-l <population>]
+ *                      [-r <repetitions>] [-S <initial step size>]
+ *                      [-t <timeout in s>] [-s <seed>] [-c <base parameters>]
+ *                      [-p <parameter ranges>] [-b <SimRobot>] [-w <work dir>]
+ *                      [-o <output file>]
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <Eigen/Eigenvalues>
+
+static volatile std::sig_atomic_t running = 1;
+
+/** A parameter to optimize. */
+struct Parameter
+{
+  std::string path; /**< The path of the parameter in walk2014Generator.cfg, e.g. "maxSpeed.translation.x". */
+  double min; /**< The smallest value allowed. */
+  double max; /**< The largest value allowed. */
+};
+
+/** The rating of a parameter set as written by the WalkEvaluator. */
+struct Evaluation
+{
+  bool valid = false; /**< Did the simulation finish? */
+  double speedRatio = 0.0;
+  double gyroDeviation = 0.0;
+  int falls = 0;
+};
+
+/**
+ * A file in config map format whose literal values can be replaced while the
+ * rest of the text, including formatting and comments, is kept.
+ */
+class ConfigText
+{
+public:
+  std::string text;
+
+  /**
+   * Reads a file.
+   * @param fileName The name of the file.
+   * @return Was the file read?
+   */
+  bool read(const std::string& fileName)
+  {
+    std::ifstream stream(fileName);
+    if(!stream)
+      return false;
+    std::stringstream buffer;
+    buffer << stream.rdbuf();
+    text = buffer.str();
+    tokenize();
+    return true;
+  }
+
+  /**
+   * Finds the literal values of all attributes outside of arrays.
+   * @return The positions of the values in the text by their dotted paths.
+   */
+  std::map<std::string, std::pair<size_t, size_t>> values() const
+  {
+    std::map<std::string, std::pair<size_t, size_t>> result;
+    size_t i = 0;
+    parseRecord(i, "", result);
+    return result;
+  }
+
+  /**
+   * Returns the text with some values replaced.
+   * @param replacements New values by dotted paths.
+   * @return The text.
+   */
+  std::string replace(const std::map<std::string, std::string>& replacements) const
+  {
+    const auto positions = values();
+    std::vector<std::pair<std::pair<size_t, size_t>, std::string>> edits;
+    for(const auto& replacement : replacements)
+    {
+      const auto position = positions.find(replacement.first);
+      if(position != positions.end())
+        edits.emplace_back(position->second, replacement.second);
+    }
+    std::sort(edits.begin(), edits.end(), [](const auto& a, const auto& b) {return a.first.first > b.first.first;});
+    std::string result = text;
+    for(const auto& edit : edits)
+      result.replace(edit.first.first, edit.first.second - edit.first.first, edit.second);
+    return result;
+  }
+
+  /**
+   * Returns the text without comments on a single line, as expected by the
+   * "set" command of the console.
+   * @param text The text in config map format.
+   * @return The text on a single line.
+   */
+  static std::string singleLine(const std::string& text)
+  {
+    std::string result;
+    for(size_t i = 0; i < text.size(); ++i)
+    {
+      if(text[i] == '"')
+      {
+        const size_t end = std::min(text.find('"', i + 1), text.size() - 1);
+        result += text.substr(i, end - i + 1);
+        i = end;
+      }
+      else if(text.compare(i, 2, "//") == 0)
+        i = std::min(text.find('\n', i), text.size()) - 1;
+      else if(text.compare(i, 2, "/*") == 0)
+        i = std::min(text.find("*/", i + 2), text.size() - 2) + 1;
+      else
+        result += std::isspace(static_cast<unsigned char>(text[i])) ? ' ' : text[i];
+    }
+    return result;
+  }
+
+  /**
+   * Parses an array of records of the form {path = {min = <min>; max = <max>;};}
+   * as found in walk2014Learner.cfg.
+   * @param name The name of the array.
+   * @return The parameters.
+   */
+  std::vector<Parameter> parameters(const std::string& name) const
+  {
+    std::vector<Parameter> result;
+    size_t i = 0;
+    while(i + 2 < tokens.size() && !(text.compare(tokens[i].first, tokens[i].second - tokens[i].first, name) == 0 && token(i + 1) == "=" && token(i + 2) == "["))
+      ++i;
+    for(i += 3; i + 2 < tokens.size() && token(i) == "{"; ++i)
+    {
+      Parameter parameter = {token(i + 1), 0.0, 0.0};
+      for(i += 4; i < tokens.size() && token(i) != "}"; ++i)
+        if(i + 2 < tokens.size() && token(i + 1) == "=")
+        {
+          (token(i) == "min" ? parameter.min : parameter.max) = std::atof(token(i + 2).c_str());
+          i += 2;
+        }
+      result.push_back(parameter);
+      while(i < tokens.size() && token(i) != "," && token(i) != "]")
+        ++i;
+      if(i < tokens.size() && token(i) == "]")
+        break;
+    }
+    return result;
+  }
+
+private:
+  std::vector<std::pair<size_t, size_t>> tokens; /**< The begin and end of all tokens in the text. */
+
+  std::string token(size_t i) const {return text.substr(tokens[i].first, tokens[i].second - tokens[i].first);}
+
+  /** Splits the text into tokens, skipping comments. */
+  void tokenize()
+  {
+    tokens.clear();
+    for(size_t i = 0; i < text.size();)
+    {
+      if(std::isspace(static_cast<unsigned char>(text[i])))
+        ++i;
+      else if(text.compare(i, 2, "//") == 0)
+        i = std::min(text.find('\n', i), text.size());
+      else if(text.compare(i, 2, "/*") == 0)
+        i = std::min(text.find("*/", i + 2), text.size() - 2) + 2;
+      else if(std::strchr("=;,[]{}", text[i]))
+      {
+        tokens.emplace_back(i, i + 1);
+        ++i;
+      }
+      else if(text[i] == '"')
+      {
+        const size_t end = std::min(text.find('"', i + 1), text.size() - 1) + 1;
+        tokens.emplace_back(i, end);
+        i = end;
+      }
+      else
+      {
+        size_t end = i;
+        while(end < text.size() && !std::isspace(static_cast<unsigned char>(text[end])) && !std::strchr("=;,[]{}\"", text[end])
+              && text.compare(end, 2, "//") != 0 && text.compare(end, 2, "/*") != 0)
+          ++end;
+        tokens.emplace_back(i, end);
+        i = end;
+      }
+    }
+  }
+
+  /** Parses the attributes of a record until its closing brace. */
+  void parseRecord(size_t& i, const std::string& prefix, std::map<std::string, std::pair<size_t, size_t>>& result) const
+  {
+    while(i < tokens.size() && token(i) != "}")
+    {
+      const std::string name = prefix + token(i);
+      if(i + 2 >= tokens.size() || token(i + 1) != "=")
+        return;
+      i += 2;
+      parseValue(i, name, result);
+      if(i < tokens.size() && token(i) == ";")
+        ++i;
+    }
+  }
+
+  /** Parses a value, i.e. a literal, a record or an array. */
+  void parseValue(size_t& i, const std::string& name, std::map<std::string, std::pair<size_t, size_t>>& result) const
+  {
+    if(token(i) == "{")
+    {
+      parseRecord(++i, name + ".", result);
+      ++i;
+    }
+    else if(token(i) == "[")
+    {
+      for(int depth = 0; i < tokens.size(); ++i)
+        if(token(i) == "[" || token(i) == "{")
+          ++depth;
+        else if((token(i) == "]" || token(i) == "}") && --depth == 0)
+          break;
+      ++i;
+    }
+    else
+      result[name] = tokens[i++];
+  }
+};
+
+/**
+ * A minimal CMA-ES (Hansen, The CMA Evolution Strategy: A Tutorial) that
+ * minimizes in the unit cube. Points outside are clamped for the evaluation
+ * and penalized by their squared distance to the cube.
+ */
+class CMAES
+{
+public:
+  using Vector = Eigen::VectorXd;
+  using Matrix = Eigen::MatrixXd;
+
+  const int n; /**< The number of dimensions. */
+  const int lambda; /**< The population size. */
+  const int mu; /**< The number of parents. */
+  Vector weights; /**< The recombination weights of the parents. */
+  double muEff; /**< The variance effective selection mass. */
+  double cc, cs, c1, cmu, damps, chiN; /**< Learning rates and damping. */
+
+  Vector mean; /**< The mean of the distribution. */
+  double sigma; /**< The step size. */
+  Matrix C; /**< The covariance matrix. */
+  Vector pc; /**< The evolution path of C. */
+  Vector ps; /**< The evolution path of sigma. */
+  Matrix B; /**< The eigenvectors of C. */
+  Vector D; /**< The square roots of the eigenvalues of C. */
+  int generation = 0;
+
+  std::mt19937 random;
+
+  CMAES(const Vector& start, double sigma, int lambda, unsigned seed) :
+    n(static_cast<int>(start.size())), lambda(lambda), mu(lambda / 2), mean(start), sigma(sigma),
+    C(Matrix::Identity(n, n)), pc(Vector::Zero(n)), ps(Vector::Zero(n)), B(Matrix::Identity(n, n)), D(Vector::Ones(n)), random(seed)
+  {
+    weights.resize(mu);
+    for(int i = 0; i < mu; ++i)
+      weights(i) = std::log(mu + 0.5) - std::log(i + 1.0);
+    weights /= weights.sum();
+    muEff = 1.0 / weights.squaredNorm();
+    cc = (4.0 + muEff / n) / (n + 4.0 + 2.0 * muEff / n);
+    cs = (muEff + 2.0) / (n + muEff + 5.0);
+    c1 = 2.0 / ((n + 1.3) * (n + 1.3) + muEff);
+    cmu = std::min(1.0 - c1, 2.0 * (muEff - 2.0 + 1.0 / muEff) / ((n + 2.0) * (n + 2.0) + muEff));
+    damps = 1.0 + 2.0 * std::max(0.0, std::sqrt((muEff - 1.0) / (n + 1.0)) - 1.0) + cs;
+    chiN = std::sqrt(static_cast<double>(n)) * (1.0 - 1.0 / (4.0 * n) + 1.0 / (21.0 * n * n));
+  }
+
+  /**
+   * Samples the next population.
+   * @return The candidates.
+   */
+  std::vector<Vector> sample()
+  {
+    std::normal_distribution<double> normal;
+    std::vector<Vector> population(lambda);
+    for(Vector& x : population)
+    {
+      Vector z(n);
+      for(int i = 0; i < n; ++i)
+        z(i) = normal(random);
+      x = mean + sigma * (B * D.asDiagonal() * z);
+    }
+    return population;
+  }
+
+  /**
+   * Adapts the distribution to the fitness of the population.
+   * @param population The candidates returned by sample().
+   * @param fitness The fitness of each candidate (smaller is better).
+   */
+  void update(const std::vector<Vector>& population, const std::vector<double>& fitness)
+  {
+    std::vector<int> order(lambda);
+    for(int i = 0; i < lambda; ++i)
+      order[i] = i;
+    std::sort(order.begin(), order.end(), [&](int a, int b) {return fitness[a] < fitness[b];});
+
+    const Vector oldMean = mean;
+    mean = Vector::Zero(n);
+    for(int i = 0; i < mu; ++i)
+      mean += weights(i) * population[order[i]];
+
+    const Vector yw = (mean - oldMean) / sigma;
+    const Matrix invSqrtC = B * D.cwiseInverse().asDiagonal() * B.transpose();
+    ps = (1.0 - cs) * ps + std::sqrt(cs * (2.0 - cs) * muEff) * invSqrtC * yw;
+    ++generation;
+    const bool hsig = ps.norm() / std::sqrt(1.0 - std::pow(1.0 - cs, 2.0 * generation)) / chiN < 1.4 + 2.0 / (n + 1.0);
+    pc = (1.0 - cc) * pc + (hsig ? std::sqrt(cc * (2.0 - cc) * muEff) : 0.0) * yw;
+
+    Matrix rankMu = Matrix::Zero(n, n);
+    for(int i = 0; i < mu; ++i)
+    {
+      const Vector y = (population[order[i]] - oldMean) / sigma;
+      rankMu += weights(i) * y * y.transpose();
+    }
+    C = (1.0 - c1 - cmu) * C + c1 * (pc * pc.transpose() + (hsig ? 0.0 : cc * (2.0 - cc)) * C) + cmu * rankMu;
+    sigma *= std::exp(cs / damps * (ps.norm() / chiN - 1.0));
+
+    C = (C + C.transpose()) * 0.5;
+    Eigen::SelfAdjointEigenSolver<Matrix> solver(C);
+    B = solver.eigenvectors();
+    D = solver.eigenvalues().cwiseMax(1e-20).cwiseSqrt();
+  }
+};
+
+/** A simulation that is currently running. */
+struct Job
+{
+  int candidate; /**< The index of the candidate evaluated. */
+  pid_t pid; /**< The process of SimRobot. */
+  std::string resultFile; /**< The file the WalkEvaluator writes to. */
+  double startTime; /**< When was the simulation started (in s)? */
+};
+
+static double now()
+{
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static std::string formatNumber(double value)
+{
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.6g", value);
+  return buffer;
+}
+
+/**
+ * Reads a literal value from the config, converting angles to radians.
+ * @param literal The literal, e.g. "70deg".
+ * @return The value.
+ */
+static double parseValue(const std::string& literal)
+{
+  char* end;
+  const double value = std::strtod(literal.c_str(), &end);
+  return std::strcmp(end, "deg") == 0 ? value * M_PI / 180.0 : value;
+}
+
+/**
+ * Reads the result file of the WalkEvaluator.
+ * @param fileName The name of the file.
+ * @return The evaluation.
+ */
+static Evaluation readEvaluation(const std::string& fileName)
+{
+  Evaluation evaluation;
+  ConfigText config;
+  if(config.read(fileName))
+  {
+    const auto values = config.values();
+    auto get = [&](const char* name) -> std::string
+    {
+      const auto value = values.find(name);
+      return value == values.end() ? "" : config.text.substr(value->second.first, value->second.second - value->second.first);
+    };
+    evaluation.valid = get("finished") == "true";
+    evaluation.speedRatio = std::atof(get("speedRatio").c_str());
+    evaluation.gyroDeviation = std::atof(get("gyroDeviation").c_str());
+    evaluation.falls = std::atoi(get("falls").c_str());
+  }
+  return evaluation;
+}
+
+/** Stops a simulation and all its processes. */
+static void stop(pid_t pid)
+{
+  kill(-pid, SIGTERM);
+  for(int i = 0; i < 50; ++i)
+  {
+    if(waitpid(pid, nullptr, WNOHANG) == pid)
+      return;
+    usleep(100000);
+  }
+  kill(-pid, SIGKILL);
+  waitpid(pid, nullptr, 0);
+}
+
+class WalkOptimizer
+{
+public:
+  std::string bhDir; /**< The root directory of the B-Human code. */
+  std::string simRobot; /**< The SimRobot executable. */
+  std::string workDir; /**< The directory for the scenes and results. */
+  unsigned processes = 1; /**< How many simulations run in parallel? */
+  unsigned repetitions = 1; /**< How often is each candidate evaluated? */
+  double timeout = 300.0; /**< The maximum wall clock time of a simulation (in s). */
+  double gyroWeight = 0.5; /**< Fitness weight of the gyro deviation (per radians/s). */
+  double fallWeight = 1.0; /**< Fitness weight of each fall. */
+
+  ConfigText walkParameters; /**< The walk parameters the candidates modify. */
+  ConfigText evaluatorParameters; /**< The parameters of the WalkEvaluator. */
+  std::vector<Parameter> parameters; /**< The parameters optimized. */
+  unsigned numOfJobs = 0; /**< The number of simulations started so far. */
+
+  /**
+   * Converts a point in the unit cube to the parameters in walk2014Generator.cfg.
+   * @param x The point. It is clamped to the unit cube.
+   * @return The text of walk2014Generator.cfg.
+   */
+  std::string toConfig(const CMAES::Vector& x) const
+  {
+    std::map<std::string, std::string> values;
+    for(size_t i = 0; i < parameters.size(); ++i)
+    {
+      const double ratio = std::max(0.0, std::min(1.0, x(i)));
+      values[parameters[i].path] = formatNumber(parameters[i].min + ratio * (parameters[i].max - parameters[i].min));
+    }
+    return walkParameters.replace(values);
+  }
+
+  /**
+   * Determines the point in the unit cube of the parameters in walk2014Generator.cfg.
+   * @return The point.
+   */
+  CMAES::Vector fromConfig() const
+  {
+    const auto values = walkParameters.values();
+    CMAES::Vector x(parameters.size());
+    for(size_t i = 0; i < parameters.size(); ++i)
+    {
+      const auto value = values.find(parameters[i].path);
+      if(value == values.end())
+      {
+        std::fprintf(stderr, "%s not found, starting in the middle of its range.\n", parameters[i].path.c_str());
+        x(i) = 0.5;
+      }
+      else
+        x(i) = (parseValue(walkParameters.text.substr(value->second.first, value->second.second - value->second.first)) - parameters[i].min)
+               / (parameters[i].max - parameters[i].min);
+    }
+    return x.cwiseMax(0.0).cwiseMin(1.0);
+  }
+
+  /**
+   * Computes the fitness of a candidate from its evaluations.
+   * @param x The candidate.
+   * @param evaluations The evaluations of all repetitions.
+   * @return The fitness (smaller is better).
+   */
+  double fitness(const CMAES::Vector& x, const std::vector<Evaluation>& evaluations) const
+  {
+    double sum = 0.0;
+    for(const Evaluation& evaluation : evaluations)
+      sum += evaluation.valid ? -evaluation.speedRatio + gyroWeight * evaluation.gyroDeviation + fallWeight * evaluation.falls
+                              : 10.0 * fallWeight;
+    const double penalty = (x - x.cwiseMax(0.0).cwiseMin(1.0)).squaredNorm();
+    return sum / static_cast<double>(evaluations.size()) + penalty;
+  }
+
+  /**
+   * Evaluates a population in parallel simulations.
+   * @param population The candidates.
+   * @return The evaluations of all repetitions of each candidate.
+   */
+  std::vector<std::vector<Evaluation>> evaluate(const std::vector<CMAES::Vector>& population)
+  {
+    std::vector<std::vector<Evaluation>> evaluations(population.size());
+    std::vector<Job> jobs;
+    size_t next = 0;
+    const size_t total = population.size() * repetitions;
+    while(running && (next < total || !jobs.empty()))
+    {
+      while(running && next < total && jobs.size() < processes)
+      {
+        const int candidate = static_cast<int>(next++ % population.size());
+        Job job;
+        if(start(population[candidate], candidate, job))
+          jobs.push_back(job);
+        else
+          evaluations[candidate].push_back(Evaluation());
+      }
+
+      usleep(100000);
+      for(auto job = jobs.begin(); job != jobs.end();)
+      {
+        struct stat buffer;
+        const bool done = stat(job->resultFile.c_str(), &buffer) == 0;
+        const bool exited = !done && waitpid(job->pid, nullptr, WNOHANG) == job->pid;
+        if(done || exited || now() - job->startTime > timeout)
+        {
+          if(!exited)
+            stop(job->pid);
+          evaluations[job->candidate].push_back(done ? readEvaluation(job->resultFile) : Evaluation());
+          if(!done)
+            std::fprintf(stderr, "Simulation of candidate %d %s.\n", job->candidate, exited ? "terminated" : "timed out");
+          job = jobs.erase(job);
+        }
+        else
+          ++job;
+      }
+    }
+    for(Job& job : jobs)
+      stop(job.pid);
+    return evaluations;
+  }
+
+private:
+  /**
+   * Writes the scene of a simulation and starts SimRobot.
+   * @param x The candidate.
+   * @param candidate The index of the candidate.
+   * @param job The job that is filled.
+   * @return Was SimRobot started?
+   */
+  bool start(const CMAES::Vector& x, int candidate, Job& job)
+  {
+    const std::string name = workDir + "/job" + std::to_string(numOfJobs++);
+    job.candidate = candidate;
+    job.resultFile = name + ".result";
+    std::remove(job.resultFile.c_str());
+
+    const std::string includes = bhDir + "/Config/Scenes/Includes/";
+    std::ofstream scene(name + ".ros2");
+    scene << "<Simulation>\n"
+          << "  <Include href=\"" << includes << "NaoV6H25.rsi2\"/>\n"
+          << "  <Include href=\"" << includes << "Ball2016SPL.rsi2\"/>\n"
+          << "  <Include href=\"" << includes << "Field2020SPL.rsi2\"/>\n"
+          << "  <Scene name=\"RoboCup\" controller=\"SimulatedNao\" stepLength=\"0.012\" color=\"rgb(65%, 65%, 70%)\" ERP=\"0.8\" CFM=\"0.001\" contactSoftERP=\"0.2\" contactSoftCFM=\"0.005\">\n"
+          << "    <Light z=\"9m\" ambientColor=\"rgb(50%, 50%, 50%)\"/>\n"
+          << "    <Compound name=\"teamColors\">\n"
+          << "      <Appearance name=\"black\"/>\n"
+          << "      <Appearance name=\"blue\"/>\n"
+          << "    </Compound>\n"
+          << "    <Compound name=\"robots\">\n"
+          << "      <Body ref=\"Nao\" name=\"robot2\">\n"
+          << "        <Translation x=\"-3.5\" z=\"320mm\"/>\n"
+          << "      </Body>\n"
+          << "    </Compound>\n"
+          << "    <Compound name=\"balls\">\n"
+          << "      <Body ref=\"ball\">\n"
+          << "        <Translation x=\"4.4\" y=\"2.9\" z=\"1m\"/>\n"
+          << "      </Body>\n"
+          << "    </Compound>\n"
+          << "    <Compound ref=\"field\"/>\n"
+          << "  </Scene>\n"
+          << "</Simulation>\n";
+
+    std::ofstream console(name + ".con");
+    console << "call Includes/Fast\n"
+            << "mr MotionRequest WalkEvaluator Cognition\n"
+            << "mr WalkEvaluation WalkEvaluator Cognition\n"
+            << "set parameters:Walk2014Generator " << ConfigText::singleLine(toConfig(x)) << "\n"
+            << "set parameters:WalkEvaluator " << ConfigText::singleLine(evaluatorParameters.replace({{"resultFile", "\"" + job.resultFile + "\""}})) << "\n"
+            << "gc playing\n";
+    if(!scene || !console)
+    {
+      std::fprintf(stderr, "Cannot write %s.\n", name.c_str());
+      return false;
+    }
+    scene.close();
+    console.close();
+
+    std::fflush(nullptr); // Otherwise, the child would write buffered output again.
+    job.pid = fork();
+    if(job.pid == 0)
+    {
+      setpgid(0, 0);
+      setenv("QT_QPA_PLATFORM", "offscreen", 1);
+      std::freopen("/dev/null", "w", stdout);
+      std::freopen("/dev/null", "w", stderr);
+      const std::string sceneFile = name + ".ros2";
+      execl(simRobot.c_str(), simRobot.c_str(), sceneFile.c_str(), static_cast<char*>(nullptr));
+      _exit(127);
+    }
+    if(job.pid < 0)
+    {
+      std::perror("fork");
+      return false;
+    }
+    setpgid(job.pid, job.pid);
+    job.startTime = now();
+    return true;
+  }
+};
+
+/**
+ * Searches the root directory of the B-Human code upwards from the current
+ * directory.
+ * @return The directory or an empty string if it was not found.
+ */
+static std::string findBHDir()
+{
+  char buffer[4096];
+  if(!getcwd(buffer, sizeof(buffer)))
+    return "";
+  std::string dir = buffer;
+  for(;;)
+  {
+    struct stat info;
+    if(stat((dir + "/Config/Scenes/Includes").c_str(), &info) == 0)
+      return dir;
+    const size_t slash = dir.find_last_of('/');
+    if(slash == std::string::npos || slash == 0)
+      return "";
+    dir.resize(slash);
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  WalkOptimizer optimizer;
+  optimizer.bhDir = findBHDir();
+  optimizer.processes = std::max(1u, static_cast<unsigned>(sysconf(_SC_NPROCESSORS_ONLN)));
+  unsigned generations = 30;
+  int lambda = 0;
+  double sigma = 0.2;
+  unsigned seed = std::random_device()();
+  std::string baseFile, rangeFile, outputFile = "walk2014Generator.cfg";
+  optimizer.workDir = "/tmp/walkOptimizer";
+  for(int i = 1; i < argc; ++i)
+  {
+    if(i + 1 < argc && !std::strcmp(argv[i], "-j"))
+      optimizer.processes = std::max(1, std::atoi(argv[++i]));
+    else if(i + 1 < argc && !std::strcmp(argv[i], "-g"))
+      generations = static_cast<unsigned>(std::atoi(argv[++i]));
+    else if(i + 1 < argc && !std::strcmp(argv[i], "-l"))
+      lambda = std::atoi(argv[++i]);
+    else if(i + 1 < argc && !std::strcmp(argv[i], "-r"))
+      optimizer.repetitions = std::max(1, std::atoi(argv[++i]));
+    else if(i + 1 < argc && !std::strcmp(argv[i], "-S"))
+      sigma = std::atof(argv[++i]);
+    else if(i + 1 < argc && !std::strcmp(argv[i], "-t"))
+      optimizer.timeout = std::atof(argv[++i]);
+    else if(i + 1 < argc && !std::strcmp(argv[i], "-s"))
+      seed = static_cast<unsigned>(std::atoi(argv[++i]));
+    else if(i + 1 < argc && !std::strcmp(argv[i], "-c"))
+      baseFile = argv[++i];
+    else if(i + 1 < argc && !std::strcmp(argv[i], "-p"))
+      rangeFile = argv[++i];
+    else if(i + 1 < argc && !std::strcmp(argv[i], "-b"))
+      optimizer.simRobot = argv[++i];
+    else if(i + 1 < argc && !std::strcmp(argv[i], "-w"))
+      optimizer.workDir = argv[++i];
+    else if(i + 1 < argc && !std::strcmp(argv[i], "-o"))
+      outputFile = argv[++i];
+    else
+    {
+      std::fprintf(stderr, "usage: %s [-j <processes>] [-g <generations>] [-l <population>] [-r <repetitions>] [-S <initial step size>] "
+                   "[-t <timeout in s>] [-s <seed>] [-c <base parameters>] [-p <parameter ranges>] [-b <SimRobot>] [-w <work dir>] [-o <output file>]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  if(optimizer.bhDir.empty())
+  {
+    std::fprintf(stderr, "Run this program inside the B-Human directory.\n");
+    return 2;
+  }
+  if(baseFile.empty())
+    baseFile = optimizer.bhDir + "/Config/Robots/Nao/Nao/walk2014Generator.cfg";
+  if(rangeFile.empty())
+    rangeFile = optimizer.bhDir + "/Config/Scenarios/Default/walk2014Learner.cfg";
+  if(optimizer.simRobot.empty())
+    optimizer.simRobot = optimizer.bhDir + "/Build/Linux/SimRobot/Develop/SimRobot";
+
+  ConfigText ranges;
+  if(!optimizer.walkParameters.read(baseFile) || !ranges.read(rangeFile)
+     || !optimizer.evaluatorParameters.read(optimizer.bhDir + "/Config/Scenarios/Default/walkEvaluator.cfg"))
+  {
+    std::fprintf(stderr, "Cannot read %s, %s or walkEvaluator.cfg.\n", baseFile.c_str(), rangeFile.c_str());
+    return 2;
+  }
+  optimizer.parameters = ranges.parameters("parameters");
+  if(optimizer.parameters.empty())
+  {
+    std::fprintf(stderr, "No parameters to optimize found in %s.\n", rangeFile.c_str());
+    return 2;
+  }
+  mkdir(optimizer.workDir.c_str(), 0755);
+
+  std::signal(SIGINT, [](int) {running = 0;});
+  std::signal(SIGTERM, [](int) {running = 0;});
+
+  const int n = static_cast<int>(optimizer.parameters.size());
+  CMAES cmaes(optimizer.fromConfig(), sigma, lambda > 1 ? lambda : 4 + static_cast<int>(3.0 * std::log(n)), seed);
+  std::printf("Optimizing %d parameters with a population of %d in %u processes.\n", n, cmaes.lambda, optimizer.processes);
+
+  CMAES::Vector best = cmaes.mean;
+  double bestFitness = std::numeric_limits<double>::max();
+  for(unsigned generation = 0; generation < generations && running; ++generation)
+  {
+    const double startTime = now();
+    const std::vector<CMAES::Vector> population = cmaes.sample();
+    const std::vector<std::vector<Evaluation>> evaluations = optimizer.evaluate(population);
+    if(!running)
+      break;
+
+    std::vector<double> fitness(population.size());
+    int bestIndex = 0;
+    for(size_t i = 0; i < population.size(); ++i)
+    {
+      fitness[i] = optimizer.fitness(population[i], evaluations[i]);
+      if(fitness[i] < fitness[bestIndex])
+        bestIndex = static_cast<int>(i);
+    }
+    cmaes.update(population, fitness);
+
+    const Evaluation& evaluation = evaluations[bestIndex].front();
+    std::printf("generation %u: best fitness %.4f (speed ratio %.3f, gyro deviation %.3f rad/s, %d falls), sigma %.4f, %.0f s\n",
+                generation, fitness[bestIndex], evaluation.speedRatio, evaluation.gyroDeviation, evaluation.falls, cmaes.sigma, now() - startTime);
+    if(fitness[bestIndex] < bestFitness)
+    {
+      bestFitness = fitness[bestIndex];
+      best = population[bestIndex];
+      std::ofstream output(outputFile);
+      output << optimizer.toConfig(best);
+      if(!output)
+        std::fprintf(stderr, "Cannot write %s.\n", outputFile.c_str());
+    }
+    std::fflush(stdout);
+  }
+
+  if(bestFitness == std::numeric_limits<double>::max())
+    return 1;
+  std::printf("Best fitness %.4f written to %s.\n", bestFitness, outputFile.c_str());
+  return 0;
+}
@@ -116,7 +116,8 @@ class NAOCommunicationController(twisted.internet.protocol.DatagramProtocol):
     
     def handleBooleanFlagsMessage(self, content, message_info):
         content_fields = content.split(";")[1:]
-        flags_list = {flag_name : flag_value for (flag_name, flag_value) in [flag.split(":") for flag in content_fields]}
+        #Each flag is "name:value", changed flags also carry the frame timestamp of the change as "name:value:timestamp"
+        flags_list = {flag.split(":")[0] : flag.split(":")[1] for flag in content_fields}
         #print("[Robot {}] Boolean flags: ".format(self.robot_number), ", ".join(["({}, {})".format(flag_name, flag_value) for flag_name, flag_value in flags_list.items()]))
 
         self.communication_manager.updateBooleanFlags(self.robot_number, message_info["timestamp"], flags_list)